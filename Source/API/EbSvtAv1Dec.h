@@ -117,9 +117,32 @@ typedef struct EbSvtAv1DecConfiguration {
     uint32_t channel_id;
     uint32_t active_channel_count;
 
+    /* Time the decoding stages, see eb_svt_dec_get_stage_stats().
+     *
+     * Default is 0. */
     uint32_t stat_report;
+
+    /* Low memory mode: picture buffers are allocated when a frame needs one
+     * and freed once neither the reference map nor the output holds them,
+     * instead of keeping a pool that only grows.
+     *
+     * Default is 0. */
+    EbBool low_memory;
 } EbSvtAv1DecConfiguration;
 
+/* Time spent in each decoding stage in microseconds, accumulated over the
+ * frames decoded since eb_init_decoder() when stat_report is set. With
+ * threads > 1 the stages overlap on the worker threads and only the film
+ * grain is timed. */
+typedef struct EbSvtDecStageStats {
+    uint64_t parse_time;
+    uint64_t recon_time;
+    uint64_t lf_time;
+    uint64_t cdef_time;
+    uint64_t lr_time;
+    uint64_t film_grain_time;
+} EbSvtDecStageStats;
+
 /* STEP 1: Call the library to construct a Component Handle.
      *
      * Parameter:
@@ -204,6 +227,26 @@ EB_API EbErrorType eb_svt_decode_frame(EbComponentType *svt_dec_component, const
 EB_API EbErrorType eb_svt_decode_tu(EbComponentType *svt_dec_component, const uint8_t *data,
                                     const uint32_t data_size);
 
+/*!\brief STEP 5-alt-3: Pushes a chunk of a low overhead bitstream (Section 5,
+     * every OBU carrying obu_size) of any size. The OBUs complete in the chunk
+     * are decoded in place, a tile group is parsed as soon as it is complete.
+     * The start of an OBU cut by the end of the chunk is kept by the decoder
+     * and completed by the next push. Decoding stops after each decoded
+     * frame so the picture can be fetched with eb_svt_dec_get_picture(), the
+     * remaining data is pushed again afterwards.
+     *
+     * Parameter:
+     * @ *svt_dec_component     Decoder handle
+     * @ *data                  Chunk of the bitstream, only read during the call
+     * @ data_size              Chunk size in bytes
+     * @ *consumed              Bytes of the chunk used
+     * @ *frame_decoded         Set when a frame has been decoded
+     *
+     *  Returns EB_ErrorNone if the data has been processed successfully. */
+EB_API EbErrorType eb_svt_dec_push_data(EbComponentType *svt_dec_component, const uint8_t *data,
+                                        size_t data_size, size_t *consumed,
+                                        EbBool *frame_decoded);
+
 /* STEP 6: Get the next decoded picture. When several output pictures
      * have been generated, calling this function multiple times will
      * iterate over the decoded pictures. The previous output picture becomes
@@ -257,6 +300,79 @@ EB_API EbErrorType eb_dec_flush(EbComponentType *svt_dec_component);
 EB_API EbErrorType eb_get_stream_info(EbComponentType *svt_dec_component,
                                       EbAV1StreamInfo *stream_info, EbAV1FrameInfo *frame_info);
 
+/* Returns the time spent in each decoding stage.
+     *
+     * Parameter:
+     * @ *svt_dec_component     Decoder handle.
+     * @ *stats                 Stage times, all 0 when stat_report is not set */
+EB_API EbErrorType eb_svt_dec_get_stage_stats(EbComponentType *   svt_dec_component,
+                                              EbSvtDecStageStats *stats);
+
+/* Shared decoder pool
+     *
+     * A pool owns a fixed set of worker threads that decode the temporal
+     * units submitted by any number of attached decoder handles, so many
+     * streams can be decoded without one set of threads per stream.
+     * Streams are served round robin, one temporal unit per turn, and the
+     * temporal units of one stream are always decoded in submission order
+     * by at most one worker at a time. Attached handles must be configured
+     * with threads = 1 and initialized with eb_init_decoder(). */
+typedef struct EbSvtDecPool EbSvtDecPool;
+
+/* Called on the pool worker once a submitted temporal unit has been decoded.
+     * The decoded picture can be fetched here with eb_svt_dec_get_picture(),
+     * the next temporal unit of the same stream is not decoded before the
+     * callback returns. */
+typedef void (*EbSvtDecPoolCallback)(EbComponentType *svt_dec_component, EbErrorType error,
+                                     void *user_data);
+
+/* Create a pool of num_threads workers.
+     *
+     * Parameter:
+     * @ **pool             Created pool
+     * @ num_threads        Number of worker threads, at least 1 */
+EB_API EbErrorType eb_svt_dec_pool_create(EbSvtDecPool **pool, uint32_t num_threads);
+
+/* Stop the workers and free the pool. Work still queued is decoded first,
+     * then the streams still attached are detached.
+     *
+     * Parameter:
+     * @ *pool              Pool to destroy */
+EB_API EbErrorType eb_svt_dec_pool_destroy(EbSvtDecPool *pool);
+
+/* Attach an initialized decoder handle to the pool.
+     *
+     * Parameter:
+     * @ *pool              Pool
+     * @ *svt_dec_component Decoder handle */
+EB_API EbErrorType eb_svt_dec_pool_attach(EbSvtDecPool *pool, EbComponentType *svt_dec_component);
+
+/* Wait for the queued work of the handle and detach it from its pool.
+     * Called by eb_deinit_decoder() for handles still attached.
+     *
+     * Parameter:
+     * @ *svt_dec_component Decoder handle */
+EB_API EbErrorType eb_svt_dec_pool_detach(EbComponentType *svt_dec_component);
+
+/* Queue a temporal unit for decoding, the equivalent of eb_svt_decode_frame().
+     * The data is copied, the call returns without waiting for the decode.
+     *
+     * Parameter:
+     * @ *svt_dec_component Attached decoder handle
+     * @ *data              Buffer with data
+     * @ data_size          Data size in bytes
+     * @ callback           Called once the data has been decoded, may be NULL
+     * @ *user_data         Passed to callback */
+EB_API EbErrorType eb_svt_dec_pool_submit(EbComponentType *svt_dec_component, const uint8_t *data,
+                                          const size_t data_size, uint32_t is_annexb,
+                                          EbSvtDecPoolCallback callback, void *user_data);
+
+/* Block until all the temporal units submitted for the handle are decoded.
+     *
+     * Parameter:
+     * @ *svt_dec_component Attached decoder handle */
+EB_API EbErrorType eb_svt_dec_pool_wait(EbComponentType *svt_dec_component);
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
@@ -182,6 +182,16 @@ typedef struct EbSvtAv1EncConfiguration {
     FILE *input_stat_file;
     /* output stats file */
     FILE *output_stat_file;
+    /* Fast first pass: when set together with output_stat_file, the first pass
+     * writes the compact per-picture analysis statistics (intra/inter cost,
+     * variance, scene changes). It codes the input at half resolution with the
+     * fastest enc_mode, and deblocking, restoration and altrefs off; a warning
+     * is logged for each setting it changes. The recon output is not
+     * supported. The second pass detects the format from input_stat_file and
+     * uses it to distribute the VBR budget across the sequence.
+     *
+     * Default is 0. */
+    uint8_t fast_first_pass;
     /* Enable picture QP scaling between hierarchical levels
     *
     * Default is null.*/
@@ -385,6 +395,8 @@ typedef struct EbSvtAv1EncConfiguration {
      *
      * 0 = Constant QP.
      * 1 = Average BitRate.
+     * 2 = Constrained Variable BitRate.
+     * 3 = Constant Rate Factor, qp is used as the quality level.
      *
      * Default is 0. */
     uint32_t rate_control_mode;
@@ -408,6 +420,14 @@ typedef struct EbSvtAv1EncConfiguration {
     /* VBV Buffer size */
     uint32_t vbv_bufsize;
 
+    /* Maximum bitrate in bits/second, only applicable when rate control mode is
+     * set to 3. The rate is enforced over a VBV buffer of vbv_bufsize bits.
+     *
+     * 0 = no cap.
+     *
+     * Default is 0. */
+    uint32_t max_bit_rate;
+
     /* Maxium QP value allowed for rate control use, only applicable when rate
      * control mode is set to 1. It has to be greater or equal to minQpAllowed.
      *
@@ -465,6 +485,11 @@ typedef struct EbSvtAv1EncConfiguration {
     /* ID assigned to each channel when multiple instances are running within the
      * same application. */
     uint32_t channel_id;
+    /* Number of channels running in the same process. When logical_processors
+     * is 0, each channel sizes its threads and buffer pools from an equal share
+     * of the cores. The channels share the immutable quantizer tables, but
+     * every channel still runs its own threads: there is no worker pool shared
+     * across channels. */
     uint32_t active_channel_count;
 
     /* Flag to enable the Speed Control functionality to achieve the real-time
@@ -504,6 +529,20 @@ typedef struct EbSvtAv1EncConfiguration {
     * Default is 1. */
     uint32_t unpin_lp1;
 
+    /* Approximate memory budget in MB for the picture buffer pools. When the
+     * estimated footprint exceeds it, the pools are reduced to their minimum
+     * sizes and then the look-ahead distance is shortened one mini-GOP at a
+     * time. In rate control mode 2 the look-ahead is not shortened below the
+     * intra period, and eb_svt_enc_set_parameter() rejects the configuration
+     * if the budget is still not met.
+     * The estimate counts the picture buffers and the largest per-picture
+     * tables only, not every buffer of the picture control sets nor the
+     * per-thread contexts, so the resident memory of the encoder is higher.
+     * 0 = no budget.
+     *
+     * Default is 0. */
+    uint32_t max_memory_mb;
+
     /* Target socket to run on. For dual socket systems, this can specify which
      * socket the encoder runs on.
      *
@@ -604,6 +643,18 @@ EB_API EbErrorType eb_svt_enc_set_parameter(
     EbSvtAv1EncConfiguration *
         pComponentParameterStructure); // pComponentParameterStructure contents will be copied to the library
 
+/* OPTIONAL: Get the estimated size of the picture buffer pools, valid after
+     * eb_svt_enc_set_parameter() and before eb_init_encoder(). The estimate is
+     * approximate: the smaller picture control set buffers and the per-thread
+     * contexts are not included. The picture pools are filled on demand, so
+     * this is the most they can grow to.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *footprint_bytes    Estimated pool memory in bytes. */
+EB_API EbErrorType eb_svt_enc_get_memory_footprint(EbComponentType *svt_enc_component,
+                                                   uint64_t *       footprint_bytes);
+
 /* STEP 3: Initialize encoder and allocates memory to necessary buffers.
      *
      * Parameter:
@@ -633,7 +684,9 @@ EB_API EbErrorType eb_svt_release_enc_stream_header(EbBufferHeaderType *stream_h
 EB_API EbErrorType eb_svt_enc_eos_nal(EbComponentType *    svt_enc_component,
                                       EbBufferHeaderType **output_stream_ptr);
 
-/* STEP 4: Send the picture.
+/* STEP 4: Send the picture. The input buffers are allocated on first use, an
+     * allocation failure is returned here. A failure inside the pipeline is
+     * reported by eb_svt_get_packet() with an error packet.
      *
      * Parameter:
      * @ *svt_enc_component  Encoder handler.
@@ -664,6 +717,19 @@ EB_API void eb_svt_release_out_buffer(EbBufferHeaderType **p_buffer);
 EB_API EbErrorType eb_svt_get_recon(EbComponentType *   svt_enc_component,
                                     EbBufferHeaderType *p_buffer);
 
+/* OPTIONAL: Restart the encoder on a new sequence with a new configuration,
+     * instead of going through STEP 6, 7, 1, 2 and 3. The current sequence must
+     * be fully flushed: the packet flagged EB_BUFFERFLAG_EOS was received, or
+     * no picture was sent yet. The picture pools that would be allocated
+     * identically for the new configuration keep their buffers. After it
+     * returns, continue from eb_svt_enc_stream_header().
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *config_ptr         Configuration of the new sequence. */
+EB_API EbErrorType eb_svt_enc_reset(EbComponentType *         svt_enc_component,
+                                    EbSvtAv1EncConfiguration *config_ptr);
+
 /* STEP 6: Deinitialize encoder library.
      *
      * Parameter:
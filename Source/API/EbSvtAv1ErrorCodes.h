@@ -222,6 +222,8 @@ typedef enum ENCODER_ERROR_CODES {
     EB_ENC_PD_ERROR6 = 0x2105,
     EB_ENC_PD_ERROR7 = 0x2106,
     EB_ENC_PD_ERROR8 = 0x2107,
+    //EB_ENC_SRM_ERRORS                 = 0x2200,
+    EB_ENC_SRM_OBJECT_CTOR_ERROR = 0x2200,
 } ENCODER_ERROR_CODES;
 
 #ifdef __cplusplus
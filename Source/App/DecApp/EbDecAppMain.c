@@ -15,6 +15,7 @@
 #include "EbDecParamParser.h"
 #include "EbMD5Utility.h"
 #include "EbDecTime.h"
+#include "EbDecBench.h"
 
 #ifdef _WIN32
 #include <io.h> /* _setmode() */
@@ -135,11 +136,13 @@ int32_t main(int32_t argc, char *argv[]) {
     EbSvtAv1DecConfiguration *config_ptr =
         (EbSvtAv1DecConfiguration *)malloc(sizeof(EbSvtAv1DecConfiguration));
     CliInput cli;
-    cli.in_file     = NULL;
-    cli.out_file    = NULL;
-    cli.enable_md5  = 0;
-    cli.fps_frm     = 0;
-    cli.fps_summary = 0;
+    cli.in_file       = NULL;
+    cli.out_file      = NULL;
+    cli.enable_md5    = 0;
+    cli.fps_frm       = 0;
+    cli.fps_summary   = 0;
+    cli.bench_threads = 0;
+    cli.bench_json    = NULL;
 
     DecInputContext    input   = {NULL, NULL};
     ObuDecInputContext obu_ctx = {NULL, 0, 0, 0, 0};
@@ -172,8 +175,10 @@ int32_t main(int32_t argc, char *argv[]) {
     return_error |= eb_dec_init_handle(&p_handle, p_app_data, config_ptr);
     if (return_error != EB_ErrorNone) goto fail;
 
-    if (read_command_line(argc, argv, config_ptr, &cli, &obu_ctx) == 0 &&
-        !eb_svt_dec_set_parameter(p_handle, config_ptr)) {
+    EbErrorType cli_error = read_command_line(argc, argv, config_ptr, &cli, &obu_ctx);
+    if (cli_error == EB_ErrorNone && cli.bench_threads)
+        return_error = dec_bench_run(&input, config_ptr);
+    else if (cli_error == EB_ErrorNone && !eb_svt_dec_set_parameter(p_handle, config_ptr)) {
         return_error = eb_init_decoder(p_handle);
         if (return_error != EB_ErrorNone) {
             return_error |= eb_dec_deinit_handle(p_handle);
@@ -0,0 +1,380 @@
+/*
+* Copyright(c) 2019 Netflix, Inc.
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+// Decoder benchmark: fps, stage times and peak memory over thread counts
+
+/***************************************
+ * Includes
+ ***************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "EbDecBench.h"
+#include "EbDecParamParser.h"
+#include "EbDecTime.h"
+
+int read_input_frame(DecInputContext *input, uint8_t **buffer, size_t *bytes_read,
+                     size_t *buffer_size, int64_t *pts);
+
+/* Temporal units of the input held in memory */
+typedef struct DecBenchStream {
+    uint8_t **tu;
+    size_t *  tu_size;
+    uint32_t  num_tus;
+} DecBenchStream;
+
+typedef struct DecBenchPass {
+    uint32_t           threads;
+    uint32_t           frames;
+    uint64_t           time_us;
+    uint64_t           peak_rss_kb;
+    EbSvtDecStageStats stages;
+} DecBenchPass;
+
+/* Peak resident memory of the process so far, a high-water mark that no pass
+ * can reset */
+static uint64_t peak_rss_kb(void) {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return 0;
+    return pmc.PeakWorkingSetSize / 1024;
+#else
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage)) return 0;
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+static void free_stream(DecBenchStream *stream) {
+    for (uint32_t i = 0; i < stream->num_tus; i++) free(stream->tu[i]);
+    free(stream->tu);
+    free(stream->tu_size);
+}
+
+static EbErrorType load_stream(DecInputContext *input, const EbSvtAv1DecConfiguration *config,
+                               DecBenchStream *stream) {
+    uint8_t *buf         = NULL;
+    size_t   bytes_read  = 0;
+    size_t   buffer_size = 0;
+    uint32_t capacity    = 0;
+    uint64_t skip        = config->skip_frames;
+
+    memset(stream, 0, sizeof(*stream));
+    while (skip && read_input_frame(input, &buf, &bytes_read, &buffer_size, NULL)) skip--;
+    while ((!config->frames_to_be_decoded || stream->num_tus < config->frames_to_be_decoded) &&
+           read_input_frame(input, &buf, &bytes_read, &buffer_size, NULL)) {
+        if (stream->num_tus == capacity) {
+            capacity          = capacity ? capacity * 2 : 64;
+            uint8_t **tu      = (uint8_t **)realloc(stream->tu, capacity * sizeof(*tu));
+            size_t *  tu_size = tu ? (size_t *)realloc(stream->tu_size, capacity * sizeof(*tu_size))
+                                 : NULL;
+            if (tu) stream->tu = tu;
+            if (tu_size) stream->tu_size = tu_size;
+            if (!tu || !tu_size) break;
+        }
+        stream->tu[stream->num_tus] = (uint8_t *)malloc(bytes_read);
+        if (!stream->tu[stream->num_tus]) break;
+        memcpy(stream->tu[stream->num_tus], buf, bytes_read);
+        stream->tu_size[stream->num_tus++] = bytes_read;
+    }
+    free(buf);
+
+    if (!stream->num_tus) {
+        free_stream(stream);
+        return EB_ErrorBadParameter;
+    }
+    return EB_ErrorNone;
+}
+
+static EbErrorType bench_pass(const DecBenchStream *stream, const EbSvtAv1DecConfiguration *config,
+                              uint32_t is_annexb, uint32_t threads, DecBenchPass *pass) {
+    EbComponentType *        handle;
+    EbSvtAv1DecConfiguration pass_config;
+    EbBufferHeaderType       out_buf;
+    EbSvtIOFormat            out_img;
+    EbAV1StreamInfo          stream_info;
+    EbAV1FrameInfo           frame_info;
+    struct EbDecTimer        timer;
+    EbErrorType              return_error;
+
+    return_error = eb_dec_init_handle(&handle, NULL, &pass_config);
+    if (return_error != EB_ErrorNone) return return_error;
+
+    pass_config             = *config;
+    pass_config.threads     = threads;
+    pass_config.stat_report = 1;
+    return_error            = eb_svt_dec_set_parameter(handle, &pass_config);
+    if (return_error == EB_ErrorNone) return_error = eb_init_decoder(handle);
+    if (return_error != EB_ErrorNone) {
+        eb_dec_deinit_handle(handle);
+        return return_error;
+    }
+
+    /* The planes are allocated by the decoder with the first picture */
+    memset(&out_img, 0, sizeof(out_img));
+    out_img.bit_depth = config->max_bit_depth;
+    out_buf.p_buffer  = (uint8_t *)&out_img;
+
+    memset(pass, 0, sizeof(*pass));
+    pass->threads = threads;
+
+    dec_timer_start(&timer);
+    for (uint32_t i = 0; i < stream->num_tus; i++) {
+        return_error = eb_svt_decode_frame(handle, stream->tu[i], stream->tu_size[i], is_annexb);
+        if (return_error != EB_ErrorNone) break;
+        if (eb_svt_dec_get_picture(handle, &out_buf, &stream_info, &frame_info) !=
+            EB_DecNoOutputPicture)
+            pass->frames++;
+    }
+    dec_timer_mark(&timer);
+    pass->time_us = dec_timer_elapsed(&timer);
+    eb_svt_dec_get_stage_stats(handle, &pass->stages);
+
+    eb_deinit_decoder(handle);
+    eb_dec_deinit_handle(handle);
+    free(out_img.luma);
+    free(out_img.cb);
+    free(out_img.cr);
+    return return_error;
+}
+
+#ifdef _WIN32
+/* The passes share the process, only the first one has its own peak memory */
+static EbErrorType run_pass(const DecBenchStream *stream, const EbSvtAv1DecConfiguration *config,
+                            uint32_t is_annexb, uint32_t threads, DecBenchPass *pass) {
+    EbErrorType return_error = bench_pass(stream, config, is_annexb, threads, pass);
+
+    pass->peak_rss_kb = threads == 1 ? peak_rss_kb() : 0;
+    return return_error;
+}
+#else
+typedef struct DecBenchResult {
+    EbErrorType  error;
+    DecBenchPass pass;
+} DecBenchResult;
+
+/* Decode in a child process, so that the peak memory of the pass covers the
+ * stream loaded by the parent and that pass only */
+static EbErrorType run_pass(const DecBenchStream *stream, const EbSvtAv1DecConfiguration *config,
+                            uint32_t is_annexb, uint32_t threads, DecBenchPass *pass) {
+    DecBenchResult result;
+    int            fd[2];
+    int            status;
+    pid_t          pid;
+
+    if (pipe(fd)) return EB_ErrorInsufficientResources;
+    fflush(stderr);
+    pid = fork();
+    if (pid == 0) {
+        close(fd[0]);
+        result.error            = bench_pass(stream, config, is_annexb, threads, &result.pass);
+        result.pass.peak_rss_kb = peak_rss_kb();
+        /* Below PIPE_BUF, the result is written at once */
+        _exit(write(fd[1], &result, sizeof(result)) == sizeof(result) ? 0 : 1);
+    }
+    close(fd[1]);
+    if (pid < 0) {
+        close(fd[0]);
+        return EB_ErrorInsufficientResources;
+    }
+    if (read(fd[0], &result, sizeof(result)) != sizeof(result))
+        result.error = EB_ErrorUndefined;
+    close(fd[0]);
+    if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status))
+        result.error = EB_ErrorUndefined;
+    if (result.error == EB_ErrorNone) *pass = result.pass;
+    return result.error;
+}
+#endif
+
+typedef enum DecBenchStage {
+    DEC_BENCH_PARSE,
+    DEC_BENCH_RECON,
+    DEC_BENCH_LF,
+    DEC_BENCH_CDEF,
+    DEC_BENCH_LR,
+    DEC_BENCH_FILM_GRAIN,
+    DEC_BENCH_STAGES
+} DecBenchStage;
+
+static const char *const stage_names[DEC_BENCH_STAGES] = {
+    "parse", "recon", "lf", "cdef", "lr", "film_grain"};
+
+static void get_stage_times(const DecBenchPass *pass, uint64_t stage_us[DEC_BENCH_STAGES]) {
+    stage_us[DEC_BENCH_PARSE]      = pass->stages.parse_time;
+    stage_us[DEC_BENCH_RECON]      = pass->stages.recon_time;
+    stage_us[DEC_BENCH_LF]         = pass->stages.lf_time;
+    stage_us[DEC_BENCH_CDEF]       = pass->stages.cdef_time;
+    stage_us[DEC_BENCH_LR]         = pass->stages.lr_time;
+    stage_us[DEC_BENCH_FILM_GRAIN] = pass->stages.film_grain_time;
+}
+
+static double pass_fps(const DecBenchPass *pass) {
+    return pass->time_us ? (double)pass->frames * 1000000.0 / (double)pass->time_us : 0.0;
+}
+
+static void write_json_string(FILE *f, const char *s) {
+    fputc('"', f);
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\')
+            fprintf(f, "\\%c", *s);
+        else if ((unsigned char)*s < 0x20)
+            fprintf(f, "\\u%04x", *s);
+        else
+            fputc(*s, f);
+    }
+    fputc('"', f);
+}
+
+/* With threads > 1 the stages overlap on the worker threads and only the film
+ * grain is timed, see EbSvtDecStageStats */
+static int stage_timed(const DecBenchPass *pass, DecBenchStage stage) {
+    return pass->threads == 1 || stage == DEC_BENCH_FILM_GRAIN;
+}
+
+static void write_json_value(FILE *f, const char *name, uint64_t value, int known) {
+    if (known)
+        fprintf(f, "\"%s\": %" PRIu64, name, value);
+    else
+        fprintf(f, "\"%s\": null", name);
+}
+
+static void write_json(FILE *f, const char *in_filename, const DecBenchPass *passes,
+                       uint32_t num_passes) {
+    fprintf(f, "{\n  \"input\": ");
+    write_json_string(f, in_filename);
+    fprintf(f, ",\n  \"passes\": [\n");
+    for (uint32_t i = 0; i < num_passes; i++) {
+        const DecBenchPass *pass = &passes[i];
+        uint64_t            stage_us[DEC_BENCH_STAGES];
+
+        get_stage_times(pass, stage_us);
+        fprintf(f,
+                "    {\"threads\": %u, \"frames\": %u, \"time_us\": %" PRIu64 ", \"fps\": %.3f, ",
+                pass->threads,
+                pass->frames,
+                pass->time_us,
+                pass_fps(pass));
+        write_json_value(f, "peak_rss_kb", pass->peak_rss_kb, pass->peak_rss_kb != 0);
+        fprintf(f, ",\n     \"stages_us\": {");
+        for (int stage = 0; stage < DEC_BENCH_STAGES; stage++) {
+            if (stage) fprintf(f, ", ");
+            write_json_value(f,
+                             stage_names[stage],
+                             stage_us[stage],
+                             stage_timed(pass, (DecBenchStage)stage));
+        }
+        fprintf(f, "}}%s\n", i + 1 < num_passes ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+}
+
+/* Right aligned value, or - when it is not known */
+static void show_value(uint64_t value, int known, int width) {
+    if (known)
+        fprintf(stderr, " %*" PRIu64, width, value);
+    else
+        fprintf(stderr, " %*s", width, "-");
+}
+
+static void show_pass(const DecBenchPass *pass) {
+    uint64_t stage_us[DEC_BENCH_STAGES];
+
+    get_stage_times(pass, stage_us);
+    fprintf(stderr,
+            "%7u %7u %10.2f %10" PRIu64,
+            pass->threads,
+            pass->frames,
+            pass_fps(pass),
+            pass->time_us / 1000);
+    for (int stage = 0; stage < DEC_BENCH_STAGES; stage++)
+        show_value(stage_us[stage] / 1000, stage_timed(pass, (DecBenchStage)stage), 9);
+    show_value(pass->peak_rss_kb, pass->peak_rss_kb != 0, 12);
+    fprintf(stderr, "\n");
+}
+
+EbErrorType dec_bench_run(DecInputContext *input, const EbSvtAv1DecConfiguration *config) {
+    CliInput *     cli         = input->cli_ctx;
+    uint32_t       max_threads = cli->bench_threads ? cli->bench_threads : 1;
+    DecBenchStream stream;
+    DecBenchPass * passes;
+    uint32_t       num_passes = 0;
+    EbErrorType    return_error;
+
+    return_error = load_stream(input, config, &stream);
+    if (return_error != EB_ErrorNone) {
+        fprintf(stderr, "No temporal unit read from the input. \n");
+        return return_error;
+    }
+    passes = (DecBenchPass *)malloc(max_threads * sizeof(*passes));
+    if (!passes) {
+        free_stream(&stream);
+        return EB_ErrorInsufficientResources;
+    }
+
+    for (uint32_t threads = 1; threads <= max_threads; threads++) {
+        return_error = run_pass(
+            &stream, config, input->obu_ctx->is_annexb, threads, &passes[num_passes]);
+        if (return_error != EB_ErrorNone) {
+            fprintf(stderr, "Decoding failed with %u threads. \n", threads);
+            break;
+        }
+        num_passes++;
+    }
+
+    /* Shown once all the passes are done, the decoder logs when it starts */
+    fprintf(stderr,
+            "Benchmark of %u temporal units, times in ms, peak memory in KB\n"
+            "%7s %7s %10s %10s %9s %9s %9s %9s %9s %9s %12s\n",
+            stream.num_tus,
+            "threads",
+            "frames",
+            "fps",
+            "total",
+            "parse",
+            "recon",
+            "lf",
+            "cdef",
+            "lr",
+            "grain",
+            "peak_rss");
+    for (uint32_t i = 0; i < num_passes; i++) show_pass(&passes[i]);
+
+    if (cli->bench_json && num_passes) {
+        FILE *f = NULL;
+        FOPEN(f, cli->bench_json, "w");
+        if (f) {
+            write_json(f, cli->in_filename, passes, num_passes);
+            fclose(f);
+        } else {
+            fprintf(stderr, "Invalid benchmark output file \n");
+            return_error = EB_ErrorBadParameter;
+        }
+    }
+
+    free(passes);
+    free_stream(&stream);
+    return return_error;
+}
@@ -0,0 +1,21 @@
+/*
+* Copyright(c) 2019 Netflix, Inc.
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbDecBench_h
+#define EbDecBench_h
+
+#include "EbSvtAv1Dec.h"
+#include "EbFileUtils.h"
+
+/* Decode the input once per thread count from 1 to cli->bench_threads and
+ * report the fps, the stage times and the peak memory of each pass, in JSON
+ * to cli->bench_json when it is set. The stream is read in memory first so
+ * that the passes do not time the file reads. Each pass runs in a child
+ * process so that its peak memory is its own, on Windows only the first pass
+ * reports it. The stage times are only known with 1 thread, besides the film
+ * grain. Unknown values are shown as - and written as null. */
+EbErrorType dec_bench_run(DecInputContext *input, const EbSvtAv1DecConfiguration *config);
+
+#endif
@@ -51,6 +51,9 @@ static void set_num_pframes(const char *value, EbSvtAv1DecConfiguration *cfg) {
         cfg->num_p_frames = 1;
     }
 };
+static void set_low_memory(const char *value, EbSvtAv1DecConfiguration *cfg) {
+    cfg->low_memory = (EbBool)strtoul(value, NULL, 0);
+};
 
 /**********************************
   * Config Entry Array
@@ -66,6 +69,7 @@ ConfigEntry config_entry[] = {
     {COLOUR_SPACE_TOKEN, "InputColourSpace", 1, set_colour_space},
     {THREADS_TOKEN, "ThreadCount", 1, set_num_thread},
     {FRAME_PLL_TOKEN, "PllFrameCount", 1, set_num_pframes},
+    {LOW_MEMORY_TOKEN, "LowMemory", 0, set_low_memory},
     // Termination
     {NULL, NULL, 0, NULL}};
 
@@ -83,11 +87,14 @@ static void show_help() {
     H0(" -colour-space <arg>       Input picture colour space. [400, 420, 422, 444]\n");
     H0(" -threads <arg>            Number of threads to be launched \n");
     H0(" -parallel-frames <arg>    Number of frames to be processed in parallel \n");
+    H0(" -low-mem                  Only keep the picture buffers held as references \n");
     H0(" -enable-row-mt            Enable row level parallelism \n");
     H0(" -md5                      MD5 support flag \n");
     H0(" -fps-frm                  Show fps after each frame decoded\n");
-    H0(" -fps-summary              Show fps summary");
-    H0(" -skip-film-grain          Disable Film Grain");
+    H0(" -fps-summary              Show fps summary\n");
+    H0(" -skip-film-grain          Disable Film Grain\n");
+    H0(" -bench <arg>              Benchmark the decoding with 1 to n threads \n");
+    H0(" -bench-json <arg>         Benchmark output file name in JSON \n");
 
     exit(1);
 }
@@ -146,6 +153,14 @@ EbErrorType read_command_line(int32_t argc, char *const argv[], EbSvtAv1DecConfi
                 cli->skip_film_grain = 1;
             else if (EB_STRCMP(cmd_copy[token_index], ANNEX_B_TOKEN) == 0)
                 obu_ctx->is_annexb = 1;
+            else if (EB_STRCMP(cmd_copy[token_index], BENCH_TOKEN) == 0 &&
+                     config_strings[token_index])
+                cli->bench_threads = strtoul(config_strings[token_index], NULL, 0);
+            else if (EB_STRCMP(cmd_copy[token_index], BENCH_JSON_TOKEN) == 0 &&
+                     config_strings[token_index]) {
+                cli->bench_json = config_strings[token_index];
+                if (!cli->bench_threads) cli->bench_threads = 1;
+            }
             else if (EB_STRCMP(cmd_copy[token_index], HELP_TOKEN) == 0)
                 show_help();
             else {
@@ -39,11 +39,14 @@
 #define COLOUR_SPACE_TOKEN "-colour-space"
 #define THREADS_TOKEN "-threads"
 #define FRAME_PLL_TOKEN "-parallel-frames"
+#define LOW_MEMORY_TOKEN "-low-mem"
 #define MD5_SUPPORT_TOKEN "-md5"
 #define FPS_FRM_TOKEN "-fps-frm"
 #define FPS_SUMMARY_TOKEN "-fps-summary"
 #define FILM_GRAIN_TOKEN "-skip-film-grain"
 #define ANNEX_B_TOKEN "-annex-b"
+#define BENCH_TOKEN "-bench"
+#define BENCH_JSON_TOKEN "-bench-json"
 #define MAX_NUM_TOKENS 200
 
 #define EB_STRCMP(target, token) strcmp(target, token)
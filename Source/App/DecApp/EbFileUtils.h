@@ -61,6 +61,8 @@ typedef struct CliInput {
     uint32_t                       fps_frm;
     uint32_t                       fps_summary;
     uint32_t                       skip_film_grain;
+    uint32_t                       bench_threads;
+    const char *                   bench_json;
 } CliInput;
 
 typedef struct ObuDecInputContext {
@@ -50,6 +50,9 @@
 #define INPUT_COMPRESSED_TEN_BIT_FORMAT "-compressed-ten-bit-format"
 #define ENCMODE_TOKEN "-enc-mode"
 #define ENCMODE2P_TOKEN "-enc-mode-2p"
+#define FAST_FIRST_PASS_TOKEN "-fast-first-pass"
+#define CHUNK_COUNT_TOKEN "-chunks"
+#define LADDER_TOKEN "-ladder"
 #define HIERARCHICAL_LEVELS_TOKEN "-hierarchical-levels" // no Eval
 #define PRED_STRUCT_TOKEN "-pred-struct"
 #define INTRA_PERIOD_TOKEN "-intra-period"
@@ -118,6 +121,7 @@
 #define TARGET_BIT_RATE_TOKEN "-tbr"
 #define MAX_QP_TOKEN "-max-qp"
 #define VBV_BUFSIZE_TOKEN "-vbv-bufsize"
+#define MAX_BIT_RATE_TOKEN "-mbr"
 #define MIN_QP_TOKEN "-min-qp"
 #define ADAPTIVE_QP_ENABLE_TOKEN "-adaptive-quantization"
 #define LOOK_AHEAD_DIST_TOKEN "-lad"
@@ -137,6 +141,7 @@
 #define THREAD_MGMNT "-lp"
 #define UNPIN_LP1_TOKEN "-unpin-lp1"
 #define TARGET_SOCKET "-ss"
+#define MAX_MEMORY_TOKEN "-max-mem"
 #define UNRESTRICTED_MOTION_VECTOR "-umv"
 #define CONFIG_FILE_COMMENT_CHAR '#'
 #define CONFIG_FILE_NEWLINE_CHAR '\n'
@@ -218,6 +223,41 @@ static void set_output_stat_file(const char *value, EbConfig *cfg) {
 static void set_snd_pass_enc_mode(const char *value, EbConfig *cfg) {
     cfg->snd_pass_enc_mode = (uint8_t)strtoul(value, NULL, 0);
 };
+static void set_fast_first_pass(const char *value, EbConfig *cfg) {
+    cfg->fast_first_pass = (uint8_t)strtoul(value, NULL, 0);
+};
+static void set_chunk_count(const char *value, EbConfig *cfg) {
+    cfg->chunk_count = strtoul(value, NULL, 0);
+};
+// Renditions are listed as WxH:kbps:stream separated by commas
+static void set_ladder(const char *value, EbConfig *cfg) {
+    const char *pos = value;
+
+    cfg->ladder_count = 0;
+    while (*pos) {
+        EbLadderRendition *rendition;
+        char *             end;
+        size_t             path_len;
+
+        if (cfg->ladder_count == MAX_LADDER_RENDITIONS) break;
+        rendition        = &cfg->ladder[cfg->ladder_count];
+        rendition->width = strtoul(pos, &end, 10);
+        if (*end != 'x') break;
+        rendition->height = strtoul(end + 1, &end, 10);
+        if (*end != ':') break;
+        rendition->target_bit_rate = 1000 * strtoul(end + 1, &end, 10);
+        if (*end != ':') break;
+        pos      = end + 1;
+        path_len = strcspn(pos, ",");
+        if (path_len == 0 || path_len >= LADDER_PATH_MAX_LEN) break;
+        memcpy(rendition->stream_path, pos, path_len);
+        rendition->stream_path[path_len] = '\0';
+        ++cfg->ladder_count;
+        pos += path_len;
+        if (*pos == ',') ++pos;
+    }
+    if (*pos) cfg->ladder_count = MAX_LADDER_RENDITIONS + 1;
+};
 static void set_cfg_stat_file(const char *value, EbConfig *cfg) {
     if (cfg->stat_file) { fclose(cfg->stat_file); }
     FOPEN(cfg->stat_file, value, "wb");
@@ -393,6 +433,9 @@ static void set_target_bit_rate(const char *value, EbConfig *cfg) {
 static void set_vbv_buf_size(const char *value, EbConfig *cfg) {
     cfg->vbv_bufsize = 1000 * strtoul(value, NULL, 0);
 };
+static void set_max_bit_rate(const char *value, EbConfig *cfg) {
+    cfg->max_bit_rate = 1000 * strtoul(value, NULL, 0);
+};
 static void set_max_qp_allowed(const char *value, EbConfig *cfg) {
     cfg->max_qp_allowed = strtoul(value, NULL, 0);
 };
@@ -559,6 +602,9 @@ static void set_logical_processors(const char *value, EbConfig *cfg) {
 static void set_unpin_single_core_execution(const char *value, EbConfig *cfg) {
     cfg->unpin_lp1 = (uint32_t)strtoul(value, NULL, 0);
 };
+static void set_max_memory_mb(const char *value, EbConfig *cfg) {
+    cfg->max_memory_mb = (uint32_t)strtoul(value, NULL, 0);
+};
 static void set_target_socket(const char *value, EbConfig *cfg) {
     cfg->target_socket = (int32_t)strtol(value, NULL, 0);
 };
@@ -629,6 +675,9 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, BASE_LAYER_SWITCH_MODE_TOKEN, "BaseLayerSwitchMode", set_base_layer_switch_mode},
     {SINGLE_INPUT, ENCMODE_TOKEN, "EncoderMode", set_enc_mode},
     {SINGLE_INPUT, ENCMODE2P_TOKEN, "EncoderMode2p", set_snd_pass_enc_mode},
+    {SINGLE_INPUT, FAST_FIRST_PASS_TOKEN, "FastFirstPass", set_fast_first_pass},
+    {SINGLE_INPUT, CHUNK_COUNT_TOKEN, "ChunkCount", set_chunk_count},
+    {SINGLE_INPUT, LADDER_TOKEN, "Ladder", set_ladder},
     {SINGLE_INPUT, INTRA_PERIOD_TOKEN, "IntraPeriod", set_cfg_intra_period},
     {SINGLE_INPUT, INTRA_REFRESH_TYPE_TOKEN, "IntraRefreshType", set_cfg_intra_refresh_type},
     {SINGLE_INPUT, FRAME_RATE_TOKEN, "FrameRate", set_frame_rate},
@@ -658,6 +707,7 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, MAX_QP_TOKEN, "MaxQpAllowed", set_max_qp_allowed},
     {SINGLE_INPUT, MIN_QP_TOKEN, "MinQpAllowed", set_min_qp_allowed},
     {SINGLE_INPUT, VBV_BUFSIZE_TOKEN, "VBVBufSize", set_vbv_buf_size},
+    {SINGLE_INPUT, MAX_BIT_RATE_TOKEN, "MaxBitRate", set_max_bit_rate},
     {SINGLE_INPUT, ADAPTIVE_QP_ENABLE_TOKEN, "AdaptiveQuantization", set_adaptive_quantization},
 
     // DLF
@@ -761,6 +811,7 @@ ConfigEntry config_entry[] = {
     // Thread Management
     {SINGLE_INPUT, THREAD_MGMNT, "LogicalProcessors", set_logical_processors},
     {SINGLE_INPUT, UNPIN_LP1_TOKEN, "UnpinSingleCoreExecution", set_unpin_single_core_execution},
+    {SINGLE_INPUT, MAX_MEMORY_TOKEN, "MaxMemoryMb", set_max_memory_mb},
     {SINGLE_INPUT, TARGET_SOCKET, "TargetSocket", set_target_socket},
     // Optional Features
     {SINGLE_INPUT,
@@ -846,6 +897,10 @@ void eb_config_ctor(EbConfig *config_ptr) {
     config_ptr->enable_adaptive_quantization              = 2;
     config_ptr->enc_mode                                  = MAX_ENC_PRESET;
     config_ptr->snd_pass_enc_mode                         = MAX_ENC_PRESET + 1;
+    config_ptr->fast_first_pass                           = 0;
+    config_ptr->chunk_count                               = 0;
+    config_ptr->ladder_count                              = 0;
+    config_ptr->ladder_source                             = NULL;
     config_ptr->intra_period                              = -2;
     config_ptr->intra_refresh_type                        = 1;
     config_ptr->hierarchical_levels                       = 4;
@@ -906,6 +961,7 @@ void eb_config_ctor(EbConfig *config_ptr) {
     config_ptr->cpu_flags_limit = CPU_FLAGS_ALL;
 
     config_ptr->unpin_lp1     = 1;
+    config_ptr->max_memory_mb = 0;
     config_ptr->target_socket = -1;
 
     config_ptr->unrestricted_motion_vector = EB_TRUE;
@@ -947,6 +1003,11 @@ void eb_config_dtor(EbConfig *config_ptr) {
         config_ptr->bitstream_file = (FILE *)NULL;
     }
 
+    if (config_ptr->chunk_output_file) {
+        fclose(config_ptr->chunk_output_file);
+        config_ptr->chunk_output_file = (FILE *)NULL;
+    }
+
     if (config_ptr->recon_file) {
         fclose(config_ptr->recon_file);
         config_ptr->recon_file = (FILE *)NULL;
@@ -1658,3 +1719,209 @@ EbErrorType read_command_line(int32_t argc, char *const argv[], EbConfig **confi
     for (index = 0; index < MAX_CHANNEL_NUMBER; ++index) free(config_strings[index]);
     return return_error;
 }
+
+/******************************************
+* Chunk Parallel Encoding
+******************************************/
+#define Y4M_FRAME_DELIMITER_SIZE 6 // "FRAME\n"
+
+// Size of one input frame in the file, including the y4m frame delimiter
+static uint64_t get_input_frame_size(EbConfig *config) {
+    uint64_t frame_size = (uint64_t)config->input_padded_width * config->input_padded_height;
+
+    frame_size += 2 * (frame_size >> (3 - config->encoder_color_format));
+    if (config->encoder_bit_depth == 10)
+        frame_size = config->compressed_ten_bit_format == 1 ? frame_size * 5 / 4 : frame_size << 1;
+    if (config->y4m_input == EB_TRUE) frame_size += Y4M_FRAME_DELIMITER_SIZE;
+    return frame_size;
+}
+
+// Splits the single channel configuration into chunks starting at key frames. Each chunk is a
+// channel reading its own range of the input and writing to a temporary stream, the chunk
+// streams are stitched in order once all the channels are done. Every chunk is rate controlled
+// on its own at the configured target rate, the rate control budget is not shared.
+EbErrorType setup_chunk_configs(int32_t argc, char *const argv[], EbConfig **configs,
+                                uint32_t *num_channels, EbErrorType *return_errors) {
+    EbConfig *base_config = configs[0];
+    uint32_t  chunk_count = base_config->chunk_count;
+    int64_t   frames_left = base_config->frames_to_be_encoded;
+    uint64_t  gop_size;
+    uint64_t  gop_count;
+    uint64_t  gops_per_chunk;
+    uint32_t  index;
+
+    if (chunk_count > MAX_CHANNEL_NUMBER) {
+        fprintf(base_config->error_log_file,
+                "Error: The number of chunks has to be within the range [0,%u]\n",
+                (uint32_t)MAX_CHANNEL_NUMBER);
+        return EB_ErrorBadParameter;
+    }
+    if (base_config->input_file == stdin || base_config->input_file_is_fifo) {
+        fprintf(base_config->error_log_file, "Error: Chunk encoding requires a seekable input\n");
+        return EB_ErrorBadParameter;
+    }
+    if (base_config->intra_period < 0) {
+        fprintf(base_config->error_log_file,
+                "Error: Chunk encoding requires an explicit IntraPeriod\n");
+        return EB_ErrorBadParameter;
+    }
+    if (base_config->recon_file || base_config->stat_file || base_config->use_qp_file ||
+        base_config->input_stat_file || base_config->output_stat_file) {
+        fprintf(base_config->error_log_file,
+                "Error: Chunk encoding does not support recon, stat, qp or two pass files\n");
+        return EB_ErrorBadParameter;
+    }
+
+    // Chunks are made of whole intra periods so that the key frames stay where a single
+    // encode would place them
+    gop_size       = (uint64_t)base_config->intra_period + 1;
+    gop_count      = ((uint64_t)frames_left + gop_size - 1) / gop_size;
+    gops_per_chunk = (gop_count + chunk_count - 1) / chunk_count;
+    chunk_count    = (uint32_t)((gop_count + gops_per_chunk - 1) / gops_per_chunk);
+
+    for (index = 1; index < chunk_count; ++index) {
+        configs[index] = (EbConfig *)malloc(sizeof(EbConfig));
+        if (!configs[index]) return EB_ErrorInsufficientResources;
+        eb_config_ctor(configs[index]);
+        return_errors[index] = EB_ErrorNone;
+        *num_channels        = index + 1;
+        if (read_command_line(argc, argv, &configs[index], 1, &return_errors[index]) !=
+            EB_ErrorNone)
+            return EB_ErrorBadParameter;
+        if (configs[index]->error_log_file != base_config->error_log_file) {
+            if (configs[index]->error_log_file && configs[index]->error_log_file != stderr)
+                fclose(configs[index]->error_log_file);
+            configs[index]->error_log_file = stderr;
+        }
+        // The same output path was opened again, only the first handle is used for stitching
+        if (configs[index]->bitstream_file) fclose(configs[index]->bitstream_file);
+        configs[index]->bitstream_file = (FILE *)NULL;
+    }
+
+    base_config->chunk_output_file = base_config->bitstream_file;
+    base_config->bitstream_file    = (FILE *)NULL;
+    for (index = 0; index < chunk_count; ++index) {
+        EbConfig *config      = configs[index];
+        uint64_t  start_frame = (uint64_t)index * gops_per_chunk * gop_size;
+
+        config->frames_to_be_encoded = frames_left < (int64_t)(gops_per_chunk * gop_size)
+                                           ? frames_left
+                                           : (int64_t)(gops_per_chunk * gop_size);
+        frames_left -= config->frames_to_be_encoded;
+        // The y4m header was already consumed, seek relative to the first frame
+        if (fseeko(config->input_file,
+                   (int64_t)(start_frame * get_input_frame_size(config)),
+                   SEEK_CUR) != 0) {
+            fprintf(config->error_log_file, "Error: Could not seek to chunk %u\n", index + 1);
+            return EB_ErrorBadParameter;
+        }
+        if (base_config->chunk_output_file) {
+            config->bitstream_file = tmpfile();
+            if (config->bitstream_file == NULL) {
+                fprintf(config->error_log_file,
+                        "Error: Could not create the stream of chunk %u\n",
+                        index + 1);
+                return EB_ErrorInsufficientResources;
+            }
+        }
+    }
+    *num_channels = chunk_count;
+    return EB_ErrorNone;
+}
+
+/******************************************
+* ABR Ladder Encoding
+******************************************/
+// Adds a channel per lower rendition of the ladder. The input is only read by the first channel,
+// every rendition is fed with its downscaled frames and keeps the same prediction structure so
+// that the key frames of all the renditions are aligned. Each rendition is a separate encoder:
+// the scene cut and GOP decisions are not shared and the motion estimation of a rendition is not
+// seeded from the others. Every rendition is rate controlled on its own at its target rate.
+EbErrorType setup_ladder_configs(int32_t argc, char *const argv[], EbConfig **configs,
+                                 uint32_t *num_channels, EbErrorType *return_errors) {
+    EbConfig *base_config  = configs[0];
+    uint32_t  ladder_count = base_config->ladder_count;
+    uint32_t  index;
+
+    if (ladder_count > MAX_LADDER_RENDITIONS) {
+        fprintf(base_config->error_log_file,
+                "Error: The ladder has to list up to %u renditions as WxH:kbps:stream\n",
+                (uint32_t)MAX_LADDER_RENDITIONS);
+        return EB_ErrorBadParameter;
+    }
+    if (base_config->input_file == stdin || base_config->input_file_is_fifo) {
+        fprintf(base_config->error_log_file, "Error: Ladder encoding requires a seekable input\n");
+        return EB_ErrorBadParameter;
+    }
+    if (base_config->encoder_bit_depth > 8 && base_config->compressed_ten_bit_format == 1) {
+        fprintf(base_config->error_log_file,
+                "Error: Ladder encoding does not support the compressed 10-bit format\n");
+        return EB_ErrorBadParameter;
+    }
+    // Scene change key frames depend on the content of each rendition, the renditions only
+    // switch at the intra period so that their key frames stay aligned
+    if (base_config->scene_change_detection) {
+        fprintf(base_config->error_log_file,
+                "Error: Ladder encoding does not support scene change detection\n");
+        return EB_ErrorBadParameter;
+    }
+    if (base_config->recon_file || base_config->stat_file || base_config->use_qp_file ||
+        base_config->input_stat_file || base_config->output_stat_file) {
+        fprintf(base_config->error_log_file,
+                "Error: Ladder encoding does not support recon, stat, qp or two pass files\n");
+        return EB_ErrorBadParameter;
+    }
+    for (index = 0; index < ladder_count; ++index) {
+        const EbLadderRendition *rendition = &base_config->ladder[index];
+        if (rendition->width < 64 || rendition->height < 64 || rendition->width % 8 ||
+            rendition->height % 8 || rendition->width > base_config->source_width ||
+            rendition->height > base_config->source_height) {
+            fprintf(base_config->error_log_file,
+                    "Error: Ladder rendition %u has to be a multiple of 8 within [64x64,%ux%u]\n",
+                    index + 1,
+                    base_config->source_width,
+                    base_config->source_height);
+            return EB_ErrorBadParameter;
+        }
+    }
+
+    for (index = 0; index < ladder_count; ++index) {
+        const EbLadderRendition *rendition = &base_config->ladder[index];
+        EbConfig *               config;
+
+        configs[index + 1] = (EbConfig *)malloc(sizeof(EbConfig));
+        if (!configs[index + 1]) return EB_ErrorInsufficientResources;
+        config = configs[index + 1];
+        eb_config_ctor(config);
+        return_errors[index + 1] = EB_ErrorNone;
+        *num_channels            = index + 2;
+        if (read_command_line(argc, argv, &configs[index + 1], 1, &return_errors[index + 1]) !=
+            EB_ErrorNone)
+            return EB_ErrorBadParameter;
+        if (config->error_log_file != base_config->error_log_file) {
+            if (config->error_log_file && config->error_log_file != stderr)
+                fclose(config->error_log_file);
+            config->error_log_file = stderr;
+        }
+        // The same output path was opened again, the rendition writes to its own stream
+        if (config->bitstream_file) fclose(config->bitstream_file);
+        FOPEN(config->bitstream_file, rendition->stream_path, "wb");
+        if (config->bitstream_file == NULL) {
+            fprintf(config->error_log_file,
+                    "Error: Could not open the stream of ladder rendition %u\n",
+                    index + 1);
+            return EB_ErrorBadParameter;
+        }
+
+        config->source_width         = rendition->width;
+        config->source_height        = rendition->height;
+        config->input_padded_width   = rendition->width;
+        config->input_padded_height  = rendition->height;
+        config->target_bit_rate      = rendition->target_bit_rate;
+        config->frames_to_be_encoded = base_config->frames_to_be_encoded;
+        config->buffered_input       = -1;
+        config->ladder_count         = 0;
+        config->ladder_source        = base_config;
+    }
+    return EB_ErrorNone;
+}
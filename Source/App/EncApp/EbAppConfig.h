@@ -104,6 +104,8 @@ extern uint32_t          app_malloc_count;
 
 #define MAX_CHANNEL_NUMBER 6
 #define MAX_NUM_TOKENS 200
+#define MAX_LADDER_RENDITIONS (MAX_CHANNEL_NUMBER - 1)
+#define LADDER_PATH_MAX_LEN 256
 
 #ifdef _WIN32
 #define FOPEN(f, s, m) fopen_s(&f, s, m)
@@ -111,6 +113,14 @@ extern uint32_t          app_malloc_count;
 #define FOPEN(f, s, m) f = fopen(s, m)
 #endif
 
+// Lower rendition of an ABR ladder, encoded from the downscaled input of the first channel
+typedef struct EbLadderRendition {
+    uint32_t width;
+    uint32_t height;
+    uint32_t target_bit_rate;
+    char     stream_path[LADDER_PATH_MAX_LEN];
+} EbLadderRendition;
+
 typedef struct EbPerformanceContext {
     /****************************************
      * Computational Performance Data
@@ -193,6 +203,7 @@ typedef struct EbConfig {
     uint32_t base_layer_switch_mode;
     uint8_t  enc_mode;
     uint8_t  snd_pass_enc_mode;
+    uint8_t  fast_first_pass;
     int32_t  intra_period;
     uint32_t intra_refresh_type;
     uint32_t hierarchical_levels;
@@ -385,6 +396,7 @@ typedef struct EbConfig {
     uint32_t max_qp_allowed;
     uint32_t min_qp_allowed;
     uint32_t vbv_bufsize;
+    uint32_t max_bit_rate;
 
     EbBool enable_adaptive_quantization;
 
@@ -425,6 +437,7 @@ typedef struct EbConfig {
     uint32_t active_channel_count;
     uint32_t logical_processors;
     uint32_t unpin_lp1;
+    uint32_t max_memory_mb;
     int32_t  target_socket;
     EbBool   stop_encoder; // to signal CTRL+C Event, need to stop encoding.
 
@@ -434,6 +447,19 @@ typedef struct EbConfig {
     uint64_t byte_count_since_ivf;
     uint64_t ivf_count;
 
+    /****************************************
+     * Chunk Parallel Encoding
+     ****************************************/
+    uint32_t chunk_count;
+    FILE *   chunk_output_file; // final output, the chunks are encoded to temporary files
+
+    /****************************************
+     * ABR Ladder Encoding
+     ****************************************/
+    uint32_t          ladder_count; // above MAX_LADDER_RENDITIONS when the ladder is invalid
+    EbLadderRendition ladder[MAX_LADDER_RENDITIONS];
+    struct EbConfig * ladder_source; // first channel, only set for the renditions
+
     // --- start: ALTREF_FILTERING_SUPPORT
     /****************************************
      * ALT-REF related Parameters
@@ -465,5 +491,9 @@ extern EbErrorType read_command_line(int32_t argc, char *const argv[], EbConfig
                                      uint32_t num_channels, EbErrorType *return_errors);
 extern uint32_t    get_help(int32_t argc, char *const argv[]);
 extern uint32_t    get_number_of_channels(int32_t argc, char *const argv[]);
+extern EbErrorType setup_chunk_configs(int32_t argc, char *const argv[], EbConfig **configs,
+                                       uint32_t *num_channels, EbErrorType *return_errors);
+extern EbErrorType setup_ladder_configs(int32_t argc, char *const argv[], EbConfig **configs,
+                                        uint32_t *num_channels, EbErrorType *return_errors);
 
 #endif //EbAppConfig_h
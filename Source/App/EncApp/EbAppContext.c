@@ -110,12 +110,14 @@ EbErrorType copy_configuration_parameters(EbConfig *config, EbAppContext *callba
     callback_data->eb_enc_parameters.max_qp_allowed         = config->max_qp_allowed;
     callback_data->eb_enc_parameters.min_qp_allowed         = config->min_qp_allowed;
     callback_data->eb_enc_parameters.vbv_bufsize            = config->vbv_bufsize;
+    callback_data->eb_enc_parameters.max_bit_rate           = config->max_bit_rate;
     callback_data->eb_enc_parameters.enable_adaptive_quantization =
         (EbBool)config->enable_adaptive_quantization;
     callback_data->eb_enc_parameters.qp                   = config->qp;
     callback_data->eb_enc_parameters.use_qp_file          = (EbBool)config->use_qp_file;
     callback_data->eb_enc_parameters.input_stat_file      = config->input_stat_file;
     callback_data->eb_enc_parameters.output_stat_file     = config->output_stat_file;
+    callback_data->eb_enc_parameters.fast_first_pass      = config->fast_first_pass;
     callback_data->eb_enc_parameters.stat_report          = (EbBool)config->stat_report;
     callback_data->eb_enc_parameters.disable_dlf_flag     = (EbBool)config->disable_dlf_flag;
     callback_data->eb_enc_parameters.enable_warped_motion = (EbBool)config->enable_warped_motion;
@@ -183,6 +185,7 @@ EbErrorType copy_configuration_parameters(EbConfig *config, EbAppContext *callba
     callback_data->eb_enc_parameters.use_cpu_flags             = config->cpu_flags_limit;
     callback_data->eb_enc_parameters.logical_processors        = config->logical_processors;
     callback_data->eb_enc_parameters.unpin_lp1                 = config->unpin_lp1;
+    callback_data->eb_enc_parameters.max_memory_mb             = config->max_memory_mb;
     callback_data->eb_enc_parameters.target_socket             = config->target_socket;
     callback_data->eb_enc_parameters.unrestricted_motion_vector =
         config->unrestricted_motion_vector;
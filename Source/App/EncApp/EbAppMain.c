@@ -45,6 +45,13 @@ extern AppExitConditionType process_output_stream_buffer(EbConfig *    config,
                                                          EbAppContext *app_call_back,
                                                          uint8_t       pic_send_done);
 
+extern AppExitConditionType process_ladder_input_buffer(EbConfig *           config,
+                                                        EbAppContext *       app_call_back,
+                                                        const EbSvtIOFormat *source_frame,
+                                                        EbBool               source_done);
+
+extern EbErrorType stitch_chunk_streams(EbConfig **configs, uint32_t chunk_count);
+
 volatile int32_t keep_running = 1;
 
 void event_handler(int32_t dummy) {
@@ -96,6 +103,9 @@ int32_t main(int32_t argc, char *argv[]) {
     uint32_t      num_channels = 0;
     uint32_t      inst_cnt     = 0;
     EbAppContext *app_callbacks[MAX_CHANNEL_NUMBER]; // Instances App callback data
+    // Frame of the first channel the ladder renditions are downscaled from, it is kept here as
+    // the input buffer header drops it along with the end of stream
+    const EbSvtIOFormat *ladder_source_frame = NULL;
     signal(SIGINT, event_handler);
     fprintf(stderr, "-------------------------------------------\n");
     fprintf(stderr, "SVT-AV1 Encoder\n");
@@ -134,6 +144,39 @@ int32_t main(int32_t argc, char *argv[]) {
         // Read all configuration files.
         return_error = read_command_line(argc, argv, configs, num_channels, return_errors);
 
+        // Split a single channel in chunks encoded as parallel channels
+        if (return_error == EB_ErrorNone && configs[0]->chunk_count > 1) {
+            uint32_t allocated_channels = num_channels;
+            if (num_channels == 1)
+                return_error =
+                    setup_chunk_configs(argc, argv, configs, &num_channels, return_errors);
+            else {
+                fprintf(stderr, "Error: Chunk encoding requires a single channel\n");
+                return_error = EB_ErrorBadParameter;
+            }
+            for (inst_cnt = allocated_channels; inst_cnt < num_channels; ++inst_cnt) {
+                app_callbacks[inst_cnt] = (EbAppContext *)malloc(sizeof(EbAppContext));
+                if (!app_callbacks[inst_cnt]) return_error = EB_ErrorInsufficientResources;
+            }
+        }
+
+        // Add the lower renditions of an ABR ladder as channels fed by the first one
+        if (return_error == EB_ErrorNone && configs[0]->ladder_count) {
+            uint32_t allocated_channels = num_channels;
+            if (num_channels == 1 && configs[0]->chunk_count <= 1)
+                return_error =
+                    setup_ladder_configs(argc, argv, configs, &num_channels, return_errors);
+            else {
+                fprintf(stderr,
+                        "Error: Ladder encoding requires a single channel without chunks\n");
+                return_error = EB_ErrorBadParameter;
+            }
+            for (inst_cnt = allocated_channels; inst_cnt < num_channels; ++inst_cnt) {
+                app_callbacks[inst_cnt] = (EbAppContext *)malloc(sizeof(EbAppContext));
+                if (!app_callbacks[inst_cnt]) return_error = EB_ErrorInsufficientResources;
+            }
+        }
+
         // Process any command line options, including the configuration file
 
         if (return_error == EB_ErrorNone) {
@@ -156,6 +199,9 @@ int32_t main(int32_t argc, char *argv[]) {
                 } else
                     channel_active[inst_cnt] = EB_FALSE;
             }
+            if (return_errors[0] == EB_ErrorNone)
+                ladder_source_frame =
+                    (const EbSvtIOFormat *)app_callbacks[0]->input_buffer_pool->p_buffer;
 
             {
                 // Start the Encoder
@@ -191,9 +237,18 @@ int32_t main(int32_t argc, char *argv[]) {
                     exit_condition = APP_ExitConditionFinished;
                     for (inst_cnt = 0; inst_cnt < num_channels; ++inst_cnt) {
                         if (channel_active[inst_cnt] == EB_TRUE) {
-                            if (exit_cond_input[inst_cnt] == APP_ExitConditionNone)
-                                exit_cond_input[inst_cnt] = process_input_buffer(
-                                    configs[inst_cnt], app_callbacks[inst_cnt]);
+                            if (exit_cond_input[inst_cnt] == APP_ExitConditionNone) {
+                                if (configs[inst_cnt]->ladder_source)
+                                    exit_cond_input[inst_cnt] = process_ladder_input_buffer(
+                                        configs[inst_cnt],
+                                        app_callbacks[inst_cnt],
+                                        ladder_source_frame,
+                                        channel_active[0] == EB_FALSE ||
+                                            exit_cond_input[0] != APP_ExitConditionNone);
+                                else
+                                    exit_cond_input[inst_cnt] = process_input_buffer(
+                                        configs[inst_cnt], app_callbacks[inst_cnt]);
+                            }
                             if (exit_cond_recon[inst_cnt] == APP_ExitConditionNone)
                                 exit_cond_recon[inst_cnt] = process_output_recon_buffer(
                                     configs[inst_cnt], app_callbacks[inst_cnt]);
@@ -364,6 +419,19 @@ int32_t main(int32_t argc, char *argv[]) {
                 fprintf(stderr, "\n");
                 fflush(stdout);
             }
+            // Stitch the chunk streams once every chunk is complete
+            if (configs[0]->chunk_output_file) {
+                EbBool chunks_done = EB_TRUE;
+                for (inst_cnt = 0; inst_cnt < num_channels; ++inst_cnt) {
+                    if (exit_cond[inst_cnt] != APP_ExitConditionFinished ||
+                        return_errors[inst_cnt] != EB_ErrorNone)
+                        chunks_done = EB_FALSE;
+                }
+                if (chunks_done)
+                    return_error = stitch_chunk_streams(configs, num_channels);
+                else
+                    fprintf(stderr, "Error: Chunk streams were not stitched\n");
+            }
             for (inst_cnt = 0; inst_cnt < num_channels; ++inst_cnt) {
                 if (exit_cond[inst_cnt] == APP_ExitConditionFinished &&
                     return_errors[inst_cnt] == EB_ErrorNone) {
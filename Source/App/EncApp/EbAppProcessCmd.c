@@ -944,9 +944,9 @@ AppExitConditionType process_input_buffer(EbConfig *config, EbAppContext *app_ca
 
             if (keep_running == 0 && !config->stop_encoder) config->stop_encoder = EB_TRUE;
             // Fill in Buffers Header control data
-            header_ptr->pts      = config->processed_frame_count - 1;
+            header_ptr->pts = config->processed_frame_count - 1;
             header_ptr->pic_type = EB_AV1_INVALID_PICTURE;
-            header_ptr->flags    = 0;
+            header_ptr->flags = 0;
 
             // Send the picture
             eb_svt_enc_send_picture(component_handle, header_ptr);
@@ -972,6 +972,112 @@ AppExitConditionType process_input_buffer(EbConfig *config, EbAppContext *app_ca
     return return_value;
 }
 
+/***************************************
+* ABR Ladder Input
+***************************************/
+// Area averaging of a plane, each destination sample covers at least one source sample
+static void downscale_plane(const uint8_t *src, uint32_t src_stride, uint32_t src_width,
+                            uint32_t src_height, uint8_t *dst, uint32_t dst_stride,
+                            uint32_t dst_width, uint32_t dst_height, uint8_t is_16bit) {
+    for (uint32_t y = 0; y < dst_height; ++y) {
+        const uint32_t y0 = (uint32_t)((uint64_t)y * src_height / dst_height);
+        uint32_t       y1 = (uint32_t)((uint64_t)(y + 1) * src_height / dst_height);
+        if (y1 <= y0) y1 = y0 + 1;
+        for (uint32_t x = 0; x < dst_width; ++x) {
+            const uint32_t x0  = (uint32_t)((uint64_t)x * src_width / dst_width);
+            uint32_t       x1  = (uint32_t)((uint64_t)(x + 1) * src_width / dst_width);
+            uint32_t       sum = 0;
+            if (x1 <= x0) x1 = x0 + 1;
+            for (uint32_t sy = y0; sy < y1; ++sy) {
+                for (uint32_t sx = x0; sx < x1; ++sx)
+                    sum += is_16bit ? ((const uint16_t *)src)[sy * src_stride + sx]
+                                    : src[sy * src_stride + sx];
+            }
+            sum = (sum + ((y1 - y0) * (x1 - x0) >> 1)) / ((y1 - y0) * (x1 - x0));
+            if (is_16bit)
+                ((uint16_t *)dst)[y * dst_stride + x] = (uint16_t)sum;
+            else
+                dst[y * dst_stride + x] = (uint8_t)sum;
+        }
+    }
+}
+
+//************************************/
+// process_ladder_input_buffer
+// Feeds a ladder rendition with the downscaled
+// frame last sent by the first channel
+/************************************/
+AppExitConditionType process_ladder_input_buffer(EbConfig *config, EbAppContext *app_call_back,
+                                                 const EbSvtIOFormat *source_frame,
+                                                 EbBool               source_done) {
+    const EbConfig *    source           = config->ladder_source;
+    const uint8_t       is_16bit         = (uint8_t)(config->encoder_bit_depth > 8);
+    EbBufferHeaderType *header_ptr       = app_call_back->input_buffer_pool;
+    EbComponentType *   component_handle = (EbComponentType *)app_call_back->svt_encoder_handle;
+
+    if (config->processed_frame_count < source->processed_frame_count) {
+        const EbSvtIOFormat *src_ptr       = source_frame;
+        EbSvtIOFormat *      dst_ptr       = (EbSvtIOFormat *)header_ptr->p_buffer;
+        const uint8_t        color_format  = config->encoder_color_format;
+        const uint8_t        subsampling_x = (color_format == EB_YUV444 ? 1 : 2) - 1;
+        const uint8_t        subsampling_y = (color_format >= EB_YUV422 ? 1 : 2) - 1;
+
+        downscale_plane(src_ptr->luma,
+                        src_ptr->y_stride,
+                        source->source_width,
+                        source->source_height,
+                        dst_ptr->luma,
+                        dst_ptr->y_stride,
+                        config->source_width,
+                        config->source_height,
+                        is_16bit);
+        downscale_plane(src_ptr->cb,
+                        src_ptr->cb_stride,
+                        source->source_width >> subsampling_x,
+                        source->source_height >> subsampling_y,
+                        dst_ptr->cb,
+                        dst_ptr->cb_stride,
+                        config->source_width >> subsampling_x,
+                        config->source_height >> subsampling_y,
+                        is_16bit);
+        downscale_plane(src_ptr->cr,
+                        src_ptr->cr_stride,
+                        source->source_width >> subsampling_x,
+                        source->source_height >> subsampling_y,
+                        dst_ptr->cr,
+                        dst_ptr->cr_stride,
+                        config->source_width >> subsampling_x,
+                        config->source_height >> subsampling_y,
+                        is_16bit);
+
+        header_ptr->n_filled_len = (uint32_t)SIZE_OF_ONE_FRAME_IN_BYTES(
+            config->input_padded_width, config->input_padded_height, color_format, is_16bit);
+        config->processed_byte_count += header_ptr->n_filled_len;
+        header_ptr->p_app_private = (EbPtr)EB_NULL;
+        config->frames_encoded    = (int32_t)(++config->processed_frame_count);
+        header_ptr->pts           = config->processed_frame_count - 1;
+        header_ptr->pic_type      = EB_AV1_INVALID_PICTURE;
+        header_ptr->flags         = 0;
+
+        eb_svt_enc_send_picture(component_handle, header_ptr);
+        return APP_ExitConditionNone;
+    }
+
+    // The rendition ends with the first channel, once it has sent every frame of the source
+    if (!source_done) return APP_ExitConditionNone;
+    config->stop_encoder      = source->stop_encoder;
+    header_ptr->n_alloc_len   = 0;
+    header_ptr->n_filled_len  = 0;
+    header_ptr->n_tick_count  = 0;
+    header_ptr->p_app_private = NULL;
+    header_ptr->flags         = EB_BUFFERFLAG_EOS;
+    header_ptr->p_buffer      = NULL;
+    header_ptr->pic_type      = EB_AV1_INVALID_PICTURE;
+
+    eb_svt_enc_send_picture(component_handle, header_ptr);
+    return APP_ExitConditionFinished;
+}
+
 #define LONG_ENCODE_FRAME_ENCODE 4000
 #define SPEED_MEASUREMENT_INTERVAL 2000
 #define START_STEADY_STATE 1000
@@ -1059,6 +1165,66 @@ static void write_ivf_frame_header(EbConfig *config, uint32_t byte_count) {
 
     if (config->bitstream_file) fwrite(header, 1, IVF_FRAME_HEADER_SIZE, config->bitstream_file);
 }
+static __inline uint32_t mem_get_le32(const void *vmem) {
+    const uint8_t *mem = (const uint8_t *)vmem;
+
+    return (uint32_t)mem[0] | ((uint32_t)mem[1] << 8) | ((uint32_t)mem[2] << 16) |
+           ((uint32_t)mem[3] << 24);
+}
+
+/***************************************
+* Stitch the chunk streams in order into the output file, renumbering the IVF frame timestamps
+***************************************/
+EbErrorType stitch_chunk_streams(EbConfig **configs, uint32_t chunk_count) {
+    FILE *   output_file   = configs[0]->chunk_output_file;
+    EbBool   header_done   = EB_FALSE;
+    uint64_t pts           = 0;
+    uint8_t *buffer        = NULL;
+    uint32_t buffer_size   = 0;
+    uint8_t  header[IVF_STREAM_HEADER_SIZE];
+    uint32_t chunk_index;
+
+    if (output_file == NULL) return EB_ErrorNone;
+    for (chunk_index = 0; chunk_index < chunk_count; ++chunk_index) {
+        FILE *chunk_file = configs[chunk_index]->bitstream_file;
+
+        if (chunk_file == NULL) continue;
+        fseeko(chunk_file, 0, SEEK_SET);
+        // Every chunk starts with its own stream header, only the first one is kept
+        if (fread(header, 1, IVF_STREAM_HEADER_SIZE, chunk_file) != IVF_STREAM_HEADER_SIZE)
+            continue;
+        if (!header_done) {
+            fwrite(header, 1, IVF_STREAM_HEADER_SIZE, output_file);
+            header_done = EB_TRUE;
+        }
+        while (fread(header, 1, IVF_FRAME_HEADER_SIZE, chunk_file) == IVF_FRAME_HEADER_SIZE) {
+            uint32_t frame_size = mem_get_le32(header);
+
+            if (frame_size > buffer_size) {
+                uint8_t *new_buffer = (uint8_t *)realloc(buffer, frame_size);
+                if (new_buffer == NULL) {
+                    free(buffer);
+                    return EB_ErrorInsufficientResources;
+                }
+                buffer      = new_buffer;
+                buffer_size = frame_size;
+            }
+            if (fread(buffer, 1, frame_size, chunk_file) != frame_size) {
+                fprintf(stderr, "Error: truncated stream in chunk %u\n", chunk_index + 1);
+                free(buffer);
+                return EB_ErrorBadParameter;
+            }
+            mem_put_le32(&header[4], (int32_t)(pts & 0xFFFFFFFF));
+            mem_put_le32(&header[8], (int32_t)(pts >> 32));
+            ++pts;
+            fwrite(header, 1, IVF_FRAME_HEADER_SIZE, output_file);
+            fwrite(buffer, 1, frame_size, output_file);
+        }
+    }
+    free(buffer);
+    return EB_ErrorNone;
+}
+
 double get_psnr(double sse, double max) {
     double psnr;
     if (sse == 0)
@@ -1258,6 +1424,9 @@ AppExitConditionType process_output_stream_buffer(EbConfig *config, EbAppContext
                     config->byte_count_since_ivf += (header_ptr->n_filled_len);
                     break;
                 }
+                // terminate the last ivf packet of a chunk so that the chunk streams can be stitched
+                if (config->chunk_count > 1 && (header_ptr->flags & EB_BUFFERFLAG_EOS))
+                    update_prev_ivf_header(config);
             }
             config->performance_context.byte_count += header_ptr->n_filled_len;
 
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+#include <immintrin.h>
+
+#include "EbDefinitions.h"
+#include "common_dsp_rtcd.h"
+
+// scaling_lut has 257 entries, the last one repeats entry 255
+static INLINE __m256i scale_lut_hbd_avx2(const int32_t *scaling_lut, const __m256i index,
+                                         const int32_t bit_depth) {
+    const __m128i shift = _mm_cvtsi32_si128(bit_depth - 8);
+    const __m256i x     = _mm256_srl_epi32(index, shift);
+    const __m256i frac  = _mm256_and_si256(index, _mm256_set1_epi32((1 << (bit_depth - 8)) - 1));
+    const __m256i a     = _mm256_i32gather_epi32(scaling_lut, x, 4);
+    const __m256i b =
+        _mm256_i32gather_epi32(scaling_lut, _mm256_add_epi32(x, _mm256_set1_epi32(1)), 4);
+    const __m256i interp = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(b, a), frac),
+                                            _mm256_set1_epi32(1 << (bit_depth - 9)));
+    return _mm256_add_epi32(a, _mm256_sra_epi32(interp, shift));
+}
+
+static INLINE __m256i add_noise_avx2(const __m256i pix, const __m256i scale, const int32_t *grain,
+                                     const __m256i rounding, const __m128i scaling_shift,
+                                     const __m256i min_val, const __m256i max_val) {
+    const __m256i noise = _mm256_sra_epi32(
+        _mm256_add_epi32(_mm256_mullo_epi32(scale, _mm256_loadu_si256((const __m256i *)grain)),
+                         rounding),
+        scaling_shift);
+    return _mm256_min_epi32(_mm256_max_epi32(_mm256_add_epi32(pix, noise), min_val), max_val);
+}
+
+static INLINE void store_8x8(uint8_t *dst, const __m256i res) {
+    const __m256i words = _mm256_permute4x64_epi64(_mm256_packus_epi32(res, res), 0x88);
+    const __m128i lo    = _mm256_castsi256_si128(words);
+    _mm_storel_epi64((__m128i *)dst, _mm_packus_epi16(lo, lo));
+}
+
+static INLINE void store_8x16(uint16_t *dst, const __m256i res) {
+    const __m256i words = _mm256_permute4x64_epi64(_mm256_packus_epi32(res, res), 0x88);
+    _mm_storeu_si128((__m128i *)dst, _mm256_castsi256_si128(words));
+}
+
+void eb_av1_add_luma_noise_avx2(uint8_t *luma, int32_t luma_stride, const int32_t *grain,
+                                int32_t grain_stride, const int32_t *scaling_lut, int32_t width,
+                                int32_t height, int32_t scaling_shift, int32_t min_luma,
+                                int32_t max_luma) {
+    const __m256i rounding = _mm256_set1_epi32(1 << (scaling_shift - 1));
+    const __m128i shift    = _mm_cvtsi32_si128(scaling_shift);
+    const __m256i min_val  = _mm256_set1_epi32(min_luma);
+    const __m256i max_val  = _mm256_set1_epi32(max_luma);
+    const int32_t width8   = width & ~7;
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < width8; j += 8) {
+            const __m256i pix =
+                _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i *)(luma + i * luma_stride + j)));
+            const __m256i scale = _mm256_i32gather_epi32(scaling_lut, pix, 4);
+            store_8x8(luma + i * luma_stride + j,
+                      add_noise_avx2(pix,
+                                     scale,
+                                     grain + i * grain_stride + j,
+                                     rounding,
+                                     shift,
+                                     min_val,
+                                     max_val));
+        }
+    }
+
+    if (width8 < width) {
+        eb_av1_add_luma_noise_c(luma + width8,
+                                luma_stride,
+                                grain + width8,
+                                grain_stride,
+                                scaling_lut,
+                                width - width8,
+                                height,
+                                scaling_shift,
+                                min_luma,
+                                max_luma);
+    }
+}
+
+void eb_av1_add_luma_noise_hbd_avx2(uint16_t *luma, int32_t luma_stride, const int32_t *grain,
+                                    int32_t grain_stride, const int32_t *scaling_lut,
+                                    int32_t width, int32_t height, int32_t scaling_shift,
+                                    int32_t min_luma, int32_t max_luma, int32_t bit_depth) {
+    const __m256i rounding = _mm256_set1_epi32(1 << (scaling_shift - 1));
+    const __m128i shift    = _mm_cvtsi32_si128(scaling_shift);
+    const __m256i min_val  = _mm256_set1_epi32(min_luma);
+    const __m256i max_val  = _mm256_set1_epi32(max_luma);
+    const int32_t width8   = bit_depth > 8 ? width & ~7 : 0;
+
+    for (int32_t i = 0; i < height && width8; i++) {
+        for (int32_t j = 0; j < width8; j += 8) {
+            const __m256i pix =
+                _mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i *)(luma + i * luma_stride + j)));
+            const __m256i scale = scale_lut_hbd_avx2(scaling_lut, pix, bit_depth);
+            store_8x16(luma + i * luma_stride + j,
+                       add_noise_avx2(pix,
+                                      scale,
+                                      grain + i * grain_stride + j,
+                                      rounding,
+                                      shift,
+                                      min_val,
+                                      max_val));
+        }
+    }
+
+    if (width8 < width) {
+        eb_av1_add_luma_noise_hbd_c(luma + width8,
+                                    luma_stride,
+                                    grain + width8,
+                                    grain_stride,
+                                    scaling_lut,
+                                    width - width8,
+                                    height,
+                                    scaling_shift,
+                                    min_luma,
+                                    max_luma,
+                                    bit_depth);
+    }
+}
+
+// Average of the luma samples co-located with 8 chroma samples
+static INLINE __m256i average_luma_avx2(const __m256i luma_16x16) {
+    const __m256i sum = _mm256_madd_epi16(luma_16x16, _mm256_set1_epi16(1));
+    return _mm256_srai_epi32(_mm256_add_epi32(sum, _mm256_set1_epi32(1)), 1);
+}
+
+static INLINE __m256i chroma_index_avx2(const __m256i average_luma, const __m256i chroma,
+                                        const __m256i luma_mult, const __m256i chroma_mult,
+                                        const __m256i offset, const __m256i max_index) {
+    const __m256i combined = _mm256_add_epi32(_mm256_mullo_epi32(average_luma, luma_mult),
+                                              _mm256_mullo_epi32(chroma_mult, chroma));
+    const __m256i index = _mm256_add_epi32(_mm256_srai_epi32(combined, 6), offset);
+    return _mm256_min_epi32(_mm256_max_epi32(index, _mm256_setzero_si256()), max_index);
+}
+
+void eb_av1_add_chroma_noise_avx2(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma,
+                                  int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+                                  const int32_t *scaling_lut, int32_t width, int32_t height,
+                                  int32_t luma_mult, int32_t chroma_mult, int32_t offset,
+                                  int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma,
+                                  int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
+    const __m256i rounding      = _mm256_set1_epi32(1 << (scaling_shift - 1));
+    const __m128i shift         = _mm_cvtsi32_si128(scaling_shift);
+    const __m256i min_val       = _mm256_set1_epi32(min_chroma);
+    const __m256i max_val       = _mm256_set1_epi32(max_chroma);
+    const __m256i luma_mult_v   = _mm256_set1_epi32(luma_mult);
+    const __m256i chroma_mult_v = _mm256_set1_epi32(chroma_mult);
+    const __m256i offset_v      = _mm256_set1_epi32(offset);
+    const __m256i max_index     = _mm256_set1_epi32(255);
+    const int32_t width8        = width & ~7;
+
+    for (int32_t i = 0; i < height; i++) {
+        const uint8_t *luma_row = luma + (i << chroma_subsamp_y) * luma_stride;
+        for (int32_t j = 0; j < width8; j += 8) {
+            __m256i average_luma;
+            if (chroma_subsamp_x) {
+                average_luma = average_luma_avx2(
+                    _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i *)(luma_row + (j << 1)))));
+            } else
+                average_luma = _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i *)(luma_row + j)));
+            const __m256i pix =
+                _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i *)(chroma + i * chroma_stride + j)));
+            const __m256i index = chroma_index_avx2(
+                average_luma, pix, luma_mult_v, chroma_mult_v, offset_v, max_index);
+            const __m256i scale = _mm256_i32gather_epi32(scaling_lut, index, 4);
+            store_8x8(chroma + i * chroma_stride + j,
+                      add_noise_avx2(pix,
+                                     scale,
+                                     grain + i * grain_stride + j,
+                                     rounding,
+                                     shift,
+                                     min_val,
+                                     max_val));
+        }
+    }
+
+    if (width8 < width) {
+        eb_av1_add_chroma_noise_c(chroma + width8,
+                                  chroma_stride,
+                                  luma + (width8 << chroma_subsamp_x),
+                                  luma_stride,
+                                  grain + width8,
+                                  grain_stride,
+                                  scaling_lut,
+                                  width - width8,
+                                  height,
+                                  luma_mult,
+                                  chroma_mult,
+                                  offset,
+                                  scaling_shift,
+                                  min_chroma,
+                                  max_chroma,
+                                  chroma_subsamp_y,
+                                  chroma_subsamp_x);
+    }
+}
+
+void eb_av1_add_chroma_noise_hbd_avx2(uint16_t *chroma, int32_t chroma_stride,
+                                      const uint16_t *luma, int32_t luma_stride,
+                                      const int32_t *grain, int32_t grain_stride,
+                                      const int32_t *scaling_lut, int32_t width, int32_t height,
+                                      int32_t luma_mult, int32_t chroma_mult, int32_t offset,
+                                      int32_t scaling_shift, int32_t min_chroma,
+                                      int32_t max_chroma, int32_t chroma_subsamp_y,
+                                      int32_t chroma_subsamp_x, int32_t bit_depth) {
+    const __m256i rounding      = _mm256_set1_epi32(1 << (scaling_shift - 1));
+    const __m128i shift         = _mm_cvtsi32_si128(scaling_shift);
+    const __m256i min_val       = _mm256_set1_epi32(min_chroma);
+    const __m256i max_val       = _mm256_set1_epi32(max_chroma);
+    const __m256i luma_mult_v   = _mm256_set1_epi32(luma_mult);
+    const __m256i chroma_mult_v = _mm256_set1_epi32(chroma_mult);
+    const __m256i offset_v      = _mm256_set1_epi32(offset);
+    const __m256i max_index     = _mm256_set1_epi32((256 << (bit_depth - 8)) - 1);
+    const int32_t width8        = bit_depth > 8 ? width & ~7 : 0;
+
+    for (int32_t i = 0; i < height && width8; i++) {
+        const uint16_t *luma_row = luma + (i << chroma_subsamp_y) * luma_stride;
+        for (int32_t j = 0; j < width8; j += 8) {
+            __m256i average_luma;
+            if (chroma_subsamp_x) {
+                average_luma = average_luma_avx2(
+                    _mm256_loadu_si256((__m256i *)(luma_row + (j << 1))));
+            } else
+                average_luma = _mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i *)(luma_row + j)));
+            const __m256i pix =
+                _mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i *)(chroma + i * chroma_stride + j)));
+            const __m256i index = chroma_index_avx2(
+                average_luma, pix, luma_mult_v, chroma_mult_v, offset_v, max_index);
+            const __m256i scale = scale_lut_hbd_avx2(scaling_lut, index, bit_depth);
+            store_8x16(chroma + i * chroma_stride + j,
+                       add_noise_avx2(pix,
+                                      scale,
+                                      grain + i * grain_stride + j,
+                                      rounding,
+                                      shift,
+                                      min_val,
+                                      max_val));
+        }
+    }
+
+    if (width8 < width) {
+        eb_av1_add_chroma_noise_hbd_c(chroma + width8,
+                                      chroma_stride,
+                                      luma + (width8 << chroma_subsamp_x),
+                                      luma_stride,
+                                      grain + width8,
+                                      grain_stride,
+                                      scaling_lut,
+                                      width - width8,
+                                      height,
+                                      luma_mult,
+                                      chroma_mult,
+                                      offset,
+                                      scaling_shift,
+                                      min_chroma,
+                                      max_chroma,
+                                      chroma_subsamp_y,
+                                      chroma_subsamp_x,
+                                      bit_depth);
+    }
+}
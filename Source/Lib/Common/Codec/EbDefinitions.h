@@ -3040,8 +3040,31 @@ static const uint32_t md_scan_to_ois_32x32_scan[CU_MAX_COUNT] =
 
 typedef struct StatStruct
 {
-    uint32_t                        referenced_area[MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE];
+    uint32_t                       *referenced_area; // one entry per 64x64 SB of the picture
 } StatStruct;
+// The two-pass stat file keeps one fixed size record per picture, independent of the resolution
+#define STAT_STRUCT_RECORD_SIZE (MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE * sizeof(uint32_t))
+/* Fast first pass statistics file layout: one FirstPassStatsHeader followed by one
+ * FirstPassFrameStats record per input picture, stored at its picture number. */
+#define FIRST_PASS_STATS_MAGIC 0x31535046 // "FPS1"
+#define FIRST_PASS_STATS_VERSION 1
+typedef struct FirstPassStatsHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+} FirstPassStatsHeader;
+typedef struct FirstPassFrameStats {
+    uint64_t picture_number;
+    uint64_t intra_cost; // sum of the 64x64 variance based intra cost estimates
+    uint64_t inter_cost; // sum of the 64x64 ME distortions, intra_cost for I_SLICE
+    uint16_t avg_variance;
+    uint16_t non_moving_index_average;
+    uint8_t  slice_type;
+    uint8_t  temporal_layer_index;
+    uint8_t  scene_change_flag;
+    uint8_t  valid;
+} FirstPassFrameStats;
 #define TWO_PASS_IR_THRSHLD 40  // Intra refresh threshold used to reduce the reference area.
                                 // If the periodic Intra refresh is less than the threshold,
                                 // the referenced area is normalized
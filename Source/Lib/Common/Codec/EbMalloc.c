@@ -353,3 +353,30 @@ void eb_decrease_component_count() {
     eb_release_mutex(m);
 #endif
 }
+
+EbErrorType eb_arena_ctor(EbArena* arena, size_t size) {
+    arena->base = NULL;
+    arena->size = EB_ARENA_SIZE(size);
+    arena->used = 0;
+    if (arena->size) EB_MALLOC_ALIGNED(arena->base, arena->size);
+    return EB_ErrorNone;
+}
+
+void eb_arena_dctor(EbArena* arena) {
+    if (arena->base) EB_FREE_ALIGNED(arena->base);
+    arena->size = 0;
+    arena->used = 0;
+}
+
+void eb_arena_reset(EbArena* arena) { arena->used = 0; }
+
+void* eb_arena_alloc(EbArena* arena, size_t size) {
+    size = EB_ARENA_SIZE(size);
+    if (arena->used + size > arena->size) {
+        SVT_ERROR("arena of %" PRIu64 " bytes exhausted\n", (uint64_t)arena->size);
+        return NULL;
+    }
+    void* p = arena->base + arena->used;
+    arena->used += size;
+    return p;
+}
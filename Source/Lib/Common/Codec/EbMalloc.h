@@ -10,6 +10,10 @@
 #include "EbSvtAv1Enc.h"
 #include "EbDefinitions.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 #ifndef NDEBUG
 #define DEBUG_MEMORY_USAGE
 #endif
@@ -172,8 +176,40 @@ void eb_remove_mem_entry(void* ptr, EbPtrType type);
 
 #define EB_FREE_ALIGNED_ARRAY(pa) EB_FREE_ALIGNED(pa)
 
+/* Bump arena: one backing allocation carved into ALVALUE aligned sub-allocations. The owner sizes
+ * it up front by summing EB_ARENA_SIZE() of every sub-allocation, and everything is released at
+ * once by eb_arena_dctor(). eb_arena_reset() hands the whole backing allocation out again.
+ * Sub-allocations are not initialized. */
+#define EB_ARENA_SIZE(size) (((size_t)(size) + ALVALUE - 1) & ~((size_t)ALVALUE - 1))
+
+typedef struct EbArena {
+    uint8_t* base;
+    size_t   size;
+    size_t   used;
+} EbArena;
+
+EbErrorType eb_arena_ctor(EbArena* arena, size_t size);
+void        eb_arena_dctor(EbArena* arena);
+void        eb_arena_reset(EbArena* arena);
+void*       eb_arena_alloc(EbArena* arena, size_t size);
+
+#define EB_ARENA_ALLOC_ARRAY(arena, pa, count)                            \
+    do {                                                                  \
+        *(void**)&(pa) = eb_arena_alloc(arena, sizeof(*(pa)) * (count)); \
+        EB_CHECK_MEM(pa);                                                 \
+    } while (0)
+
+#define EB_ARENA_CALLOC_ARRAY(arena, pa, count)  \
+    do {                                         \
+        EB_ARENA_ALLOC_ARRAY(arena, pa, count);  \
+        memset(pa, 0, sizeof(*(pa)) * (count)); \
+    } while (0)
+
 void eb_print_memory_usage();
 void eb_increase_component_count();
 void eb_decrease_component_count();
 
+#ifdef __cplusplus
+}
+#endif
 #endif //EbMalloc_h
@@ -231,20 +231,27 @@ void setup_common_rtcd_internal(CPU_FLAGS flags) {
     if (flags & HAS_AVX2) aom_blend_a64_mask = aom_blend_a64_mask_avx2;
     aom_blend_a64_hmask = aom_blend_a64_hmask_c;
     if (flags & HAS_SSE4_1) aom_blend_a64_hmask = aom_blend_a64_hmask_sse4_1;
+    if (flags & HAS_AVX2) aom_blend_a64_hmask = aom_blend_a64_hmask_avx2;
     aom_blend_a64_vmask = aom_blend_a64_vmask_c;
     if (flags & HAS_SSE4_1) aom_blend_a64_vmask = aom_blend_a64_vmask_sse4_1;
+    if (flags & HAS_AVX2) aom_blend_a64_vmask = aom_blend_a64_vmask_avx2;
 
     aom_highbd_blend_a64_mask = aom_highbd_blend_a64_mask_c;
     if (flags & HAS_SSE4_1) aom_highbd_blend_a64_mask = aom_highbd_blend_a64_mask_sse4_1;
+    if (flags & HAS_AVX2) aom_highbd_blend_a64_mask = aom_highbd_blend_a64_mask_avx2;
     aom_highbd_blend_a64_hmask = aom_highbd_blend_a64_hmask_c;
     if (flags & HAS_SSE4_1) aom_highbd_blend_a64_hmask = aom_highbd_blend_a64_hmask_sse4_1;
+    if (flags & HAS_AVX2) aom_highbd_blend_a64_hmask = aom_highbd_blend_a64_hmask_avx2;
     aom_highbd_blend_a64_vmask = aom_highbd_blend_a64_vmask_c;
     if (flags & HAS_SSE4_1) aom_highbd_blend_a64_vmask = aom_highbd_blend_a64_vmask_sse4_1;
+    if (flags & HAS_AVX2) aom_highbd_blend_a64_vmask = aom_highbd_blend_a64_vmask_avx2;
 
     eb_aom_highbd_blend_a64_vmask = eb_aom_highbd_blend_a64_vmask_c;
     if (flags & HAS_SSE4_1) eb_aom_highbd_blend_a64_vmask = eb_aom_highbd_blend_a64_vmask_sse4_1;
+    if (flags & HAS_AVX2) eb_aom_highbd_blend_a64_vmask = eb_aom_highbd_blend_a64_vmask_avx2;
     eb_aom_highbd_blend_a64_hmask = eb_aom_highbd_blend_a64_hmask_c;
     if (flags & HAS_SSE4_1) eb_aom_highbd_blend_a64_hmask = eb_aom_highbd_blend_a64_hmask_sse4_1;
+    if (flags & HAS_AVX2) eb_aom_highbd_blend_a64_hmask = eb_aom_highbd_blend_a64_hmask_avx2;
 
     eb_cfl_predict_lbd = eb_cfl_predict_lbd_c;
     if (flags & HAS_AVX2) eb_cfl_predict_lbd = eb_cfl_predict_lbd_avx2;
@@ -368,4 +375,12 @@ void setup_common_rtcd_internal(CPU_FLAGS flags) {
     SET_SSSE3(avc_style_luma_interpolation_filter,
               avc_style_luma_interpolation_filter_helper_c,
               avc_style_luma_interpolation_filter_helper_ssse3);
+
+    SET_AVX2(eb_av1_add_luma_noise, eb_av1_add_luma_noise_c, eb_av1_add_luma_noise_avx2);
+    SET_AVX2(
+        eb_av1_add_luma_noise_hbd, eb_av1_add_luma_noise_hbd_c, eb_av1_add_luma_noise_hbd_avx2);
+    SET_AVX2(eb_av1_add_chroma_noise, eb_av1_add_chroma_noise_c, eb_av1_add_chroma_noise_avx2);
+    SET_AVX2(eb_av1_add_chroma_noise_hbd,
+             eb_av1_add_chroma_noise_hbd_c,
+             eb_av1_add_chroma_noise_hbd_avx2);
 }
@@ -18,6 +18,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include "grainSynthesis.h"
+#include "common_dsp_rtcd.h"
 #include "EbLog.h"
 
 // Samples with Gaussian distribution in the range of [-2048, 2047] (12 bits)
@@ -185,11 +186,16 @@ static const int32_t gaussian_sequence[2048] = {
 
 static const int32_t gauss_bits = 11;
 
-static int32_t luma_subblock_size_y = 32;
-static int32_t luma_subblock_size_x = 32;
+static const int32_t luma_subblock_size_y = 32;
+static const int32_t luma_subblock_size_x = 32;
 
-static int32_t chroma_subblock_size_y = 16;
-static int32_t chroma_subblock_size_x = 16;
+// Padding of the grain templates, the AR coefficients need 3 samples around
+// each position and the same amount is used to stabilize the AR process
+#define FG_LEFT_PAD 3
+#define FG_RIGHT_PAD 3
+#define FG_TOP_PAD 3
+#define FG_BOTTOM_PAD 0
+#define FG_AR_PADDING 3
 
 static const int32_t min_luma_legal_range = 16;
 static const int32_t max_luma_legal_range = 235;
@@ -197,16 +203,6 @@ static const int32_t max_luma_legal_range = 235;
 static const int32_t min_chroma_legal_range = 16;
 static const int32_t max_chroma_legal_range = 240;
 
-static int32_t scaling_lut_y[256];
-static int32_t scaling_lut_cb[256];
-static int32_t scaling_lut_cr[256];
-
-static int32_t grain_center;
-static int32_t grain_min;
-static int32_t grain_max;
-
-static uint16_t random_register = 0; // random number generator register
-
 //----------------------------------------------------------------------
 // todo: aomlib memory functions (to be replaced by Eb functions)
 /*
@@ -270,18 +266,10 @@ void eb_aom_free(void *memblk) {
 */
 //--------------------------------------------------------------------
 
-static void init_arrays(AomFilmGrain *params, int32_t luma_stride, int32_t chroma_stride,
-                        int32_t ***pred_pos_luma_p, int32_t ***pred_pos_chroma_p,
-                        int32_t **luma_grain_block, int32_t **cb_grain_block,
-                        int32_t **cr_grain_block, int32_t **y_line_buf, int32_t **cb_line_buf,
-                        int32_t **cr_line_buf, int32_t **y_col_buf, int32_t **cb_col_buf,
-                        int32_t **cr_col_buf, int32_t luma_grain_samples,
-                        int32_t chroma_grain_samples, int32_t chroma_subsamp_y,
-                        int32_t chroma_subsamp_x) {
-    memset(scaling_lut_y, 0, sizeof(*scaling_lut_y) * 256);
-    memset(scaling_lut_cb, 0, sizeof(*scaling_lut_cb) * 256);
-    memset(scaling_lut_cr, 0, sizeof(*scaling_lut_cr) * 256);
-
+static void init_arrays(AomFilmGrain *params, int32_t ***pred_pos_luma_p,
+                        int32_t ***pred_pos_chroma_p, int32_t **luma_grain_block,
+                        int32_t **cb_grain_block, int32_t **cr_grain_block,
+                        int32_t luma_grain_samples, int32_t chroma_grain_samples) {
     int32_t num_pos_luma   = 2 * params->ar_coeff_lag * (params->ar_coeff_lag + 1);
     int32_t num_pos_chroma = num_pos_luma;
     if (params->num_y_points > 0) ++num_pos_chroma;
@@ -339,90 +327,58 @@ static void init_arrays(AomFilmGrain *params, int32_t luma_stride, int32_t chrom
     *pred_pos_luma_p   = pred_pos_luma;
     *pred_pos_chroma_p = pred_pos_chroma;
 
-    *y_line_buf = (int32_t *)malloc(sizeof(**y_line_buf) * luma_stride * 2);
-    *cb_line_buf =
-        (int32_t *)malloc(sizeof(**cb_line_buf) * chroma_stride * (2 >> chroma_subsamp_y));
-    *cr_line_buf =
-        (int32_t *)malloc(sizeof(**cr_line_buf) * chroma_stride * (2 >> chroma_subsamp_y));
-
-    *y_col_buf  = (int32_t *)malloc(sizeof(**y_col_buf) * (luma_subblock_size_y + 2) * 2);
-    *cb_col_buf = (int32_t *)malloc(sizeof(**cb_col_buf) *
-                                    (chroma_subblock_size_y + (2 >> chroma_subsamp_y)) *
-                                    (2 >> chroma_subsamp_x));
-    *cr_col_buf = (int32_t *)malloc(sizeof(**cr_col_buf) *
-                                    (chroma_subblock_size_y + (2 >> chroma_subsamp_y)) *
-                                    (2 >> chroma_subsamp_x));
-
     *luma_grain_block = (int32_t *)malloc(sizeof(**luma_grain_block) * luma_grain_samples);
     *cb_grain_block   = (int32_t *)malloc(sizeof(**cb_grain_block) * chroma_grain_samples);
     *cr_grain_block   = (int32_t *)malloc(sizeof(**cr_grain_block) * chroma_grain_samples);
 }
 
 static void dealloc_arrays(AomFilmGrain *params, int32_t ***pred_pos_luma,
-                           int32_t ***pred_pos_chroma, int32_t **luma_grain_block,
-                           int32_t **cb_grain_block, int32_t **cr_grain_block, int32_t **y_line_buf,
-                           int32_t **cb_line_buf, int32_t **cr_line_buf, int32_t **y_col_buf,
-                           int32_t **cb_col_buf, int32_t **cr_col_buf) {
+                           int32_t ***pred_pos_chroma) {
     int32_t num_pos_luma   = 2 * params->ar_coeff_lag * (params->ar_coeff_lag + 1);
-    int32_t num_pos_chroma = num_pos_luma + 1;
+    int32_t num_pos_chroma = num_pos_luma;
+    if (params->num_y_points > 0) ++num_pos_chroma;
 
     for (int32_t row = 0; row < num_pos_luma; row++) free((*pred_pos_luma)[row]);
     free(*pred_pos_luma);
 
     for (int32_t row = 0; row < num_pos_chroma; row++) free((*pred_pos_chroma)[row]);
     free((*pred_pos_chroma));
-
-    free(*y_line_buf);
-
-    free(*cb_line_buf);
-
-    free(*cr_line_buf);
-
-    free(*y_col_buf);
-
-    free(*cb_col_buf);
-
-    free(*cr_col_buf);
-
-    free(*luma_grain_block);
-
-    free(*cb_grain_block);
-
-    free(*cr_grain_block);
 }
 
 // get a number between 0 and 2^bits - 1
-static INLINE int32_t get_random_number(int32_t bits) {
+static INLINE int32_t get_random_number(uint16_t *random_register, int32_t bits) {
     uint16_t bit;
-    bit = ((random_register >> 0) ^ (random_register >> 1) ^ (random_register >> 3) ^
-           (random_register >> 12)) &
+    bit = ((*random_register >> 0) ^ (*random_register >> 1) ^ (*random_register >> 3) ^
+           (*random_register >> 12)) &
           1;
-    random_register = (random_register >> 1) | (bit << 15);
-    return (random_register >> (16 - bits)) & ((1 << bits) - 1);
+    *random_register = (*random_register >> 1) | (bit << 15);
+    return (*random_register >> (16 - bits)) & ((1 << bits) - 1);
 }
 
-static void init_random_generator(int32_t luma_line, uint16_t seed) {
+static void init_random_generator(uint16_t *random_register, int32_t luma_line, uint16_t seed) {
     // same for the picture
 
     uint16_t msb = (seed >> 8) & 255;
     uint16_t lsb = seed & 255;
 
-    random_register = (msb << 8) + lsb;
+    *random_register = (msb << 8) + lsb;
 
     //  changes for each row
     int32_t luma_num = luma_line >> 5;
 
-    random_register ^= ((luma_num * 37 + 178) & 255) << 8;
-    random_register ^= ((luma_num * 173 + 105) & 255);
+    *random_register ^= ((luma_num * 37 + 178) & 255) << 8;
+    *random_register ^= ((luma_num * 173 + 105) & 255);
 }
 
 static void generate_luma_grain_block(AomFilmGrain *params, int32_t **pred_pos_luma,
                                       int32_t *luma_grain_block, int32_t luma_block_size_y,
                                       int32_t luma_block_size_x, int32_t luma_grain_stride,
                                       int32_t left_pad, int32_t top_pad, int32_t right_pad,
-                                      int32_t bottom_pad) {
+                                      int32_t bottom_pad, int32_t grain_min, int32_t grain_max) {
     if (params->num_y_points == 0) return;
 
+    uint16_t random_register = params->random_seed;
+
     int32_t bit_depth       = params->bit_depth;
     int32_t gauss_sec_shift = 12 - bit_depth + params->grain_scale_shift;
 
@@ -432,7 +388,7 @@ static void generate_luma_grain_block(AomFilmGrain *params, int32_t **pred_pos_l
     for (int32_t i = 0; i < luma_block_size_y; i++)
         for (int32_t j = 0; j < luma_block_size_x; j++)
             luma_grain_block[i * luma_grain_stride + j] =
-                (gaussian_sequence[get_random_number(gauss_bits)] +
+                (gaussian_sequence[get_random_number(&random_register, gauss_bits)] +
                  ((1 << gauss_sec_shift) >> 1)) >>
                 gauss_sec_shift;
 
@@ -458,7 +414,8 @@ static void generate_chroma_grain_blocks(
     int32_t **pred_pos_chroma, int32_t *luma_grain_block, int32_t *cb_grain_block,
     int32_t *cr_grain_block, int32_t luma_grain_stride, int32_t chroma_block_size_y,
     int32_t chroma_block_size_x, int32_t chroma_grain_stride, int32_t left_pad, int32_t top_pad,
-    int32_t right_pad, int32_t bottom_pad, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
+    int32_t right_pad, int32_t bottom_pad, int32_t chroma_subsamp_y, int32_t chroma_subsamp_x,
+    int32_t grain_min, int32_t grain_max) {
     int32_t bit_depth       = params->bit_depth;
     int32_t gauss_sec_shift = 12 - bit_depth + params->grain_scale_shift;
 
@@ -466,23 +423,24 @@ static void generate_chroma_grain_blocks(
     if (params->num_y_points > 0) ++num_pos_chroma;
     int32_t rounding_offset = (1 << (params->ar_coeff_shift - 1));
 
+    uint16_t random_register;
     if (params->num_cb_points) {
-        init_random_generator(7 << 5, params->random_seed);
+        init_random_generator(&random_register, 7 << 5, params->random_seed);
 
         for (int32_t i = 0; i < chroma_block_size_y; i++)
             for (int32_t j = 0; j < chroma_block_size_x; j++)
                 cb_grain_block[i * chroma_grain_stride + j] =
-                    (gaussian_sequence[get_random_number(gauss_bits)] +
+                    (gaussian_sequence[get_random_number(&random_register, gauss_bits)] +
                      ((1 << gauss_sec_shift) >> 1)) >>
                     gauss_sec_shift;
     }
     if (params->num_cr_points) {
-        init_random_generator(11 << 5, params->random_seed);
+        init_random_generator(&random_register, 11 << 5, params->random_seed);
 
         for (int32_t i = 0; i < chroma_block_size_y; i++)
             for (int32_t j = 0; j < chroma_block_size_x; j++)
                 cr_grain_block[i * chroma_grain_stride + j] =
-                    (gaussian_sequence[get_random_number(gauss_bits)] +
+                    (gaussian_sequence[get_random_number(&random_register, gauss_bits)] +
                      ((1 << gauss_sec_shift) >> 1)) >>
                     gauss_sec_shift;
     }
@@ -563,7 +521,7 @@ static void init_scaling_function(int32_t scaling_points[][2], int32_t num_point
 
 // function that extracts samples from a lut (and interpolates intemediate
 // frames for 10- and 12-bit video)
-static int32_t scale_lut(int32_t *scaling_lut, int32_t index, int32_t bit_depth) {
+static int32_t scale_lut(const int32_t *scaling_lut, int32_t index, int32_t bit_depth) {
     int32_t x = index >> (bit_depth - 8);
 
     if (!(bit_depth - 8) || x == 255)
@@ -575,12 +533,132 @@ static int32_t scale_lut(int32_t *scaling_lut, int32_t index, int32_t bit_depth)
                 (bit_depth - 8));
 }
 
-static void add_noise_to_block(AomFilmGrain *params, uint8_t *luma, uint8_t *cb, uint8_t *cr,
+void eb_av1_add_luma_noise_c(uint8_t *luma, int32_t luma_stride, const int32_t *grain,
+                             int32_t grain_stride, const int32_t *scaling_lut, int32_t width,
+                             int32_t height, int32_t scaling_shift, int32_t min_luma,
+                             int32_t max_luma) {
+    int32_t rounding_offset = (1 << (scaling_shift - 1));
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < width; j++) {
+            luma[i * luma_stride + j] =
+                clamp(luma[i * luma_stride + j] +
+                          ((scale_lut(scaling_lut, luma[i * luma_stride + j], 8) *
+                                grain[i * grain_stride + j] +
+                            rounding_offset) >>
+                           scaling_shift),
+                      min_luma,
+                      max_luma);
+        }
+    }
+}
+
+void eb_av1_add_luma_noise_hbd_c(uint16_t *luma, int32_t luma_stride, const int32_t *grain,
+                                 int32_t grain_stride, const int32_t *scaling_lut, int32_t width,
+                                 int32_t height, int32_t scaling_shift, int32_t min_luma,
+                                 int32_t max_luma, int32_t bit_depth) {
+    int32_t rounding_offset = (1 << (scaling_shift - 1));
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < width; j++) {
+            luma[i * luma_stride + j] =
+                clamp(luma[i * luma_stride + j] +
+                          ((scale_lut(scaling_lut, luma[i * luma_stride + j], bit_depth) *
+                                grain[i * grain_stride + j] +
+                            rounding_offset) >>
+                           scaling_shift),
+                      min_luma,
+                      max_luma);
+        }
+    }
+}
+
+// The luma samples are read before any noise is added to them
+void eb_av1_add_chroma_noise_c(uint8_t *chroma, int32_t chroma_stride, const uint8_t *luma,
+                               int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+                               const int32_t *scaling_lut, int32_t width, int32_t height,
+                               int32_t luma_mult, int32_t chroma_mult, int32_t offset,
+                               int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma,
+                               int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
+    int32_t rounding_offset = (1 << (scaling_shift - 1));
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < width; j++) {
+            int32_t average_luma = 0;
+            if (chroma_subsamp_x) {
+                average_luma =
+                    (luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x)] +
+                     luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x) + 1] +
+                     1) >>
+                    1;
+            } else
+                average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
+            chroma[i * chroma_stride + j] = clamp(
+                chroma[i * chroma_stride + j] +
+                    ((scale_lut(scaling_lut,
+                                clamp(((average_luma * luma_mult +
+                                        chroma_mult * chroma[i * chroma_stride + j]) >>
+                                       6) +
+                                          offset,
+                                      0,
+                                      255),
+                                8) *
+                          grain[i * grain_stride + j] +
+                      rounding_offset) >>
+                     scaling_shift),
+                min_chroma,
+                max_chroma);
+        }
+    }
+}
+
+void eb_av1_add_chroma_noise_hbd_c(uint16_t *chroma, int32_t chroma_stride, const uint16_t *luma,
+                                   int32_t luma_stride, const int32_t *grain, int32_t grain_stride,
+                                   const int32_t *scaling_lut, int32_t width, int32_t height,
+                                   int32_t luma_mult, int32_t chroma_mult, int32_t offset,
+                                   int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma,
+                                   int32_t chroma_subsamp_y, int32_t chroma_subsamp_x,
+                                   int32_t bit_depth) {
+    int32_t rounding_offset = (1 << (scaling_shift - 1));
+
+    for (int32_t i = 0; i < height; i++) {
+        for (int32_t j = 0; j < width; j++) {
+            int32_t average_luma = 0;
+            if (chroma_subsamp_x) {
+                average_luma =
+                    (luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x)] +
+                     luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x) + 1] +
+                     1) >>
+                    1;
+            } else
+                average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
+            chroma[i * chroma_stride + j] = clamp(
+                chroma[i * chroma_stride + j] +
+                    ((scale_lut(scaling_lut,
+                                clamp(((average_luma * luma_mult +
+                                        chroma_mult * chroma[i * chroma_stride + j]) >>
+                                       6) +
+                                          offset,
+                                      0,
+                                      (256 << (bit_depth - 8)) - 1),
+                                bit_depth) *
+                          grain[i * grain_stride + j] +
+                      rounding_offset) >>
+                     scaling_shift),
+                min_chroma,
+                max_chroma);
+        }
+    }
+}
+
+static void add_noise_to_block(const FilmGrainFrame *fg, uint8_t *luma, uint8_t *cb, uint8_t *cr,
                                int32_t luma_stride, int32_t chroma_stride, int32_t *luma_grain,
                                int32_t *cb_grain, int32_t *cr_grain, int32_t luma_grain_stride,
                                int32_t chroma_grain_stride, int32_t half_luma_height,
-                               int32_t half_luma_width, int32_t bit_depth, int32_t chroma_subsamp_y,
+                               int32_t half_luma_width, int32_t chroma_subsamp_y,
                                int32_t chroma_subsamp_x) {
+    const AomFilmGrain *params = &fg->params;
+
     int32_t cb_mult      = params->cb_mult - 128; // fixed scale
     int32_t cb_luma_mult = params->cb_luma_mult - 128; // fixed scale
     int32_t cb_offset    = params->cb_offset - 256;
@@ -589,8 +667,6 @@ static void add_noise_to_block(AomFilmGrain *params, uint8_t *luma, uint8_t *cb,
     int32_t cr_luma_mult = params->cr_luma_mult - 128; // fixed scale
     int32_t cr_offset    = params->cr_offset - 256;
 
-    int32_t rounding_offset = (1 << (params->scaling_shift - 1));
-
     int32_t apply_y  = params->num_y_points > 0 ? 1 : 0;
     int32_t apply_cb = params->num_cb_points > 0 ? 1 : 0;
     int32_t apply_cr = params->num_cr_points > 0 ? 1 : 0;
@@ -618,77 +694,70 @@ static void add_noise_to_block(AomFilmGrain *params, uint8_t *luma, uint8_t *cb,
         max_luma = max_chroma = 255;
     }
 
-    for (int32_t i = 0; i < (half_luma_height << (1 - chroma_subsamp_y)); i++) {
-        for (int32_t j = 0; j < (half_luma_width << (1 - chroma_subsamp_x)); j++) {
-            int32_t average_luma = 0;
-            if (chroma_subsamp_x) {
-                average_luma =
-                    (luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x)] +
-                     luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x) + 1] +
-                     1) >>
-                    1;
-            } else
-                average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
-            if (apply_cb) {
-                cb[i * chroma_stride + j] =
-                    clamp(cb[i * chroma_stride + j] +
-                              ((scale_lut(scaling_lut_cb,
-                                          clamp(((average_luma * cb_luma_mult +
-                                                  cb_mult * cb[i * chroma_stride + j]) >>
-                                                 6) +
-                                                    cb_offset,
-                                                0,
-                                                (256 << (bit_depth - 8)) - 1),
-                                          8) *
-                                    cb_grain[i * chroma_grain_stride + j] +
-                                rounding_offset) >>
-                               params->scaling_shift),
-                          min_chroma,
-                          max_chroma);
-            }
+    // The chroma noise depends on the luma samples without noise
+    if (apply_cb) {
+        eb_av1_add_chroma_noise(cb,
+                                chroma_stride,
+                                luma,
+                                luma_stride,
+                                cb_grain,
+                                chroma_grain_stride,
+                                fg->scaling_lut_cb,
+                                half_luma_width << (1 - chroma_subsamp_x),
+                                half_luma_height << (1 - chroma_subsamp_y),
+                                cb_luma_mult,
+                                cb_mult,
+                                cb_offset,
+                                params->scaling_shift,
+                                min_chroma,
+                                max_chroma,
+                                chroma_subsamp_y,
+                                chroma_subsamp_x);
+    }
 
-            if (apply_cr) {
-                cr[i * chroma_stride + j] =
-                    clamp(cr[i * chroma_stride + j] +
-                              ((scale_lut(scaling_lut_cr,
-                                          clamp(((average_luma * cr_luma_mult +
-                                                  cr_mult * cr[i * chroma_stride + j]) >>
-                                                 6) +
-                                                    cr_offset,
-                                                0,
-                                                (256 << (bit_depth - 8)) - 1),
-                                          8) *
-                                    cr_grain[i * chroma_grain_stride + j] +
-                                rounding_offset) >>
-                               params->scaling_shift),
-                          min_chroma,
-                          max_chroma);
-            }
-        }
+    if (apply_cr) {
+        eb_av1_add_chroma_noise(cr,
+                                chroma_stride,
+                                luma,
+                                luma_stride,
+                                cr_grain,
+                                chroma_grain_stride,
+                                fg->scaling_lut_cr,
+                                half_luma_width << (1 - chroma_subsamp_x),
+                                half_luma_height << (1 - chroma_subsamp_y),
+                                cr_luma_mult,
+                                cr_mult,
+                                cr_offset,
+                                params->scaling_shift,
+                                min_chroma,
+                                max_chroma,
+                                chroma_subsamp_y,
+                                chroma_subsamp_x);
     }
 
     if (apply_y) {
-        for (int32_t i = 0; i < (half_luma_height << 1); i++) {
-            for (int32_t j = 0; j < (half_luma_width << 1); j++) {
-                luma[i * luma_stride + j] =
-                    clamp(luma[i * luma_stride + j] +
-                              ((scale_lut(scaling_lut_y, luma[i * luma_stride + j], 8) *
-                                    luma_grain[i * luma_grain_stride + j] +
-                                rounding_offset) >>
-                               params->scaling_shift),
-                          min_luma,
-                          max_luma);
-            }
-        }
+        eb_av1_add_luma_noise(luma,
+                              luma_stride,
+                              luma_grain,
+                              luma_grain_stride,
+                              fg->scaling_lut_y,
+                              half_luma_width << 1,
+                              half_luma_height << 1,
+                              params->scaling_shift,
+                              min_luma,
+                              max_luma);
     }
 }
 
-static void add_noise_to_block_hbd(AomFilmGrain *params, uint16_t *luma, uint16_t *cb, uint16_t *cr,
-                                   int32_t luma_stride, int32_t chroma_stride, int32_t *luma_grain,
-                                   int32_t *cb_grain, int32_t *cr_grain, int32_t luma_grain_stride,
-                                   int32_t chroma_grain_stride, int32_t half_luma_height,
-                                   int32_t half_luma_width, int32_t bit_depth,
-                                   int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
+static void add_noise_to_block_hbd(const FilmGrainFrame *fg, uint16_t *luma, uint16_t *cb,
+                                   uint16_t *cr, int32_t luma_stride, int32_t chroma_stride,
+                                   int32_t *luma_grain, int32_t *cb_grain, int32_t *cr_grain,
+                                   int32_t luma_grain_stride, int32_t chroma_grain_stride,
+                                   int32_t half_luma_height, int32_t half_luma_width,
+                                   int32_t bit_depth, int32_t chroma_subsamp_y,
+                                   int32_t chroma_subsamp_x) {
+    const AomFilmGrain *params = &fg->params;
+
     int32_t cb_mult      = params->cb_mult - 128; // fixed scale
     int32_t cb_luma_mult = params->cb_luma_mult - 128; // fixed scale
     // offset value depends on the bit depth
@@ -699,8 +768,6 @@ static void add_noise_to_block_hbd(AomFilmGrain *params, uint16_t *luma, uint16_
     // offset value depends on the bit depth
     int32_t cr_offset = (params->cr_offset << (bit_depth - 8)) - (1 << bit_depth);
 
-    int32_t rounding_offset = (1 << (params->scaling_shift - 1));
-
     int32_t apply_y  = params->num_y_points > 0 ? 1 : 0;
     int32_t apply_cb = params->num_cb_points > 0 ? 1 : 0;
     int32_t apply_cr = params->num_cr_points > 0 ? 1 : 0;
@@ -728,67 +795,61 @@ static void add_noise_to_block_hbd(AomFilmGrain *params, uint16_t *luma, uint16_
         max_luma = max_chroma = (256 << (bit_depth - 8)) - 1;
     }
 
-    for (int32_t i = 0; i < (half_luma_height << (1 - chroma_subsamp_y)); i++) {
-        for (int32_t j = 0; j < (half_luma_width << (1 - chroma_subsamp_x)); j++) {
-            int32_t average_luma = 0;
-            if (chroma_subsamp_x) {
-                average_luma =
-                    (luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x)] +
-                     luma[(i << chroma_subsamp_y) * luma_stride + (j << chroma_subsamp_x) + 1] +
-                     1) >>
-                    1;
-            } else
-                average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
-            if (apply_cb) {
-                cb[i * chroma_stride + j] =
-                    clamp(cb[i * chroma_stride + j] +
-                              ((scale_lut(scaling_lut_cb,
-                                          clamp(((average_luma * cb_luma_mult +
-                                                  cb_mult * cb[i * chroma_stride + j]) >>
-                                                 6) +
-                                                    cb_offset,
-                                                0,
-                                                (256 << (bit_depth - 8)) - 1),
-                                          bit_depth) *
-                                    cb_grain[i * chroma_grain_stride + j] +
-                                rounding_offset) >>
-                               params->scaling_shift),
-                          min_chroma,
-                          max_chroma);
-            }
-            if (apply_cr) {
-                cr[i * chroma_stride + j] =
-                    clamp(cr[i * chroma_stride + j] +
-                              ((scale_lut(scaling_lut_cr,
-                                          clamp(((average_luma * cr_luma_mult +
-                                                  cr_mult * cr[i * chroma_stride + j]) >>
-                                                 6) +
-                                                    cr_offset,
-                                                0,
-                                                (256 << (bit_depth - 8)) - 1),
-                                          bit_depth) *
-                                    cr_grain[i * chroma_grain_stride + j] +
-                                rounding_offset) >>
-                               params->scaling_shift),
-                          min_chroma,
-                          max_chroma);
-            }
-        }
+    // The chroma noise depends on the luma samples without noise
+    if (apply_cb) {
+        eb_av1_add_chroma_noise_hbd(cb,
+                                    chroma_stride,
+                                    luma,
+                                    luma_stride,
+                                    cb_grain,
+                                    chroma_grain_stride,
+                                    fg->scaling_lut_cb,
+                                    half_luma_width << (1 - chroma_subsamp_x),
+                                    half_luma_height << (1 - chroma_subsamp_y),
+                                    cb_luma_mult,
+                                    cb_mult,
+                                    cb_offset,
+                                    params->scaling_shift,
+                                    min_chroma,
+                                    max_chroma,
+                                    chroma_subsamp_y,
+                                    chroma_subsamp_x,
+                                    bit_depth);
+    }
+
+    if (apply_cr) {
+        eb_av1_add_chroma_noise_hbd(cr,
+                                    chroma_stride,
+                                    luma,
+                                    luma_stride,
+                                    cr_grain,
+                                    chroma_grain_stride,
+                                    fg->scaling_lut_cr,
+                                    half_luma_width << (1 - chroma_subsamp_x),
+                                    half_luma_height << (1 - chroma_subsamp_y),
+                                    cr_luma_mult,
+                                    cr_mult,
+                                    cr_offset,
+                                    params->scaling_shift,
+                                    min_chroma,
+                                    max_chroma,
+                                    chroma_subsamp_y,
+                                    chroma_subsamp_x,
+                                    bit_depth);
     }
 
     if (apply_y) {
-        for (int32_t i = 0; i < (half_luma_height << 1); i++) {
-            for (int32_t j = 0; j < (half_luma_width << 1); j++) {
-                luma[i * luma_stride + j] =
-                    clamp(luma[i * luma_stride + j] +
-                              ((scale_lut(scaling_lut_y, luma[i * luma_stride + j], bit_depth) *
-                                    luma_grain[i * luma_grain_stride + j] +
-                                rounding_offset) >>
-                               params->scaling_shift),
-                          min_luma,
-                          max_luma);
-            }
-        }
+        eb_av1_add_luma_noise_hbd(luma,
+                                  luma_stride,
+                                  luma_grain,
+                                  luma_grain_stride,
+                                  fg->scaling_lut_y,
+                                  half_luma_width << 1,
+                                  half_luma_height << 1,
+                                  params->scaling_shift,
+                                  min_luma,
+                                  max_luma,
+                                  bit_depth);
     }
 }
 
@@ -863,7 +924,8 @@ static void copy_area(int32_t *src, int32_t src_stride, int32_t *dst, int32_t ds
 
 static void ver_boundary_overlap(int32_t *left_block, int32_t left_stride, int32_t *right_block,
                                  int32_t right_stride, int32_t *dst_block, int32_t dst_stride,
-                                 int32_t width, int32_t height) {
+                                 int32_t width, int32_t height, int32_t grain_min,
+                                 int32_t grain_max) {
     if (width == 1) {
         while (height) {
             *dst_block =
@@ -891,7 +953,8 @@ static void ver_boundary_overlap(int32_t *left_block, int32_t left_stride, int32
 
 static void hor_boundary_overlap(int32_t *top_block, int32_t top_stride, int32_t *bottom_block,
                                  int32_t bottom_stride, int32_t *dst_block, int32_t dst_stride,
-                                 int32_t width, int32_t height) {
+                                 int32_t width, int32_t height, int32_t grain_min,
+                                 int32_t grain_max) {
     if (height == 1) {
         while (width) {
             *dst_block =
@@ -919,476 +982,531 @@ static void hor_boundary_overlap(int32_t *top_block, int32_t top_stride, int32_t
     }
 }
 
-void eb_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb, uint8_t *cr,
-                               int32_t height, int32_t width, int32_t luma_stride,
-                               int32_t chroma_stride, int32_t use_high_bit_depth,
-                               int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
+void eb_av1_film_grain_frame_init(FilmGrainFrame *fg, const AomFilmGrain *params, uint8_t *luma,
+                                  uint8_t *cb, uint8_t *cr, int32_t height, int32_t width,
+                                  int32_t luma_stride, int32_t chroma_stride,
+                                  int32_t use_high_bit_depth, int32_t chroma_subsamp_y,
+                                  int32_t chroma_subsamp_x) {
     int32_t **pred_pos_luma;
     int32_t **pred_pos_chroma;
-    int32_t * luma_grain_block;
-    int32_t * cb_grain_block;
-    int32_t * cr_grain_block;
-
-    int32_t *y_line_buf;
-    int32_t *cb_line_buf;
-    int32_t *cr_line_buf;
 
-    int32_t *y_col_buf;
-    int32_t *cb_col_buf;
-    int32_t *cr_col_buf;
-
-    random_register = params->random_seed;
-
-    int32_t left_pad   = 3;
-    int32_t right_pad  = 3; // padding to offset for AR coefficients
-    int32_t top_pad    = 3;
-    int32_t bottom_pad = 0;
-
-    int32_t ar_padding = 3; // maximum lag used for stabilization of AR coefficients
-
-    luma_subblock_size_y = 32;
-    luma_subblock_size_x = 32;
-
-    chroma_subblock_size_y = luma_subblock_size_y >> chroma_subsamp_y;
-    chroma_subblock_size_x = luma_subblock_size_x >> chroma_subsamp_x;
+    memset(fg, 0, sizeof(*fg));
+    fg->params             = *params;
+    fg->luma               = luma;
+    fg->cb                 = cb;
+    fg->cr                 = cr;
+    fg->height             = height;
+    fg->width              = width;
+    fg->luma_stride        = luma_stride;
+    fg->chroma_stride      = chroma_stride;
+    fg->use_high_bit_depth = use_high_bit_depth;
+    fg->chroma_subsamp_y   = chroma_subsamp_y;
+    fg->chroma_subsamp_x   = chroma_subsamp_x;
+    fg->num_stripes        = (height / 2 + (luma_subblock_size_y >> 1) - 1) /
+                      (luma_subblock_size_y >> 1);
+
+    int32_t chroma_subblock_size_y = luma_subblock_size_y >> chroma_subsamp_y;
+    int32_t chroma_subblock_size_x = luma_subblock_size_x >> chroma_subsamp_x;
 
     // Initial padding is only needed for generation of
     // film grain templates (to stabilize the AR process)
     // Only a 64x64 luma and 32x32 chroma part of a template
     // is used later for adding grain, padding can be discarded
 
-    int32_t luma_block_size_y = top_pad + 2 * ar_padding + luma_subblock_size_y * 2 + bottom_pad;
-    int32_t luma_block_size_x =
-        left_pad + 2 * ar_padding + luma_subblock_size_x * 2 + 2 * ar_padding + right_pad;
+    int32_t luma_block_size_y =
+        FG_TOP_PAD + 2 * FG_AR_PADDING + luma_subblock_size_y * 2 + FG_BOTTOM_PAD;
+    int32_t luma_block_size_x = FG_LEFT_PAD + 2 * FG_AR_PADDING + luma_subblock_size_x * 2 +
+                                2 * FG_AR_PADDING + FG_RIGHT_PAD;
 
-    int32_t chroma_block_size_y =
-        top_pad + (2 >> chroma_subsamp_y) * ar_padding + chroma_subblock_size_y * 2 + bottom_pad;
-    int32_t chroma_block_size_x = left_pad + (2 >> chroma_subsamp_x) * ar_padding +
+    int32_t chroma_block_size_y = FG_TOP_PAD + (2 >> chroma_subsamp_y) * FG_AR_PADDING +
+                                  chroma_subblock_size_y * 2 + FG_BOTTOM_PAD;
+    int32_t chroma_block_size_x = FG_LEFT_PAD + (2 >> chroma_subsamp_x) * FG_AR_PADDING +
                                   chroma_subblock_size_x * 2 +
-                                  (2 >> chroma_subsamp_x) * ar_padding + right_pad;
-
-    int32_t luma_grain_stride   = luma_block_size_x;
-    int32_t chroma_grain_stride = chroma_block_size_x;
+                                  (2 >> chroma_subsamp_x) * FG_AR_PADDING + FG_RIGHT_PAD;
 
-    int32_t overlap   = params->overlap_flag;
-    int32_t bit_depth = params->bit_depth;
+    fg->luma_grain_stride   = luma_block_size_x;
+    fg->chroma_grain_stride = chroma_block_size_x;
 
-    grain_center = 128 << (bit_depth - 8);
-    grain_min    = 0 - grain_center;
-    grain_max    = (256 << (bit_depth - 8)) - 1 - grain_center;
+    int32_t bit_depth    = params->bit_depth;
+    int32_t grain_center = 128 << (bit_depth - 8);
+    fg->grain_min        = 0 - grain_center;
+    fg->grain_max        = (256 << (bit_depth - 8)) - 1 - grain_center;
 
-    init_arrays(params,
-                luma_stride,
-                chroma_stride,
+    init_arrays(&fg->params,
                 &pred_pos_luma,
                 &pred_pos_chroma,
-                &luma_grain_block,
-                &cb_grain_block,
-                &cr_grain_block,
-                &y_line_buf,
-                &cb_line_buf,
-                &cr_line_buf,
-                &y_col_buf,
-                &cb_col_buf,
-                &cr_col_buf,
+                &fg->luma_grain_block,
+                &fg->cb_grain_block,
+                &fg->cr_grain_block,
                 luma_block_size_y * luma_block_size_x,
-                chroma_block_size_y * chroma_block_size_x,
-                chroma_subsamp_y,
-                chroma_subsamp_x);
+                chroma_block_size_y * chroma_block_size_x);
 
-    generate_luma_grain_block(params,
+    generate_luma_grain_block(&fg->params,
                               pred_pos_luma,
-                              luma_grain_block,
+                              fg->luma_grain_block,
                               luma_block_size_y,
                               luma_block_size_x,
-                              luma_grain_stride,
-                              left_pad,
-                              top_pad,
-                              right_pad,
-                              bottom_pad);
-
-    generate_chroma_grain_blocks(params,
+                              fg->luma_grain_stride,
+                              FG_LEFT_PAD,
+                              FG_TOP_PAD,
+                              FG_RIGHT_PAD,
+                              FG_BOTTOM_PAD,
+                              fg->grain_min,
+                              fg->grain_max);
+
+    generate_chroma_grain_blocks(&fg->params,
                                  //                               pred_pos_luma,
                                  pred_pos_chroma,
-                                 luma_grain_block,
-                                 cb_grain_block,
-                                 cr_grain_block,
-                                 luma_grain_stride,
+                                 fg->luma_grain_block,
+                                 fg->cb_grain_block,
+                                 fg->cr_grain_block,
+                                 fg->luma_grain_stride,
                                  chroma_block_size_y,
                                  chroma_block_size_x,
-                                 chroma_grain_stride,
-                                 left_pad,
-                                 top_pad,
-                                 right_pad,
-                                 bottom_pad,
+                                 fg->chroma_grain_stride,
+                                 FG_LEFT_PAD,
+                                 FG_TOP_PAD,
+                                 FG_RIGHT_PAD,
+                                 FG_BOTTOM_PAD,
                                  chroma_subsamp_y,
-                                 chroma_subsamp_x);
+                                 chroma_subsamp_x,
+                                 fg->grain_min,
+                                 fg->grain_max);
 
-    init_scaling_function(params->scaling_points_y, params->num_y_points, scaling_lut_y);
+    dealloc_arrays(&fg->params, &pred_pos_luma, &pred_pos_chroma);
 
-    if (params->chroma_scaling_from_luma) {
-        memcpy(scaling_lut_cb, scaling_lut_y, sizeof(*scaling_lut_y) * 256);
-        memcpy(scaling_lut_cr, scaling_lut_y, sizeof(*scaling_lut_y) * 256);
+    init_scaling_function(fg->params.scaling_points_y, fg->params.num_y_points, fg->scaling_lut_y);
+
+    if (fg->params.chroma_scaling_from_luma) {
+        memcpy(fg->scaling_lut_cb, fg->scaling_lut_y, sizeof(fg->scaling_lut_y));
+        memcpy(fg->scaling_lut_cr, fg->scaling_lut_y, sizeof(fg->scaling_lut_y));
     } else {
-        init_scaling_function(params->scaling_points_cb, params->num_cb_points, scaling_lut_cb);
-        init_scaling_function(params->scaling_points_cr, params->num_cr_points, scaling_lut_cr);
+        init_scaling_function(
+            fg->params.scaling_points_cb, fg->params.num_cb_points, fg->scaling_lut_cb);
+        init_scaling_function(
+            fg->params.scaling_points_cr, fg->params.num_cr_points, fg->scaling_lut_cr);
     }
-    for (int32_t y = 0; y < height / 2; y += (luma_subblock_size_y >> 1)) {
-        init_random_generator(y * 2, params->random_seed);
-
-        for (int32_t x = 0; x < width / 2; x += (luma_subblock_size_x >> 1)) {
-            int32_t offset_y = get_random_number(8);
-            int32_t offset_x = (offset_y >> 4) & 15;
-            offset_y &= 15;
-
-            int32_t luma_offset_y = left_pad + 2 * ar_padding + (offset_y << 1);
-            int32_t luma_offset_x = top_pad + 2 * ar_padding + (offset_x << 1);
-
-            int32_t chroma_offset_y =
-                top_pad + (2 >> chroma_subsamp_y) * ar_padding + offset_y * (2 >> chroma_subsamp_y);
-            int32_t chroma_offset_x = left_pad + (2 >> chroma_subsamp_x) * ar_padding +
-                                      offset_x * (2 >> chroma_subsamp_x);
-
-            if (overlap && x) {
-                ver_boundary_overlap(
-                    y_col_buf,
-                    2,
-                    luma_grain_block + luma_offset_y * luma_grain_stride + luma_offset_x,
-                    luma_grain_stride,
-                    y_col_buf,
-                    2,
-                    2,
-                    AOMMIN(luma_subblock_size_y + 2, height - (y << 1)));
-
-                ver_boundary_overlap(
-                    cb_col_buf,
-                    2 >> chroma_subsamp_x,
-                    cb_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x,
-                    chroma_grain_stride,
-                    cb_col_buf,
-                    2 >> chroma_subsamp_x,
-                    2 >> chroma_subsamp_x,
-                    AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
-                           (height - (y << 1)) >> chroma_subsamp_y));
-
-                ver_boundary_overlap(
-                    cr_col_buf,
-                    2 >> chroma_subsamp_x,
-                    cr_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x,
-                    chroma_grain_stride,
-                    cr_col_buf,
-                    2 >> chroma_subsamp_x,
-                    2 >> chroma_subsamp_x,
-                    AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
-                           (height - (y << 1)) >> chroma_subsamp_y));
-
-                int32_t i = y ? 1 : 0;
-
-                if (use_high_bit_depth) {
-                    add_noise_to_block_hbd(
-                        params,
-                        (uint16_t *)luma + ((y + i) << 1) * luma_stride + (x << 1),
-                        (uint16_t *)cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                            (x << (1 - chroma_subsamp_x)),
-                        (uint16_t *)cr + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                            (x << (1 - chroma_subsamp_x)),
-                        luma_stride,
-                        chroma_stride,
-                        y_col_buf + i * 4,
-                        cb_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-                        cr_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-                        2,
-                        (2 - chroma_subsamp_x),
-                        AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
-                        1,
-                        bit_depth,
-                        chroma_subsamp_y,
-                        chroma_subsamp_x);
-                } else {
-                    add_noise_to_block(
-                        params,
-                        luma + ((y + i) << 1) * luma_stride + (x << 1),
-                        cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                            (x << (1 - chroma_subsamp_x)),
-                        cr + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                            (x << (1 - chroma_subsamp_x)),
-                        luma_stride,
-                        chroma_stride,
-                        y_col_buf + i * 4,
-                        cb_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-                        cr_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
-                        2,
-                        (2 - chroma_subsamp_x),
-                        AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
-                        1,
-                        bit_depth,
-                        chroma_subsamp_y,
-                        chroma_subsamp_x);
-                }
-            }
+    // The extra entry lets the interpolation read index + 1 without a branch
+    fg->scaling_lut_y[256]  = fg->scaling_lut_y[255];
+    fg->scaling_lut_cb[256] = fg->scaling_lut_cb[255];
+    fg->scaling_lut_cr[256] = fg->scaling_lut_cr[255];
+}
 
-            if (overlap && y) {
-                if (x) {
-                    ASSERT(y_col_buf != NULL);
-                    hor_boundary_overlap(y_line_buf + (x << 1),
-                                         luma_stride,
-                                         y_col_buf,
-                                         2,
-                                         y_line_buf + (x << 1),
-                                         luma_stride,
-                                         2,
-                                         2);
-
-                    hor_boundary_overlap(cb_line_buf + x * (2 >> chroma_subsamp_x),
-                                         chroma_stride,
-                                         cb_col_buf,
-                                         2 >> chroma_subsamp_x,
-                                         cb_line_buf + x * (2 >> chroma_subsamp_x),
-                                         chroma_stride,
-                                         2 >> chroma_subsamp_x,
-                                         2 >> chroma_subsamp_y);
-
-                    hor_boundary_overlap(cr_line_buf + x * (2 >> chroma_subsamp_x),
-                                         chroma_stride,
-                                         cr_col_buf,
-                                         2 >> chroma_subsamp_x,
-                                         cr_line_buf + x * (2 >> chroma_subsamp_x),
-                                         chroma_stride,
-                                         2 >> chroma_subsamp_x,
-                                         2 >> chroma_subsamp_y);
-                }
+void eb_av1_film_grain_frame_free(FilmGrainFrame *fg) {
+    free(fg->luma_grain_block);
+    free(fg->cb_grain_block);
+    free(fg->cr_grain_block);
+    fg->luma_grain_block = NULL;
+    fg->cb_grain_block   = NULL;
+    fg->cr_grain_block   = NULL;
+}
 
-                hor_boundary_overlap(y_line_buf + ((x ? x + 1 : 0) << 1),
-                                     luma_stride,
-                                     luma_grain_block + luma_offset_y * luma_grain_stride +
-                                         luma_offset_x + (x ? 2 : 0),
-                                     luma_grain_stride,
-                                     y_line_buf + ((x ? x + 1 : 0) << 1),
-                                     luma_stride,
-                                     AOMMIN(luma_subblock_size_x - ((x ? 1 : 0) << 1),
-                                            width - ((x ? x + 1 : 0) << 1)),
-                                     2);
-
-                hor_boundary_overlap(
-                    cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_stride,
-                    cb_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
-                        ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_grain_stride,
-                    cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_stride,
-                    AOMMIN(chroma_subblock_size_x - ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
-                           (width - ((x ? x + 1 : 0) << 1)) >> chroma_subsamp_x),
-                    2 >> chroma_subsamp_y);
-
-                hor_boundary_overlap(
-                    cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_stride,
-                    cr_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
-                        ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_grain_stride,
-                    cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                    chroma_stride,
-                    AOMMIN(chroma_subblock_size_x - ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
-                           (width - ((x ? x + 1 : 0) << 1)) >> chroma_subsamp_x),
-                    2 >> chroma_subsamp_y);
-
-                if (use_high_bit_depth) {
-                    add_noise_to_block_hbd(
-                        params,
-                        (uint16_t *)luma + (y << 1) * luma_stride + (x << 1),
-                        (uint16_t *)cb + (y << (1 - chroma_subsamp_y)) * chroma_stride +
-                            (x << ((1 - chroma_subsamp_x))),
-                        (uint16_t *)cr + (y << (1 - chroma_subsamp_y)) * chroma_stride +
-                            (x << ((1 - chroma_subsamp_x))),
-                        luma_stride,
-                        chroma_stride,
-                        y_line_buf + (x << 1),
-                        cb_line_buf + (x << (1 - chroma_subsamp_x)),
-                        cr_line_buf + (x << (1 - chroma_subsamp_x)),
-                        luma_stride,
-                        chroma_stride,
-                        1,
-                        AOMMIN(luma_subblock_size_x >> 1, width / 2 - x),
-                        bit_depth,
-                        chroma_subsamp_y,
-                        chroma_subsamp_x);
-                } else {
-                    add_noise_to_block(params,
-                                       luma + (y << 1) * luma_stride + (x << 1),
-                                       cb + (y << (1 - chroma_subsamp_y)) * chroma_stride +
-                                           (x << ((1 - chroma_subsamp_x))),
-                                       cr + (y << (1 - chroma_subsamp_y)) * chroma_stride +
-                                           (x << ((1 - chroma_subsamp_x))),
-                                       luma_stride,
-                                       chroma_stride,
-                                       y_line_buf + (x << 1),
-                                       cb_line_buf + (x << (1 - chroma_subsamp_x)),
-                                       cr_line_buf + (x << (1 - chroma_subsamp_x)),
-                                       luma_stride,
-                                       chroma_stride,
-                                       1,
-                                       AOMMIN(luma_subblock_size_x >> 1, width / 2 - x),
-                                       bit_depth,
-                                       chroma_subsamp_y,
-                                       chroma_subsamp_x);
-                }
-            }
+/* Grain kept between the blocks of a stripe and between stripes for the overlap */
+typedef struct FilmGrainOverlapBufs {
+    int32_t *y_line_buf;
+    int32_t *cb_line_buf;
+    int32_t *cr_line_buf;
 
-            int32_t i = overlap && y ? 1 : 0;
-            int32_t j = overlap && x ? 1 : 0;
+    int32_t *y_col_buf;
+    int32_t *cb_col_buf;
+    int32_t *cr_col_buf;
+} FilmGrainOverlapBufs;
+
+static void add_noise_at(const FilmGrainFrame *fg, int32_t half_y, int32_t half_x,
+                         int32_t *luma_grain, int32_t *cb_grain, int32_t *cr_grain,
+                         int32_t luma_grain_stride, int32_t chroma_grain_stride,
+                         int32_t half_luma_height, int32_t half_luma_width) {
+    const int32_t chroma_subsamp_y = fg->chroma_subsamp_y;
+    const int32_t chroma_subsamp_x = fg->chroma_subsamp_x;
+    const int32_t luma_offset      = (half_y << 1) * fg->luma_stride + (half_x << 1);
+    const int32_t chroma_offset    = (half_y << (1 - chroma_subsamp_y)) * fg->chroma_stride +
+                                  (half_x << (1 - chroma_subsamp_x));
+
+    if (fg->use_high_bit_depth) {
+        add_noise_to_block_hbd(fg,
+                               (uint16_t *)fg->luma + luma_offset,
+                               (uint16_t *)fg->cb + chroma_offset,
+                               (uint16_t *)fg->cr + chroma_offset,
+                               fg->luma_stride,
+                               fg->chroma_stride,
+                               luma_grain,
+                               cb_grain,
+                               cr_grain,
+                               luma_grain_stride,
+                               chroma_grain_stride,
+                               half_luma_height,
+                               half_luma_width,
+                               fg->params.bit_depth,
+                               chroma_subsamp_y,
+                               chroma_subsamp_x);
+    } else {
+        add_noise_to_block(fg,
+                           fg->luma + luma_offset,
+                           fg->cb + chroma_offset,
+                           fg->cr + chroma_offset,
+                           fg->luma_stride,
+                           fg->chroma_stride,
+                           luma_grain,
+                           cb_grain,
+                           cr_grain,
+                           luma_grain_stride,
+                           chroma_grain_stride,
+                           half_luma_height,
+                           half_luma_width,
+                           chroma_subsamp_y,
+                           chroma_subsamp_x);
+    }
+}
 
-            if (use_high_bit_depth) {
-                add_noise_to_block_hbd(
-                    params,
-                    (uint16_t *)luma + ((y + i) << 1) * luma_stride + ((x + j) << 1),
-                    (uint16_t *)cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                        ((x + j) << (1 - chroma_subsamp_x)),
-                    (uint16_t *)cr + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                        ((x + j) << (1 - chroma_subsamp_x)),
-                    luma_stride,
-                    chroma_stride,
-                    luma_grain_block + (luma_offset_y + (i << 1)) * luma_grain_stride +
-                        luma_offset_x + (j << 1),
-                    cb_grain_block +
-                        (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
-                        chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-                    cr_grain_block +
-                        (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
-                        chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-                    luma_grain_stride,
-                    chroma_grain_stride,
-                    AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
-                    AOMMIN(luma_subblock_size_x >> 1, width / 2 - x) - j,
-                    bit_depth,
-                    chroma_subsamp_y,
-                    chroma_subsamp_x);
-            } else {
-                add_noise_to_block(
-                    params,
-                    luma + ((y + i) << 1) * luma_stride + ((x + j) << 1),
-                    cb + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                        ((x + j) << (1 - chroma_subsamp_x)),
-                    cr + ((y + i) << (1 - chroma_subsamp_y)) * chroma_stride +
-                        ((x + j) << (1 - chroma_subsamp_x)),
-                    luma_stride,
-                    chroma_stride,
-                    luma_grain_block + (luma_offset_y + (i << 1)) * luma_grain_stride +
-                        luma_offset_x + (j << 1),
-                    cb_grain_block +
-                        (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
-                        chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-                    cr_grain_block +
-                        (chroma_offset_y + (i << (1 - chroma_subsamp_y))) * chroma_grain_stride +
-                        chroma_offset_x + (j << (1 - chroma_subsamp_x)),
-                    luma_grain_stride,
-                    chroma_grain_stride,
-                    AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
-                    AOMMIN(luma_subblock_size_x >> 1, width / 2 - x) - j,
-                    bit_depth,
-                    chroma_subsamp_y,
-                    chroma_subsamp_x);
+/* Adds the grain to the 32 luma rows of a stripe. With grain_only set the
+ * picture is left untouched and only the overlap buffers are brought to the
+ * state the next stripe expects. */
+static void add_grain_to_stripe(const FilmGrainFrame *fg, FilmGrainOverlapBufs *bufs,
+                                int32_t stripe, int32_t grain_only) {
+    const int32_t chroma_subsamp_y       = fg->chroma_subsamp_y;
+    const int32_t chroma_subsamp_x       = fg->chroma_subsamp_x;
+    const int32_t chroma_subblock_size_y = luma_subblock_size_y >> chroma_subsamp_y;
+    const int32_t chroma_subblock_size_x = luma_subblock_size_x >> chroma_subsamp_x;
+    const int32_t luma_stride            = fg->luma_stride;
+    const int32_t chroma_stride          = fg->chroma_stride;
+    const int32_t luma_grain_stride      = fg->luma_grain_stride;
+    const int32_t chroma_grain_stride    = fg->chroma_grain_stride;
+    const int32_t height                 = fg->height;
+    const int32_t width                  = fg->width;
+    const int32_t overlap                = fg->params.overlap_flag;
+    const int32_t grain_min              = fg->grain_min;
+    const int32_t grain_max              = fg->grain_max;
+
+    int32_t *y_line_buf  = bufs->y_line_buf;
+    int32_t *cb_line_buf = bufs->cb_line_buf;
+    int32_t *cr_line_buf = bufs->cr_line_buf;
+    int32_t *y_col_buf   = bufs->y_col_buf;
+    int32_t *cb_col_buf  = bufs->cb_col_buf;
+    int32_t *cr_col_buf  = bufs->cr_col_buf;
+
+    int32_t  y = stripe * (luma_subblock_size_y >> 1);
+    uint16_t random_register;
+
+    init_random_generator(&random_register, y * 2, fg->params.random_seed);
+
+    for (int32_t x = 0; x < width / 2; x += (luma_subblock_size_x >> 1)) {
+        int32_t offset_y = get_random_number(&random_register, 8);
+        int32_t offset_x = (offset_y >> 4) & 15;
+        offset_y &= 15;
+
+        int32_t luma_offset_y = FG_LEFT_PAD + 2 * FG_AR_PADDING + (offset_y << 1);
+        int32_t luma_offset_x = FG_TOP_PAD + 2 * FG_AR_PADDING + (offset_x << 1);
+
+        int32_t chroma_offset_y = FG_TOP_PAD + (2 >> chroma_subsamp_y) * FG_AR_PADDING +
+                                  offset_y * (2 >> chroma_subsamp_y);
+        int32_t chroma_offset_x = FG_LEFT_PAD + (2 >> chroma_subsamp_x) * FG_AR_PADDING +
+                                  offset_x * (2 >> chroma_subsamp_x);
+
+        int32_t *luma_grain =
+            fg->luma_grain_block + luma_offset_y * luma_grain_stride + luma_offset_x;
+        int32_t *cb_grain =
+            fg->cb_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x;
+        int32_t *cr_grain =
+            fg->cr_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x;
+
+        if (overlap && x) {
+            ver_boundary_overlap(y_col_buf,
+                                 2,
+                                 luma_grain,
+                                 luma_grain_stride,
+                                 y_col_buf,
+                                 2,
+                                 2,
+                                 AOMMIN(luma_subblock_size_y + 2, height - (y << 1)),
+                                 grain_min,
+                                 grain_max);
+
+            ver_boundary_overlap(cb_col_buf,
+                                 2 >> chroma_subsamp_x,
+                                 cb_grain,
+                                 chroma_grain_stride,
+                                 cb_col_buf,
+                                 2 >> chroma_subsamp_x,
+                                 2 >> chroma_subsamp_x,
+                                 AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
+                                        (height - (y << 1)) >> chroma_subsamp_y),
+                                 grain_min,
+                                 grain_max);
+
+            ver_boundary_overlap(cr_col_buf,
+                                 2 >> chroma_subsamp_x,
+                                 cr_grain,
+                                 chroma_grain_stride,
+                                 cr_col_buf,
+                                 2 >> chroma_subsamp_x,
+                                 2 >> chroma_subsamp_x,
+                                 AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
+                                        (height - (y << 1)) >> chroma_subsamp_y),
+                                 grain_min,
+                                 grain_max);
+
+            int32_t i = y ? 1 : 0;
+
+            if (!grain_only) {
+                add_noise_at(fg,
+                             y + i,
+                             x,
+                             y_col_buf + i * 4,
+                             cb_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
+                             cr_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
+                             2,
+                             (2 - chroma_subsamp_x),
+                             AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
+                             1);
             }
+        }
 
-            if (overlap) {
-                if (x) {
-                    // Copy overlapped column bufer to line buffer
-                    copy_area(y_col_buf + (luma_subblock_size_y << 1),
-                              2,
-                              y_line_buf + (x << 1),
-                              luma_stride,
-                              2,
-                              2);
-
-                    copy_area(cb_col_buf + (chroma_subblock_size_y << (1 - chroma_subsamp_x)),
-                              2 >> chroma_subsamp_x,
-                              cb_line_buf + (x << (1 - chroma_subsamp_x)),
-                              chroma_stride,
-                              2 >> chroma_subsamp_x,
-                              2 >> chroma_subsamp_y);
-
-                    copy_area(cr_col_buf + (chroma_subblock_size_y << (1 - chroma_subsamp_x)),
-                              2 >> chroma_subsamp_x,
-                              cr_line_buf + (x << (1 - chroma_subsamp_x)),
-                              chroma_stride,
-                              2 >> chroma_subsamp_x,
-                              2 >> chroma_subsamp_y);
-                }
-
-                // Copy grain to the line buffer for overlap with a bottom block
-                copy_area(luma_grain_block +
-                              (luma_offset_y + luma_subblock_size_y) * luma_grain_stride +
-                              luma_offset_x + ((x ? 2 : 0)),
-                          luma_grain_stride,
-                          y_line_buf + ((x ? x + 1 : 0) << 1),
-                          luma_stride,
-                          AOMMIN(luma_subblock_size_x, width - (x << 1)) - (x ? 2 : 0),
-                          2);
+        if (overlap && y && !grain_only) {
+            if (x) {
+                ASSERT(y_col_buf != NULL);
+                hor_boundary_overlap(y_line_buf + (x << 1),
+                                     luma_stride,
+                                     y_col_buf,
+                                     2,
+                                     y_line_buf + (x << 1),
+                                     luma_stride,
+                                     2,
+                                     2,
+                                     grain_min,
+                                     grain_max);
+
+                hor_boundary_overlap(cb_line_buf + x * (2 >> chroma_subsamp_x),
+                                     chroma_stride,
+                                     cb_col_buf,
+                                     2 >> chroma_subsamp_x,
+                                     cb_line_buf + x * (2 >> chroma_subsamp_x),
+                                     chroma_stride,
+                                     2 >> chroma_subsamp_x,
+                                     2 >> chroma_subsamp_y,
+                                     grain_min,
+                                     grain_max);
+
+                hor_boundary_overlap(cr_line_buf + x * (2 >> chroma_subsamp_x),
+                                     chroma_stride,
+                                     cr_col_buf,
+                                     2 >> chroma_subsamp_x,
+                                     cr_line_buf + x * (2 >> chroma_subsamp_x),
+                                     chroma_stride,
+                                     2 >> chroma_subsamp_x,
+                                     2 >> chroma_subsamp_y,
+                                     grain_min,
+                                     grain_max);
+            }
 
-                copy_area(cb_grain_block +
-                              (chroma_offset_y + chroma_subblock_size_y) * chroma_grain_stride +
-                              chroma_offset_x + (x ? 2 >> chroma_subsamp_x : 0),
-                          chroma_grain_stride,
-                          cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                          chroma_stride,
-                          AOMMIN(chroma_subblock_size_x, ((width - (x << 1)) >> chroma_subsamp_x)) -
-                              (x ? 2 >> chroma_subsamp_x : 0),
-                          2 >> chroma_subsamp_y);
+            hor_boundary_overlap(y_line_buf + ((x ? x + 1 : 0) << 1),
+                                 luma_stride,
+                                 luma_grain + (x ? 2 : 0),
+                                 luma_grain_stride,
+                                 y_line_buf + ((x ? x + 1 : 0) << 1),
+                                 luma_stride,
+                                 AOMMIN(luma_subblock_size_x - ((x ? 1 : 0) << 1),
+                                        width - ((x ? x + 1 : 0) << 1)),
+                                 2,
+                                 grain_min,
+                                 grain_max);
+
+            hor_boundary_overlap(
+                cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                chroma_stride,
+                cb_grain + ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
+                chroma_grain_stride,
+                cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                chroma_stride,
+                AOMMIN(chroma_subblock_size_x - ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
+                       (width - ((x ? x + 1 : 0) << 1)) >> chroma_subsamp_x),
+                2 >> chroma_subsamp_y,
+                grain_min,
+                grain_max);
+
+            hor_boundary_overlap(
+                cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                chroma_stride,
+                cr_grain + ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
+                chroma_grain_stride,
+                cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                chroma_stride,
+                AOMMIN(chroma_subblock_size_x - ((x ? 1 : 0) << (1 - chroma_subsamp_x)),
+                       (width - ((x ? x + 1 : 0) << 1)) >> chroma_subsamp_x),
+                2 >> chroma_subsamp_y,
+                grain_min,
+                grain_max);
+
+            add_noise_at(fg,
+                         y,
+                         x,
+                         y_line_buf + (x << 1),
+                         cb_line_buf + (x << (1 - chroma_subsamp_x)),
+                         cr_line_buf + (x << (1 - chroma_subsamp_x)),
+                         luma_stride,
+                         chroma_stride,
+                         1,
+                         AOMMIN(luma_subblock_size_x >> 1, width / 2 - x));
+        }
 
-                copy_area(cr_grain_block +
-                              (chroma_offset_y + chroma_subblock_size_y) * chroma_grain_stride +
-                              chroma_offset_x + (x ? 2 >> chroma_subsamp_x : 0),
-                          chroma_grain_stride,
-                          cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
-                          chroma_stride,
-                          AOMMIN(chroma_subblock_size_x, ((width - (x << 1)) >> chroma_subsamp_x)) -
-                              (x ? 2 >> chroma_subsamp_x : 0),
-                          2 >> chroma_subsamp_y);
+        if (!grain_only) {
+            int32_t i = overlap && y ? 1 : 0;
+            int32_t j = overlap && x ? 1 : 0;
 
-                // Copy grain to the column buffer for overlap with the next block to
-                // the right
+            add_noise_at(fg,
+                         y + i,
+                         x + j,
+                         luma_grain + (i << 1) * luma_grain_stride + (j << 1),
+                         cb_grain + (i << (1 - chroma_subsamp_y)) * chroma_grain_stride +
+                             (j << (1 - chroma_subsamp_x)),
+                         cr_grain + (i << (1 - chroma_subsamp_y)) * chroma_grain_stride +
+                             (j << (1 - chroma_subsamp_x)),
+                         luma_grain_stride,
+                         chroma_grain_stride,
+                         AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
+                         AOMMIN(luma_subblock_size_x >> 1, width / 2 - x) - j);
+        }
 
-                copy_area(luma_grain_block + luma_offset_y * luma_grain_stride + luma_offset_x +
-                              luma_subblock_size_x,
-                          luma_grain_stride,
-                          y_col_buf,
+        if (overlap) {
+            if (x) {
+                // Copy overlapped column bufer to line buffer
+                copy_area(y_col_buf + (luma_subblock_size_y << 1),
                           2,
+                          y_line_buf + (x << 1),
+                          luma_stride,
                           2,
-                          AOMMIN(luma_subblock_size_y + 2, height - (y << 1)));
+                          2);
 
-                copy_area(cb_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
-                              chroma_subblock_size_x,
-                          chroma_grain_stride,
-                          cb_col_buf,
+                copy_area(cb_col_buf + (chroma_subblock_size_y << (1 - chroma_subsamp_x)),
                           2 >> chroma_subsamp_x,
+                          cb_line_buf + (x << (1 - chroma_subsamp_x)),
+                          chroma_stride,
                           2 >> chroma_subsamp_x,
-                          AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
-                                 (height - (y << 1)) >> chroma_subsamp_y));
+                          2 >> chroma_subsamp_y);
 
-                copy_area(cr_grain_block + chroma_offset_y * chroma_grain_stride + chroma_offset_x +
-                              chroma_subblock_size_x,
-                          chroma_grain_stride,
-                          cr_col_buf,
+                copy_area(cr_col_buf + (chroma_subblock_size_y << (1 - chroma_subsamp_x)),
                           2 >> chroma_subsamp_x,
+                          cr_line_buf + (x << (1 - chroma_subsamp_x)),
+                          chroma_stride,
                           2 >> chroma_subsamp_x,
-                          AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
-                                 (height - (y << 1)) >> chroma_subsamp_y));
+                          2 >> chroma_subsamp_y);
             }
+
+            // Copy grain to the line buffer for overlap with a bottom block
+            copy_area(luma_grain + luma_subblock_size_y * luma_grain_stride + ((x ? 2 : 0)),
+                      luma_grain_stride,
+                      y_line_buf + ((x ? x + 1 : 0) << 1),
+                      luma_stride,
+                      AOMMIN(luma_subblock_size_x, width - (x << 1)) - (x ? 2 : 0),
+                      2);
+
+            copy_area(cb_grain + chroma_subblock_size_y * chroma_grain_stride +
+                          (x ? 2 >> chroma_subsamp_x : 0),
+                      chroma_grain_stride,
+                      cb_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                      chroma_stride,
+                      AOMMIN(chroma_subblock_size_x, ((width - (x << 1)) >> chroma_subsamp_x)) -
+                          (x ? 2 >> chroma_subsamp_x : 0),
+                      2 >> chroma_subsamp_y);
+
+            copy_area(cr_grain + chroma_subblock_size_y * chroma_grain_stride +
+                          (x ? 2 >> chroma_subsamp_x : 0),
+                      chroma_grain_stride,
+                      cr_line_buf + ((x ? x + 1 : 0) << (1 - chroma_subsamp_x)),
+                      chroma_stride,
+                      AOMMIN(chroma_subblock_size_x, ((width - (x << 1)) >> chroma_subsamp_x)) -
+                          (x ? 2 >> chroma_subsamp_x : 0),
+                      2 >> chroma_subsamp_y);
+
+            // Copy grain to the column buffer for overlap with the next block to
+            // the right
+
+            copy_area(luma_grain + luma_subblock_size_x,
+                      luma_grain_stride,
+                      y_col_buf,
+                      2,
+                      2,
+                      AOMMIN(luma_subblock_size_y + 2, height - (y << 1)));
+
+            copy_area(cb_grain + chroma_subblock_size_x,
+                      chroma_grain_stride,
+                      cb_col_buf,
+                      2 >> chroma_subsamp_x,
+                      2 >> chroma_subsamp_x,
+                      AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
+                             (height - (y << 1)) >> chroma_subsamp_y));
+
+            copy_area(cr_grain + chroma_subblock_size_x,
+                      chroma_grain_stride,
+                      cr_col_buf,
+                      2 >> chroma_subsamp_x,
+                      2 >> chroma_subsamp_x,
+                      AOMMIN(chroma_subblock_size_y + (2 >> chroma_subsamp_y),
+                             (height - (y << 1)) >> chroma_subsamp_y));
         }
     }
+}
 
-    dealloc_arrays(params,
-                   &pred_pos_luma,
-                   &pred_pos_chroma,
-                   &luma_grain_block,
-                   &cb_grain_block,
-                   &cr_grain_block,
-                   &y_line_buf,
-                   &cb_line_buf,
-                   &cr_line_buf,
-                   &y_col_buf,
-                   &cb_col_buf,
-                   &cr_col_buf);
+void eb_av1_add_film_grain_stripes(const FilmGrainFrame *fg, int32_t first_stripe,
+                                   int32_t num_stripes) {
+    const int32_t chroma_subsamp_y       = fg->chroma_subsamp_y;
+    const int32_t chroma_subsamp_x       = fg->chroma_subsamp_x;
+    const int32_t chroma_subblock_size_y = luma_subblock_size_y >> chroma_subsamp_y;
+    FilmGrainOverlapBufs bufs;
+
+    bufs.y_line_buf = (int32_t *)malloc(sizeof(*bufs.y_line_buf) * fg->luma_stride * 2);
+    bufs.cb_line_buf =
+        (int32_t *)malloc(sizeof(*bufs.cb_line_buf) * fg->chroma_stride * (2 >> chroma_subsamp_y));
+    bufs.cr_line_buf =
+        (int32_t *)malloc(sizeof(*bufs.cr_line_buf) * fg->chroma_stride * (2 >> chroma_subsamp_y));
+
+    bufs.y_col_buf = (int32_t *)malloc(sizeof(*bufs.y_col_buf) * (luma_subblock_size_y + 2) * 2);
+    bufs.cb_col_buf =
+        (int32_t *)malloc(sizeof(*bufs.cb_col_buf) *
+                          (chroma_subblock_size_y + (2 >> chroma_subsamp_y)) *
+                          (2 >> chroma_subsamp_x));
+    bufs.cr_col_buf =
+        (int32_t *)malloc(sizeof(*bufs.cr_col_buf) *
+                          (chroma_subblock_size_y + (2 >> chroma_subsamp_y)) *
+                          (2 >> chroma_subsamp_x));
+
+    num_stripes = AOMMIN(num_stripes, fg->num_stripes - first_stripe);
+
+    // The overlap with the stripe above needs the grain its blocks left in the
+    // line buffers, generating it again is cheap compared to adding the noise
+    if (fg->params.overlap_flag && first_stripe > 0 && num_stripes > 0)
+        add_grain_to_stripe(fg, &bufs, first_stripe - 1, 1);
+
+    for (int32_t stripe = first_stripe; stripe < first_stripe + num_stripes; stripe++)
+        add_grain_to_stripe(fg, &bufs, stripe, 0);
+
+    free(bufs.y_line_buf);
+    free(bufs.cb_line_buf);
+    free(bufs.cr_line_buf);
+    free(bufs.y_col_buf);
+    free(bufs.cb_col_buf);
+    free(bufs.cr_col_buf);
+}
+
+void eb_av1_add_film_grain_run(AomFilmGrain *params, uint8_t *luma, uint8_t *cb, uint8_t *cr,
+                               int32_t height, int32_t width, int32_t luma_stride,
+                               int32_t chroma_stride, int32_t use_high_bit_depth,
+                               int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
+    FilmGrainFrame fg;
+
+    eb_av1_film_grain_frame_init(&fg,
+                                 params,
+                                 luma,
+                                 cb,
+                                 cr,
+                                 height,
+                                 width,
+                                 luma_stride,
+                                 chroma_stride,
+                                 use_high_bit_depth,
+                                 chroma_subsamp_y,
+                                 chroma_subsamp_x);
+    eb_av1_add_film_grain_stripes(&fg, 0, fg.num_stripes);
+    eb_av1_film_grain_frame_free(&fg);
 }
 
 /*
@@ -84,6 +84,69 @@ typedef struct {
 
 int32_t film_grain_params_equal(AomFilmGrain *pars_a, AomFilmGrain *pars_b);
 
+/*!\brief Film grain state shared by the stripes of a frame
+     *
+     * The grain templates and scaling functions are generated once per frame,
+     * the stripes of 32 luma rows can then be processed in any order and by
+     * different threads.
+     */
+typedef struct FilmGrainFrame {
+    AomFilmGrain params;
+
+    uint8_t *luma;
+    uint8_t *cb;
+    uint8_t *cr;
+    int32_t  height;
+    int32_t  width;
+    int32_t  luma_stride;
+    int32_t  chroma_stride;
+    int32_t  use_high_bit_depth;
+    int32_t  chroma_subsamp_y;
+    int32_t  chroma_subsamp_x;
+
+    int32_t *luma_grain_block;
+    int32_t *cb_grain_block;
+    int32_t *cr_grain_block;
+    int32_t  luma_grain_stride;
+    int32_t  chroma_grain_stride;
+
+    // The last entry repeats entry 255 for the high bit depth interpolation
+    int32_t scaling_lut_y[257];
+    int32_t scaling_lut_cb[257];
+    int32_t scaling_lut_cr[257];
+
+    int32_t grain_min;
+    int32_t grain_max;
+    int32_t num_stripes;
+} FilmGrainFrame;
+
+/*!\brief Generate the grain templates of a frame
+     *
+     * \param[out]   fg               Frame state, released with eb_av1_film_grain_frame_free
+     * \param[in]    grain_params     Grain parameters
+     * \param[in]    luma             luma plane
+     * \param[in]    cb               cb plane
+     * \param[in]    cr               cr plane
+     * \param[in]    height           luma plane height
+     * \param[in]    width            luma plane width
+     * \param[in]    luma_stride      luma plane stride
+     * \param[in]    chroma_stride    chroma plane stride
+     */
+void eb_av1_film_grain_frame_init(FilmGrainFrame *fg, const AomFilmGrain *grain_params,
+                                  uint8_t *luma, uint8_t *cb, uint8_t *cr, int32_t height,
+                                  int32_t width, int32_t luma_stride, int32_t chroma_stride,
+                                  int32_t use_high_bit_depth, int32_t chroma_subsamp_y,
+                                  int32_t chroma_subsamp_x);
+
+/*!\brief Add film grain to the stripes [first_stripe, first_stripe + num_stripes)
+     *
+     * A stripe covers 32 luma rows, fg->num_stripes cover the frame.
+     */
+void eb_av1_add_film_grain_stripes(const FilmGrainFrame *fg, int32_t first_stripe,
+                                   int32_t num_stripes);
+
+void eb_av1_film_grain_frame_free(FilmGrainFrame *fg);
+
 /*!\brief Add film grain
      *
      * Add film grain to an image
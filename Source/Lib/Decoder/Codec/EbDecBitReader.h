@@ -40,6 +40,8 @@ extern "C" {
     aom_read_cdf_(r, cdf, nsymbs ACCT_STR_ARG(ACCT_STR_NAME))
 #define svt_read_symbol(r, cdf, nsymbs, ACCT_STR_NAME) \
     aom_read_symbol_(r, cdf, nsymbs ACCT_STR_ARG(ACCT_STR_NAME))
+#define svt_read_symbol4(r, cdf, ACCT_STR_NAME) \
+    aom_read_symbol4_(r, cdf ACCT_STR_ARG(ACCT_STR_NAME))
 #define svt_read_ns_ae(r, nsymbs, ACCT_STR_NAME) \
     aom_read_ns_ae_(r, nsymbs ACCT_STR_ARG(ACCT_STR_NAME))
 
@@ -90,6 +92,18 @@ static INLINE int aom_read_symbol_(SvtReader *r, AomCdfProb *cdf, int nsymbs ACC
     return ret;
 }
 
+/* aom_read_symbol_() of a 4-symbol CDF */
+static INLINE int aom_read_symbol4_(SvtReader *r, AomCdfProb *cdf ACCT_STR_PARAM) {
+    int ret;
+#if CONFIG_BITSTREAM_DEBUG || ENABLE_ENTROPY_TRACE
+    ret = svt_read_cdf(r, cdf, 4, ACCT_STR_NAME);
+#else
+    ret = od_ec_decode_cdf4_q15(&r->ec, cdf);
+#endif
+    if (r->allow_update_cdf) dec_update_cdf4(cdf, ret);
+    return ret;
+}
+
 static INLINE int aom_read_ns_ae_(SvtReader *r, int nsymbs ACCT_STR_PARAM) {
     int w = get_msb(nsymbs) + 1; //w = FloorLog2(n) + 1
     int m = (1 << w) - nsymbs;
@@ -231,6 +231,54 @@ int od_ec_decode_cdf_q15(OdEcDec *dec, const uint16_t *icdf, int nsyms) {
     return od_ec_dec_normalize(dec, dif, r, ret);
 }
 
+/*The bound of the symbol s of a 4-symbol alphabet, see od_ec_decode_cdf_q15().*/
+static INLINE unsigned od_ec_cdf4_bound(unsigned r, const uint16_t *icdf, int s) {
+    return ((r >> 8) * (uint32_t)(icdf[s] >> EC_PROB_SHIFT) >> (7 - EC_PROB_SHIFT - CDF_SHIFT)) +
+           EC_MIN_PROB * (3 - s);
+}
+
+/*Decodes a symbol of a 4-symbol alphabet, od_ec_decode_cdf_q15() unrolled.
+  These are the coefficient base and range levels, most of the symbols of high
+  rate streams.*/
+int od_ec_decode_cdf4_q15(OdEcDec *dec, const uint16_t *icdf) {
+    OdEcWindow dif = dec->dif;
+    unsigned   r   = dec->rng;
+    unsigned   c;
+    unsigned   u;
+    unsigned   v;
+    int        ret;
+
+    assert(dif >> (OD_EC_WINDOW_SIZE - 16) < r);
+    assert(icdf[3] == OD_ICDF(CDF_PROB_TOP));
+    assert(32768U <= r);
+    c = (unsigned)(dif >> (OD_EC_WINDOW_SIZE - 16));
+    u = r;
+    v = od_ec_cdf4_bound(r, icdf, 0);
+    if (c >= v)
+        ret = 0;
+    else {
+        u = v;
+        v = od_ec_cdf4_bound(r, icdf, 1);
+        if (c >= v)
+            ret = 1;
+        else {
+            u = v;
+            v = od_ec_cdf4_bound(r, icdf, 2);
+            if (c >= v)
+                ret = 2;
+            else {
+                u   = v;
+                v   = 0;
+                ret = 3;
+            }
+        }
+    }
+    assert(v < u);
+    r = u - v;
+    dif -= (OdEcWindow)v << (OD_EC_WINDOW_SIZE - 16);
+    return od_ec_dec_normalize(dec, dif, r, ret);
+}
+
 /********************************************************************************************************************************/
 /********************************************************************************************************************************/
 /********************************************************************************************************************************/
@@ -94,6 +94,20 @@ static INLINE void dec_update_cdf(AomCdfProb *cdf, int8_t val, int nsymbs) {
     cdf[nsymbs] += (cdf[nsymbs] < 32);
 }
 
+/* dec_update_cdf() of a 4-symbol CDF */
+static INLINE void dec_update_cdf4(AomCdfProb *cdf, int8_t val) {
+    const int rate = 5 + (cdf[4] > 15) + (cdf[4] > 31);
+
+    // The symbols below val move toward AOM_ICDF(0), the others toward 0
+    for (int i = 0; i < 3; ++i) {
+        if (i < val)
+            cdf[i] += (AomCdfProb)((AOM_ICDF(0) - cdf[i]) >> rate);
+        else
+            cdf[i] -= (AomCdfProb)(cdf[i] >> rate);
+    }
+    cdf[4] += (cdf[4] < 32);
+}
+
 /********************************************************************************************************************************/
 /********************************************************************************************************************************/
 /********************************************************************************************************************************/
@@ -132,6 +146,7 @@ typedef struct OdEcDec {
 
 int od_ec_decode_bool_q15(OdEcDec *dec, unsigned f);
 int od_ec_decode_cdf_q15(OdEcDec *dec, const uint16_t *cdf, int nsyms);
+int od_ec_decode_cdf4_q15(OdEcDec *dec, const uint16_t *cdf);
 
 /********************************************************************************************************************************/
 /********************************************************************************************************************************/
@@ -21,6 +21,7 @@
 #include "EbDecUtils.h"
 #include "EbDecNbr.h"
 #include "EbUtility.h"
+#include "EbDecCdef.h"
 
 /*Compute's whether 8x8 block is skip or not skip block*/
 static INLINE int32_t dec_is_8x8_block_skip(BlockModeInfo *mbmi) {
@@ -585,459 +586,109 @@ void svt_cdef_sb_row_mt(EbDecHandle *dec_handle, int32_t *mi_wide_l2, int32_t *m
     }
 }
 
-/* Frame level call, for CDEF */
-void svt_cdef_frame(EbDecHandle *dec_handle, int enable_flag) {
-    if (!enable_flag) return;
-
+void svt_cdef_frame_start(EbDecHandle *dec_handle, DecCdefCtxt *ctxt) {
     EbPictureBufferDesc *recon_picture_ptr = dec_handle->cur_pic_buf[0]->ps_pic_buf;
-    int8_t               use_highbd        = dec_handle->seq_header.color_config.bit_depth > 8;
+    FrameHeader *        frame_info        = &dec_handle->frame_header;
+    const int32_t        num_planes        = av1_num_planes(&dec_handle->seq_header.color_config);
+    const int32_t        nhfb = (frame_info->mi_cols + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
 
-    uint8_t *     curr_blk_recon_buf[MAX_MB_PLANE];
-    int32_t       curr_recon_stride[MAX_MB_PLANE];
-    FrameHeader * frame_info = &dec_handle->frame_header;
-    const int32_t num_planes = av1_num_planes(&dec_handle->seq_header.color_config);
+    ctxt->num_planes = num_planes;
+    ctxt->row_cdef = (uint8_t *)eb_aom_malloc(sizeof(*ctxt->row_cdef) * (nhfb + 2) * 2);
+    assert(ctxt->row_cdef != NULL);
+    memset(ctxt->row_cdef, 1, sizeof(*ctxt->row_cdef) * (nhfb + 2) * 2);
+    ctxt->prev_row_cdef = ctxt->row_cdef + 1;
+    ctxt->curr_row_cdef = ctxt->prev_row_cdef + nhfb + 2;
+    ctxt->next_fbr      = 0;
 
-    DECLARE_ALIGNED(16, uint16_t, src[CDEF_INBUF_SIZE]);
-    uint16_t *    linebuf[3];
-    uint16_t *    colbuf[3];
-    CdefList      dlist[MI_SIZE_64X64 * MI_SIZE_64X64];
-    uint8_t *     row_cdef, *prev_row_cdef, *curr_row_cdef;
-    int32_t       cdef_count;
-    int32_t       dir[CDEF_NBLOCKS][CDEF_NBLOCKS] = {{0}};
-    int32_t       var[CDEF_NBLOCKS][CDEF_NBLOCKS] = {{0}};
-    int32_t       mi_wide_l2[3];
-    int32_t       mi_high_l2[3];
-    int32_t       xdec[3];
-    int32_t       ydec[3];
-    int32_t       coeff_shift = AOMMAX(recon_picture_ptr->bit_depth - 8, 0);
-    const int32_t nvfb        = (frame_info->mi_rows + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
-    const int32_t nhfb        = (frame_info->mi_cols + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
-    row_cdef                  = (uint8_t *)eb_aom_malloc(sizeof(*row_cdef) * (nhfb + 2) * 2);
-    assert(row_cdef != NULL);
-    memset(row_cdef, 1, sizeof(*row_cdef) * (nhfb + 2) * 2);
-    prev_row_cdef = row_cdef + 1;
-    curr_row_cdef = prev_row_cdef + nhfb + 2;
-
-    const int32_t stride = (frame_info->mi_cols << MI_SIZE_LOG2) + 2 * CDEF_HBORDER;
-
-    MasterFrameBuf *master_frame_buf = &dec_handle->master_frame_buf;
-    CurFrameBuf *   frame_buf        = &master_frame_buf->cur_frame_bufs[0];
-    const int32_t   cdef_mask        = 1;
+    ctxt->linebuf_stride = (frame_info->mi_cols << MI_SIZE_LOG2) + 2 * CDEF_HBORDER;
 
     for (int32_t pli = 0; pli < num_planes; pli++) {
-        int32_t sub_x   = (pli == 0) ? 0 : dec_handle->seq_header.color_config.subsampling_x;
-        int32_t sub_y   = (pli == 0) ? 0 : dec_handle->seq_header.color_config.subsampling_y;
-        xdec[pli]       = sub_x;
-        ydec[pli]       = sub_y;
-        mi_wide_l2[pli] = MI_SIZE_LOG2 - sub_x;
-        mi_high_l2[pli] = MI_SIZE_LOG2 - sub_y;
+        int32_t sub_x = (pli == 0) ? 0 : dec_handle->seq_header.color_config.subsampling_x;
+        int32_t sub_y = (pli == 0) ? 0 : dec_handle->seq_header.color_config.subsampling_y;
+        ctxt->mi_wide_l2[pli] = MI_SIZE_LOG2 - sub_x;
+        ctxt->mi_high_l2[pli] = MI_SIZE_LOG2 - sub_y;
 
         /*Deriveing  recon pict buffer ptr's*/
         derive_blk_pointers(recon_picture_ptr,
                             pli,
                             0,
                             0,
-                            (void *)&curr_blk_recon_buf[pli],
-                            &curr_recon_stride[pli],
+                            (void *)&ctxt->curr_blk_recon_buf[pli],
+                            &ctxt->curr_recon_stride[pli],
                             sub_x,
                             sub_y);
         /*Allocating memory for line buffes->to fill from src if needed*/
-        linebuf[pli] = (uint16_t *)eb_aom_malloc(sizeof(*linebuf) * CDEF_VBORDER * stride);
+        ctxt->linebuf[pli] = (uint16_t *)eb_aom_malloc(sizeof(*ctxt->linebuf[pli]) *
+                                                       CDEF_VBORDER * ctxt->linebuf_stride);
         /*Allocating memory for col buffes->to fill from src if needed*/
-        colbuf[pli] = (uint16_t *)eb_aom_malloc(
-            sizeof(*colbuf) * ((CDEF_BLOCKSIZE << mi_high_l2[pli]) + 2 * CDEF_VBORDER) *
-            CDEF_HBORDER);
+        ctxt->colbuf[pli] = (uint16_t *)eb_aom_malloc(
+            sizeof(*ctxt->colbuf[pli]) *
+            ((CDEF_BLOCKSIZE << ctxt->mi_high_l2[pli]) + 2 * CDEF_VBORDER) * CDEF_HBORDER);
     }
+}
+
+void svt_cdef_frame_rows(EbDecHandle *dec_handle, DecCdefCtxt *ctxt, int32_t end_row) {
+    DECLARE_ALIGNED(16, uint16_t, src[CDEF_INBUF_SIZE]);
+    FrameHeader * frame_info = &dec_handle->frame_header;
+    const int32_t num_planes = ctxt->num_planes;
+    const int32_t nvfb       = (frame_info->mi_rows + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
+    const int32_t nhfb       = (frame_info->mi_cols + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
+    const int32_t end_fbr    = end_row >= (int32_t)frame_info->frame_size.frame_height
+                                ? nvfb
+                                : end_row / (MI_SIZE_64X64 << MI_SIZE_LOG2);
 
     /*Loop for 64x64 block wise, along col wise for frame size*/
-    for (int32_t fbr = 0; fbr < nvfb; fbr++) {
+    for (; ctxt->next_fbr < end_fbr; ctxt->next_fbr++) {
+        const int32_t fbr = ctxt->next_fbr;
         for (int32_t pli = 0; pli < num_planes; pli++) {
-            const int32_t block_height = (MI_SIZE_64X64 << mi_high_l2[pli]) + 2 * CDEF_VBORDER;
+            const int32_t block_height =
+                (MI_SIZE_64X64 << ctxt->mi_high_l2[pli]) + 2 * CDEF_VBORDER;
             /*Filling the colbuff's with some values.*/
-            fill_rect(colbuf[pli], CDEF_HBORDER, block_height, CDEF_HBORDER, CDEF_VERY_LARGE);
+            fill_rect(ctxt->colbuf[pli], CDEF_HBORDER, block_height, CDEF_HBORDER, CDEF_VERY_LARGE);
         }
 
-        int32_t cdef_left = 1;
-        /*Loop for 64x64 block wise, along row wise for frame size*/
+        uint32_t cdef_left = 1;
+        /*Loop for 64x64 block wise, along row wise for frame size. The rows
+        above are read from and the bottom rows saved to the same line buffers*/
         for (int32_t fbc = 0; fbc < nhfb; fbc++) {
-            /* Logic for getting SBinfo,
-            SbInfo points to every super block.*/
-            SBInfo *sb_info = NULL;
-            if (dec_handle->seq_header.sb_size == BLOCK_128X128) {
-                sb_info =
-                    frame_buf->sb_info + ((fbr >> 1) * master_frame_buf->sb_cols) + (fbc >> 1);
-            } else {
-                sb_info = frame_buf->sb_info + ((fbr)*master_frame_buf->sb_cols) + (fbc);
-            }
-
-            /*Logic for consuming cdef values from super block,
-            Index will vary from 0 to 3 based on position of 64x64 block
-            in Superblock.*/
-            const int32_t index = dec_handle->seq_header.sb_size == BLOCK_128X128
-                                      ? (!!(fbc & cdef_mask) + 2 * !!(fbr & cdef_mask))
-                                      : 0;
-
-            int32_t level, sec_strength;
-            int32_t uv_level, uv_sec_strength;
-            int32_t nhb, nvb;
-            int32_t cstart     = 0;
-            curr_row_cdef[fbc] = 0;
-            if (sb_info == NULL || sb_info->sb_cdef_strength[index] == -1) {
-                cdef_left = 0;
-                continue;
-            }
-            if (!cdef_left) cstart = -CDEF_HBORDER;
-            nhb = AOMMIN(MI_SIZE_64X64, frame_info->mi_cols - MI_SIZE_64X64 * fbc);
-            nvb = AOMMIN(MI_SIZE_64X64, frame_info->mi_rows - MI_SIZE_64X64 * fbr);
-            int32_t frame_top, frame_left, frame_bottom, frame_right;
-            int32_t row_ofset = MI_SIZE_64X64 * fbr;
-            int32_t col_ofset = MI_SIZE_64X64 * fbc;
-
-            /*For the current filter block, it's top left corner mi structure (mi_tl)
-            is first accessed to check whether the top and left boundaries are
-            frame boundaries. Then bottom-left and top-right mi structures are
-            accessed to check whether the bottom and right boundaries
-            (respectively) are frame boundaries.
-
-            Note that we can't just check the bottom-right mi structure - eg. if
-            we're at the right-hand edge of the frame but not the bottom, then
-            the bottom-right mi is NULL but the bottom-left is not.  */
-
-            frame_top  = (row_ofset == 0) ? 1 : 0;
-            frame_left = (col_ofset == 0) ? 1 : 0;
-
-            if (fbr != nvfb - 1) {
-                frame_bottom = ((uint32_t)row_ofset + MI_SIZE_64X64 == frame_info->mi_rows) ? 1 : 0;
-            } else
-                frame_bottom = 1;
-
-            if (fbc != nhfb - 1) {
-                frame_right = ((uint32_t)col_ofset + MI_SIZE_64X64 == frame_info->mi_cols) ? 1 : 0;
-            } else
-                frame_right = 1;
-
-            const int32_t cdef_strength = sb_info->sb_cdef_strength[index];
-            level = frame_info->cdef_params.cdef_y_strength[cdef_strength] / CDEF_SEC_STRENGTHS;
-            sec_strength =
-                frame_info->cdef_params.cdef_y_strength[cdef_strength] % CDEF_SEC_STRENGTHS;
-            sec_strength += sec_strength == 3;
-            uv_level = frame_info->cdef_params.cdef_uv_strength[cdef_strength] / CDEF_SEC_STRENGTHS;
-            uv_sec_strength =
-                frame_info->cdef_params.cdef_uv_strength[cdef_strength] % CDEF_SEC_STRENGTHS;
-            uv_sec_strength += uv_sec_strength == 3;
-
-            if ((level == 0 && sec_strength == 0 && uv_level == 0 && uv_sec_strength == 0) ||
-                (cdef_count = dec_sb_compute_cdef_list(dec_handle,
-                                                       sb_info,
-                                                       frame_info,
-                                                       (fbr * MI_SIZE_64X64),
-                                                       (fbc * MI_SIZE_64X64),
-                                                       dlist,
-                                                       BLOCK_64X64)) == 0) {
-                cdef_left = 0;
-                continue;
-            }
-            curr_row_cdef[fbc] = 1;
-            /*Cdef loop for each plane*/
-            for (int32_t pli = 0; pli < num_planes; pli++) {
-                int32_t coffset;
-                int32_t rend, cend;
-                int32_t pri_damping = frame_info->cdef_params.cdef_damping;
-                int32_t sec_damping = frame_info->cdef_params.cdef_damping;
-                int32_t hsize       = nhb << mi_wide_l2[pli];
-                int32_t vsize       = nvb << mi_high_l2[pli];
-                if (pli) {
-                    level        = uv_level;
-                    sec_strength = uv_sec_strength;
-                }
-
-                if (fbc == nhfb - 1)
-                    cend = hsize;
-                else
-                    cend = hsize + CDEF_HBORDER;
-
-                if (fbr == nvfb - 1)
-                    rend = vsize;
-                else
-                    rend = vsize + CDEF_VBORDER;
-
-                coffset = fbc * MI_SIZE_64X64 << mi_wide_l2[pli];
-                if (fbc == nhfb - 1) {
-                    /* On the last superblock column, fill in the right border with
-                       CDEF_VERY_LARGE to avoid filtering with the outside. */
-                    fill_rect(&src[cend + CDEF_HBORDER],
-                              CDEF_BSTRIDE,
-                              rend + CDEF_VBORDER,
-                              hsize + CDEF_HBORDER - cend,
-                              CDEF_VERY_LARGE);
-                }
-                if (fbr == nvfb - 1) {
-                    /* On the last superblock row, fill in the bottom border with
-                       CDEF_VERY_LARGE to avoid filtering with the outside. */
-                    fill_rect(&src[(rend + CDEF_VBORDER) * CDEF_BSTRIDE],
-                              CDEF_BSTRIDE,
-                              CDEF_VBORDER,
-                              hsize + 2 * CDEF_HBORDER,
-                              CDEF_VERY_LARGE);
-                }
-                uint8_t *rec_buff   = 0;
-                uint32_t rec_stride = 0;
-                switch (pli) {
-                case 0:
-                    rec_buff   = curr_blk_recon_buf[0];
-                    rec_stride = curr_recon_stride[0];
-                    break;
-                case 1:
-                    rec_buff   = curr_blk_recon_buf[1];
-                    rec_stride = curr_recon_stride[1];
-                    break;
-                case 2:
-                    rec_buff   = curr_blk_recon_buf[2];
-                    rec_stride = curr_recon_stride[2];
-                    break;
-                }
-                /* Copy in the pixels we need from the current superblock for
-                   deringing.*/
-                if (use_highbd)
-                    copy_sb16_16(&src[CDEF_VBORDER * CDEF_BSTRIDE + CDEF_HBORDER + cstart],
-                                 CDEF_BSTRIDE,
-                                 (uint16_t *)rec_buff /*xd->plane[pli].dst.buf*/,
-                                 (MI_SIZE_64X64 << mi_high_l2[pli]) * fbr,
-                                 coffset + cstart,
-                                 rec_stride /*xd->plane[pli].dst.stride*/,
-                                 rend,
-                                 cend - cstart);
-                else
-                    copy_sb8_16(&src[CDEF_VBORDER * CDEF_BSTRIDE + CDEF_HBORDER + cstart],
-                                CDEF_BSTRIDE,
-                                rec_buff /*xd->plane[pli].dst.buf*/,
-                                (MI_SIZE_64X64 << mi_high_l2[pli]) * fbr,
-                                coffset + cstart,
-                                rec_stride /*xd->plane[pli].dst.stride*/,
-                                rend,
-                                cend - cstart);
-                if (!prev_row_cdef[fbc]) {
-                    if (use_highbd)
-                        copy_sb16_16( //cm,
-                            &src[CDEF_HBORDER],
-                            CDEF_BSTRIDE,
-                            (uint16_t *)rec_buff /*xd->plane[pli].dst.buf*/,
-                            (MI_SIZE_64X64 << mi_high_l2[pli]) * fbr - CDEF_VBORDER,
-                            coffset,
-                            rec_stride /*xd->plane[pli].dst.stride*/,
-                            CDEF_VBORDER,
-                            hsize);
-                    else
-                        copy_sb8_16( //cm,
-                            &src[CDEF_HBORDER],
-                            CDEF_BSTRIDE,
-                            rec_buff /*xd->plane[pli].dst.buf*/,
-                            (MI_SIZE_64X64 << mi_high_l2[pli]) * fbr - CDEF_VBORDER,
-                            coffset,
-                            rec_stride /*xd->plane[pli].dst.stride*/,
-                            CDEF_VBORDER,
-                            hsize);
-                } else if (fbr > 0) {
-                    copy_rect(&src[CDEF_HBORDER],
-                              CDEF_BSTRIDE,
-                              &linebuf[pli][coffset],
-                              stride,
-                              CDEF_VBORDER,
-                              hsize);
-                } else {
-                    fill_rect(
-                        &src[CDEF_HBORDER], CDEF_BSTRIDE, CDEF_VBORDER, hsize, CDEF_VERY_LARGE);
-                }
-
-                if (!prev_row_cdef[fbc - 1]) {
-                    if (use_highbd)
-                        copy_sb16_16( //cm,
-                            src,
-                            CDEF_BSTRIDE,
-                            (uint16_t *)rec_buff /*xd->plane[pli].dst.buf*/,
-                            (MI_SIZE_64X64 << mi_high_l2[pli]) * fbr - CDEF_VBORDER,
-                            coffset - CDEF_HBORDER,
-                            rec_stride /*xd->plane[pli].
-                            dst.stride*/
-                            ,
-                            CDEF_VBORDER,
-                            CDEF_HBORDER);
-                    else
-                        copy_sb8_16( //cm,
-                            src,
-                            CDEF_BSTRIDE,
-                            rec_buff /*xd->plane[pli].dst.buf*/,
-                            (MI_SIZE_64X64 << mi_high_l2[pli]) * fbr - CDEF_VBORDER,
-                            coffset - CDEF_HBORDER,
-                            rec_stride /*xd->plane[pli].
-                            dst.stride*/
-                            ,
-                            CDEF_VBORDER,
-                            CDEF_HBORDER);
-                } else if (fbr > 0 && fbc > 0) {
-                    copy_rect(src,
-                              CDEF_BSTRIDE,
-                              &linebuf[pli][coffset - CDEF_HBORDER],
-                              stride,
-                              CDEF_VBORDER,
-                              CDEF_HBORDER);
-                } else {
-                    fill_rect(src, CDEF_BSTRIDE, CDEF_VBORDER, CDEF_HBORDER, CDEF_VERY_LARGE);
-                }
-
-                if (!prev_row_cdef[fbc + 1]) {
-                    if (use_highbd)
-                        copy_sb16_16( //cm,
-                            &src[CDEF_HBORDER + (nhb << mi_wide_l2[pli])],
-                            CDEF_BSTRIDE,
-                            (uint16_t *)rec_buff /*xd->plane[pli].dst.buf*/,
-                            (MI_SIZE_64X64 << mi_high_l2[pli]) * fbr - CDEF_VBORDER,
-                            coffset + hsize,
-                            rec_stride /*xd->plane[pli].dst.stride*/,
-                            CDEF_VBORDER,
-                            CDEF_HBORDER);
-                    else
-                        copy_sb8_16( //cm,
-                            &src[CDEF_HBORDER + (nhb << mi_wide_l2[pli])],
-                            CDEF_BSTRIDE,
-                            rec_buff /*xd->plane[pli].dst.buf*/,
-                            (MI_SIZE_64X64 << mi_high_l2[pli]) * fbr - CDEF_VBORDER,
-                            coffset + hsize,
-                            rec_stride /*xd->plane[pli].dst.stride*/,
-                            CDEF_VBORDER,
-                            CDEF_HBORDER);
-                } else if (fbr > 0 && fbc < nhfb - 1) {
-                    copy_rect(&src[hsize + CDEF_HBORDER],
-                              CDEF_BSTRIDE,
-                              &linebuf[pli][coffset + hsize],
-                              stride,
-                              CDEF_VBORDER,
-                              CDEF_HBORDER);
-                } else {
-                    fill_rect(&src[hsize + CDEF_HBORDER],
-                              CDEF_BSTRIDE,
-                              CDEF_VBORDER,
-                              CDEF_HBORDER,
-                              CDEF_VERY_LARGE);
-                }
+            svt_cdef_block(dec_handle,
+                           ctxt->mi_wide_l2,
+                           ctxt->mi_high_l2,
+                           ctxt->colbuf,
+                           ctxt->prev_row_cdef,
+                           ctxt->curr_row_cdef,
+                           fbr,
+                           fbc,
+                           &cdef_left,
+                           num_planes,
+                           src,
+                           ctxt->curr_recon_stride,
+                           ctxt->curr_blk_recon_buf,
+                           ctxt->linebuf,
+                           ctxt->linebuf,
+                           ctxt->linebuf_stride);
+        }
+        uint8_t *tmp        = ctxt->prev_row_cdef;
+        ctxt->prev_row_cdef = ctxt->curr_row_cdef;
+        ctxt->curr_row_cdef = tmp;
+    }
+}
 
-                if (cdef_left) {
-                    /* If we deringed the superblock on the left
-                       then we need to copy in saved pixels. */
-                    copy_rect(src,
-                              CDEF_BSTRIDE,
-                              colbuf[pli],
-                              CDEF_HBORDER,
-                              rend + CDEF_VBORDER,
-                              CDEF_HBORDER);
-                }
+void svt_cdef_frame_end(DecCdefCtxt *ctxt) {
+    eb_aom_free(ctxt->row_cdef);
+    for (int32_t pli = 0; pli < ctxt->num_planes; pli++) {
+        eb_aom_free(ctxt->linebuf[pli]);
+        eb_aom_free(ctxt->colbuf[pli]);
+    }
+}
 
-                /* Saving pixels in case we need to dering the superblock
-                    on the right. */
-                if (fbc < nhfb - 1)
-                    copy_rect(colbuf[pli],
-                              CDEF_HBORDER,
-                              src + hsize,
-                              CDEF_BSTRIDE,
-                              rend + CDEF_VBORDER,
-                              CDEF_HBORDER);
+/* Frame level call, for CDEF */
+void svt_cdef_frame(EbDecHandle *dec_handle, int enable_flag) {
+    if (!enable_flag) return;
 
-                if (fbr < nvfb - 1) {
-                    if (use_highbd)
-                        copy_sb16_16(&linebuf[pli][coffset],
-                                     stride,
-                                     (uint16_t *)rec_buff,
-                                     (MI_SIZE_64X64 << mi_high_l2[pli]) * (fbr + 1) - CDEF_VBORDER,
-                                     coffset,
-                                     rec_stride,
-                                     CDEF_VBORDER,
-                                     hsize);
-                    else
-                        copy_sb8_16(&linebuf[pli][coffset],
-                                    stride,
-                                    rec_buff,
-                                    (MI_SIZE_64X64 << mi_high_l2[pli]) * (fbr + 1) - CDEF_VBORDER,
-                                    coffset,
-                                    rec_stride,
-                                    CDEF_VBORDER,
-                                    hsize);
-                }
+    DecCdefCtxt ctxt;
 
-                if (frame_top) {
-                    fill_rect(
-                        src, CDEF_BSTRIDE, CDEF_VBORDER, hsize + 2 * CDEF_HBORDER, CDEF_VERY_LARGE);
-                }
-                if (frame_left) {
-                    fill_rect(
-                        src, CDEF_BSTRIDE, vsize + 2 * CDEF_VBORDER, CDEF_HBORDER, CDEF_VERY_LARGE);
-                }
-                if (frame_bottom) {
-                    fill_rect(&src[(vsize + CDEF_VBORDER) * CDEF_BSTRIDE],
-                              CDEF_BSTRIDE,
-                              CDEF_VBORDER,
-                              hsize + 2 * CDEF_HBORDER,
-                              CDEF_VERY_LARGE);
-                }
-                if (frame_right) {
-                    fill_rect(&src[hsize + CDEF_HBORDER],
-                              CDEF_BSTRIDE,
-                              vsize + 2 * CDEF_VBORDER,
-                              CDEF_HBORDER,
-                              CDEF_VERY_LARGE);
-                }
-                /* Cdef filter calling function */
-                if (use_highbd) {
-                    uint16_t *tmp_buff = (uint16_t *)rec_buff;
-                    eb_cdef_filter_fb(
-                        NULL,
-                        &tmp_buff[rec_stride * (MI_SIZE_64X64 * fbr << mi_high_l2[pli]) +
-                                  (fbc * MI_SIZE_64X64 << mi_wide_l2[pli])],
-                        rec_stride,
-                        &src[CDEF_VBORDER * CDEF_BSTRIDE + CDEF_HBORDER],
-                        xdec[pli],
-                        ydec[pli],
-                        dir,
-                        NULL,
-                        var,
-                        pli,
-                        dlist,
-                        cdef_count,
-                        level,
-                        sec_strength,
-                        pri_damping,
-                        sec_damping,
-                        coeff_shift);
-                } else
-                    eb_cdef_filter_fb(
-                        &rec_buff[rec_stride * (MI_SIZE_64X64 * fbr << mi_high_l2[pli]) +
-                                  (fbc * MI_SIZE_64X64 << mi_wide_l2[pli])],
-                        NULL,
-                        rec_stride,
-                        &src[CDEF_VBORDER * CDEF_BSTRIDE + CDEF_HBORDER],
-                        xdec[pli],
-                        ydec[pli],
-                        dir,
-                        NULL,
-                        var,
-                        pli,
-                        dlist,
-                        cdef_count,
-                        level,
-                        sec_strength,
-                        pri_damping,
-                        sec_damping,
-                        coeff_shift);
-            } /*cdef plane loop ending*/
-            //CHKN filtered data is written back directy to recFrame.
-            cdef_left = 1;
-        }
-        uint8_t *tmp  = prev_row_cdef;
-        prev_row_cdef = curr_row_cdef;
-        curr_row_cdef = tmp;
-    }
-    eb_aom_free(row_cdef);
-    for (int32_t pli = 0; pli < num_planes; pli++) {
-        eb_aom_free(linebuf[pli]);
-        eb_aom_free(colbuf[pli]);
-    }
+    svt_cdef_frame_start(dec_handle, &ctxt);
+    svt_cdef_frame_rows(dec_handle, &ctxt, dec_handle->frame_header.frame_size.frame_height);
+    svt_cdef_frame_end(&ctxt);
 }
@@ -24,8 +24,36 @@
 extern "C" {
 #endif
 
+/* Single thread CDEF of a frame run a 64x64 row at a time */
+typedef struct DecCdefCtxt {
+    uint8_t *curr_blk_recon_buf[MAX_MB_PLANE];
+    int32_t  curr_recon_stride[MAX_MB_PLANE];
+    int32_t  mi_wide_l2[MAX_MB_PLANE];
+    int32_t  mi_high_l2[MAX_MB_PLANE];
+    int32_t  num_planes;
+    /* Rows above the current 64x64 row as they were before CDEF */
+    uint16_t *linebuf[MAX_MB_PLANE];
+    int32_t   linebuf_stride;
+    uint16_t *colbuf[MAX_MB_PLANE];
+    /* Whether CDEF was applied to each 64x64 of the previous and current row */
+    uint8_t *row_cdef;
+    uint8_t *prev_row_cdef;
+    uint8_t *curr_row_cdef;
+    /* Next 64x64 row to filter */
+    int32_t next_fbr;
+} DecCdefCtxt;
+
 void svt_cdef_frame(EbDecHandle *dec_handle, int enable_flag);
 
+void svt_cdef_frame_start(EbDecHandle *dec_handle, DecCdefCtxt *ctxt);
+
+/* Filter the 64x64 rows above the luma row end_row, which must have been
+ * deblocked along with the rows CDEF reads below it. The picture height
+ * filters the rows left. */
+void svt_cdef_frame_rows(EbDecHandle *dec_handle, DecCdefCtxt *ctxt, int32_t end_row);
+
+void svt_cdef_frame_end(DecCdefCtxt *ctxt);
+
 void svt_cdef_sb_row_mt(EbDecHandle *dec_handle, int32_t *mi_wide_l2, int32_t *mi_high_l2,
                         uint16_t **colbuf, int32_t sb_fbr, uint16_t *src,
                         int32_t *curr_recon_stride, uint8_t **curr_blk_recon_buf);
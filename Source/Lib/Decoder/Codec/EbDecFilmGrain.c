@@ -0,0 +1,189 @@
+/*
+* Copyright(c) 2019 Netflix, Inc.
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+// SUMMARY
+//   Film grain of the output pictures, split in stripes over worker threads
+
+/**************************************
+ * Includes
+ **************************************/
+#include <stdlib.h>
+#include <string.h>
+
+#include "EbDefinitions.h"
+#include "EbThreads.h"
+#include "EbDecFilmGrain.h"
+
+/* Luma rows of a film grain stripe */
+#define FG_STRIPE_HEIGHT 32
+/* Jobs handed out per thread, more jobs balance better but replay more grain */
+#define FG_JOBS_PER_THREAD 2
+
+struct DecFilmGrainCtxt {
+    EbHandle  mutex;
+    /* Posted once per worker for each frame and on exit */
+    EbHandle  work_semaphore;
+    EbHandle  done_semaphore;
+    EbHandle *thread_handle_array;
+    uint32_t  num_threads;
+    EbBool    exit;
+    /* Frame being processed, set before the workers are woken up */
+    const DecOutFrame *   out;
+    const FilmGrainFrame *fg;
+    int32_t               stripes_per_job;
+    int32_t               num_jobs;
+    int32_t               next_job;
+};
+
+void dec_copy_out_rows(const DecOutFrame *out, int32_t first_row, int32_t end_row) {
+    EbPictureBufferDesc *recon              = out->recon;
+    const int32_t        use_high_bit_depth = recon->bit_depth == EB_8BIT ? 0 : 1;
+    uint8_t *            src;
+    uint8_t *            dst;
+
+    /* Luma */
+    dst = out->luma + ((first_row * out->y_stride) << use_high_bit_depth);
+    src = recon->buffer_y +
+          ((recon->origin_x + (recon->origin_y + first_row) * recon->stride_y)
+           << use_high_bit_depth);
+    for (int32_t i = first_row; i < end_row; i++) {
+        memcpy(dst, src, out->width << use_high_bit_depth);
+        dst += out->y_stride << use_high_bit_depth;
+        src += recon->stride_y << use_high_bit_depth;
+    }
+
+    if (recon->color_format == EB_YUV400) return;
+
+    const int32_t sx        = out->sx;
+    const int32_t sy        = out->sy;
+    const int32_t first_uv  = first_row >> sy;
+    const int32_t end_uv    = (end_row + sy) >> sy;
+    const int32_t width_uv  = ((out->width + sx) >> sx) << use_high_bit_depth;
+    const int32_t origin_uv = recon->origin_x >> sx;
+
+    /* Cb */
+    dst = out->cb + ((first_uv * out->cb_stride) << use_high_bit_depth);
+    src = recon->buffer_cb +
+          ((origin_uv + ((recon->origin_y >> sy) + first_uv) * recon->stride_cb)
+           << use_high_bit_depth);
+    for (int32_t i = first_uv; i < end_uv; i++) {
+        memcpy(dst, src, width_uv);
+        dst += out->cb_stride << use_high_bit_depth;
+        src += recon->stride_cb << use_high_bit_depth;
+    }
+
+    /* Cr */
+    dst = out->cr + ((first_uv * out->cr_stride) << use_high_bit_depth);
+    src = recon->buffer_cr +
+          ((origin_uv + ((recon->origin_y >> sy) + first_uv) * recon->stride_cr)
+           << use_high_bit_depth);
+    for (int32_t i = first_uv; i < end_uv; i++) {
+        memcpy(dst, src, width_uv);
+        dst += out->cr_stride << use_high_bit_depth;
+        src += recon->stride_cr << use_high_bit_depth;
+    }
+}
+
+static void dec_film_grain_job(const DecOutFrame *out, const FilmGrainFrame *fg,
+                               int32_t first_stripe, int32_t num_stripes) {
+    const int32_t end_stripe = first_stripe + num_stripes;
+    /* The last stripe also copies the odd row left without grain */
+    const int32_t end_row =
+        end_stripe >= fg->num_stripes ? out->height : end_stripe * FG_STRIPE_HEIGHT;
+
+    dec_copy_out_rows(out, first_stripe * FG_STRIPE_HEIGHT, end_row);
+    eb_av1_add_film_grain_stripes(fg, first_stripe, num_stripes);
+}
+
+/* Run the jobs of the current frame until none is left */
+static void dec_film_grain_run_jobs(DecFilmGrainCtxt *ctxt) {
+    for (;;) {
+        eb_block_on_mutex(ctxt->mutex);
+        const int32_t job = ctxt->next_job < ctxt->num_jobs ? ctxt->next_job++ : -1;
+        eb_release_mutex(ctxt->mutex);
+        if (job < 0) break;
+        dec_film_grain_job(
+            ctxt->out, ctxt->fg, job * ctxt->stripes_per_job, ctxt->stripes_per_job);
+    }
+}
+
+static void *dec_film_grain_kernel(void *input_ptr) {
+    DecFilmGrainCtxt *ctxt = (DecFilmGrainCtxt *)input_ptr;
+
+    for (;;) {
+        eb_block_on_semaphore(ctxt->work_semaphore);
+        if (ctxt->exit) break;
+        dec_film_grain_run_jobs(ctxt);
+        eb_post_semaphore(ctxt->done_semaphore);
+    }
+
+    eb_post_semaphore(ctxt->done_semaphore);
+    return EB_NULL;
+}
+
+EbErrorType dec_film_grain_ctxt_create(DecFilmGrainCtxt **ctxt, uint32_t num_threads) {
+    *ctxt = NULL;
+
+    DecFilmGrainCtxt *ctxt_ptr = (DecFilmGrainCtxt *)calloc(1, sizeof(DecFilmGrainCtxt));
+    if (ctxt_ptr == NULL) return EB_ErrorInsufficientResources;
+    ctxt_ptr->thread_handle_array = (EbHandle *)calloc(num_threads, sizeof(EbHandle));
+    ctxt_ptr->mutex               = eb_create_mutex();
+    ctxt_ptr->work_semaphore      = eb_create_semaphore(0, num_threads);
+    ctxt_ptr->done_semaphore      = eb_create_semaphore(0, num_threads);
+    if (ctxt_ptr->thread_handle_array == NULL || ctxt_ptr->mutex == NULL ||
+        ctxt_ptr->work_semaphore == NULL || ctxt_ptr->done_semaphore == NULL) {
+        dec_film_grain_ctxt_destroy(ctxt_ptr);
+        return EB_ErrorInsufficientResources;
+    }
+
+    for (uint32_t i = 0; i < num_threads; i++) {
+        ctxt_ptr->thread_handle_array[i] = eb_create_thread(dec_film_grain_kernel, ctxt_ptr);
+        if (ctxt_ptr->thread_handle_array[i] == NULL) {
+            dec_film_grain_ctxt_destroy(ctxt_ptr);
+            return EB_ErrorInsufficientResources;
+        }
+        ctxt_ptr->num_threads++;
+    }
+
+    *ctxt = ctxt_ptr;
+    return EB_ErrorNone;
+}
+
+void dec_film_grain_ctxt_destroy(DecFilmGrainCtxt *ctxt) {
+    if (ctxt == NULL) return;
+
+    ctxt->exit = EB_TRUE;
+    for (uint32_t i = 0; i < ctxt->num_threads; i++) eb_post_semaphore(ctxt->work_semaphore);
+    for (uint32_t i = 0; i < ctxt->num_threads; i++) eb_block_on_semaphore(ctxt->done_semaphore);
+    for (uint32_t i = 0; i < ctxt->num_threads; i++)
+        eb_destroy_thread(ctxt->thread_handle_array[i]);
+
+    if (ctxt->done_semaphore) eb_destroy_semaphore(ctxt->done_semaphore);
+    if (ctxt->work_semaphore) eb_destroy_semaphore(ctxt->work_semaphore);
+    if (ctxt->mutex) eb_destroy_mutex(ctxt->mutex);
+    free(ctxt->thread_handle_array);
+    free(ctxt);
+}
+
+void dec_film_grain_output(DecFilmGrainCtxt *ctxt, const DecOutFrame *out,
+                           const FilmGrainFrame *fg) {
+    if (ctxt == NULL || fg->num_stripes < 2) {
+        dec_film_grain_job(out, fg, 0, fg->num_stripes);
+        return;
+    }
+
+    const int32_t max_jobs        = (int32_t)(ctxt->num_threads + 1) * FG_JOBS_PER_THREAD;
+    const int32_t stripes_per_job = (fg->num_stripes + max_jobs - 1) / max_jobs;
+
+    ctxt->out             = out;
+    ctxt->fg              = fg;
+    ctxt->stripes_per_job = stripes_per_job;
+    ctxt->num_jobs        = (fg->num_stripes + stripes_per_job - 1) / stripes_per_job;
+    ctxt->next_job        = 0;
+
+    for (uint32_t i = 0; i < ctxt->num_threads; i++) eb_post_semaphore(ctxt->work_semaphore);
+    dec_film_grain_run_jobs(ctxt);
+    for (uint32_t i = 0; i < ctxt->num_threads; i++) eb_block_on_semaphore(ctxt->done_semaphore);
+}
@@ -0,0 +1,49 @@
+/*
+* Copyright(c) 2019 Netflix, Inc.
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbDecFilmGrain_h
+#define EbDecFilmGrain_h
+
+#include "EbPictureBufferDesc.h"
+#include "grainSynthesis.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Output picture filled from the recon buffer */
+typedef struct DecOutFrame {
+    EbPictureBufferDesc *recon;
+    uint8_t *            luma;
+    uint8_t *            cb;
+    uint8_t *            cr;
+    int32_t              y_stride;
+    int32_t              cb_stride;
+    int32_t              cr_stride;
+    int32_t              width;
+    int32_t              height;
+    int32_t              sx;
+    int32_t              sy;
+} DecOutFrame;
+
+typedef struct DecFilmGrainCtxt DecFilmGrainCtxt;
+
+/* Copy the luma rows [first_row, end_row) and the co-located chroma rows */
+void dec_copy_out_rows(const DecOutFrame *out, int32_t first_row, int32_t end_row);
+
+EbErrorType dec_film_grain_ctxt_create(DecFilmGrainCtxt **ctxt, uint32_t num_threads);
+
+void dec_film_grain_ctxt_destroy(DecFilmGrainCtxt *ctxt);
+
+/* Copy the recon to the output and add the grain, a stripe at a time so that
+ * the rows are still in cache when the grain is added. The stripes are shared
+ * with the worker threads of ctxt, which may be NULL. */
+void dec_film_grain_output(DecFilmGrainCtxt *ctxt, const DecOutFrame *out,
+                           const FilmGrainFrame *fg);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbDecFilmGrain_h
@@ -10,6 +10,7 @@
  * Includes
  **************************************/
 #include <stdlib.h>
+#include <string.h>
 
 #include "EbDefinitions.h"
 #include "EbPictureBufferDesc.h"
@@ -19,6 +20,7 @@
 #include "EbDecMemInit.h"
 #include "EbDecPicMgr.h"
 #include "grainSynthesis.h"
+#include "EbDecFilmGrain.h"
 
 #ifndef _WIN32
 #include <pthread.h>
@@ -53,11 +55,11 @@ typedef struct logicalProcessorGroup {
 processorGroup *lp_group = NULL;
 #endif
 
-EbMemoryMapEntry *svt_dec_memory_map;
-uint32_t *        svt_dec_memory_map_index;
-uint64_t *        svt_dec_total_lib_memory;
+DEC_THREAD_LOCAL EbMemoryMapEntry *svt_dec_memory_map;
+DEC_THREAD_LOCAL uint32_t *        svt_dec_memory_map_index;
+DEC_THREAD_LOCAL uint64_t *        svt_dec_total_lib_memory;
 
-uint32_t svt_dec_lib_malloc_count = 0;
+DEC_THREAD_LOCAL uint32_t svt_dec_lib_malloc_count = 0;
 
 //TODO: Should be removed! Check
 EbMemoryMapEntry *memory_map;
@@ -77,6 +79,20 @@ void        dec_sync_all_threads(EbDecHandle *dec_handle_ptr);
 
 EbErrorType decode_multiple_obu(EbDecHandle *dec_handle_ptr, uint8_t **data, size_t data_size,
                                 uint32_t is_annexb);
+EbErrorType decode_one_obu(EbDecHandle *dec_handle_ptr, uint8_t **data, size_t *data_size,
+                           uint32_t is_annexb, int *frame_decoding_finished);
+
+/* Point the allocation list of the calling thread at the handle, the head
+ * is stored back by dec_mem_map_unbind() once the call is done. */
+static void dec_mem_map_bind(EbDecHandle *dec_handle_ptr) {
+    svt_dec_total_lib_memory = &dec_handle_ptr->total_lib_memory;
+    svt_dec_memory_map       = dec_handle_ptr->memory_map;
+    svt_dec_memory_map_index = &dec_handle_ptr->memory_map_index;
+}
+
+static void dec_mem_map_unbind(EbDecHandle *dec_handle_ptr) {
+    dec_handle_ptr->memory_map = svt_dec_memory_map;
+}
 
 void switch_to_real_time() {
 #ifndef _WIN32
@@ -106,12 +122,16 @@ static EbErrorType eb_dec_handle_ctor(EbDecHandle **decHandleDblPtr, EbComponent
         sizeof(EbComponentType) + sizeof(EbDecHandle) + sizeof(EbMemoryMapEntry);
     dec_handle_ptr->memory_map_init_address = dec_handle_ptr->memory_map;
     // Save Memory Map Pointers
-    svt_dec_total_lib_memory = &dec_handle_ptr->total_lib_memory;
-    svt_dec_memory_map       = dec_handle_ptr->memory_map;
-    svt_dec_memory_map_index = &dec_handle_ptr->memory_map_index;
+    dec_mem_map_bind(dec_handle_ptr);
     svt_dec_lib_malloc_count = 0;
 
     dec_handle_ptr->start_thread_process = EB_FALSE;
+    // The picture manager is created with the first sequence header
+    dec_handle_ptr->pv_pic_mgr           = NULL;
+    dec_handle_ptr->pool_stream          = NULL;
+    dec_handle_ptr->film_grain_ctxt      = NULL;
+    memset(&dec_handle_ptr->push_ctxt, 0, sizeof(dec_handle_ptr->push_ctxt));
+    dec_stats_init(&dec_handle_ptr->stage_stats, EB_FALSE);
 
     return return_error;
 }
@@ -133,7 +153,7 @@ int svt_dec_out_buf(EbDecHandle *dec_handle_ptr, EbBufferHeaderType *p_buffer) {
 
     uint32_t wd = dec_handle_ptr->frame_header.frame_size.superres_upscaled_width;
     uint32_t ht = dec_handle_ptr->frame_header.frame_size.frame_height;
-    uint32_t i, sx = 0, sy = 0;
+    uint32_t sx = 0, sy = 0;
 
     if (out_img->height != ht || out_img->width != wd ||
         out_img->color_fmt != recon_picture_buf->color_format ||
@@ -224,109 +244,53 @@ int svt_dec_out_buf(EbDecHandle *dec_handle_ptr, EbBufferHeaderType *p_buffer) {
               << use_high_bit_depth);
     }
 
-    /* Memcpy to dst buffer */
-    {
-        if (recon_picture_buf->bit_depth == EB_8BIT) {
-            uint8_t *src, *dst;
-            dst = luma;
-            src = recon_picture_buf->buffer_y + recon_picture_buf->origin_x +
-                  (recon_picture_buf->origin_y * recon_picture_buf->stride_y);
-
-            for (i = 0; i < ht; i++) {
-                memcpy(dst, src, wd);
-                dst += out_img->y_stride;
-                src += recon_picture_buf->stride_y;
-            }
-
-            if (recon_picture_buf->color_format != EB_YUV400) {
-                /* Cb */
-                dst = cb;
-                src = recon_picture_buf->buffer_cb + (recon_picture_buf->origin_x >> sx) +
-                      ((recon_picture_buf->origin_y >> sy) * recon_picture_buf->stride_cb);
-
-                for (i = 0; i < ((ht + sy) >> sy); i++) {
-                    memcpy(dst, src, ((wd + sx) >> sx));
-                    dst += out_img->cb_stride;
-                    src += recon_picture_buf->stride_cb;
-                }
-
-                /* Cr */
-                dst = cr;
-                src = recon_picture_buf->buffer_cr + (recon_picture_buf->origin_x >> sx) +
-                      ((recon_picture_buf->origin_y >> sy) * recon_picture_buf->stride_cr);
-
-                for (i = 0; i < ((ht + sy) >> sy); i++) {
-                    memcpy(dst, src, ((wd + sx) >> sx));
-                    dst += out_img->cr_stride;
-                    src += recon_picture_buf->stride_cr;
-                }
-            }
-        } else {
-            uint16_t *pu2_dst;
-            uint16_t *pu2_src;
-
-            /* Luma */
-            pu2_dst = (uint16_t *)luma;
-            pu2_src = (uint16_t *)recon_picture_buf->buffer_y + recon_picture_buf->origin_x +
-                      (recon_picture_buf->origin_y * recon_picture_buf->stride_y);
-
-            for (i = 0; i < ht; i++) {
-                memcpy(pu2_dst, pu2_src, sizeof(uint16_t) * wd);
-                pu2_dst += out_img->y_stride;
-                pu2_src += recon_picture_buf->stride_y;
-            }
-
-            if (recon_picture_buf->color_format != EB_YUV400) {
-                /* Cb */
-                pu2_dst = (uint16_t *)cb;
-                pu2_src = (uint16_t *)recon_picture_buf->buffer_cb +
-                          (recon_picture_buf->origin_x >> sx) +
-                          ((recon_picture_buf->origin_y >> sy) * recon_picture_buf->stride_cb);
-
-                for (i = 0; i < ((ht + sy) >> sy); i++) {
-                    memcpy(pu2_dst, pu2_src, sizeof(uint16_t) * ((wd + sx) >> sx));
-                    pu2_dst += out_img->cb_stride;
-                    pu2_src += recon_picture_buf->stride_cb;
-                }
-
-                /* Cr */
-                pu2_dst = (uint16_t *)cr;
-                pu2_src = (uint16_t *)recon_picture_buf->buffer_cr +
-                          (recon_picture_buf->origin_x >> sx) +
-                          ((recon_picture_buf->origin_y >> sy) * recon_picture_buf->stride_cr);
-
-                for (i = 0; i < ((ht + sy) >> sy); i++) {
-                    memcpy(pu2_dst, pu2_src, sizeof(uint16_t) * ((wd + sx) >> sx));
-                    pu2_dst += out_img->cr_stride;
-                    pu2_src += recon_picture_buf->stride_cr;
-                }
-            }
+    DecOutFrame out_frame;
+    out_frame.recon     = recon_picture_buf;
+    out_frame.luma      = luma;
+    out_frame.cb        = cb;
+    out_frame.cr        = cr;
+    out_frame.y_stride  = out_img->y_stride;
+    out_frame.cb_stride = out_img->cb_stride;
+    out_frame.cr_stride = out_img->cr_stride;
+    out_frame.width     = wd;
+    out_frame.height    = ht;
+    out_frame.sx        = sx;
+    out_frame.sy        = sy;
+
+    AomFilmGrain *film_grain_ptr = &dec_handle_ptr->cur_pic_buf[0]->film_grain_params;
+    if (!dec_handle_ptr->dec_config.skip_film_grain && film_grain_ptr->apply_grain) {
+        FilmGrainFrame fg;
+        uint64_t       start = dec_stage_start(&dec_handle_ptr->stage_stats);
+
+        switch (recon_picture_buf->bit_depth) {
+        case EB_8BIT: film_grain_ptr->bit_depth = 8; break;
+        case EB_10BIT: film_grain_ptr->bit_depth = 10; break;
+        default: assert(0);
         }
-    }
 
-    if (!dec_handle_ptr->dec_config.skip_film_grain) {
-        /* Need to fill the dst buf with recon data before calling film_grain */
-        AomFilmGrain *film_grain_ptr = &dec_handle_ptr->cur_pic_buf[0]->film_grain_params;
-        if (film_grain_ptr->apply_grain) {
-            switch (recon_picture_buf->bit_depth) {
-            case EB_8BIT: film_grain_ptr->bit_depth = 8; break;
-            case EB_10BIT: film_grain_ptr->bit_depth = 10; break;
-            default: assert(0);
-            }
-
-            eb_av1_add_film_grain_run(film_grain_ptr,
-                                      luma,
-                                      cb,
-                                      cr,
-                                      ht,
-                                      wd,
-                                      out_img->y_stride,
-                                      out_img->cb_stride,
-                                      use_high_bit_depth,
-                                      sy,
-                                      sx);
-        }
-    }
+        /* The stripes are shared with worker threads when the decoder has
+         * some, without them the frame is done by this thread */
+        if (dec_handle_ptr->dec_config.threads > 1 && dec_handle_ptr->film_grain_ctxt == NULL)
+            dec_film_grain_ctxt_create(&dec_handle_ptr->film_grain_ctxt,
+                                       dec_handle_ptr->dec_config.threads - 1);
+
+        eb_av1_film_grain_frame_init(&fg,
+                                     film_grain_ptr,
+                                     luma,
+                                     cb,
+                                     cr,
+                                     ht,
+                                     wd,
+                                     out_img->y_stride,
+                                     out_img->cb_stride,
+                                     use_high_bit_depth,
+                                     sy,
+                                     sx);
+        dec_film_grain_output(dec_handle_ptr->film_grain_ctxt, &out_frame, &fg);
+        eb_av1_film_grain_frame_free(&fg);
+        dec_stage_end(&dec_handle_ptr->stage_stats, DEC_STAGE_FILM_GRAIN, start);
+    } else
+        dec_copy_out_rows(&out_frame, 0, ht);
 
     return 1;
 }
@@ -362,6 +326,7 @@ EbErrorType eb_svt_dec_set_default_parameter(EbSvtAv1DecConfiguration *config_pt
     /* Multi-thread parameters */
     config_ptr->threads      = 1;
     config_ptr->num_p_frames = 1;
+    config_ptr->low_memory   = EB_FALSE;
 
     return return_error;
 }
@@ -475,6 +440,8 @@ eb_init_decoder(EbComponentType *svt_dec_component) {
     dec_handle_ptr->show_existing_frame = 0;
     dec_handle_ptr->show_frame          = 0;
     dec_handle_ptr->showable_frame      = 0;
+    dec_stats_init(&dec_handle_ptr->stage_stats,
+                   (EbBool)(dec_handle_ptr->dec_config.stat_report != 0));
 
     setup_common_rtcd_internal(cpu_flags);
     setup_rtcd_internal(cpu_flags);
@@ -491,7 +458,9 @@ eb_init_decoder(EbComponentType *svt_dec_component) {
     /************************************
     * Decoder Memory Init
     ************************************/
+    dec_mem_map_bind(dec_handle_ptr);
     return_error = dec_mem_init(dec_handle_ptr);
+    dec_mem_map_unbind(dec_handle_ptr);
     if (return_error != EB_ErrorNone) return return_error;
 
     return return_error;
@@ -511,6 +480,7 @@ eb_svt_decode_frame(EbComponentType *svt_dec_component, const uint8_t *data, con
     uint8_t *    data_end             = (uint8_t *)data + data_size;
     dec_handle_ptr->seen_frame_header = 0;
 
+    dec_mem_map_bind(dec_handle_ptr);
     while (data_start < data_end) {
         /*TODO : Remove or move. For Test purpose only */
         dec_handle_ptr->dec_cnt++;
@@ -539,7 +509,163 @@ eb_svt_decode_frame(EbComponentType *svt_dec_component, const uint8_t *data, con
             dec_handle_ptr->frame_header.frame_size.frame_height,
             dec_handle_ptr->frame_header.frame_type);*/
     }
+    dec_mem_map_unbind(dec_handle_ptr);
+
+    return return_error;
+}
+
+/* Largest OBU header plus obu_size field: 2 header bytes and 8 bytes of leb128 */
+#define DEC_PUSH_MAX_OBU_HEADER 10
+
+typedef struct DecPushTileGroup {
+    struct DecPushTileGroup *next;
+} DecPushTileGroup;
+
+/* Size of the OBU starting at buf, 0 while the header is not complete */
+static EbErrorType dec_push_obu_size(const uint8_t *buf, size_t avail, size_t *obu_size) {
+    *obu_size = 0;
+    if (avail < 1) return EB_ErrorNone;
+    // obu_forbidden_bit and obu_reserved_1bit must be 0, obu_has_size_field 1
+    if ((buf[0] & 0x83) != 0x02) return EB_Corrupt_Frame;
+    size_t header_size  = (buf[0] & 0x04) ? 2 : 1;
+    size_t payload_size = 0;
+    for (size_t i = 0; i < 8; i++) {
+        if (header_size + i >= avail) return EB_ErrorNone;
+        const uint8_t byte = buf[header_size + i];
+        payload_size |= (size_t)(byte & 0x7f) << (i * 7);
+        if (!(byte & 0x80)) {
+            if (payload_size > UINT32_MAX) return EB_Corrupt_Frame;
+            *obu_size = header_size + i + 1 + payload_size;
+            return EB_ErrorNone;
+        }
+    }
+    return EB_Corrupt_Frame;
+}
+
+static EbErrorType dec_push_carry(DecPushCtxt *push_ctxt, const uint8_t *data, size_t size) {
+    if (push_ctxt->carry_size + size > push_ctxt->carry_capacity) {
+        size_t   capacity = AOMMAX(2 * push_ctxt->carry_capacity, push_ctxt->carry_size + size);
+        uint8_t *carry    = (uint8_t *)realloc(push_ctxt->carry, capacity);
+        if (carry == NULL) return EB_ErrorInsufficientResources;
+        push_ctxt->carry          = carry;
+        push_ctxt->carry_capacity = capacity;
+    }
+    memcpy(push_ctxt->carry + push_ctxt->carry_size, data, size);
+    push_ctxt->carry_size += size;
+    return EB_ErrorNone;
+}
+
+static void dec_push_free_tile_groups(DecPushCtxt *push_ctxt) {
+    while (push_ctxt->tile_groups) {
+        DecPushTileGroup *tile_group = push_ctxt->tile_groups;
+        push_ctxt->tile_groups       = tile_group->next;
+        free(tile_group);
+    }
+}
+
+/* Decode one complete OBU in place. With threads the tile jobs only run once
+ * the last tile group of the frame is parsed, so OBU_TILE_GROUPs are copied
+ * there (an OBU_FRAME always ends the frame). */
+static EbErrorType dec_push_decode_obu(EbDecHandle *dec_handle_ptr, const uint8_t *obu,
+                                       size_t obu_size, EbBool *frame_decoded) {
+    DecPushCtxt *push_ctxt               = &dec_handle_ptr->push_ctxt;
+    const int    obu_type                = (obu[0] >> 3) & 0xf;
+    int          frame_decoding_finished = 0;
+    uint8_t *    data                    = (uint8_t *)obu;
+    size_t       data_size               = obu_size;
+
+    if (obu_type == OBU_TILE_GROUP && dec_handle_ptr->dec_config.threads > 1) {
+        DecPushTileGroup *tile_group =
+            (DecPushTileGroup *)malloc(sizeof(DecPushTileGroup) + obu_size);
+        if (tile_group == NULL) return EB_ErrorInsufficientResources;
+        tile_group->next       = push_ctxt->tile_groups;
+        push_ctxt->tile_groups = tile_group;
+        data                   = (uint8_t *)(tile_group + 1);
+        memcpy(data, obu, obu_size);
+    }
+
+    EbErrorType return_error =
+        decode_one_obu(dec_handle_ptr, &data, &data_size, 0, &frame_decoding_finished);
+    if (return_error != EB_ErrorNone) return return_error;
+
+    if (obu_type == OBU_FRAME_HEADER && dec_handle_ptr->show_existing_frame) {
+        // No tile group follows a shown existing frame
+        dec_handle_ptr->seen_frame_header = 0;
+        frame_decoding_finished           = 1;
+    }
+    if (frame_decoding_finished) {
+        dec_handle_ptr->dec_cnt++;
+        dec_pic_mgr_update_ref_pic(
+            dec_handle_ptr, 1, dec_handle_ptr->frame_header.refresh_frame_flags);
+        dec_push_free_tile_groups(push_ctxt);
+        *frame_decoded = EB_TRUE;
+    }
+    return EB_ErrorNone;
+}
 
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType
+eb_svt_dec_push_data(EbComponentType *svt_dec_component, const uint8_t *data, size_t data_size,
+                     size_t *consumed, EbBool *frame_decoded) {
+    if (svt_dec_component == NULL || consumed == NULL || frame_decoded == NULL ||
+        (data == NULL && data_size))
+        return EB_ErrorBadParameter;
+
+    EbDecHandle *  dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
+    DecPushCtxt *  push_ctxt      = &dec_handle_ptr->push_ctxt;
+    const uint8_t *cur            = data;
+    const uint8_t *end            = data + data_size;
+    EbErrorType    return_error   = EB_ErrorNone;
+
+    *frame_decoded = EB_FALSE;
+    dec_mem_map_bind(dec_handle_ptr);
+    while (!*frame_decoded && cur < end) {
+        size_t obu_size;
+        if (push_ctxt->carry_size) {
+            // Complete the OBU started by a previous push, its header first
+            return_error = dec_push_obu_size(push_ctxt->carry, push_ctxt->carry_size, &obu_size);
+            if (return_error != EB_ErrorNone) break;
+            size_t need = obu_size ? obu_size - push_ctxt->carry_size
+                                   : DEC_PUSH_MAX_OBU_HEADER - push_ctxt->carry_size;
+            need         = AOMMIN(need, (size_t)(end - cur));
+            return_error = dec_push_carry(push_ctxt, cur, need);
+            if (return_error != EB_ErrorNone) break;
+            cur += need;
+            if (!obu_size) {
+                return_error =
+                    dec_push_obu_size(push_ctxt->carry, push_ctxt->carry_size, &obu_size);
+                if (return_error != EB_ErrorNone) break;
+                if (!obu_size) continue;
+                // Hand back the bytes taken past the end of a short OBU
+                if (push_ctxt->carry_size > obu_size) {
+                    cur -= push_ctxt->carry_size - obu_size;
+                    push_ctxt->carry_size = obu_size;
+                }
+            }
+            if (push_ctxt->carry_size < obu_size) continue;
+
+            return_error =
+                dec_push_decode_obu(dec_handle_ptr, push_ctxt->carry, obu_size, frame_decoded);
+            push_ctxt->carry_size = 0;
+        } else {
+            return_error = dec_push_obu_size(cur, end - cur, &obu_size);
+            if (return_error != EB_ErrorNone) break;
+            if (!obu_size || obu_size > (size_t)(end - cur)) {
+                // Incomplete OBU, keep it for the next push
+                return_error = dec_push_carry(push_ctxt, cur, end - cur);
+                cur          = end;
+                break;
+            }
+            return_error = dec_push_decode_obu(dec_handle_ptr, cur, obu_size, frame_decoded);
+            cur += obu_size;
+        }
+        if (return_error != EB_ErrorNone) break;
+    }
+    dec_mem_map_unbind(dec_handle_ptr);
+
+    *consumed = cur - data;
     return return_error;
 }
 
@@ -561,6 +687,18 @@ eb_svt_dec_get_picture(EbComponentType *svt_dec_component, EbBufferHeaderType *p
     return return_error;
 }
 
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType
+eb_svt_dec_get_stage_stats(EbComponentType *svt_dec_component, EbSvtDecStageStats *stats) {
+    if (svt_dec_component == NULL || stats == NULL) return EB_ErrorBadParameter;
+
+    EbDecHandle *dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
+    dec_stats_get(&dec_handle_ptr->stage_stats, stats);
+    return EB_ErrorNone;
+}
+
 #ifdef __GNUC__
 __attribute__((visibility("default")))
 #endif
@@ -571,12 +709,21 @@ eb_deinit_decoder(EbComponentType *svt_dec_component) {
     EbErrorType  return_error   = EB_ErrorNone;
 
     if (dec_handle_ptr) {
-        if (dec_handle_ptr->dec_config.threads > 1) dec_sync_all_threads(dec_handle_ptr);
+        if (dec_handle_ptr->pool_stream) eb_svt_dec_pool_detach(svt_dec_component);
+        dec_film_grain_ctxt_destroy(dec_handle_ptr->film_grain_ctxt);
+        dec_push_free_tile_groups(&dec_handle_ptr->push_ctxt);
+        free(dec_handle_ptr->push_ctxt.carry);
+        // The worker threads are started with the first tile group
+        if (dec_handle_ptr->dec_config.threads > 1 && dec_handle_ptr->start_thread_process)
+            dec_sync_all_threads(dec_handle_ptr);
+        dec_pic_mgr_deinit(dec_handle_ptr);
+        dec_mem_map_bind(dec_handle_ptr);
         if (svt_dec_memory_map) {
             // Loop through the ptr table and free all malloc'd pointers per channel
+            // memory_map_init_address is the head of the list, it holds no allocation
             EbMemoryMapEntry *memory_entry = svt_dec_memory_map;
             if (memory_entry) {
-                do {
+                while (memory_entry != dec_handle_ptr->memory_map_init_address && memory_entry) {
                     switch (memory_entry->ptr_type) {
                     case EB_N_PTR: free(memory_entry->ptr); break;
                     case EB_A_PTR:
@@ -594,7 +741,7 @@ eb_deinit_decoder(EbComponentType *svt_dec_component) {
                     EbMemoryMapEntry *tmp_memory_entry = memory_entry;
                     memory_entry = (EbMemoryMapEntry *)tmp_memory_entry->prev_entry;
                     if (tmp_memory_entry) free(tmp_memory_entry);
-                } while (memory_entry != dec_handle_ptr->memory_map_init_address && memory_entry);
+                }
                 if (dec_handle_ptr->memory_map_init_address)
                     free(dec_handle_ptr->memory_map_init_address);
             }
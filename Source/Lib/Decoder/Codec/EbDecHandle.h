@@ -24,6 +24,7 @@ extern "C" {
 #include "EbDecStruct.h"
 #include "EbDecBlock.h"
 #include "EbDecProcess.h"
+#include "EbDecStats.h"
 #include "EbCabacContextModel.h"
 
 #include "../../Encoder/Codec/EbPictureControlSet.h"
@@ -68,6 +69,8 @@ typedef struct EbDecPicBuf {
 
     /* MV at 8x8 lvl */
     TemporalMvRef *mvs;
+    /* Number of entries in mvs */
+    size_t mvs_size;
 
     /* seg map */
     uint8_t *          segment_maps;
@@ -144,6 +147,17 @@ typedef struct MasterFrameBuf {
 
 } MasterFrameBuf;
 
+/* State of the eb_svt_dec_push_data() parser */
+typedef struct DecPushCtxt {
+    /* Start of an OBU split across pushes */
+    uint8_t *carry;
+    size_t   carry_size;
+    size_t   carry_capacity;
+    /* Copies of the tile groups the MT tile jobs point to, kept until the
+       frame is decoded */
+    struct DecPushTileGroup *tile_groups;
+} DecPushCtxt;
+
 /**************************************
  * Component Private Data
  **************************************/
@@ -239,6 +253,17 @@ typedef struct EbDecHandle {
     EbBool                start_thread_process;
     EbHandle              thread_semaphore;
     struct DecThreadCtxt *thread_ctxt_pa;
+
+    /* Job queue of the stream when attached to a shared decoder pool */
+    struct DecPoolStream *pool_stream;
+
+    /* Film grain worker threads, created with the first frame with grain */
+    struct DecFilmGrainCtxt *film_grain_ctxt;
+
+    DecPushCtxt push_ctxt;
+
+    /* Stage times reported by eb_svt_dec_get_stage_stats() */
+    DecStageStats stage_stats;
 } EbDecHandle;
 
 /* Thread level context data */
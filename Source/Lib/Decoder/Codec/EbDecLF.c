@@ -560,28 +560,13 @@ void dec_loop_filter_row(EbDecHandle *dec_handle_ptr, EbPictureBufferDesc *recon
     }
 }
 
-/*Frame level function to trigger loop filter for each superblock*/
-void dec_av1_loop_filter_frame(EbDecHandle *dec_handle_ptr, EbPictureBufferDesc *recon_picture_buf,
-                               LfCtxt *lf_ctxt, int32_t plane_start, int32_t plane_end,
-                               int32_t is_mt, int enable_flag) {
-    if (!enable_flag) return;
-
-    FrameHeader *frm_hdr      = &dec_handle_ptr->frame_header;
-    SeqHeader *  seq_header   = &dec_handle_ptr->seq_header;
-    uint8_t      sb_size_log2 = seq_header->sb_size_log2;
-    uint32_t     x_sb_index;
-    uint32_t     y_sb_index;
-    uint32_t     sb_origin_x;
-    uint32_t     sb_origin_y;
-    EbBool       end_of_row_flag;
-
+/* Set up the loop filter of a frame before its SB rows are filtered */
+void dec_av1_loop_filter_frame_setup(EbDecHandle *dec_handle_ptr, LfCtxt *lf_ctxt,
+                                     int32_t plane_start, int32_t plane_end) {
+    FrameHeader *    frm_hdr = &dec_handle_ptr->frame_header;
     LoopFilterInfoN *lf_info = &lf_ctxt->lf_info;
-    lf_ctxt->delta_lf_stride = dec_handle_ptr->master_frame_buf.sb_cols * FRAME_LF_COUNT;
 
-    int32_t  sb_size_w            = block_size_wide[seq_header->sb_size];
-    int32_t  sb_size_h            = block_size_high[seq_header->sb_size];
-    uint32_t pic_width_in_sb      = (seq_header->max_frame_width + sb_size_w - 1) / sb_size_w;
-    uint32_t picture_height_in_sb = (seq_header->max_frame_height + sb_size_h - 1) / sb_size_h;
+    lf_ctxt->delta_lf_stride = dec_handle_ptr->master_frame_buf.sb_cols * FRAME_LF_COUNT;
 
     frm_hdr->loop_filter_params.combine_vert_horz_lf = 1;
     /*init hev threshold const vectors*/
@@ -592,13 +577,63 @@ void dec_av1_loop_filter_frame(EbDecHandle *dec_handle_ptr, EbPictureBufferDesc
 
     set_lbd_lf_filter_tap_functions();
     set_hbd_lf_filter_tap_functions();
+}
+
+/* Single thread loop filter of a SB row */
+void dec_av1_loop_filter_sb_row(EbDecHandle *dec_handle_ptr, EbPictureBufferDesc *recon_picture_buf,
+                                LfCtxt *lf_ctxt, uint32_t y_sb_index, int32_t plane_start,
+                                int32_t plane_end) {
+    MasterFrameBuf *master_frame_buf = &dec_handle_ptr->master_frame_buf;
+    CurFrameBuf *   frame_buf        = &master_frame_buf->cur_frame_bufs[0];
+    FrameHeader *   frm_hdr          = &dec_handle_ptr->frame_header;
+    SeqHeader *     seq_header       = &dec_handle_ptr->seq_header;
+    uint8_t         sb_size_log2     = seq_header->sb_size_log2;
+    int32_t         sb_size_w        = block_size_wide[seq_header->sb_size];
+    uint32_t        pic_width_in_sb  = (seq_header->max_frame_width + sb_size_w - 1) / sb_size_w;
+    uint32_t        sb_origin_y      = y_sb_index << sb_size_log2;
+
+    for (uint32_t x_sb_index = 0; x_sb_index < pic_width_in_sb; ++x_sb_index) {
+        uint32_t sb_origin_x     = x_sb_index << sb_size_log2;
+        EbBool   end_of_row_flag = (x_sb_index == pic_width_in_sb - 1) ? EB_TRUE : EB_FALSE;
+
+        SBInfo *sb_info =
+            frame_buf->sb_info + (((y_sb_index * master_frame_buf->sb_cols) + x_sb_index));
+
+        /*LF function for a SB*/
+        dec_loop_filter_sb(frm_hdr,
+                           seq_header,
+                           recon_picture_buf,
+                           lf_ctxt,
+                           &lf_ctxt->lf_info,
+                           sb_origin_y >> 2,
+                           sb_origin_x >> 2,
+                           plane_start,
+                           plane_end,
+                           end_of_row_flag,
+                           sb_info->sb_delta_lf);
+    }
+}
+
+/*Frame level function to trigger loop filter for each superblock*/
+void dec_av1_loop_filter_frame(EbDecHandle *dec_handle_ptr, EbPictureBufferDesc *recon_picture_buf,
+                               LfCtxt *lf_ctxt, int32_t plane_start, int32_t plane_end,
+                               int32_t is_mt, int enable_flag) {
+    if (!enable_flag) return;
+
+    SeqHeader *seq_header = &dec_handle_ptr->seq_header;
+    uint32_t   y_sb_index;
+
+    int32_t  sb_size_h            = block_size_high[seq_header->sb_size];
+    uint32_t picture_height_in_sb = (seq_header->max_frame_height + sb_size_h - 1) / sb_size_h;
+
+    dec_av1_loop_filter_frame_setup(dec_handle_ptr, lf_ctxt, plane_start, plane_end);
 
     if (is_mt) {
         for (y_sb_index = 0; y_sb_index < picture_height_in_sb; ++y_sb_index) {
             dec_loop_filter_row(dec_handle_ptr,
                                 recon_picture_buf,
                                 lf_ctxt,
-                                lf_info,
+                                &lf_ctxt->lf_info,
                                 y_sb_index,
                                 plane_start,
                                 plane_end);
@@ -606,33 +641,8 @@ void dec_av1_loop_filter_frame(EbDecHandle *dec_handle_ptr, EbPictureBufferDesc
     } else {
         /*Loop over a frame : tregger dec_loop_filter_sb for each SB*/
         for (y_sb_index = 0; y_sb_index < picture_height_in_sb; ++y_sb_index) {
-            for (x_sb_index = 0; x_sb_index < pic_width_in_sb; ++x_sb_index) {
-                sb_origin_x     = x_sb_index << sb_size_log2;
-                sb_origin_y     = y_sb_index << sb_size_log2;
-                end_of_row_flag = (x_sb_index == pic_width_in_sb - 1) ? EB_TRUE : EB_FALSE;
-
-                MasterFrameBuf *master_frame_buf = &dec_handle_ptr->master_frame_buf;
-                CurFrameBuf *   frame_buf        = &master_frame_buf->cur_frame_bufs[0];
-
-                SBInfo *sb_info =
-                    frame_buf->sb_info + (((y_sb_index * master_frame_buf->sb_cols) + x_sb_index));
-
-                /*sb_info->sb_delta_lf = frame_buf->delta_lf + (FRAME_LF_COUNT *
-                    ((y_sb_index * master_frame_buf->sb_cols) + x_sb_index));*/
-
-                /*LF function for a SB*/
-                dec_loop_filter_sb(frm_hdr,
-                                   seq_header,
-                                   recon_picture_buf,
-                                   lf_ctxt,
-                                   lf_info,
-                                   sb_origin_y >> 2,
-                                   sb_origin_x >> 2,
-                                   plane_start,
-                                   plane_end,
-                                   end_of_row_flag,
-                                   sb_info->sb_delta_lf);
-            }
+            dec_av1_loop_filter_sb_row(
+                dec_handle_ptr, recon_picture_buf, lf_ctxt, y_sb_index, plane_start, plane_end);
         }
     }
 }
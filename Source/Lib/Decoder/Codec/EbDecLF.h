@@ -60,6 +60,13 @@ void dec_av1_loop_filter_frame(EbDecHandle *dec_handle_ptr, EbPictureBufferDesc
                                LfCtxt *lf_ctxt, int32_t plane_start, int32_t plane_end,
                                int32_t is_mt, int enable_flag);
 
+void dec_av1_loop_filter_frame_setup(EbDecHandle *dec_handle_ptr, LfCtxt *lf_ctxt,
+                                     int32_t plane_start, int32_t plane_end);
+
+void dec_av1_loop_filter_sb_row(EbDecHandle *dec_handle_ptr, EbPictureBufferDesc *recon_picture_buf,
+                                LfCtxt *lf_ctxt, uint32_t y_sb_index, int32_t plane_start,
+                                int32_t plane_end);
+
 void set_lbd_lf_filter_tap_functions(void);
 void set_hbd_lf_filter_tap_functions(void);
 
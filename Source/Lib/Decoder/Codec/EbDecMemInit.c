@@ -414,7 +414,12 @@ static EbErrorType init_lr_ctxt(EbDecHandle  *dec_handle_ptr)
     lr_ctxt->dst_stride = ALIGN_POWER_OF_TWO(frame_width, 4);
 
     EB_MALLOC_DEC(uint8_t *, lr_ctxt->dst, lr_ctxt->dst_stride *
-        (frame_height) * sizeof(uint8_t) << use_highbd, EB_N_PTR);
+        AOMMIN(frame_height, LR_UNIT_ROW_MAX_HEIGHT) * sizeof(uint8_t) << use_highbd, EB_N_PTR);
+
+    for (int plane = 0; plane < num_planes; plane++) {
+        EB_MALLOC_DEC(uint8_t *, lr_ctxt->pending[plane], lr_ctxt->dst_stride *
+            RESTORATION_BORDER * sizeof(uint8_t) << use_highbd, EB_N_PTR);
+    }
 
     return return_error;
 }
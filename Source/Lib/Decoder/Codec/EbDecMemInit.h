@@ -10,10 +10,19 @@
 extern "C" {
 #endif
 
-extern EbMemoryMapEntry *svt_dec_memory_map;
-extern uint32_t         *svt_dec_memory_map_index;
-extern uint64_t         *svt_dec_total_lib_memory;
-extern uint32_t          svt_dec_lib_malloc_count;
+/* The allocation list pointers are per thread so that several decoder
+ * handles can decode concurrently. Every API entry point binds them to the
+ * handle it works on, see dec_mem_map_bind(). */
+#ifdef _MSC_VER
+#define DEC_THREAD_LOCAL __declspec(thread)
+#else
+#define DEC_THREAD_LOCAL __thread
+#endif
+
+extern DEC_THREAD_LOCAL EbMemoryMapEntry *svt_dec_memory_map;
+extern DEC_THREAD_LOCAL uint32_t         *svt_dec_memory_map_index;
+extern DEC_THREAD_LOCAL uint64_t         *svt_dec_total_lib_memory;
+extern DEC_THREAD_LOCAL uint32_t          svt_dec_lib_malloc_count;
 
 #ifdef _WIN32
 #define EB_ALLIGN_MALLOC_DEC(type, pointer, n_elements, pointer_class)                  \
@@ -14,6 +14,8 @@
 * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
 */
 
+#include <limits.h>
+
 #include "EbDefinitions.h"
 #include "EbPictureBufferDesc.h"
 
@@ -1062,8 +1064,11 @@ void svt_setup_motion_field(EbDecHandle *dec_handle, DecThreadCtxt *thread_ctxt)
         }
         eb_release_mutex(dec_mt_frame_data->temp_mutex);
 
+        /* A thread that left early for the exit does not come here, so
+           stop waiting for it once dec_sync_all_threads() is called */
         volatile uint32_t *num_threads_header = &dec_mt_frame_data->num_threads_header;
-        while (*num_threads_header != dec_handle->dec_config.threads)
+        volatile EbBool *  end_flag           = &dec_mt_frame_data->end_flag;
+        while (*num_threads_header != dec_handle->dec_config.threads && *end_flag == EB_FALSE)
             ;
     }
 }
@@ -1647,48 +1652,48 @@ void reset_skip_context(ParseCtxt *parse_ctxt, PartitionInfo *pi, BlockSize bsiz
     }
 }
 
-void update_coeff_ctx(ParseCtxt *parse_ctxt, int plane, PartitionInfo *pi, TxSize tx_size,
-                      uint32_t blk_row, uint32_t blk_col, int above_off, int left_off,
+/* Coefficient contexts of a plane of the block being parsed, shared by all
+ * its transform blocks */
+typedef struct CoeffNbrCtxt {
+    /* Above and left contexts at the top left corner of the block */
+    uint8_t *above_ctx;
+    uint8_t *left_ctx;
+    int      plane_bsize;
+    /* Transform units inside the frame, INT_MAX when the block is */
+    int      blocks_wide;
+    int      blocks_high;
+} CoeffNbrCtxt;
+
+static void set_coeff_nbr_ctxt(ParseCtxt *parse_ctxt, PartitionInfo *pi, int plane, int subx,
+                               int suby, CoeffNbrCtxt *nbr_ctxt) {
+    const BlockSize bsize = pi->mi->sb_type;
+
+    nbr_ctxt->above_ctx = parse_ctxt->parse_above_nbr4x4_ctxt->above_ctx[plane] +
+                          (pi->mi_col >> subx) - (parse_ctxt->cur_tile_info.mi_col_start >> subx);
+    nbr_ctxt->left_ctx  = parse_ctxt->parse_left_nbr4x4_ctxt->left_ctx[plane] +
+                          (pi->mi_row >> suby) - (parse_ctxt->sb_row_mi >> suby);
+    nbr_ctxt->plane_bsize =
+        (bsize == BLOCK_INVALID) ? BLOCK_INVALID : ss_size_lookup[bsize][subx][suby];
+    nbr_ctxt->blocks_wide =
+        pi->mb_to_right_edge < 0 ? max_block_wide(pi, nbr_ctxt->plane_bsize, subx) : INT_MAX;
+    nbr_ctxt->blocks_high =
+        pi->mb_to_bottom_edge < 0 ? max_block_high(pi, nbr_ctxt->plane_bsize, suby) : INT_MAX;
+}
+
+void update_coeff_ctx(const CoeffNbrCtxt *nbr_ctxt, TxSize tx_size, int above_off, int left_off,
                       int cul_level) {
-    ParseAboveNbr4x4Ctxt *above_parse_ctx = parse_ctxt->parse_above_nbr4x4_ctxt;
-    ParseLeftNbr4x4Ctxt * left_parse_ctx  = parse_ctxt->parse_left_nbr4x4_ctxt;
-
-    uint8_t suby = plane ? parse_ctxt->seq_header->color_config.subsampling_y : 0;
-    uint8_t subx = plane ? parse_ctxt->seq_header->color_config.subsampling_x : 0;
-
-    uint8_t *const above_ctx = above_parse_ctx->above_ctx[plane] + blk_col -
-                               (parse_ctxt->cur_tile_info.mi_col_start >> subx);
-    uint8_t *const left_ctx =
-        left_parse_ctx->left_ctx[plane] + (blk_row - (parse_ctxt->sb_row_mi >> suby));
-
-    const int txs_wide = tx_size_wide_unit[tx_size];
-    const int txs_high = tx_size_high_unit[tx_size];
-
-    if (pi->mb_to_right_edge < 0) {
-        int plane_bsize = (pi->mi->sb_type == BLOCK_INVALID)
-                              ? BLOCK_INVALID
-                              : ss_size_lookup[pi->mi->sb_type][subx][suby];
-        const int blocks_wide    = max_block_wide(pi, plane_bsize, subx);
-        const int above_contexts = AOMMIN(txs_wide, (blocks_wide - above_off));
-
-        memset(above_ctx, cul_level, above_contexts);
-        memset(above_ctx + above_contexts, 0, (txs_wide - above_contexts));
-    } else {
-        memset(above_ctx, cul_level, txs_wide);
-    }
+    uint8_t *const above_ctx = nbr_ctxt->above_ctx + above_off;
+    uint8_t *const left_ctx  = nbr_ctxt->left_ctx + left_off;
 
-    if (pi->mb_to_bottom_edge < 0) {
-        int plane_bsize = (pi->mi->sb_type == BLOCK_INVALID)
-                              ? BLOCK_INVALID
-                              : ss_size_lookup[pi->mi->sb_type][subx][suby];
-        const int blocks_high   = max_block_high(pi, plane_bsize, suby);
-        const int left_contexts = AOMMIN(txs_high, (blocks_high - left_off));
+    const int txs_wide       = tx_size_wide_unit[tx_size];
+    const int txs_high       = tx_size_high_unit[tx_size];
+    const int above_contexts = AOMMIN(txs_wide, nbr_ctxt->blocks_wide - above_off);
+    const int left_contexts  = AOMMIN(txs_high, nbr_ctxt->blocks_high - left_off);
 
-        memset(left_ctx, cul_level, left_contexts);
-        memset(left_ctx + left_contexts, 0, txs_high - left_contexts);
-    } else {
-        memset(left_ctx, cul_level, txs_high);
-    }
+    memset(above_ctx, cul_level, above_contexts);
+    memset(above_ctx + above_contexts, 0, txs_wide - above_contexts);
+    memset(left_ctx, cul_level, left_contexts);
+    memset(left_ctx + left_contexts, 0, txs_high - left_contexts);
 }
 
 static INLINE int rec_eob_pos(const int eob_token, const int extra) {
@@ -1697,19 +1702,17 @@ static INLINE int rec_eob_pos(const int eob_token, const int extra) {
     return eob;
 }
 
-static INLINE int get_lower_levels_ctx_2d(const uint8_t *levels, int coeff_idx, int bwl,
-                                          TxSize tx_size) {
-    assert(coeff_idx > 0);
-    int mag;
-    levels = levels + get_padded_idx(coeff_idx, bwl);
-    mag    = AOMMIN(levels[1], 3); // { 0, 1 }
-    mag += AOMMIN(levels[(1 << bwl) + TX_PAD_HOR], 3); // { 1, 0 }
-    mag += AOMMIN(levels[(1 << bwl) + TX_PAD_HOR + 1], 3); // { 1, 1 }
-    mag += AOMMIN(levels[2], 3); // { 0, 2 }
-    mag += AOMMIN(levels[(2 << bwl) + (2 << TX_PAD_HOR_LOG2)], 3); // { 2, 0 }
-
-    const int ctx = AOMMIN((mag + 1) >> 1, 4);
-    return ctx + eb_av1_nz_map_ctx_offset[tx_size][coeff_idx];
+/* Base level context of the coefficient at level_ptr, before the offset of its
+ * position */
+static INLINE int get_lower_levels_ctx_2d(const uint8_t *const level_ptr, int bwl) {
+    const int stride = (1 << bwl) + TX_PAD_HOR;
+    int       mag;
+    mag = clip_max3[level_ptr[1]]; // { 0, 1 }
+    mag += clip_max3[level_ptr[stride]]; // { 1, 0 }
+    mag += clip_max3[level_ptr[stride + 1]]; // { 1, 1 }
+    mag += clip_max3[level_ptr[2]]; // { 0, 2 }
+    mag += clip_max3[level_ptr[2 * stride]]; // { 2, 0 }
+    return AOMMIN((mag + 1) >> 1, 4);
 }
 
 static INLINE int read_golomb(SvtReader *r) {
@@ -1734,40 +1737,45 @@ static INLINE int read_golomb(SvtReader *r) {
     return x - 1;
 }
 
-static INLINE int get_br_ctx_2d(const uint8_t *const levels,
+static INLINE int get_br_ctx_2d(const uint8_t *const level_ptr,
                                 const int            c, // raster order
                                 const int            bwl) {
     assert(c > 0);
     const int row    = c >> bwl;
     const int col    = c - (row << bwl);
     const int stride = (1 << bwl) + TX_PAD_HOR;
-    const int pos    = row * stride + col;
-    int       mag    = AOMMIN(levels[pos + 1], MAX_BASE_BR_RANGE) +
-              AOMMIN(levels[pos + stride], MAX_BASE_BR_RANGE) +
-              AOMMIN(levels[pos + 1 + stride], MAX_BASE_BR_RANGE);
+    int       mag    = AOMMIN(level_ptr[1], MAX_BASE_BR_RANGE) +
+              AOMMIN(level_ptr[stride], MAX_BASE_BR_RANGE) +
+              AOMMIN(level_ptr[1 + stride], MAX_BASE_BR_RANGE);
     mag = AOMMIN((mag + 1) >> 1, 6);
     if ((row | col) < 2) return mag + 7;
     return mag + 14;
 }
 
+/* Add the range symbols of a coefficient to its base level, they all use the
+ * same 4-symbol CDF */
+static INLINE int read_coeff_br(SvtReader *r, AomCdfProb *cdf, int level) {
+    for (int idx = 0; idx < COEFF_BASE_RANGE; idx += BR_CDF_SIZE - 1) {
+        const int k = svt_read_symbol4(r, cdf, ACCT_STR);
+        level += k;
+        if (k < BR_CDF_SIZE - 1) break;
+    }
+    return level;
+}
+
 static INLINE void read_coeffs_reverse_2d(SvtReader *r, TxSize tx_size, int start_si, int end_si,
                                           const int16_t *scan, int bwl, uint8_t *levels,
                                           BaseCdfArr base_cdf, BrCdfArr br_cdf) {
+    const int8_t *const nz_map_ctx_offset = eb_av1_nz_map_ctx_offset[tx_size];
+
     for (int c = end_si; c >= start_si; --c) {
-        const int pos       = scan[c];
-        const int coeff_ctx = get_lower_levels_ctx_2d(levels, pos, bwl, tx_size);
-        const int nsymbs    = 4;
-        int       level     = svt_read_symbol(r, base_cdf[coeff_ctx], nsymbs, ACCT_STR);
-        if (level > NUM_BASE_LEVELS) {
-            const int   br_ctx = get_br_ctx_2d(levels, pos, bwl);
-            AomCdfProb *cdf    = br_cdf[br_ctx];
-            for (int idx = 0; idx < COEFF_BASE_RANGE; idx += BR_CDF_SIZE - 1) {
-                const int k = svt_read_symbol(r, cdf, BR_CDF_SIZE, ACCT_STR);
-                level += k;
-                if (k < BR_CDF_SIZE - 1) break;
-            }
-        }
-        levels[get_padded_idx(pos, bwl)] = level;
+        const int      pos       = scan[c];
+        uint8_t *const level_ptr = levels + get_padded_idx(pos, bwl);
+        const int coeff_ctx = get_lower_levels_ctx_2d(level_ptr, bwl) + nz_map_ctx_offset[pos];
+        int       level     = svt_read_symbol4(r, base_cdf[coeff_ctx], ACCT_STR);
+        if (level > NUM_BASE_LEVELS)
+            level = read_coeff_br(r, br_cdf[get_br_ctx_2d(level_ptr, pos, bwl)], level);
+        *level_ptr = level;
     }
 }
 
@@ -1778,17 +1786,9 @@ static INLINE void read_coeffs_reverse(SvtReader *r, TxSize tx_size, TxType tx_t
     for (int c = end_si; c >= start_si; --c) {
         const int pos       = scan[c];
         const int coeff_ctx = get_lower_levels_ctx(levels, pos, bwl, tx_size, tx_class);
-        const int nsymbs    = 4;
-        int       level     = svt_read_symbol(r, base_cdf[coeff_ctx], nsymbs, ACCT_STR);
-        if (level > NUM_BASE_LEVELS) {
-            const int   br_ctx = get_br_ctx(levels, pos, bwl, tx_type);
-            AomCdfProb *cdf    = br_cdf[br_ctx];
-            for (int idx = 0; idx < COEFF_BASE_RANGE; idx += BR_CDF_SIZE - 1) {
-                const int k = svt_read_symbol(r, cdf, BR_CDF_SIZE, ACCT_STR);
-                level += k;
-                if (k < BR_CDF_SIZE - 1) break;
-            }
-        }
+        int       level     = svt_read_symbol4(r, base_cdf[coeff_ctx], ACCT_STR);
+        if (level > NUM_BASE_LEVELS)
+            level = read_coeff_br(r, br_cdf[get_br_ctx(levels, pos, bwl, tx_type)], level);
         levels[get_padded_idx(pos, bwl)] = level;
     }
 }
@@ -1800,7 +1800,7 @@ static INLINE void set_dc_sign(int *cul_level, int dc_val) {
         *cul_level += 2 << COEFF_CONTEXT_BITS;
 }
 
-uint16_t parse_coeffs(ParseCtxt *parse_ctxt, PartitionInfo *xd, uint32_t blk_row, uint32_t blk_col,
+uint16_t parse_coeffs(ParseCtxt *parse_ctxt, PartitionInfo *xd, const CoeffNbrCtxt *nbr_ctxt,
                       int above_off, int left_off, int plane, int txb_skip_ctx, int dc_sign_ctx,
                       TxSize tx_size, int32_t *coeff_buf, TransformInfo_t *trans_info) {
     SvtReader *r      = &parse_ctxt->r;
@@ -1829,8 +1829,7 @@ uint16_t parse_coeffs(ParseCtxt *parse_ctxt, PartitionInfo *xd, uint32_t blk_row
             trans_info->cbf      = 0;
         }
 
-        update_coeff_ctx(
-            parse_ctxt, plane, xd, tx_size, blk_row, blk_col, above_off, left_off, cul_level);
+        update_coeff_ctx(nbr_ctxt, tx_size, above_off, left_off, cul_level);
 
         return 0;
     }
@@ -1919,11 +1918,7 @@ uint16_t parse_coeffs(ParseCtxt *parse_ctxt, PartitionInfo *xd, uint32_t blk_row
     if (level > NUM_BASE_LEVELS) {
         const int br_ctx = get_br_ctx_eob(pos, bwl, tx_class);
         cdf              = frm_ctx->coeff_br_cdf[AOMMIN(txs_ctx, TX_32X32)][plane_type][br_ctx];
-        for (int idx = 0; idx < COEFF_BASE_RANGE / (BR_CDF_SIZE - 1); idx++) {
-            int coeff_br = svt_read_symbol(r, cdf, BR_CDF_SIZE, ACCT_STR);
-            level += coeff_br;
-            if (coeff_br < BR_CDF_SIZE - 1) break;
-        }
+        level            = read_coeff_br(r, cdf, level);
     }
     levels[get_padded_idx(pos, bwl)] = level;
 
@@ -1980,8 +1975,7 @@ uint16_t parse_coeffs(ParseCtxt *parse_ctxt, PartitionInfo *xd, uint32_t blk_row
     cul_level = AOMMIN(COEFF_CONTEXT_MASK, cul_level);
     set_dc_sign(&cul_level, dc_val);
 
-    update_coeff_ctx(
-        parse_ctxt, plane, xd, tx_size, blk_row, blk_col, above_off, left_off, cul_level);
+    update_coeff_ctx(nbr_ctxt, tx_size, above_off, left_off, cul_level);
 
     trans_info->cbf = 1;
     assert(eob);
@@ -2124,29 +2118,22 @@ static INLINE int get_entropy_context(TxSize tx_size, const uint8_t *a, const ui
     return combine_entropy_contexts(above_ec, left_ec);
 }
 
-static INLINE void dec_get_txb_ctx(ParseCtxt *parse_ctx, const TxSize tx_size, const int plane,
-                                   int plane_bsize, int txb_h_unit, int txb_w_unit, int blk_row,
+static INLINE void dec_get_txb_ctx(const CoeffNbrCtxt *nbr_ctxt, const TxSize tx_size,
+                                   const int plane, int txb_h_unit, int txb_w_unit, int blk_row,
                                    int blk_col, TXB_CTX *const txb_ctx) {
 #define MAX_TX_SIZE_UNIT 16
 
-    ParseAboveNbr4x4Ctxt *above_parse_ctx = parse_ctx->parse_above_nbr4x4_ctxt;
-    ParseLeftNbr4x4Ctxt * left_parse_ctx  = parse_ctx->parse_left_nbr4x4_ctxt;
-    EbColorConfig *       clr_cfg         = &parse_ctx->seq_header->color_config;
-
-    int suby    = plane ? clr_cfg->subsampling_y : 0;
-    int subx    = plane ? clr_cfg->subsampling_x : 0;
-    int dc_sign = 0;
-    int k       = 0;
+    const int plane_bsize = nbr_ctxt->plane_bsize;
+    int       dc_sign     = 0;
+    int       k           = 0;
 
     static const int8_t signs[3]                                   = {0, -1, 1};
     static const int8_t dc_sign_contexts[4 * MAX_TX_SIZE_UNIT + 1] = {
         1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
         1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
         2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
-    uint8_t *above_ctx = above_parse_ctx->above_ctx[plane] + blk_col -
-                         (parse_ctx->cur_tile_info.mi_col_start >> subx);
-    uint8_t *left_ctx =
-        left_parse_ctx->left_ctx[plane] + (blk_row - (parse_ctx->sb_row_mi >> suby));
+    const uint8_t *above_ctx = nbr_ctxt->above_ctx + blk_col;
+    const uint8_t *left_ctx  = nbr_ctxt->left_ctx + blk_row;
 
     do {
         const unsigned int sign = ((uint8_t)above_ctx[k] >> COEFF_CONTEXT_BITS);
@@ -2199,52 +2186,27 @@ static INLINE void dec_get_txb_ctx(ParseCtxt *parse_ctx, const TxSize tx_size, c
 #undef MAX_TX_SIZE_UNIT
 }
 
-uint16_t parse_transform_block(ParseCtxt *parse_ctx, PartitionInfo *pi, int32_t *coeff,
+uint16_t parse_transform_block(ParseCtxt *parse_ctx, PartitionInfo *pi,
+                               const CoeffNbrCtxt *nbr_ctxt, int32_t *coeff,
                                TransformInfo_t *trans_info, int plane, int blk_col, int blk_row,
-                               int start_x, int start_y, TxSize tx_size, int sub_x, int sub_y) {
-    uint16_t eob = 0;
-    TXB_CTX  txb_ctx;
-
-    BlockSize bsize = pi->mi->sb_type;
-    int       plane_bsize =
-        (bsize == BLOCK_INVALID) ? BLOCK_INVALID : ss_size_lookup[bsize][sub_x][sub_y];
-
-    int txb_w_unit = tx_size_wide_unit[tx_size];
-    int txb_h_unit = tx_size_high_unit[tx_size];
-
-    if (pi->mb_to_right_edge < 0) {
-        int plane_bsize = (pi->mi->sb_type == BLOCK_INVALID)
-                              ? BLOCK_INVALID
-                              : ss_size_lookup[pi->mi->sb_type][sub_x][sub_y];
-        const int blocks_wide = max_block_wide(pi, plane_bsize, sub_x);
-        txb_w_unit            = AOMMIN(txb_w_unit, (blocks_wide - blk_col));
-    }
-
-    if (pi->mb_to_bottom_edge < 0) {
-        int plane_bsize = (pi->mi->sb_type == BLOCK_INVALID)
-                              ? BLOCK_INVALID
-                              : ss_size_lookup[pi->mi->sb_type][sub_x][sub_y];
-        const int blocks_high = max_block_high(pi, plane_bsize, sub_y);
-        txb_h_unit            = AOMMIN(txb_h_unit, (blocks_high - blk_row));
-    }
-
-    dec_get_txb_ctx(
-        parse_ctx, tx_size, plane, plane_bsize, txb_h_unit, txb_w_unit, start_y, start_x, &txb_ctx);
-
-    eob = parse_coeffs(parse_ctx,
-                       pi,
-                       start_y,
-                       start_x,
-                       blk_col,
-                       blk_row,
-                       plane,
-                       txb_ctx.txb_skip_ctx,
-                       txb_ctx.dc_sign_ctx,
-                       tx_size,
-                       coeff,
-                       trans_info);
-
-    return eob;
+                               TxSize tx_size) {
+    TXB_CTX   txb_ctx;
+    const int txb_w_unit = AOMMIN(tx_size_wide_unit[tx_size], nbr_ctxt->blocks_wide - blk_col);
+    const int txb_h_unit = AOMMIN(tx_size_high_unit[tx_size], nbr_ctxt->blocks_high - blk_row);
+
+    dec_get_txb_ctx(nbr_ctxt, tx_size, plane, txb_h_unit, txb_w_unit, blk_row, blk_col, &txb_ctx);
+
+    return parse_coeffs(parse_ctx,
+                        pi,
+                        nbr_ctxt,
+                        blk_col,
+                        blk_row,
+                        plane,
+                        txb_ctx.txb_skip_ctx,
+                        txb_ctx.dc_sign_ctx,
+                        tx_size,
+                        coeff,
+                        trans_info);
 }
 
 void parse_residual(ParseCtxt *parse_ctx, PartitionInfo *pi, BlockSize mi_size) {
@@ -2282,6 +2244,17 @@ void parse_residual(ParseCtxt *parse_ctx, PartitionInfo *pi, BlockSize mi_size)
         (sb_info->sb_trans_info[AOM_PLANE_U] + mode->first_txb_offset[AOM_PLANE_U]) +
         num_chroma_tus;
 
+    CoeffNbrCtxt nbr_ctxt[MAX_MB_PLANE];
+    if (!skip) {
+        for (int plane = 0; plane < num_planes; ++plane) {
+            int sub_x = (plane > 0) ? color_info->subsampling_x : 0;
+            int sub_y = (plane > 0) ? color_info->subsampling_y : 0;
+
+            if (plane && !pi->is_chroma_ref) break;
+            set_coeff_nbr_ctxt(parse_ctx, pi, plane, sub_x, sub_y, &nbr_ctxt[plane]);
+        }
+    }
+
     for (int row = 0; row < max_blocks_high; row += mu_blocks_high) {
         for (int col = 0; col < max_blocks_wide; col += mu_blocks_wide) {
             for (int plane = 0; plane < num_planes; ++plane) {
@@ -2341,16 +2314,13 @@ void parse_residual(ParseCtxt *parse_ctx, PartitionInfo *pi, BlockSize mi_size)
                     if (!skip) {
                         eob = parse_transform_block(parse_ctx,
                                                     pi,
+                                                    &nbr_ctxt[plane],
                                                     coeff,
                                                     trans_info[plane],
                                                     plane,
                                                     blk_col,
                                                     blk_row,
-                                                    start_x,
-                                                    start_y,
-                                                    trans_info[plane]->tx_size,
-                                                    sub_x,
-                                                    sub_y);
+                                                    trans_info[plane]->tx_size);
                     }
 
                     if (eob != 0) {
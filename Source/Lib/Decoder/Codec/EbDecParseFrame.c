@@ -206,6 +206,17 @@ EbErrorType parse_tile(EbDecHandle *dec_handle_ptr, ParseCtxt *parse_ctx, TilesI
          mi_row += dec_handle_ptr->seq_header.sb_mi_size) {
         int32_t sb_row = (mi_row << MI_SIZE_LOG2) >> dec_handle_ptr->seq_header.sb_size_log2;
 
+        volatile uint32_t *sb_parsed_in_row = NULL;
+        uint32_t           num_sb_parsed    = 0;
+        if (is_mt) {
+            DecMtFrameData *dec_mt_frame_data =
+                &dec_handle_ptr->master_frame_buf.cur_frame_bufs[0]
+                     .dec_mt_frame_data; //multi frame Parallel 0 -> idx
+            assert(sb_row >= sb_row_tile_start);
+            sb_parsed_in_row = &dec_mt_frame_data->parse_recon_tile_info_array[tile_num]
+                                    .sb_recon_row_parsed[sb_row - sb_row_tile_start];
+        }
+
         clear_left_context(parse_ctx);
 
         /*TODO: Move CFL to thread ctxt! We need to access DecModCtxt
@@ -291,10 +302,19 @@ EbErrorType parse_tile(EbDecHandle *dec_handle_ptr, ParseCtxt *parse_ctx, TilesI
             parse_ctx->cur_coeff_buf[AOM_PLANE_V]    = sb_info->sb_coeff[AOM_PLANE_V];
             parse_ctx->prev_blk_has_chroma           = 1; //default at start of frame / tile
 
+            /* The stages are timed by the single thread decoder only */
+            DecStageStats *stats = &dec_handle_ptr->stage_stats;
+            uint64_t       start = is_mt ? 0 : dec_stage_start(stats);
+
             // Bit-stream parsing of the superblock
             parse_super_block(dec_handle_ptr, parse_ctx, mi_row, mi_col, sb_info);
 
+            /* The recon of the SB row follows the parsing SB by SB */
+            if (is_mt) *sb_parsed_in_row = ++num_sb_parsed;
+
             if (!is_mt) {
+                dec_stage_end(stats, DEC_STAGE_PARSE, start);
+
                 /* Init DecModCtxt */
                 DecModCtxt *dec_mod_ctxt = (DecModCtxt *)dec_handle_ptr->pv_dec_mod_ctxt;
                 dec_mod_ctxt->cur_coeff[AOM_PLANE_Y] = sb_info->sb_coeff[AOM_PLANE_Y];
@@ -305,17 +325,11 @@ EbErrorType parse_tile(EbDecHandle *dec_handle_ptr, ParseCtxt *parse_ctx, TilesI
 
                 /* TO DO : Will move later */
                 // decoding of the superblock
+                start = dec_stage_start(stats);
                 decode_super_block(dec_mod_ctxt, mi_row, mi_col, sb_info);
+                dec_stage_end(stats, DEC_STAGE_RECON, start);
             }
         }
-        if (is_mt) {
-            DecMtFrameData *dec_mt_frame_data =
-                &dec_handle_ptr->master_frame_buf.cur_frame_bufs[0]
-                     .dec_mt_frame_data; //multi frame Parallel 0 -> idx
-            assert(sb_row >= sb_row_tile_start);
-            dec_mt_frame_data->parse_recon_tile_info_array[tile_num]
-                .sb_recon_row_parsed[sb_row - sb_row_tile_start] = 1;
-        }
     }
 
     return status;
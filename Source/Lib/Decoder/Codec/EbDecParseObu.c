@@ -36,6 +36,7 @@
 #include "EbDecLF.h"
 
 #include "EbDecCdef.h"
+#include "EbDecPostFilter.h"
 #include "EbLog.h"
 
 void dec_av1_loop_filter_frame_mt(EbDecHandle *        dec_handle_ptr,
@@ -2326,44 +2327,58 @@ EbErrorType read_tile_group_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr, TilesI
                               lr_param[AOM_PLANE_V].frame_restoration_type != RESTORE_NONE);
     EbBool    do_lr_non_opt = !opt_lr && do_lr;
 
-    if (is_mt) {
-        dec_av1_loop_filter_frame_mt(dec_handle_ptr,
-                                     dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
-                                     dec_handle_ptr->pv_lf_ctxt,
-                                     &((LfCtxt *)dec_handle_ptr->pv_lf_ctxt)->lf_info,
-                                     AOM_PLANE_Y,
-                                     MAX_MB_PLANE,
-                                     NULL);
+    if (!is_mt && !do_upscale) {
+        dec_post_filter_frame(dec_handle_ptr, do_lf_flag, do_cdef, do_lr, opt_lr);
     } else {
-        dec_av1_loop_filter_frame(dec_handle_ptr,
-                                  dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
-                                  dec_handle_ptr->pv_lf_ctxt,
-                                  AOM_PLANE_Y,
-                                  MAX_MB_PLANE,
-                                  is_mt,
-                                  do_lf_flag);
-    }
+        /* The stages are timed by the single thread decoder only */
+        DecStageStats *stats = &dec_handle_ptr->stage_stats;
+        uint64_t       start = is_mt ? 0 : dec_stage_start(stats);
+
+        if (is_mt) {
+            dec_av1_loop_filter_frame_mt(dec_handle_ptr,
+                                         dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
+                                         dec_handle_ptr->pv_lf_ctxt,
+                                         &((LfCtxt *)dec_handle_ptr->pv_lf_ctxt)->lf_info,
+                                         AOM_PLANE_Y,
+                                         MAX_MB_PLANE,
+                                         NULL);
+        } else {
+            dec_av1_loop_filter_frame(dec_handle_ptr,
+                                      dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
+                                      dec_handle_ptr->pv_lf_ctxt,
+                                      AOM_PLANE_Y,
+                                      MAX_MB_PLANE,
+                                      is_mt,
+                                      do_lf_flag);
+            dec_stage_end(stats, DEC_STAGE_LF, start);
+        }
 
-    if (!is_mt) dec_av1_loop_restoration_save_boundary_lines(dec_handle_ptr, 0, do_lr_non_opt);
+        if (!is_mt) dec_av1_loop_restoration_save_boundary_lines(dec_handle_ptr, 0, do_lr_non_opt);
 
-    if (is_mt) {
-        svt_cdef_frame_mt(dec_handle_ptr, NULL);
-    } else
-        svt_cdef_frame(dec_handle_ptr, do_cdef);
+        if (is_mt) {
+            svt_cdef_frame_mt(dec_handle_ptr, NULL);
+        } else {
+            start = dec_stage_start(stats);
+            svt_cdef_frame(dec_handle_ptr, do_cdef);
+            dec_stage_end(stats, DEC_STAGE_CDEF, start);
+        }
 
-    av1_superres_upscale(&dec_handle_ptr->cm,
-                         &dec_handle_ptr->frame_header,
-                         &dec_handle_ptr->seq_header,
-                         dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
-                         do_upscale);
+        av1_superres_upscale(&dec_handle_ptr->cm,
+                             &dec_handle_ptr->frame_header,
+                             &dec_handle_ptr->seq_header,
+                             dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf,
+                             do_upscale);
 
-    if (do_upscale)
-        dec_handle_ptr->cm.frm_size.frame_width =
-            dec_handle_ptr->frame_header.frame_size.frame_width;
+        if (do_upscale)
+            dec_handle_ptr->cm.frm_size.frame_width =
+                dec_handle_ptr->frame_header.frame_size.frame_width;
 
-    dec_av1_loop_restoration_save_boundary_lines(dec_handle_ptr, 1, do_lr_non_opt);
+        if (!is_mt) start = dec_stage_start(stats);
+        dec_av1_loop_restoration_save_boundary_lines(dec_handle_ptr, 1, do_lr_non_opt);
 
-    dec_av1_loop_restoration_filter_frame(dec_handle_ptr, opt_lr, do_lr);
+        dec_av1_loop_restoration_filter_frame(dec_handle_ptr, opt_lr, do_lr);
+        if (!is_mt) dec_stage_end(stats, DEC_STAGE_LR, start);
+    }
     /* Save CDF */
     if (frame_header->disable_frame_end_update_cdf)
         dec_handle_ptr->cur_pic_buf[0]->final_frm_ctx = master_parse_ctxt->init_frm_ctx;
@@ -2371,130 +2386,140 @@ EbErrorType read_tile_group_obu(Bitstrm *bs, EbDecHandle *dec_handle_ptr, TilesI
     pad_pic(dec_handle_ptr->cur_pic_buf[0]->ps_pic_buf, &dec_handle_ptr->frame_header, 1);
     return status;
 }
-// Decode all OBUs in a Frame
-EbErrorType decode_multiple_obu(EbDecHandle *dec_handle_ptr, uint8_t **data, size_t data_size,
-                                uint32_t is_annexb) {
-    Bitstrm   bs;
+// Decode one OBU, *data and *data_size are advanced past it
+EbErrorType decode_one_obu(EbDecHandle *dec_handle_ptr, uint8_t **data, size_t *data_size,
+                           uint32_t is_annexb, int *frame_decoding_finished) {
+    Bitstrm     bs;
     EbErrorType status = EB_ErrorNone;
     ObuHeader   obu_header;
-    int         frame_decoding_finished = 0;
+    size_t      payload_size = 0, length_size = 0;
 
-#if ENABLE_ENTROPY_TRACE
-    enable_dump = 1;
-#if FRAME_LEVEL_TRACE
-    if (enable_dump) {
-        char str[1000];
-        sprintf(str, "SVT_fr_%d.txt", dec_handle_ptr->dec_cnt);
-        if (temp_fp == NULL) temp_fp = fopen(str, "w");
-    }
-#else
-    if (temp_fp == NULL) temp_fp = fopen("SVT.txt", "w");
-#endif
-#endif
+    /* Decoder memory init if not done */
+    if (0 == dec_handle_ptr->mem_init_done && 1 == dec_handle_ptr->seq_header_done)
+        status = dec_mem_init(dec_handle_ptr);
+    if (status != EB_ErrorNone) return status;
 
-    while (!frame_decoding_finished) {
-        size_t payload_size = 0, length_size = 0;
+    dec_bits_init(&bs, *data, *data_size);
 
-        /* Decoder memory init if not done */
-        if (0 == dec_handle_ptr->mem_init_done && 1 == dec_handle_ptr->seq_header_done)
-            status = dec_mem_init(dec_handle_ptr);
+    if (is_annexb) {
+        // read the size of OBU
+        status = read_obu_size(&bs, *data_size, &obu_header.payload_size, &length_size);
         if (status != EB_ErrorNone) return status;
 
-        dec_bits_init(&bs, *data, data_size);
-
-        if (is_annexb) {
-            // read the size of OBU
-            status = read_obu_size(&bs, data_size, &obu_header.payload_size, &length_size);
-            if (status != EB_ErrorNone) return status;
+        *data += length_size;
+        *data_size -= length_size;
+        length_size = 0;
+    }
 
-            *data += length_size;
-            data_size -= length_size;
-            length_size = 0;
-        }
+    status = read_obu_header_size(&bs, &obu_header, *data_size, &length_size);
+    if (status != EB_ErrorNone) return status;
 
-        status = read_obu_header_size(&bs, &obu_header, data_size, &length_size);
-        if (status != EB_ErrorNone) return status;
+    if (is_annexb) obu_header.payload_size -= obu_header.size;
 
-        if (is_annexb) obu_header.payload_size -= obu_header.size;
+    payload_size = obu_header.payload_size;
 
-        payload_size = obu_header.payload_size;
+    *data += (obu_header.size + length_size);
+    *data_size -= (obu_header.size + length_size);
 
-        *data += (obu_header.size + length_size);
-        data_size -= (obu_header.size + length_size);
+    if (*data_size < payload_size) return EB_Corrupt_Frame;
 
-        if (data_size < payload_size) return EB_Corrupt_Frame;
+    dec_bits_init(&bs, *data, payload_size);
 
-        dec_bits_init(&bs, *data, payload_size);
+    switch (obu_header.obu_type) {
+    case OBU_TEMPORAL_DELIMITER:
+        PRINT_NAME("**************OBU_TEMPORAL_DELIMITER*******************");
+        read_temporal_delimitor_obu(&dec_handle_ptr->seen_frame_header);
+        break;
 
-        switch (obu_header.obu_type) {
-        case OBU_TEMPORAL_DELIMITER:
-            PRINT_NAME("**************OBU_TEMPORAL_DELIMITER*******************");
-            read_temporal_delimitor_obu(&dec_handle_ptr->seen_frame_header);
-            break;
+    case OBU_SEQUENCE_HEADER: {
+        PRINT_NAME("**************OBU_SEQUENCE_HEADER*******************")
+        BlockSize prev_sb_size          = dec_handle_ptr->seq_header.sb_size;
+        uint16_t  prev_max_frame_width  = dec_handle_ptr->seq_header.max_frame_width;
+        uint16_t  prev_max_frame_height = dec_handle_ptr->seq_header.max_frame_height;
 
-        case OBU_SEQUENCE_HEADER: {
-            PRINT_NAME("**************OBU_SEQUENCE_HEADER*******************")
-            BlockSize prev_sb_size          = dec_handle_ptr->seq_header.sb_size;
-            uint16_t  prev_max_frame_width  = dec_handle_ptr->seq_header.max_frame_width;
-            uint16_t  prev_max_frame_height = dec_handle_ptr->seq_header.max_frame_height;
+        status = read_sequence_header_obu(&bs, &dec_handle_ptr->seq_header);
+        if (status != EB_ErrorNone) return status;
+        if (dec_handle_ptr->seq_header.color_config.bit_depth == EB_TWELVE_BIT)
+            dec_init_intra_predictors_12b_internal();
+        dec_handle_ptr->seq_header_done = 1;
+        if (prev_sb_size != dec_handle_ptr->seq_header.sb_size ||
+            prev_max_frame_width != dec_handle_ptr->seq_header.max_frame_width ||
+            prev_max_frame_height != dec_handle_ptr->seq_header.max_frame_height) {
+            dec_handle_ptr->mem_init_done = 0;
+        }
+        break;
+    }
+    case OBU_FRAME_HEADER:
+    case OBU_REDUNDANT_FRAME_HEADER:
+    case OBU_FRAME:
+        if (obu_header.obu_type == OBU_FRAME) {
+            PRINT_NAME("**************OBU_FRAME*******************");
+            dec_handle_ptr->show_existing_frame = 0;
+        } else if (obu_header.obu_type == OBU_FRAME_HEADER) {
+            PRINT_NAME("**************OBU_FRAME_HEADER*******************");
+            assert(dec_handle_ptr->seen_frame_header == 0);
+        } else {
+            PRINT_NAME("**************OBU_REDUNDANT_FRAME_HEADER*******************");
+            assert(dec_handle_ptr->seen_frame_header == 1);
+        }
 
-            status = read_sequence_header_obu(&bs, &dec_handle_ptr->seq_header);
-            if (status != EB_ErrorNone) return status;
-            if (dec_handle_ptr->seq_header.color_config.bit_depth == EB_TWELVE_BIT)
-                dec_init_intra_predictors_12b_internal();
-            dec_handle_ptr->seq_header_done = 1;
-            if (prev_sb_size != dec_handle_ptr->seq_header.sb_size ||
-                prev_max_frame_width != dec_handle_ptr->seq_header.max_frame_width ||
-                prev_max_frame_height != dec_handle_ptr->seq_header.max_frame_height) {
-                dec_handle_ptr->mem_init_done = 0;
-            }
-            break;
+        if (!dec_handle_ptr->seen_frame_header) {
+            dec_handle_ptr->seen_frame_header = 1;
+            status                            = read_frame_header_obu(
+                &bs, dec_handle_ptr, &obu_header, obu_header.obu_type != OBU_FRAME);
         }
-        case OBU_FRAME_HEADER:
-        case OBU_REDUNDANT_FRAME_HEADER:
-        case OBU_FRAME:
-            if (obu_header.obu_type == OBU_FRAME) {
-                PRINT_NAME("**************OBU_FRAME*******************");
-                dec_handle_ptr->show_existing_frame = 0;
-            } else if (obu_header.obu_type == OBU_FRAME_HEADER) {
-                PRINT_NAME("**************OBU_FRAME_HEADER*******************");
-                assert(dec_handle_ptr->seen_frame_header == 0);
-            } else {
-                PRINT_NAME("**************OBU_REDUNDANT_FRAME_HEADER*******************");
-                assert(dec_handle_ptr->seen_frame_header == 1);
-            }
+        /*else {
+             For OBU_REDUNDANT_FRAME_HEADER, previous frame_header is taken from dec_handle_ptr->frame_header
+            //frame_header_copy(); TODO()
+        }*/
 
-            if (!dec_handle_ptr->seen_frame_header) {
-                dec_handle_ptr->seen_frame_header = 1;
-                status                            = read_frame_header_obu(
-                    &bs, dec_handle_ptr, &obu_header, obu_header.obu_type != OBU_FRAME);
-            }
-            /*else {
-                 For OBU_REDUNDANT_FRAME_HEADER, previous frame_header is taken from dec_handle_ptr->frame_header
-                //frame_header_copy(); TODO()
-            }*/
-
-            if (obu_header.obu_type != OBU_FRAME) break; // For OBU_TILE_GROUP comes under OBU_FRAME
-            goto TITLE_GROUP;
-
-        case OBU_TILE_GROUP:
-        TITLE_GROUP:
-            PRINT_NAME("**************OBU_TILE_GROUP*******************");
-            if (!dec_handle_ptr->seen_frame_header) return EB_Corrupt_Frame;
-            status = read_tile_group_obu(&bs,
-                                         dec_handle_ptr,
-                                         &dec_handle_ptr->frame_header.tiles_info,
-                                         &obu_header,
-                                         &frame_decoding_finished);
-            if (status != EB_ErrorNone) return status;
-            if (frame_decoding_finished) dec_handle_ptr->seen_frame_header = 0;
-            break;
+        if (obu_header.obu_type != OBU_FRAME) break; // For OBU_TILE_GROUP comes under OBU_FRAME
+        goto TITLE_GROUP;
 
-        default: PRINT_NAME("**************UNKNOWN OBU*******************"); break;
-        }
+    case OBU_TILE_GROUP:
+    TITLE_GROUP:
+        PRINT_NAME("**************OBU_TILE_GROUP*******************");
+        if (!dec_handle_ptr->seen_frame_header) return EB_Corrupt_Frame;
+        status = read_tile_group_obu(&bs,
+                                     dec_handle_ptr,
+                                     &dec_handle_ptr->frame_header.tiles_info,
+                                     &obu_header,
+                                     frame_decoding_finished);
+        if (status != EB_ErrorNone) return status;
+        if (*frame_decoding_finished) dec_handle_ptr->seen_frame_header = 0;
+        break;
+
+    default: PRINT_NAME("**************UNKNOWN OBU*******************"); break;
+    }
+
+    *data += payload_size;
+    *data_size -= payload_size;
+    return status;
+}
 
-        *data += payload_size;
-        data_size -= payload_size;
+// Decode all OBUs in a Frame
+EbErrorType decode_multiple_obu(EbDecHandle *dec_handle_ptr, uint8_t **data, size_t data_size,
+                                uint32_t is_annexb) {
+    EbErrorType status                  = EB_ErrorNone;
+    int         frame_decoding_finished = 0;
+
+#if ENABLE_ENTROPY_TRACE
+    enable_dump = 1;
+#if FRAME_LEVEL_TRACE
+    if (enable_dump) {
+        char str[1000];
+        sprintf(str, "SVT_fr_%d.txt", dec_handle_ptr->dec_cnt);
+        if (temp_fp == NULL) temp_fp = fopen(str, "w");
+    }
+#else
+    if (temp_fp == NULL) temp_fp = fopen("SVT.txt", "w");
+#endif
+#endif
+
+    while (!frame_decoding_finished) {
+        status = decode_one_obu(
+            dec_handle_ptr, data, &data_size, is_annexb, &frame_decoding_finished);
+        if (status != EB_ErrorNone) return status;
         if (!data_size) frame_decoding_finished = 1;
     }
 
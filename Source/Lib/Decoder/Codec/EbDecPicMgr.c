@@ -23,6 +23,8 @@
 #include <stdlib.h>
 
 #include "EbDefinitions.h"
+#include "EbMalloc.h"
+#include "EbObject.h"
 #include "EbPictureBufferDesc.h"
 
 #include "EbSvtAv1Dec.h"
@@ -72,26 +74,94 @@ EbErrorType dec_pic_mgr_init(EbDecHandle *dec_handle_ptr) {
         ps_pic_mgr->as_dec_pic[i].size       = 0;
         ps_pic_mgr->as_dec_pic[i].ref_count  = 0;
         ps_pic_mgr->as_dec_pic[i].mvs        = NULL;
+        ps_pic_mgr->as_dec_pic[i].mvs_size   = 0;
         EB_MALLOC_DEC(
             uint8_t *, ps_pic_mgr->as_dec_pic[i].segment_maps, size * sizeof(uint8_t), EB_N_PTR);
         memset(ps_pic_mgr->as_dec_pic[i].segment_maps, 0, size);
     }
 
     ps_pic_mgr->num_pic_bufs = 0;
+    ps_pic_mgr->low_memory   = dec_handle_ptr->dec_config.low_memory;
 
     return return_error;
 }
 
-static INLINE EbErrorType mvs_8x8_memory_alloc(TemporalMvRef **mvs, FrameHeader *frame_info) {
+static INLINE size_t mvs_8x8_size(FrameHeader *frame_info) {
     const int frame_mvs_stride = ROUND_POWER_OF_TWO(frame_info->mi_cols, 1);
     const int frame_mvs_rows   = ROUND_POWER_OF_TWO(frame_info->mi_rows, 1);
-    const int mvs_buff_size    = frame_mvs_stride * frame_mvs_rows;
+    return (size_t)frame_mvs_stride * frame_mvs_rows;
+}
+
+static INLINE EbErrorType mvs_8x8_memory_alloc(TemporalMvRef **mvs, FrameHeader *frame_info) {
+    const size_t mvs_buff_size = mvs_8x8_size(frame_info);
 
-    EB_MALLOC_DEC(TemporalMvRef *, *mvs, mvs_buff_size * sizeof(*mvs), EB_N_PTR);
+    EB_MALLOC_DEC(TemporalMvRef *, *mvs, mvs_buff_size * sizeof(**mvs), EB_N_PTR);
 
     return EB_ErrorNone;
 }
 
+/* Low memory mode: the picture buffer and the 8x8 MV buffer of a slot are
+ * owned by the slot, not by the decoder memory map. They are allocated
+ * together, freed together by low_mem_release_pic(), and nothing else keeps
+ * a pointer to them once the slot is free. */
+
+static void low_mem_release_pic(EbDecPicMgr *ps_pic_mgr, EbDecPicBuf *pic_buf) {
+    if (pic_buf->ps_pic_buf == NULL) return;
+    EB_DELETE(pic_buf->ps_pic_buf);
+    EB_FREE_ARRAY(pic_buf->mvs);
+    pic_buf->mvs_size = 0;
+    pic_buf->size     = 0;
+    ps_pic_mgr->num_pic_bufs--;
+}
+
+static EbErrorType low_mem_alloc_pic(EbDecPicMgr *ps_pic_mgr, EbDecPicBuf *pic_buf,
+                                     EbPictureBufferDescInitData *init_data, size_t frame_size) {
+    low_mem_release_pic(ps_pic_mgr, pic_buf);
+    EB_NEW(pic_buf->ps_pic_buf, eb_picture_buffer_desc_ctor, (EbPtr)init_data);
+    pic_buf->size = frame_size;
+    ps_pic_mgr->num_pic_bufs++;
+    return EB_ErrorNone;
+}
+
+/* Resizes the MV buffer of an allocated slot to the current frame */
+static EbErrorType low_mem_alloc_mvs(EbDecPicBuf *pic_buf, FrameHeader *frame_info) {
+    const size_t mvs_count = mvs_8x8_size(frame_info);
+
+    if (pic_buf->mvs != NULL && pic_buf->mvs_size == mvs_count) return EB_ErrorNone;
+    EB_FREE_ARRAY(pic_buf->mvs);
+    pic_buf->mvs_size = 0;
+    EB_MALLOC_ARRAY(pic_buf->mvs, mvs_count);
+    pic_buf->mvs_size = mvs_count;
+    return EB_ErrorNone;
+}
+
+/**
+*******************************************************************************
+*
+* @brief
+*  Picture manager de-initializer
+*
+* @par Description:
+*  Frees the buffers owned by the picture manager in low memory mode, the
+*  others are released with the decoder memory map
+*
+* @param[in] dec_handle_ptr
+*  Pointer to the decoder handle
+*
+* @returns
+*
+* @remarks
+*
+*******************************************************************************
+*/
+void dec_pic_mgr_deinit(EbDecHandle *dec_handle_ptr) {
+    EbDecPicMgr *ps_pic_mgr = (EbDecPicMgr *)dec_handle_ptr->pv_pic_mgr;
+
+    if (ps_pic_mgr == NULL || !ps_pic_mgr->low_memory) return;
+    for (int32_t i = 0; i < MAX_PIC_BUFS; i++)
+        low_mem_release_pic(ps_pic_mgr, &ps_pic_mgr->as_dec_pic[i]);
+}
+
 /**
 *******************************************************************************
 *
@@ -115,13 +185,29 @@ EbDecPicBuf *dec_pic_mgr_get_cur_pic(EbDecPicMgr *ps_pic_mgr, SeqHeader *seq_hea
     int32_t      i;
     EbDecPicBuf *pic_buf = NULL;
     /* TODO: Add lock and unlock for MT */
-    // Find a free buffer.
+    // Find a free buffer. In low memory mode prefer one that is still allocated
     for (i = 0; i < MAX_PIC_BUFS; i++) {
-        if (ps_pic_mgr->as_dec_pic[i].is_free == 1) break;
+        if (ps_pic_mgr->as_dec_pic[i].is_free == 1 &&
+            (!ps_pic_mgr->low_memory || ps_pic_mgr->as_dec_pic[i].ps_pic_buf != NULL))
+            break;
+    }
+    if (i >= MAX_PIC_BUFS) {
+        for (i = 0; i < MAX_PIC_BUFS; i++) {
+            if (ps_pic_mgr->as_dec_pic[i].is_free == 1) break;
+        }
     }
 
     if (i >= MAX_PIC_BUFS) return NULL;
 
+    /* The previous frame has been output once a new one starts, so the other
+       unreferenced pictures can go */
+    if (ps_pic_mgr->low_memory) {
+        for (int32_t j = 0; j < MAX_PIC_BUFS; j++) {
+            if (j != i && ps_pic_mgr->as_dec_pic[j].is_free == 1)
+                low_mem_release_pic(ps_pic_mgr, &ps_pic_mgr->as_dec_pic[j]);
+        }
+    }
+
     uint16_t       frame_width  = frame_info->frame_size.frame_width;
     uint16_t       frame_height = frame_info->frame_size.frame_height;
     EbColorConfig *cc           = &seq_header->color_config;
@@ -151,20 +237,36 @@ EbDecPicBuf *dec_pic_mgr_get_cur_pic(EbDecPicMgr *ps_pic_mgr, SeqHeader *seq_hea
 
         input_pic_buf_desc_init_data.split_mode = EB_FALSE;
 
-        EbErrorType return_error = dec_eb_recon_picture_buffer_desc_ctor(
-            (EbPtr *)&(ps_pic_mgr->as_dec_pic[i].ps_pic_buf), (EbPtr)&input_pic_buf_desc_init_data);
-        if (return_error != EB_ErrorNone) return NULL;
-
-        ps_pic_mgr->as_dec_pic[i].size = frame_size;
-
-        /* Memory for storing MV's at 8x8 lvl*/
-        EbErrorType ret_err = mvs_8x8_memory_alloc(&ps_pic_mgr->as_dec_pic[i].mvs, frame_info);
-        if (ret_err != EB_ErrorNone) return NULL;
-
-        ps_pic_mgr->num_pic_bufs++;
+        if (ps_pic_mgr->low_memory) {
+            if (low_mem_alloc_pic(ps_pic_mgr,
+                                  &ps_pic_mgr->as_dec_pic[i],
+                                  &input_pic_buf_desc_init_data,
+                                  frame_size) != EB_ErrorNone)
+                return NULL;
+        } else {
+            EbErrorType return_error = dec_eb_recon_picture_buffer_desc_ctor(
+                (EbPtr *)&(ps_pic_mgr->as_dec_pic[i].ps_pic_buf),
+                (EbPtr)&input_pic_buf_desc_init_data);
+            if (return_error != EB_ErrorNone) return NULL;
+
+            ps_pic_mgr->as_dec_pic[i].size = frame_size;
+
+            /* Memory for storing MV's at 8x8 lvl*/
+            EbErrorType ret_err =
+                mvs_8x8_memory_alloc(&ps_pic_mgr->as_dec_pic[i].mvs, frame_info);
+            if (ret_err != EB_ErrorNone) return NULL;
+            ps_pic_mgr->as_dec_pic[i].mvs_size = mvs_8x8_size(frame_info);
+
+            ps_pic_mgr->num_pic_bufs++;
+        }
     } else
         assert(ps_pic_mgr->as_dec_pic[i].ps_pic_buf != NULL);
 
+    /* Memory for storing MV's at 8x8 lvl */
+    if (ps_pic_mgr->low_memory &&
+        low_mem_alloc_mvs(&ps_pic_mgr->as_dec_pic[i], frame_info) != EB_ErrorNone)
+        return NULL;
+
     ps_pic_mgr->as_dec_pic[i].is_free   = 0;
     ps_pic_mgr->as_dec_pic[i].ref_count = 1;
 
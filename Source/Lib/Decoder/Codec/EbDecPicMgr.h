@@ -18,6 +18,9 @@ typedef struct EbDecPicMgr {
     /* number of picture buffers */
     uint8_t num_pic_bufs;
 
+    /* Low memory mode: picture buffers are only held while referenced */
+    EbBool low_memory;
+
 } EbDecPicMgr;
 
 typedef struct RefFrameInfo {
@@ -29,6 +32,8 @@ typedef struct RefFrameInfo {
 
 EbErrorType dec_pic_mgr_init(EbDecHandle *dec_handle_ptr);
 
+void dec_pic_mgr_deinit(EbDecHandle *dec_handle_ptr);
+
 EbDecPicBuf *dec_pic_mgr_get_cur_pic(EbDecPicMgr *ps_pic_mgr, SeqHeader *seq_header,
                                      FrameHeader *frame_info, EbColorFormat color_format);
 
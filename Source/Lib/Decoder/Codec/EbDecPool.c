@@ -0,0 +1,298 @@
+/*
+* Copyright(c) 2019 Netflix, Inc.
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+// SUMMARY
+//   Shared worker pool decoding the temporal units of many decoder handles
+
+/**************************************
+ * Includes
+ **************************************/
+#include <stdlib.h>
+#include <string.h>
+
+#include "EbDefinitions.h"
+#include "EbThreads.h"
+
+#include "EbSvtAv1Dec.h"
+#include "EbDecHandle.h"
+
+#include "EbLog.h"
+
+/* One submitted temporal unit, the data follows the structure */
+typedef struct DecPoolJob {
+    struct DecPoolJob *  next;
+    size_t               data_size;
+    uint32_t             is_annexb;
+    EbSvtDecPoolCallback callback;
+    void *               user_data;
+} DecPoolJob;
+
+typedef struct DecPoolStream {
+    EbSvtDecPool *        pool;
+    EbComponentType *     svt_dec_component;
+    DecPoolJob *          job_head;
+    DecPoolJob *          job_tail;
+    struct DecPoolStream *next_ready;
+    struct DecPoolStream *next_attached;
+    /* Submitted jobs not yet completed, including the running one */
+    uint32_t pending;
+    /* Set while the stream is in the ready list or decoded by a worker */
+    EbBool   scheduled;
+    uint32_t waiters;
+    EbHandle idle_semaphore;
+} DecPoolStream;
+
+struct EbSvtDecPool {
+    EbHandle  mutex;
+    /* Posted once per ready list entry and once per worker on exit */
+    EbHandle  work_semaphore;
+    EbHandle  exit_semaphore;
+    EbHandle *thread_handle_array;
+    uint32_t  num_threads;
+    /* Streams with queued jobs, served round robin */
+    DecPoolStream *ready_head;
+    DecPoolStream *ready_tail;
+    /* Every attached stream, released by the pool if still attached when it is destroyed */
+    DecPoolStream *attached_head;
+};
+
+static void dec_pool_stream_free(DecPoolStream *stream) {
+    EbDecHandle *dec_handle_ptr =
+        (EbDecHandle *)stream->svt_dec_component->p_component_private;
+    dec_handle_ptr->pool_stream = NULL;
+    eb_destroy_semaphore(stream->idle_semaphore);
+    free(stream);
+}
+
+/* Called with the pool mutex held */
+static void dec_pool_push_ready(EbSvtDecPool *pool, DecPoolStream *stream) {
+    stream->next_ready = NULL;
+    if (pool->ready_tail)
+        pool->ready_tail->next_ready = stream;
+    else
+        pool->ready_head = stream;
+    pool->ready_tail = stream;
+    eb_post_semaphore(pool->work_semaphore);
+}
+
+static void *dec_pool_kernel(void *input_ptr) {
+    EbSvtDecPool *pool = (EbSvtDecPool *)input_ptr;
+
+    for (;;) {
+        eb_block_on_semaphore(pool->work_semaphore);
+        eb_block_on_mutex(pool->mutex);
+        DecPoolStream *stream = pool->ready_head;
+        if (stream == NULL) {
+            // Exit request, all the ready streams have been served
+            eb_release_mutex(pool->mutex);
+            break;
+        }
+        pool->ready_head = stream->next_ready;
+        if (pool->ready_head == NULL) pool->ready_tail = NULL;
+        DecPoolJob *job  = stream->job_head;
+        stream->job_head = job->next;
+        if (stream->job_head == NULL) stream->job_tail = NULL;
+        eb_release_mutex(pool->mutex);
+
+        EbErrorType return_error = eb_svt_decode_frame(
+            stream->svt_dec_component, (const uint8_t *)(job + 1), job->data_size, job->is_annexb);
+        if (job->callback) job->callback(stream->svt_dec_component, return_error, job->user_data);
+        free(job);
+
+        eb_block_on_mutex(pool->mutex);
+        stream->pending--;
+        // Back to the end of the ready list so the other streams get their turn
+        if (stream->job_head)
+            dec_pool_push_ready(pool, stream);
+        else
+            stream->scheduled = EB_FALSE;
+        if (stream->pending == 0) {
+            for (; stream->waiters; stream->waiters--) eb_post_semaphore(stream->idle_semaphore);
+        }
+        eb_release_mutex(pool->mutex);
+    }
+
+    eb_post_semaphore(pool->exit_semaphore);
+    return EB_NULL;
+}
+
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType
+eb_svt_dec_pool_create(EbSvtDecPool **pool, uint32_t num_threads) {
+    if (pool == NULL || num_threads == 0) return EB_ErrorBadParameter;
+    *pool = NULL;
+
+    EbSvtDecPool *pool_ptr = (EbSvtDecPool *)calloc(1, sizeof(EbSvtDecPool));
+    if (pool_ptr == NULL) return EB_ErrorInsufficientResources;
+    pool_ptr->thread_handle_array = (EbHandle *)calloc(num_threads, sizeof(EbHandle));
+    pool_ptr->mutex               = eb_create_mutex();
+    pool_ptr->work_semaphore      = eb_create_semaphore(0, 0x7FFFFFFF);
+    pool_ptr->exit_semaphore      = eb_create_semaphore(0, num_threads);
+    if (pool_ptr->thread_handle_array == NULL || pool_ptr->mutex == NULL ||
+        pool_ptr->work_semaphore == NULL || pool_ptr->exit_semaphore == NULL) {
+        eb_svt_dec_pool_destroy(pool_ptr);
+        return EB_ErrorInsufficientResources;
+    }
+
+    for (uint32_t i = 0; i < num_threads; i++) {
+        pool_ptr->thread_handle_array[i] = eb_create_thread(dec_pool_kernel, pool_ptr);
+        if (pool_ptr->thread_handle_array[i] == NULL) {
+            eb_svt_dec_pool_destroy(pool_ptr);
+            return EB_ErrorInsufficientResources;
+        }
+        pool_ptr->num_threads++;
+    }
+
+    *pool = pool_ptr;
+    return EB_ErrorNone;
+}
+
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType
+eb_svt_dec_pool_destroy(EbSvtDecPool *pool) {
+    if (pool == NULL) return EB_ErrorBadParameter;
+
+    // The workers leave once the ready list is empty
+    for (uint32_t i = 0; i < pool->num_threads; i++) eb_post_semaphore(pool->work_semaphore);
+    for (uint32_t i = 0; i < pool->num_threads; i++) eb_block_on_semaphore(pool->exit_semaphore);
+    for (uint32_t i = 0; i < pool->num_threads; i++)
+        eb_destroy_thread(pool->thread_handle_array[i]);
+
+    // The queued work is decoded, the streams still attached are detached here
+    while (pool->attached_head) {
+        DecPoolStream *stream = pool->attached_head;
+        pool->attached_head   = stream->next_attached;
+        dec_pool_stream_free(stream);
+    }
+
+    if (pool->exit_semaphore) eb_destroy_semaphore(pool->exit_semaphore);
+    if (pool->work_semaphore) eb_destroy_semaphore(pool->work_semaphore);
+    if (pool->mutex) eb_destroy_mutex(pool->mutex);
+    free(pool->thread_handle_array);
+    free(pool);
+    return EB_ErrorNone;
+}
+
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType
+eb_svt_dec_pool_attach(EbSvtDecPool *pool, EbComponentType *svt_dec_component) {
+    if (pool == NULL || svt_dec_component == NULL) return EB_ErrorBadParameter;
+
+    EbDecHandle *dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
+    if (dec_handle_ptr->pool_stream) {
+        SVT_ERROR("The decoder handle is already attached to a pool\n");
+        return EB_ErrorBadParameter;
+    }
+    if (dec_handle_ptr->dec_config.threads > 1) {
+        SVT_ERROR("Decoder handles attached to a pool must use a single thread\n");
+        return EB_ErrorBadParameter;
+    }
+
+    DecPoolStream *stream = (DecPoolStream *)calloc(1, sizeof(DecPoolStream));
+    if (stream == NULL) return EB_ErrorInsufficientResources;
+    stream->idle_semaphore = eb_create_semaphore(0, 0x7FFFFFFF);
+    if (stream->idle_semaphore == NULL) {
+        free(stream);
+        return EB_ErrorInsufficientResources;
+    }
+    stream->pool                = pool;
+    stream->svt_dec_component   = svt_dec_component;
+    dec_handle_ptr->pool_stream = stream;
+
+    eb_block_on_mutex(pool->mutex);
+    stream->next_attached = pool->attached_head;
+    pool->attached_head   = stream;
+    eb_release_mutex(pool->mutex);
+    return EB_ErrorNone;
+}
+
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType
+eb_svt_dec_pool_detach(EbComponentType *svt_dec_component) {
+    if (svt_dec_component == NULL) return EB_ErrorBadParameter;
+
+    EbDecHandle *  dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
+    DecPoolStream *stream         = dec_handle_ptr->pool_stream;
+    if (stream == NULL) return EB_ErrorBadParameter;
+
+    eb_svt_dec_pool_wait(svt_dec_component);
+
+    EbSvtDecPool * pool = stream->pool;
+    DecPoolStream **link;
+    eb_block_on_mutex(pool->mutex);
+    for (link = &pool->attached_head; *link != stream; link = &(*link)->next_attached)
+        ;
+    *link = stream->next_attached;
+    eb_release_mutex(pool->mutex);
+
+    dec_pool_stream_free(stream);
+    return EB_ErrorNone;
+}
+
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType
+eb_svt_dec_pool_submit(EbComponentType *svt_dec_component, const uint8_t *data,
+                       const size_t data_size, uint32_t is_annexb, EbSvtDecPoolCallback callback,
+                       void *user_data) {
+    if (svt_dec_component == NULL || (data == NULL && data_size)) return EB_ErrorBadParameter;
+
+    EbDecHandle *  dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
+    DecPoolStream *stream         = dec_handle_ptr->pool_stream;
+    if (stream == NULL) return EB_ErrorBadParameter;
+
+    DecPoolJob *job = (DecPoolJob *)malloc(sizeof(DecPoolJob) + data_size);
+    if (job == NULL) return EB_ErrorInsufficientResources;
+    job->next      = NULL;
+    job->data_size = data_size;
+    job->is_annexb = is_annexb;
+    job->callback  = callback;
+    job->user_data = user_data;
+    if (data_size) memcpy(job + 1, data, data_size);
+
+    EbSvtDecPool *pool = stream->pool;
+    eb_block_on_mutex(pool->mutex);
+    if (stream->job_tail)
+        stream->job_tail->next = job;
+    else
+        stream->job_head = job;
+    stream->job_tail = job;
+    stream->pending++;
+    if (!stream->scheduled) {
+        stream->scheduled = EB_TRUE;
+        dec_pool_push_ready(pool, stream);
+    }
+    eb_release_mutex(pool->mutex);
+    return EB_ErrorNone;
+}
+
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType
+eb_svt_dec_pool_wait(EbComponentType *svt_dec_component) {
+    if (svt_dec_component == NULL) return EB_ErrorBadParameter;
+
+    EbDecHandle *  dec_handle_ptr = (EbDecHandle *)svt_dec_component->p_component_private;
+    DecPoolStream *stream         = dec_handle_ptr->pool_stream;
+    if (stream == NULL) return EB_ErrorBadParameter;
+
+    EbSvtDecPool *pool = stream->pool;
+    eb_block_on_mutex(pool->mutex);
+    const EbBool busy = stream->pending != 0;
+    if (busy) stream->waiters++;
+    eb_release_mutex(pool->mutex);
+    if (busy) eb_block_on_semaphore(stream->idle_semaphore);
+    return EB_ErrorNone;
+}
@@ -0,0 +1,101 @@
+/*
+* Copyright(c) 2019 Netflix, Inc.
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+// SUMMARY
+//   Post filters of a frame, fused over SB rows in the single thread decoder
+
+/**************************************
+ * Includes
+ **************************************/
+#include "EbDefinitions.h"
+#include "EbDecUtils.h"
+#include "EbDecProcessFrame.h"
+#include "EbDecLF.h"
+#include "EbDecCdef.h"
+#include "EbDecRestoration.h"
+#include "EbDecPostFilter.h"
+
+void dec_save_lf_boundary_lines_sb_row(EbDecHandle *dec_handle, Av1PixelRect **tile_rect,
+                                       int32_t sb_row, uint8_t **src, int32_t *stride,
+                                       int32_t num_planes);
+
+void dec_post_filter_frame(EbDecHandle *dec_handle, EbBool do_lf, EbBool do_cdef, EbBool do_lr,
+                           EbBool opt_lr) {
+    if (!do_lf && !do_cdef && !do_lr) return;
+
+    EbPictureBufferDesc *cur_pic_buf  = dec_handle->cur_pic_buf[0]->ps_pic_buf;
+    LfCtxt *             lf_ctxt      = (LfCtxt *)dec_handle->pv_lf_ctxt;
+    const int32_t        frame_height = dec_handle->frame_header.frame_size.frame_height;
+    const int32_t        sb_size_h    = block_size_high[dec_handle->seq_header.sb_size];
+    const int32_t        sb_rows      = (frame_height + sb_size_h - 1) / sb_size_h;
+    const int32_t        num_planes   = av1_num_planes(&dec_handle->seq_header.color_config);
+    DecCdefCtxt          cdef_ctxt;
+
+    /* The LR boundary lines are saved after deblocking only, the CDEF ones
+     * at the top and bottom of the frame are never read without superres */
+    const EbBool  save_lf_lines = do_lr && !opt_lr;
+    Av1PixelRect  tile_rect[MAX_MB_PLANE];
+    Av1PixelRect *tile_rect_p[MAX_MB_PLANE];
+    uint8_t *     src[MAX_MB_PLANE];
+    int32_t       stride[MAX_MB_PLANE];
+
+    if (save_lf_lines) {
+        for (int32_t p = 0; p < num_planes; ++p) {
+            int32_t is_uv  = p ? 1 : 0;
+            int32_t sx     = is_uv ? dec_handle->cm.subsampling_x : 0;
+            int32_t sy     = is_uv ? dec_handle->cm.subsampling_y : 0;
+            tile_rect[p]   = whole_frame_rect(&dec_handle->cm.frm_size, sx, sy, is_uv);
+            tile_rect_p[p] = &tile_rect[p];
+            derive_blk_pointers(cur_pic_buf, p, 0, 0, (void *)&src[p], &stride[p], sx, sy);
+        }
+    }
+
+    DecStageStats *stats = &dec_handle->stage_stats;
+    uint64_t       start;
+
+    start = dec_stage_start(stats);
+    if (do_lf) dec_av1_loop_filter_frame_setup(dec_handle, lf_ctxt, AOM_PLANE_Y, MAX_MB_PLANE);
+    dec_stage_end(stats, DEC_STAGE_LF, start);
+    start = dec_stage_start(stats);
+    if (do_cdef) svt_cdef_frame_start(dec_handle, &cdef_ctxt);
+    dec_stage_end(stats, DEC_STAGE_CDEF, start);
+    start = dec_stage_start(stats);
+    if (do_lr) dec_av1_loop_restoration_start_frame(dec_handle);
+    dec_stage_end(stats, DEC_STAGE_LR, start);
+
+    for (int32_t sb_row = 0; sb_row < sb_rows; sb_row++) {
+        start = dec_stage_start(stats);
+        if (do_lf)
+            dec_av1_loop_filter_sb_row(
+                dec_handle, cur_pic_buf, lf_ctxt, sb_row, AOM_PLANE_Y, MAX_MB_PLANE);
+        dec_stage_end(stats, DEC_STAGE_LF, start);
+        start = dec_stage_start(stats);
+        if (save_lf_lines) {
+            dec_save_lf_boundary_lines_sb_row(
+                dec_handle, tile_rect_p, sb_row, src, stride, num_planes);
+            /* The stripes are offset upwards, the last one may start below
+             * the last SB row */
+            if (sb_row == sb_rows - 1)
+                dec_save_lf_boundary_lines_sb_row(
+                    dec_handle, tile_rect_p, sb_rows, src, stride, num_planes);
+        }
+        dec_stage_end(stats, DEC_STAGE_LR, start);
+
+        /* Deblocking the next SB row still changes the bottom rows of this
+         * one, the rows above it are done and CDEF reads only 3 rows below */
+        const int32_t done_rows = sb_row == sb_rows - 1 ? frame_height : sb_row * sb_size_h;
+
+        start = dec_stage_start(stats);
+        if (do_cdef) svt_cdef_frame_rows(dec_handle, &cdef_ctxt, done_rows);
+        dec_stage_end(stats, DEC_STAGE_CDEF, start);
+        start = dec_stage_start(stats);
+        if (do_lr) dec_av1_loop_restoration_filter_rows(dec_handle, opt_lr, done_rows);
+        dec_stage_end(stats, DEC_STAGE_LR, start);
+    }
+
+    start = dec_stage_start(stats);
+    if (do_cdef) svt_cdef_frame_end(&cdef_ctxt);
+    dec_stage_end(stats, DEC_STAGE_CDEF, start);
+}
@@ -0,0 +1,23 @@
+/*
+* Copyright(c) 2019 Netflix, Inc.
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbDecPostFilter_h
+#define EbDecPostFilter_h
+
+#include "EbDecHandle.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Single thread deblocking, CDEF and LR of a frame without superres, run a
+ * SB row at a time so that the rows are still in cache for the next filter */
+void dec_post_filter_frame(EbDecHandle *dec_handle, EbBool do_lf, EbBool do_cdef, EbBool do_lr,
+                           EbBool opt_lr);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbDecPostFilter_h
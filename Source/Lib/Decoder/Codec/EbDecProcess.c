@@ -416,14 +416,16 @@ void parse_frame_tiles(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt)
             context_ptr = (DecMtNode *)parse_results_wrapper_ptr->object_ptr;
             recon_tile_job_post(dec_mt_frame_data, context_ptr->node_index);
             dec_mt_frame_data->start_decode_frame = EB_TRUE;
-            if (EB_ErrorNone != parse_tile_job(dec_handle_ptr, context_ptr->node_index)) {
-                SVT_LOG("\nParse Issue for Tile %d", context_ptr->node_index);
-                break;
-            }
+            /* Wake up the threads waiting for recon before parsing, so that the
+               SB rows of the tile are reconstructed while it is being parsed */
             eb_post_semaphore(dec_handle_ptr->thread_semaphore);
             for (uint32_t lib_thrd = 0; lib_thrd < dec_handle_ptr->dec_config.threads - 1;
                  lib_thrd++)
                 eb_post_semaphore(dec_handle_ptr->thread_ctxt_pa[lib_thrd].thread_semaphore);
+            if (EB_ErrorNone != parse_tile_job(dec_handle_ptr, context_ptr->node_index)) {
+                SVT_LOG("\nParse Issue for Tile %d", context_ptr->node_index);
+                break;
+            }
             // Release Parse Results
             eb_release_object(parse_results_wrapper_ptr);
         } else
@@ -553,10 +555,9 @@ void svt_av1_queue_lf_jobs(EbDecHandle *dec_handle_ptr) {
 }
 
 /* Store LF_boundary_line req for LR */
-static INLINE void dec_save_lf_boundary_lines_sb_row(EbDecHandle *  dec_handle,
-                                                     Av1PixelRect **tile_rect, int32_t sb_row,
-                                                     uint8_t **src, int32_t *stride,
-                                                     int32_t num_planes) {
+void dec_save_lf_boundary_lines_sb_row(EbDecHandle *dec_handle, Av1PixelRect **tile_rect,
+                                       int32_t sb_row, uint8_t **src, int32_t *stride,
+                                       int32_t num_planes) {
     Av1Common *cm         = &dec_handle->cm;
     FrameSize *frame_size = &dec_handle->frame_header.frame_size;
     EbBool     sb_128     = dec_handle->seq_header.sb_size == BLOCK_128X128;
@@ -871,8 +872,11 @@ void svt_cdef_frame_mt(EbDecHandle *dec_handle_ptr, DecThreadCtxt *thread_ctxt)
     }
     eb_release_mutex(dec_mt_frame_data->temp_mutex);
 
+    /* dec_sync_all_threads() resets the count for the exit, a thread still
+       waiting here for the last frame must then stop waiting */
     volatile uint32_t *num_threads_cdefed = &dec_mt_frame_data->num_threads_cdefed;
-    while (*num_threads_cdefed != dec_handle_ptr->dec_config.threads)
+    volatile EbBool *  end_flag           = &dec_mt_frame_data->end_flag;
+    while (*num_threads_cdefed != dec_handle_ptr->dec_config.threads && *end_flag == EB_FALSE)
         ;
 }
 
@@ -49,8 +49,8 @@ typedef struct DecMtParseReconTileInfo {
     //EbFifo      **recon_tile_sbrow_producer_fifo_ptr;
     //EbFifo      **recon_tile_sbrow_consumer_fifo_ptr;
 
-    /* Array to store SB Recon rows completed parsing in the Tile. This will be
-       used for sb deocde row start processing. */
+    /* Array to store SBs completed parsing in every SB row of the Tile. Used
+       for SB decode to follow the parsing. */
     uint32_t *sb_recon_row_parsed;
 
     /* Array to store SB Recon rows picked up for processing in the Tile. This will be
@@ -124,6 +124,8 @@ EbErrorType decode_tile_row(DecModCtxt *dec_mod_ctxt, TilesInfo *tile_info,
     CurFrameBuf *     frame_buf                = &master_frame_buf->cur_frame_bufs[0];
     volatile int32_t *sb_completed_in_prev_row = NULL;
     uint32_t *        sb_completed_in_row;
+    volatile int32_t *sb_parsed_in_row;
+    int32_t           sb_col_in_tile = 0;
     int32_t           tile_wd_in_sb;
     int32_t           sb_mi_size_log2 = dec_mod_ctxt->seq_header->sb_size_log2 - MI_SIZE_LOG2;
 
@@ -139,6 +141,8 @@ EbErrorType decode_tile_row(DecModCtxt *dec_mod_ctxt, TilesInfo *tile_info,
     }
 
     sb_completed_in_row = &parse_recon_tile_info_array->sb_recon_completed_in_row[sb_row_in_tile];
+    sb_parsed_in_row =
+        (volatile int32_t *)&parse_recon_tile_info_array->sb_recon_row_parsed[sb_row_in_tile];
 
     tile_wd_in_sb =
         (AOMMIN(tile_info->tile_col_start_mi[tile_col + 1], dec_handle_ptr->frame_header.mi_cols) +
@@ -157,9 +161,16 @@ EbErrorType decode_tile_row(DecModCtxt *dec_mod_ctxt, TilesInfo *tile_info,
 
         SBInfo *sb_info = frame_buf->sb_info + (sb_row * master_frame_buf->sb_cols) + sb_col;
 
+        /* Wait for the parsing of the SB, the parser sets up sb_info just
+         * before it parses the SB so nothing in it can be read before this */
+        while (*sb_parsed_in_row <= sb_col_in_tile)
+            ;
+        sb_col_in_tile++;
+
         dec_mod_ctxt->cur_coeff[AOM_PLANE_Y] = sb_info->sb_coeff[AOM_PLANE_Y];
         dec_mod_ctxt->cur_coeff[AOM_PLANE_U] = sb_info->sb_coeff[AOM_PLANE_U];
         dec_mod_ctxt->cur_coeff[AOM_PLANE_V] = sb_info->sb_coeff[AOM_PLANE_V];
+
         /* Top-Right Sync*/
         if (sb_row_in_tile) {
             while (*sb_completed_in_prev_row < MIN((sb_col + 2), tile_wd_in_sb))
@@ -202,13 +213,8 @@ EbErrorType decode_tile(DecModCtxt *dec_mod_ctxt, TilesInfo *tile_info,
         //unlock mutex
         eb_release_mutex(parse_recon_tile_info_array->tile_sbrow_mutex);
 
-        //wait for parse
+        /* The SBs of the row are reconstructed as they are parsed */
         if (-1 != sb_row_in_tile) {
-            volatile int32_t *sb_row_parsed = (volatile int32_t *)&parse_recon_tile_info_array
-                                                  ->sb_recon_row_parsed[sb_row_in_tile];
-            while (0 == *sb_row_parsed)
-                ;
-
             sb_row = sb_row_in_tile + sb_row_tile_start;
 
             mi_row = (sb_row << dec_mod_ctxt->seq_header->sb_size_log2) >> MI_SIZE_LOG2;
@@ -54,6 +54,10 @@ typedef struct DecModCtxt {
     DECLARE_ALIGNED(16, uint8_t, seg_mask[2 * MAX_SB_SQUARE]);
 } DecModCtxt;
 
+/* Rows of the LR output window, a unit row is up to 1.5 units high and the
+ * last one is also offset upwards */
+#define LR_UNIT_ROW_MAX_HEIGHT (RESTORATION_UNITSIZE_MAX * 3 / 2 + RESTORATION_UNIT_OFFSET)
+
 typedef struct LrCtxt {
     /** Decoder Handle */
     void *dec_handle_ptr;
@@ -69,10 +73,20 @@ typedef struct LrCtxt {
     /* Used to store CDEF line buffer around stripe boundary */
     RestorationLineBuffers *rlbs;
 
-    /* Scratch buffer to hold LR output */
+    /* Scratch buffer to hold the LR output of one unit row */
     uint8_t *dst;
     uint16_t dst_stride;
 
+    /* Luma rows padded for LR so far */
+    int32_t padded_rows;
+    /* Next row and unit row to restore, per plane */
+    int32_t next_row[MAX_MB_PLANE];
+    int32_t next_unit_row[MAX_MB_PLANE];
+    /* LR output of the bottom rows of the last restored unit row, held back
+     * as the next unit row reads them unfiltered */
+    uint8_t *pending[MAX_MB_PLANE];
+    int32_t  num_pending[MAX_MB_PLANE];
+
     /* Pointer to a scratch buffer used by self-guided restoration */
     int32_t *rst_tmpbuf;
 } LrCtxt;
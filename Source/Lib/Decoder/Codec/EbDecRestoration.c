@@ -29,22 +29,24 @@ void save_tile_row_boundary_lines(uint8_t *src, int32_t src_stride, int32_t src_
                                   Av1Common *cm, int32_t after_cdef,
                                   RestorationStripeBoundaries *boundaries);
 
+/* Pad the rows [first_row, end_row) of a picture, along with the rows above
+ * it when first_row is 0 and the rows below it when end_row is its height */
 void lr_generate_padding(
     EbByte   src_pic, //output paramter, pointer to the source picture(0,0).
     uint32_t src_stride, //input paramter, the stride of the source picture to be padded.
     uint32_t
         original_src_width, //input paramter, the width of the source picture which excludes the padding.
     uint32_t
-        original_src_height) //input paramter, the heigth of the source picture which excludes the padding.
-{
+        original_src_height, //input paramter, the heigth of the source picture which excludes the padding.
+    uint32_t first_row, uint32_t end_row) {
     uint32_t vertical_idx;
     EbByte   temp_src_pic0;
     EbByte   temp_src_pic1;
     EbByte   temp_src_pic2;
     EbByte   temp_src_pic3;
 
-    temp_src_pic0 = src_pic;
-    for (vertical_idx = original_src_height; vertical_idx > 0; --vertical_idx) {
+    temp_src_pic0 = src_pic + first_row * src_stride;
+    for (vertical_idx = end_row - first_row; vertical_idx > 0; --vertical_idx) {
         // horizontal padding
         EB_MEMSET(temp_src_pic0 - LR_PAD_SIDE, *temp_src_pic0, LR_PAD_SIDE);
         EB_MEMSET(temp_src_pic0 + original_src_width,
@@ -62,12 +64,14 @@ void lr_generate_padding(
     for (vertical_idx = LR_PAD_SIDE; vertical_idx > 0; --vertical_idx) {
         // top part data copy
         temp_src_pic2 -= src_stride;
-        EB_MEMCPY(
-            temp_src_pic2, temp_src_pic0, sizeof(uint8_t) * (original_src_width + LR_PAD_MAX));
+        if (first_row == 0)
+            EB_MEMCPY(
+                temp_src_pic2, temp_src_pic0, sizeof(uint8_t) * (original_src_width + LR_PAD_MAX));
         // bottom part data copy
         temp_src_pic3 += src_stride;
-        EB_MEMCPY(
-            temp_src_pic3, temp_src_pic1, sizeof(uint8_t) * (original_src_width + LR_PAD_MAX));
+        if (end_row == original_src_height)
+            EB_MEMCPY(
+                temp_src_pic3, temp_src_pic1, sizeof(uint8_t) * (original_src_width + LR_PAD_MAX));
     }
     return;
 }
@@ -78,8 +82,8 @@ void lr_generate_padding16_bit(
     uint32_t
         original_src_width, //input paramter, the width of the source picture which excludes the padding.
     uint32_t
-        original_src_height) //input paramter, the height of the source picture which excludes the padding.
-{
+        original_src_height, //input paramter, the height of the source picture which excludes the padding.
+    uint32_t first_row, uint32_t end_row) {
     uint32_t vertical_idx;
     EbByte   temp_src_pic0;
     EbByte   temp_src_pic1;
@@ -87,8 +91,8 @@ void lr_generate_padding16_bit(
     EbByte   temp_src_pic3;
     uint8_t  use_highbd = 1;
 
-    temp_src_pic0 = src_pic;
-    for (vertical_idx = original_src_height; vertical_idx > 0; --vertical_idx) {
+    temp_src_pic0 = src_pic + first_row * src_stride;
+    for (vertical_idx = end_row - first_row; vertical_idx > 0; --vertical_idx) {
         // horizontal padding
         memset16bit((uint16_t *)(temp_src_pic0 - (LR_PAD_SIDE << use_highbd)),
                     ((uint16_t *)(temp_src_pic0))[0],
@@ -107,24 +111,28 @@ void lr_generate_padding16_bit(
     for (vertical_idx = LR_PAD_SIDE; vertical_idx > 0; --vertical_idx) {
         // top part data copy
         temp_src_pic2 -= src_stride;
-        EB_MEMCPY(temp_src_pic2,
-                  temp_src_pic0,
-                  sizeof(uint8_t) * (original_src_width + (LR_PAD_MAX << use_highbd)));
+        if (first_row == 0)
+            EB_MEMCPY(temp_src_pic2,
+                      temp_src_pic0,
+                      sizeof(uint8_t) * (original_src_width + (LR_PAD_MAX << use_highbd)));
         // bottom part data copy
         temp_src_pic3 += src_stride;
-        EB_MEMCPY(temp_src_pic3,
-                  temp_src_pic1,
-                  sizeof(uint8_t) * (original_src_width + (LR_PAD_MAX << use_highbd)));
+        if (end_row == original_src_height)
+            EB_MEMCPY(temp_src_pic3,
+                      temp_src_pic1,
+                      sizeof(uint8_t) * (original_src_width + (LR_PAD_MAX << use_highbd)));
     }
 
     return;
 }
 
 void lr_pad_pic(EbPictureBufferDesc *recon_picture_buf, FrameHeader *frame_hdr,
-                EbColorConfig *color_cfg) {
+                EbColorConfig *color_cfg, int32_t first_row, int32_t end_row) {
     FrameSize *frame_size = &frame_hdr->frame_size;
     uint8_t    sx         = color_cfg->subsampling_x;
     uint8_t    sy         = color_cfg->subsampling_y;
+    uint32_t   first_uv   = first_row >> sy;
+    uint32_t   end_uv     = (end_row + sy) >> sy;
 
     if (recon_picture_buf->bit_depth == EB_8BIT) {
         // Y samples
@@ -132,7 +140,9 @@ void lr_pad_pic(EbPictureBufferDesc *recon_picture_buf, FrameHeader *frame_hdr,
                                 recon_picture_buf->stride_y * recon_picture_buf->origin_y,
                             recon_picture_buf->stride_y,
                             frame_size->superres_upscaled_width,
-                            frame_size->frame_height);
+                            frame_size->frame_height,
+            first_row,
+            end_row);
 
         if (recon_picture_buf->color_format != EB_YUV400) {
             // Cb samples
@@ -141,7 +151,9 @@ void lr_pad_pic(EbPictureBufferDesc *recon_picture_buf, FrameHeader *frame_hdr,
                     recon_picture_buf->stride_cb * (recon_picture_buf->origin_y >> sy),
                 recon_picture_buf->stride_cb,
                 (frame_size->superres_upscaled_width + sx) >> sx,
-                (frame_size->frame_height + sy) >> sy);
+                (frame_size->frame_height + sy) >> sy,
+                first_uv,
+                end_uv);
 
             // Cr samples
             lr_generate_padding(
@@ -149,7 +161,9 @@ void lr_pad_pic(EbPictureBufferDesc *recon_picture_buf, FrameHeader *frame_hdr,
                     recon_picture_buf->stride_cr * (recon_picture_buf->origin_y >> sy),
                 recon_picture_buf->stride_cr,
                 (frame_size->superres_upscaled_width + sx) >> sx,
-                (frame_size->frame_height + sy) >> sy);
+                (frame_size->frame_height + sy) >> sy,
+                first_uv,
+                end_uv);
         }
     } else {
         // Y samples
@@ -158,7 +172,9 @@ void lr_pad_pic(EbPictureBufferDesc *recon_picture_buf, FrameHeader *frame_hdr,
                 (recon_picture_buf->stride_y << 1) * recon_picture_buf->origin_y,
             recon_picture_buf->stride_y << 1,
             frame_size->superres_upscaled_width << 1,
-            frame_size->frame_height);
+            frame_size->frame_height,
+            first_row,
+            end_row);
 
         if (recon_picture_buf->color_format != EB_YUV400) {
             // Cb samples
@@ -167,7 +183,9 @@ void lr_pad_pic(EbPictureBufferDesc *recon_picture_buf, FrameHeader *frame_hdr,
                     (recon_picture_buf->stride_cb << 1) * (recon_picture_buf->origin_y >> sy),
                 recon_picture_buf->stride_cb << 1,
                 ((frame_size->superres_upscaled_width + sx) >> sx) << 1,
-                (frame_size->frame_height + sy) >> sy);
+                (frame_size->frame_height + sy) >> sy,
+                first_uv,
+                end_uv);
 
             // Cr samples
             lr_generate_padding16_bit(
@@ -175,55 +193,47 @@ void lr_pad_pic(EbPictureBufferDesc *recon_picture_buf, FrameHeader *frame_hdr,
                     (recon_picture_buf->stride_cr << 1) * (recon_picture_buf->origin_y >> sy),
                 recon_picture_buf->stride_cr << 1,
                 ((frame_size->superres_upscaled_width + sx) >> sx) << 1,
-                (frame_size->frame_height + sy) >> sy);
+                (frame_size->frame_height + sy) >> sy,
+                first_uv,
+                end_uv);
         }
     }
 }
 
-void dec_av1_loop_restoration_filter_row(EbDecHandle *dec_handle, int32_t plane, int32_t row,
-                                         int *h, int32_t sx, int32_t sy, int src_stride,
-                                         int dst_stride, uint8_t *src, uint8_t *dst,
-                                         int optimized_lr, int unit_row) {
-    Av1PixelRect          tile_rect;
-    RestorationTileLimits tile_limit;
-    RestorationUnitInfo * lr_unit;
-    int                   use_highbd = (dec_handle->seq_header.color_config.bit_depth > 8);
-    int                   bit_depth  = dec_handle->seq_header.color_config.bit_depth;
-    LrCtxt *              lr_ctxt    = (LrCtxt *)dec_handle->pv_lr_ctxt;
-    LrParams *            lr_params  = &dec_handle->frame_header.lr_params[plane];
-    int                   ext_size   = lr_params->loop_restoration_size * 3 / 2;
-    int                   w = 0, tile_stripe0 = 0;
+void dec_av1_loop_restoration_filter_row(EbDecHandle *dec_handle, int32_t plane,
+                                         RestorationTileLimits *tile_limit, int32_t sx,
+                                         int32_t sy, int src_stride, int dst_stride, uint8_t *src,
+                                         uint8_t *dst, int optimized_lr, int unit_row) {
+    Av1PixelRect         tile_rect;
+    RestorationUnitInfo *lr_unit;
+    int                  use_highbd = (dec_handle->seq_header.color_config.bit_depth > 8);
+    int                  bit_depth  = dec_handle->seq_header.color_config.bit_depth;
+    LrCtxt *             lr_ctxt    = (LrCtxt *)dec_handle->pv_lr_ctxt;
+    LrParams *           lr_params  = &dec_handle->frame_header.lr_params[plane];
+    int                  ext_size   = lr_params->loop_restoration_size * 3 / 2;
+    int                  w = 0, tile_stripe0 = 0;
 
     tile_rect  = whole_frame_rect(&dec_handle->frame_header.frame_size,
                                  dec_handle->seq_header.color_config.subsampling_x,
                                  dec_handle->seq_header.color_config.subsampling_y,
                                  plane > 0);
-    int tile_h = tile_rect.bottom - tile_rect.top;
     int tile_w = tile_rect.right - tile_rect.left;
 
-    int remaining_h    = tile_h - row;
-    *h                 = (remaining_h < ext_size) ? remaining_h : lr_params->loop_restoration_size;
-    tile_limit.v_start = tile_rect.top + row;
-    tile_limit.v_end   = tile_rect.top + row + (*h);
-    assert(tile_limit.v_end <= tile_rect.bottom);
-
-    // Offset the tile upwards to align with the restoration processing stripe
-    const int voffset  = RESTORATION_UNIT_OFFSET >> sy;
-    tile_limit.v_start = AOMMAX(tile_rect.top, tile_limit.v_start - voffset);
-    if (tile_limit.v_end < tile_rect.bottom) tile_limit.v_end -= voffset;
+    // dst only holds the rows of this unit row
+    dst -= (tile_limit->v_start * dst_stride) << use_highbd;
 
     for (int x = 0, unit_col = 0; x < tile_w; x += w, unit_col++) {
         int remaining_w = tile_w - x;
         w               = (remaining_w < ext_size) ? remaining_w : lr_params->loop_restoration_size;
 
-        tile_limit.h_start = tile_rect.left + x;
-        tile_limit.h_end   = tile_rect.left + x + w;
+        tile_limit->h_start = tile_rect.left + x;
+        tile_limit->h_end   = tile_rect.left + x + w;
 
         lr_unit = lr_ctxt->lr_unit[plane] + unit_row * lr_ctxt->lr_stride[plane] + unit_col;
 
         if (!use_highbd)
             eb_av1_loop_restoration_filter_unit(1,
-                                                &tile_limit,
+                                                tile_limit,
                                                 lr_unit,
                                                 &lr_ctxt->boundaries[plane],
                                                 lr_ctxt->rlbs,
@@ -241,7 +251,7 @@ void dec_av1_loop_restoration_filter_row(EbDecHandle *dec_handle, int32_t plane,
                                                 optimized_lr);
         else
             eb_av1_loop_restoration_filter_unit(1,
-                                                &tile_limit,
+                                                tile_limit,
                                                 lr_unit,
                                                 &lr_ctxt->boundaries[plane],
                                                 lr_ctxt->rlbs,
@@ -260,36 +270,63 @@ void dec_av1_loop_restoration_filter_row(EbDecHandle *dec_handle, int32_t plane,
     }
 }
 
-void dec_av1_loop_restoration_filter_frame(EbDecHandle *dec_handle, int optimized_lr,
-                                           int enable_flag) {
-    if (!enable_flag) return;
-
-    assert(!dec_handle->frame_header.all_lossless);
-
-    FrameHeader *        frame_header     = &dec_handle->frame_header;
-    LrCtxt *             lr_ctxt          = (LrCtxt *)dec_handle->pv_lr_ctxt;
-    MasterFrameBuf *     master_frame_buf = &dec_handle->master_frame_buf;
-    CurFrameBuf *        frame_buf        = &master_frame_buf->cur_frame_bufs[0];
-    Av1PixelRect         tile_rect;
-    EbPictureBufferDesc *cur_pic_buf = dec_handle->cur_pic_buf[0]->ps_pic_buf;
-
-    lr_pad_pic(cur_pic_buf, frame_header, &dec_handle->seq_header.color_config);
+void dec_av1_loop_restoration_start_frame(EbDecHandle *dec_handle) {
+    LrCtxt *     lr_ctxt   = (LrCtxt *)dec_handle->pv_lr_ctxt;
+    CurFrameBuf *frame_buf = &dec_handle->master_frame_buf.cur_frame_bufs[0];
 
     lr_ctxt->lr_unit[AOM_PLANE_Y] = frame_buf->lr_unit[AOM_PLANE_Y];
     lr_ctxt->lr_unit[AOM_PLANE_U] = frame_buf->lr_unit[AOM_PLANE_U];
     lr_ctxt->lr_unit[AOM_PLANE_V] = frame_buf->lr_unit[AOM_PLANE_V];
 
+    lr_ctxt->padded_rows = 0;
+    for (int plane = 0; plane < MAX_MB_PLANE; plane++) {
+        lr_ctxt->next_row[plane]      = 0;
+        lr_ctxt->next_unit_row[plane] = 0;
+        lr_ctxt->num_pending[plane]   = 0;
+    }
+}
+
+/* Copy num_rows rows of width pixels from src to dst */
+static INLINE void lr_copy_rows(uint8_t *dst, int dst_stride, const uint8_t *src, int src_stride,
+                                int width, int num_rows, int use_highbd) {
+    for (int y = 0; y < num_rows; y++) {
+        memcpy(dst, src, width << use_highbd);
+        dst += dst_stride << use_highbd;
+        src += src_stride << use_highbd;
+    }
+}
+
+void dec_av1_loop_restoration_filter_rows(EbDecHandle *dec_handle, int optimized_lr,
+                                          int32_t end_row) {
+    assert(!dec_handle->frame_header.all_lossless);
+
+    FrameHeader *        frame_header = &dec_handle->frame_header;
+    LrCtxt *             lr_ctxt      = (LrCtxt *)dec_handle->pv_lr_ctxt;
+    EbPictureBufferDesc *cur_pic_buf  = dec_handle->cur_pic_buf[0]->ps_pic_buf;
+    const int32_t        frame_height = frame_header->frame_size.frame_height;
+    const int32_t        last_rows    = end_row >= frame_height;
+
+    if (last_rows) end_row = frame_height;
+    if (end_row > lr_ctxt->padded_rows) {
+        lr_pad_pic(cur_pic_buf,
+                   frame_header,
+                   &dec_handle->seq_header.color_config,
+                   lr_ctxt->padded_rows,
+                   end_row);
+        lr_ctxt->padded_rows = end_row;
+    }
+
     int      num_plane  = av1_num_planes(&dec_handle->seq_header.color_config);
     int      use_highbd = (dec_handle->seq_header.color_config.bit_depth > 8);
-    int      h          = 0, y, unit_row;
-    int      src_stride, dst_stride;
-    uint8_t *src, *dst;
+    int      dst_stride = lr_ctxt->dst_stride;
+    int      src_stride;
+    uint8_t *src, *dst = lr_ctxt->dst;
 
     for (int plane = 0; plane < num_plane; plane++) {
         LrParams *lr_params = &frame_header->lr_params[plane];
-        int       is_uv     = plane > 0;
         int       sx = 0, sy = 0;
 
+        if (lr_params->frame_restoration_type == RESTORE_NONE) continue;
         if (plane) {
             sx = dec_handle->seq_header.color_config.subsampling_x;
             sy = dec_handle->seq_header.color_config.subsampling_y;
@@ -298,22 +335,36 @@ void dec_av1_loop_restoration_filter_frame(EbDecHandle *dec_handle, int optimize
         // src points to frame start
         derive_blk_pointers(cur_pic_buf, plane, 0, 0, (void *)&src, &src_stride, sx, sy);
 
-        dst        = lr_ctxt->dst;
-        dst_stride = lr_ctxt->dst_stride;
-
-        tile_rect = whole_frame_rect(&dec_handle->frame_header.frame_size,
-                                     dec_handle->seq_header.color_config.subsampling_x,
-                                     dec_handle->seq_header.color_config.subsampling_y,
-                                     is_uv);
-
-        int tile_h = tile_rect.bottom - tile_rect.top;
-        if (lr_params->frame_restoration_type == RESTORE_NONE) continue;
+        Av1PixelRect tile_rect = whole_frame_rect(&frame_header->frame_size,
+                                                  dec_handle->seq_header.color_config.subsampling_x,
+                                                  dec_handle->seq_header.color_config.subsampling_y,
+                                                  plane > 0);
+        const int tile_h      = tile_rect.bottom - tile_rect.top;
+        const int tile_w      = tile_rect.right - tile_rect.left;
+        const int avail_rows  = last_rows ? tile_h : end_row >> sy;
+        const int ext_size    = lr_params->loop_restoration_size * 3 / 2;
+        const int voffset     = RESTORATION_UNIT_OFFSET >> sy;
+        uint8_t * pending     = lr_ctxt->pending[plane];
+        int       num_pending = lr_ctxt->num_pending[plane];
+
+        while (lr_ctxt->next_row[plane] < tile_h) {
+            RestorationTileLimits tile_limit;
+            const int             row         = lr_ctxt->next_row[plane];
+            const int             remaining_h = tile_h - row;
+            const int h = (remaining_h < ext_size) ? remaining_h : lr_params->loop_restoration_size;
+
+            // Offset the tile upwards to align with the restoration processing stripe
+            tile_limit.v_start = AOMMAX(tile_rect.top, tile_rect.top + row - voffset);
+            tile_limit.v_end   = tile_rect.top + row + h;
+            if (tile_limit.v_end < tile_rect.bottom) tile_limit.v_end -= voffset;
+            assert(tile_limit.v_end <= tile_rect.bottom);
+
+            // The filter reads RESTORATION_BORDER rows below the unit row
+            if (!last_rows && tile_limit.v_end + RESTORATION_BORDER > avail_rows) break;
 
-        for (y = 0, unit_row = 0; y < tile_h; y += h, unit_row++) {
             dec_av1_loop_restoration_filter_row(dec_handle,
                                                 plane,
-                                                y,
-                                                &h,
+                                                &tile_limit,
                                                 sx,
                                                 sy,
                                                 src_stride,
@@ -321,16 +372,51 @@ void dec_av1_loop_restoration_filter_frame(EbDecHandle *dec_handle, int optimize
                                                 src,
                                                 dst,
                                                 optimized_lr,
-                                                unit_row);
-        }
-        for (y = 0; y < tile_h; y++) {
-            memcpy(src, dst, dst_stride * sizeof(*dst) << use_highbd);
-            src += src_stride << use_highbd;
-            dst += dst_stride << use_highbd;
+                                                lr_ctxt->next_unit_row[plane]);
+
+            // The bottom rows of the previous unit row were read above this one
+            lr_copy_rows(src + (((tile_limit.v_start - num_pending) * src_stride) << use_highbd),
+                         src_stride,
+                         pending,
+                         dst_stride,
+                         tile_w,
+                         num_pending,
+                         use_highbd);
+
+            // and the bottom rows of this one are read by the next unit row
+            const int num_rows = tile_limit.v_end - tile_limit.v_start;
+            num_pending        = tile_limit.v_end < tile_rect.bottom ? RESTORATION_BORDER : 0;
+            lr_copy_rows(src + ((tile_limit.v_start * src_stride) << use_highbd),
+                         src_stride,
+                         dst,
+                         dst_stride,
+                         tile_w,
+                         num_rows - num_pending,
+                         use_highbd);
+            lr_copy_rows(pending,
+                         dst_stride,
+                         dst + (((num_rows - num_pending) * dst_stride) << use_highbd),
+                         dst_stride,
+                         tile_w,
+                         num_pending,
+                         use_highbd);
+
+            lr_ctxt->next_row[plane] += h;
+            lr_ctxt->next_unit_row[plane]++;
         }
+        lr_ctxt->num_pending[plane] = num_pending;
     }
 }
 
+void dec_av1_loop_restoration_filter_frame(EbDecHandle *dec_handle, int optimized_lr,
+                                           int enable_flag) {
+    if (!enable_flag) return;
+
+    dec_av1_loop_restoration_start_frame(dec_handle);
+    dec_av1_loop_restoration_filter_rows(
+        dec_handle, optimized_lr, dec_handle->frame_header.frame_size.frame_height);
+}
+
 void dec_av1_loop_restoration_save_boundary_lines(EbDecHandle *dec_handle, int after_cdef,
                                                   int enable_flag) {
     if (!enable_flag) return;
@@ -17,6 +17,13 @@ void dec_av1_loop_restoration_save_boundary_lines(EbDecHandle *dec_handle, int a
 void dec_av1_loop_restoration_filter_frame(EbDecHandle *dec_handle, int optimized_lr,
                                            int enable_flag);
 
+/* Reset the LR progress at the start of a frame */
+void dec_av1_loop_restoration_start_frame(EbDecHandle *dec_handle);
+/* Restore the unit rows whose rows, and the rows read below them, are among
+ * the first end_row luma rows of the frame that are done with CDEF */
+void dec_av1_loop_restoration_filter_rows(EbDecHandle *dec_handle, int optimized_lr,
+                                          int32_t end_row);
+
 #ifdef __cplusplus
 }
 #endif
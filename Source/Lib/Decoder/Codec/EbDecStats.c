@@ -0,0 +1,51 @@
+/*
+* Copyright(c) 2019 Netflix, Inc.
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+// SUMMARY
+//   Time spent in each decoding stage, reported when stat_report is set
+
+/**************************************
+ * Includes
+ **************************************/
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "EbDecStats.h"
+
+uint64_t dec_stats_time_ns(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER        count;
+
+    if (!freq.QuadPart) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (uint64_t)count.QuadPart / freq.QuadPart * 1000000000 +
+           (uint64_t)count.QuadPart % freq.QuadPart * 1000000000 / freq.QuadPart;
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+void dec_stats_init(DecStageStats *stats, EbBool enabled) {
+    memset(stats, 0, sizeof(*stats));
+    stats->enabled = enabled;
+}
+
+void dec_stats_get(const DecStageStats *stats, EbSvtDecStageStats *out) {
+    out->parse_time      = stats->time_ns[DEC_STAGE_PARSE] / 1000;
+    out->recon_time      = stats->time_ns[DEC_STAGE_RECON] / 1000;
+    out->lf_time         = stats->time_ns[DEC_STAGE_LF] / 1000;
+    out->cdef_time       = stats->time_ns[DEC_STAGE_CDEF] / 1000;
+    out->lr_time         = stats->time_ns[DEC_STAGE_LR] / 1000;
+    out->film_grain_time = stats->time_ns[DEC_STAGE_FILM_GRAIN] / 1000;
+}
@@ -0,0 +1,53 @@
+/*
+* Copyright(c) 2019 Netflix, Inc.
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbDecStats_h
+#define EbDecStats_h
+
+#include "EbDefinitions.h"
+#include "EbSvtAv1Dec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Decoding stages timed when stat_report is set */
+typedef enum DecStage {
+    DEC_STAGE_PARSE,
+    DEC_STAGE_RECON,
+    DEC_STAGE_LF,
+    DEC_STAGE_CDEF,
+    DEC_STAGE_LR,
+    DEC_STAGE_FILM_GRAIN,
+    DEC_STAGE_COUNT
+} DecStage;
+
+typedef struct DecStageStats {
+    EbBool enabled;
+    /* Nanoseconds spent in each stage */
+    uint64_t time_ns[DEC_STAGE_COUNT];
+} DecStageStats;
+
+/* Monotonic time in nanoseconds */
+uint64_t dec_stats_time_ns(void);
+
+/* Time at the start of a stage, 0 when the stats are off */
+static INLINE uint64_t dec_stage_start(const DecStageStats *stats) {
+    return stats->enabled ? dec_stats_time_ns() : 0;
+}
+
+/* Add the time since start to the stage */
+static INLINE void dec_stage_end(DecStageStats *stats, DecStage stage, uint64_t start) {
+    if (stats->enabled) stats->time_ns[stage] += dec_stats_time_ns() - start;
+}
+
+void dec_stats_init(DecStageStats *stats, EbBool enabled);
+
+void dec_stats_get(const DecStageStats *stats, EbSvtDecStageStats *out);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbDecStats_h
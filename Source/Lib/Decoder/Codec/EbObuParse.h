@@ -73,6 +73,8 @@ int get_qindex(SegmentationParams *seg_params, int segment_id, int base_q_idx);
 void svt_setup_motion_field(EbDecHandle *dec_handle, DecThreadCtxt *thread_ctxt);
 EbErrorType decode_multiple_obu(EbDecHandle *dec_handle_ptr, uint8_t **data, size_t data_size,
                                 uint32_t is_annexb);
+EbErrorType decode_one_obu(EbDecHandle *dec_handle_ptr, uint8_t **data, size_t *data_size,
+                           uint32_t is_annexb, int *frame_decoding_finished);
 
 static INLINE int allow_intrabc(const EbDecHandle *dec_handle) {
     return (dec_handle->frame_header.frame_type == KEY_FRAME ||
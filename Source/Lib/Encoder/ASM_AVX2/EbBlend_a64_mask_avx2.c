@@ -525,6 +525,307 @@ void aom_blend_a64_mask_avx2(uint8_t *dst, uint32_t dst_stride, const uint8_t *s
     }
 }
 
+/*Vertical and horizontal mask blend functions, used by OBMC*/
+void aom_blend_a64_vmask_avx2(uint8_t *dst, uint32_t dst_stride, const uint8_t *src0,
+                              uint32_t src0_stride, const uint8_t *src1, uint32_t src1_stride,
+                              const uint8_t *mask, int w, int h) {
+    assert(IMPLIES(src0 == dst, src0_stride == dst_stride));
+    assert(IMPLIES(src1 == dst, src1_stride == dst_stride));
+
+    assert(h >= 1);
+    assert(w >= 1);
+    assert(IS_POWER_OF_TWO(h));
+    assert(IS_POWER_OF_TWO(w));
+
+    if (w < 16) {
+        aom_blend_a64_vmask_sse4_1(
+            dst, dst_stride, src0, src0_stride, src1, src1_stride, mask, w, h);
+        return;
+    }
+
+    const __m256i v_maxval_b = _mm256_set1_epi8(AOM_BLEND_A64_MAX_ALPHA);
+    do {
+        const __m256i v_m0_b = _mm256_set1_epi8(*mask);
+        const __m256i v_m1_b = _mm256_sub_epi8(v_maxval_b, v_m0_b);
+
+        if (w == 16) {
+            const __m256i v_res_b =
+                blend_16_u8_avx2(src0, src1, &v_m0_b, &v_m1_b, AOM_BLEND_A64_ROUND_BITS);
+            xx_storeu_128(dst, _mm256_castsi256_si128(v_res_b));
+        } else {
+            for (int c = 0; c < w; c += 32) {
+                const __m256i v_res_b = blend_32_u8_avx2(
+                    src0 + c, src1 + c, &v_m0_b, &v_m1_b, AOM_BLEND_A64_ROUND_BITS);
+                yy_storeu_256(dst + c, v_res_b);
+            }
+        }
+        dst += dst_stride;
+        src0 += src0_stride;
+        src1 += src1_stride;
+        mask++;
+    } while (--h);
+}
+
+void aom_blend_a64_hmask_avx2(uint8_t *dst, uint32_t dst_stride, const uint8_t *src0,
+                              uint32_t src0_stride, const uint8_t *src1, uint32_t src1_stride,
+                              const uint8_t *mask, int w, int h) {
+    assert(IMPLIES(src0 == dst, src0_stride == dst_stride));
+    assert(IMPLIES(src1 == dst, src1_stride == dst_stride));
+
+    assert(h >= 1);
+    assert(w >= 1);
+    assert(IS_POWER_OF_TWO(h));
+    assert(IS_POWER_OF_TWO(w));
+
+    if (w < 16) {
+        aom_blend_a64_hmask_sse4_1(
+            dst, dst_stride, src0, src0_stride, src1, src1_stride, mask, w, h);
+        return;
+    }
+
+    const __m256i v_maxval_b = _mm256_set1_epi8(AOM_BLEND_A64_MAX_ALPHA);
+    if (w == 16) {
+        // blend_16_u8_avx2() spreads the 16 pixels over the two lanes
+        const __m256i v_m0_b =
+            _mm256_permute4x64_epi64(_mm256_castsi128_si256(xx_loadu_128(mask)), 0xd8);
+        const __m256i v_m1_b = _mm256_sub_epi8(v_maxval_b, v_m0_b);
+        do {
+            const __m256i v_res_b =
+                blend_16_u8_avx2(src0, src1, &v_m0_b, &v_m1_b, AOM_BLEND_A64_ROUND_BITS);
+            xx_storeu_128(dst, _mm256_castsi256_si128(v_res_b));
+            dst += dst_stride;
+            src0 += src0_stride;
+            src1 += src1_stride;
+        } while (--h);
+    } else {
+        // The mask row is reused by every row of the block
+        blend_a64_mask_w32n_avx2(
+            dst, dst_stride, src0, src0_stride, src1, src1_stride, mask, 0, w, h);
+    }
+}
+
+/* 16 high bitdepth pixels blended with the 16-bit weights v_m0_w */
+static INLINE __m256i highbd_blend_16_avx2(const __m256i v_s0_w, const __m256i v_s1_w,
+                                           const __m256i v_m0_w) {
+    const __m256i v_maxval_w = _mm256_set1_epi16(AOM_BLEND_A64_MAX_ALPHA);
+    const __m256i v_round_d  = _mm256_set1_epi32(1 << (AOM_BLEND_A64_ROUND_BITS - 1));
+    const __m256i v_m1_w     = _mm256_sub_epi16(v_maxval_w, v_m0_w);
+
+    // 12-bit pixels times 64 need 32-bit sums
+    const __m256i v_p0_d = _mm256_madd_epi16(_mm256_unpacklo_epi16(v_s0_w, v_s1_w),
+                                             _mm256_unpacklo_epi16(v_m0_w, v_m1_w));
+    const __m256i v_p1_d = _mm256_madd_epi16(_mm256_unpackhi_epi16(v_s0_w, v_s1_w),
+                                             _mm256_unpackhi_epi16(v_m0_w, v_m1_w));
+    const __m256i v_res0_d =
+        _mm256_srli_epi32(_mm256_add_epi32(v_p0_d, v_round_d), AOM_BLEND_A64_ROUND_BITS);
+    const __m256i v_res1_d =
+        _mm256_srli_epi32(_mm256_add_epi32(v_p1_d, v_round_d), AOM_BLEND_A64_ROUND_BITS);
+    return _mm256_packus_epi32(v_res0_d, v_res1_d);
+}
+
+/* Two rows of 8 high bitdepth pixels, one per lane */
+static INLINE void highbd_blend_8x2_avx2(uint16_t *dst, uint32_t dst_stride, const uint16_t *src0,
+                                         uint32_t src0_stride, const uint16_t *src1,
+                                         uint32_t src1_stride, const __m256i v_m0_w) {
+    const __m256i v_s0_w = yy_loadu2_128(src0 + src0_stride, src0);
+    const __m256i v_s1_w = yy_loadu2_128(src1 + src1_stride, src1);
+    yy_storeu2_128(dst + dst_stride, dst, highbd_blend_16_avx2(v_s0_w, v_s1_w, v_m0_w));
+}
+
+void eb_aom_highbd_blend_a64_vmask_avx2(uint16_t *dst, uint32_t dst_stride, const uint16_t *src0,
+                                        uint32_t src0_stride, const uint16_t *src1,
+                                        uint32_t src1_stride, const uint8_t *mask, int w, int h,
+                                        int bd) {
+    assert(IMPLIES(src0 == dst, src0_stride == dst_stride));
+    assert(IMPLIES(src1 == dst, src1_stride == dst_stride));
+
+    assert(h >= 1);
+    assert(w >= 1);
+    assert(IS_POWER_OF_TWO(h));
+    assert(IS_POWER_OF_TWO(w));
+
+    assert(bd == 8 || bd == 10 || bd == 12);
+
+    if (w < 8 || (w == 8 && h == 1)) {
+        eb_aom_highbd_blend_a64_vmask_sse4_1(
+            dst, dst_stride, src0, src0_stride, src1, src1_stride, mask, w, h, bd);
+        return;
+    }
+
+    if (w == 8) {
+        do {
+            const __m256i v_m0_w =
+                yy_set_m128i(_mm_set1_epi16(mask[1]), _mm_set1_epi16(mask[0]));
+            highbd_blend_8x2_avx2(dst, dst_stride, src0, src0_stride, src1, src1_stride, v_m0_w);
+            dst += 2 * dst_stride;
+            src0 += 2 * src0_stride;
+            src1 += 2 * src1_stride;
+            mask += 2;
+        } while (h -= 2);
+        return;
+    }
+
+    do {
+        const __m256i v_m0_w = _mm256_set1_epi16(*mask);
+        for (int c = 0; c < w; c += 16) {
+            const __m256i v_res_w = highbd_blend_16_avx2(
+                yy_loadu_256(src0 + c), yy_loadu_256(src1 + c), v_m0_w);
+            yy_storeu_256(dst + c, v_res_w);
+        }
+        dst += dst_stride;
+        src0 += src0_stride;
+        src1 += src1_stride;
+        mask++;
+    } while (--h);
+}
+
+void eb_aom_highbd_blend_a64_hmask_avx2(uint16_t *dst, uint32_t dst_stride, const uint16_t *src0,
+                                        uint32_t src0_stride, const uint16_t *src1,
+                                        uint32_t src1_stride, const uint8_t *mask, int w, int h,
+                                        int bd) {
+    assert(IMPLIES(src0 == dst, src0_stride == dst_stride));
+    assert(IMPLIES(src1 == dst, src1_stride == dst_stride));
+
+    assert(h >= 1);
+    assert(w >= 1);
+    assert(IS_POWER_OF_TWO(h));
+    assert(IS_POWER_OF_TWO(w));
+
+    assert(bd == 8 || bd == 10 || bd == 12);
+
+    if (w < 8 || (w == 8 && h == 1)) {
+        eb_aom_highbd_blend_a64_hmask_sse4_1(
+            dst, dst_stride, src0, src0_stride, src1, src1_stride, mask, w, h, bd);
+        return;
+    }
+
+    if (w == 8) {
+        const __m128i v_m_w  = _mm_cvtepu8_epi16(xx_loadl_64(mask));
+        const __m256i v_m0_w = yy_set_m128i(v_m_w, v_m_w);
+        do {
+            highbd_blend_8x2_avx2(dst, dst_stride, src0, src0_stride, src1, src1_stride, v_m0_w);
+            dst += 2 * dst_stride;
+            src0 += 2 * src0_stride;
+            src1 += 2 * src1_stride;
+        } while (h -= 2);
+        return;
+    }
+
+    do {
+        for (int c = 0; c < w; c += 16) {
+            const __m256i v_m0_w = _mm256_cvtepu8_epi16(xx_loadu_128(mask + c));
+            const __m256i v_res_w = highbd_blend_16_avx2(
+                yy_loadu_256(src0 + c), yy_loadu_256(src1 + c), v_m0_w);
+            yy_storeu_256(dst + c, v_res_w);
+        }
+        dst += dst_stride;
+        src0 += src0_stride;
+        src1 += src1_stride;
+    } while (--h);
+}
+
+void aom_highbd_blend_a64_vmask_avx2(uint8_t *dst_8, uint32_t dst_stride, const uint8_t *src0_8,
+                                     uint32_t src0_stride, const uint8_t *src1_8,
+                                     uint32_t src1_stride, const uint8_t *mask, int w, int h,
+                                     int bd) {
+    eb_aom_highbd_blend_a64_vmask_avx2((uint16_t *)dst_8,
+                                       dst_stride,
+                                       (const uint16_t *)src0_8,
+                                       src0_stride,
+                                       (const uint16_t *)src1_8,
+                                       src1_stride,
+                                       mask,
+                                       w,
+                                       h,
+                                       bd);
+}
+
+void aom_highbd_blend_a64_hmask_avx2(uint8_t *dst_8, uint32_t dst_stride, const uint8_t *src0_8,
+                                     uint32_t src0_stride, const uint8_t *src1_8,
+                                     uint32_t src1_stride, const uint8_t *mask, int w, int h,
+                                     int bd) {
+    eb_aom_highbd_blend_a64_hmask_avx2((uint16_t *)dst_8,
+                                       dst_stride,
+                                       (const uint16_t *)src0_8,
+                                       src0_stride,
+                                       (const uint16_t *)src1_8,
+                                       src1_stride,
+                                       mask,
+                                       w,
+                                       h,
+                                       bd);
+}
+
+/* 16 mask values of a high bitdepth block, subsampled like the chroma */
+static INLINE __m256i highbd_blend_mask_16_avx2(const uint8_t *mask, uint32_t mask_stride,
+                                                int subx, int suby) {
+    if (subx) {
+        const __m256i v_one_b = _mm256_set1_epi8(1);
+        __m256i       v_sum_w = _mm256_maddubs_epi16(yy_loadu_256(mask), v_one_b);
+        if (suby) {
+            v_sum_w = _mm256_add_epi16(
+                v_sum_w, _mm256_maddubs_epi16(yy_loadu_256(mask + mask_stride), v_one_b));
+            return yy_roundn_epu16(v_sum_w, 2);
+        }
+        return yy_roundn_epu16(v_sum_w, 1);
+    }
+    if (suby)
+        return _mm256_cvtepu8_epi16(
+            _mm_avg_epu8(xx_loadu_128(mask), xx_loadu_128(mask + mask_stride)));
+    return _mm256_cvtepu8_epi16(xx_loadu_128(mask));
+}
+
+void aom_highbd_blend_a64_mask_avx2(uint8_t *dst_8, uint32_t dst_stride, const uint8_t *src0_8,
+                                    uint32_t src0_stride, const uint8_t *src1_8,
+                                    uint32_t src1_stride, const uint8_t *mask,
+                                    uint32_t mask_stride, int w, int h, int subx, int suby,
+                                    int bd) {
+    uint16_t *      dst  = (uint16_t *)dst_8;
+    const uint16_t *src0 = (const uint16_t *)src0_8;
+    const uint16_t *src1 = (const uint16_t *)src1_8;
+
+    assert(IMPLIES(src0 == dst, src0_stride == dst_stride));
+    assert(IMPLIES(src1 == dst, src1_stride == dst_stride));
+
+    assert(h >= 1);
+    assert(w >= 1);
+    assert(IS_POWER_OF_TWO(h));
+    assert(IS_POWER_OF_TWO(w));
+
+    assert(bd == 8 || bd == 10 || bd == 12);
+
+    if (w < 16) {
+        aom_highbd_blend_a64_mask_sse4_1(dst_8,
+                                         dst_stride,
+                                         src0_8,
+                                         src0_stride,
+                                         src1_8,
+                                         src1_stride,
+                                         mask,
+                                         mask_stride,
+                                         w,
+                                         h,
+                                         subx,
+                                         suby,
+                                         bd);
+        return;
+    }
+
+    do {
+        for (int c = 0; c < w; c += 16) {
+            const __m256i v_m0_w =
+                highbd_blend_mask_16_avx2(mask + (c << subx), mask_stride, subx, suby);
+            const __m256i v_res_w = highbd_blend_16_avx2(
+                yy_loadu_256(src0 + c), yy_loadu_256(src1 + c), v_m0_w);
+            yy_storeu_256(dst + c, v_res_w);
+        }
+        dst += dst_stride;
+        src0 += src0_stride;
+        src1 += src1_stride;
+        mask += mask_stride << suby;
+    } while (--h);
+}
+
 /*Functions from convolve_avx2.c*/
 static INLINE void blend_a64_d16_mask_w16_avx2(uint8_t *dst, const CONV_BUF_TYPE *src0,
                                                const CONV_BUF_TYPE *src1, const __m256i *m0,
@@ -0,0 +1,174 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <immintrin.h>
+#include "noise_model.h"
+#include "aom_dsp_rtcd.h"
+
+#define kLowPolyNumParams 3
+#define kMaxFlatBlockSize 64
+
+static INLINE double hadd_pd(const __m256d sum) {
+    const __m128d sum_128 = _mm_add_pd(_mm256_castpd256_pd128(sum), _mm256_extractf128_pd(sum, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(sum_128, _mm_unpackhi_pd(sum_128, sum_128)));
+}
+
+static INLINE __m256d load_pixels(const AomFlatBlockFinder *block_finder, const uint8_t *row,
+                                  int32_t x, int32_t w) {
+    // Only the blocks on the picture border need their columns clamped
+    if (x >= 0 && x + 4 <= w) {
+        const __m128i pixels =
+            block_finder->use_highbd
+                ? _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i *)((const uint16_t *)row + x)))
+                : _mm_cvtepu8_epi32(_mm_cvtsi32_si128(*(const int32_t *)(row + x)));
+        return _mm256_cvtepi32_pd(pixels);
+    }
+    int32_t pixels[4];
+    for (int32_t i = 0; i < 4; i++) {
+        const int32_t xc = clamp(x + i, 0, w - 1);
+        pixels[i] = block_finder->use_highbd ? ((const uint16_t *)row)[xc] : row[xc];
+    }
+    return _mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i *)pixels));
+}
+
+void eb_aom_flat_block_finder_extract_block_avx2(const AomFlatBlockFinder *block_finder,
+                                                 const uint8_t *const data, int32_t w, int32_t h,
+                                                 int32_t stride, int32_t offsx, int32_t offsy,
+                                                 double *plane, double *block) {
+    const int32_t block_size = block_finder->block_size;
+    const double *A          = block_finder->A;
+    const double *at_a_inv   = block_finder->at_a_inv;
+    double        plane_coords[kLowPolyNumParams];
+    double        at_a_inv__b[kLowPolyNumParams];
+    DECLARE_ALIGNED(32, double, xd[kMaxFlatBlockSize]);
+
+    if ((block_size & 3) || block_size > kMaxFlatBlockSize) {
+        eb_aom_flat_block_finder_extract_block_c(
+            block_finder, data, w, h, stride, offsx, offsy, plane, block);
+        return;
+    }
+
+    // The columns of A are {yd, xd, 1}, yd only depends on the row and xd on
+    // the column of the pixel
+    for (int32_t x = 0; x < block_size; x++) xd[x] = A[kLowPolyNumParams * x + 1];
+
+    const __m256d normalization = _mm256_set1_pd(block_finder->normalization);
+    __m256d       sum_y         = _mm256_setzero_pd();
+    __m256d       sum_x         = _mm256_setzero_pd();
+    __m256d       sum_1         = _mm256_setzero_pd();
+
+    for (int32_t yi = 0; yi < block_size; ++yi) {
+        const int32_t  y       = clamp(offsy + yi, 0, h - 1);
+        const uint8_t *row     = data + ((y * stride) << block_finder->use_highbd);
+        const __m256d  yd      = _mm256_set1_pd(A[kLowPolyNumParams * yi * block_size]);
+        __m256d        sum_row = _mm256_setzero_pd();
+
+        for (int32_t xi = 0; xi < block_size; xi += 4) {
+            const __m256d b =
+                _mm256_div_pd(load_pixels(block_finder, row, offsx + xi, w), normalization);
+            _mm256_storeu_pd(block + yi * block_size + xi, b);
+            sum_row = _mm256_add_pd(sum_row, b);
+            sum_x   = _mm256_add_pd(sum_x, _mm256_mul_pd(b, _mm256_load_pd(xd + xi)));
+        }
+        sum_y = _mm256_add_pd(sum_y, _mm256_mul_pd(sum_row, yd));
+        sum_1 = _mm256_add_pd(sum_1, sum_row);
+    }
+    at_a_inv__b[0] = hadd_pd(sum_y);
+    at_a_inv__b[1] = hadd_pd(sum_x);
+    at_a_inv__b[2] = hadd_pd(sum_1);
+
+    for (int32_t i = 0; i < kLowPolyNumParams; ++i) {
+        plane_coords[i] = 0;
+        for (int32_t k = 0; k < kLowPolyNumParams; ++k)
+            plane_coords[i] += at_a_inv[i * kLowPolyNumParams + k] * at_a_inv__b[k];
+    }
+
+    const __m256d coord_y = _mm256_set1_pd(plane_coords[0]);
+    const __m256d coord_x = _mm256_set1_pd(plane_coords[1]);
+    const __m256d coord_1 = _mm256_set1_pd(plane_coords[2]);
+
+    for (int32_t yi = 0; yi < block_size; ++yi) {
+        const __m256d yd = _mm256_mul_pd(_mm256_set1_pd(A[kLowPolyNumParams * yi * block_size]),
+                                         coord_y);
+        for (int32_t xi = 0; xi < block_size; xi += 4) {
+            const int32_t i = yi * block_size + xi;
+            const __m256d p = _mm256_add_pd(
+                _mm256_add_pd(yd, _mm256_mul_pd(_mm256_load_pd(xd + xi), coord_x)), coord_1);
+            _mm256_storeu_pd(plane + i, p);
+            _mm256_storeu_pd(block + i, _mm256_sub_pd(_mm256_loadu_pd(block + i), p));
+        }
+    }
+}
+
+void eb_aom_flat_block_gradient_stats_avx2(const double *block, int32_t block_size,
+                                           double *stats) {
+    const __m256d half    = _mm256_set1_pd(0.5);
+    __m256d       g_xx    = _mm256_setzero_pd();
+    __m256d       g_xy    = _mm256_setzero_pd();
+    __m256d       g_yy    = _mm256_setzero_pd();
+    __m256d       mean    = _mm256_setzero_pd();
+    __m256d       var     = _mm256_setzero_pd();
+    double        tail[5] = {0, 0, 0, 0, 0};
+
+    for (int32_t yi = 1; yi < block_size - 1; ++yi) {
+        const double *row = block + yi * block_size;
+        int32_t       xi  = 1;
+
+        for (; xi + 4 <= block_size - 1; xi += 4) {
+            const __m256d b  = _mm256_loadu_pd(row + xi);
+            const __m256d gx = _mm256_mul_pd(
+                _mm256_sub_pd(_mm256_loadu_pd(row + xi + 1), _mm256_loadu_pd(row + xi - 1)), half);
+            const __m256d gy = _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(row + xi + block_size),
+                                                           _mm256_loadu_pd(row + xi - block_size)),
+                                             half);
+            g_xx = _mm256_add_pd(g_xx, _mm256_mul_pd(gx, gx));
+            g_xy = _mm256_add_pd(g_xy, _mm256_mul_pd(gx, gy));
+            g_yy = _mm256_add_pd(g_yy, _mm256_mul_pd(gy, gy));
+            mean = _mm256_add_pd(mean, b);
+            var  = _mm256_add_pd(var, _mm256_mul_pd(b, b));
+        }
+        for (; xi < block_size - 1; ++xi) {
+            const double gx = (row[xi + 1] - row[xi - 1]) / 2;
+            const double gy = (row[xi + block_size] - row[xi - block_size]) / 2;
+            tail[0] += gx * gx;
+            tail[1] += gx * gy;
+            tail[2] += gy * gy;
+            tail[3] += row[xi];
+            tail[4] += row[xi] * row[xi];
+        }
+    }
+    stats[0] = hadd_pd(g_xx) + tail[0];
+    stats[1] = hadd_pd(g_xy) + tail[1];
+    stats[2] = hadd_pd(g_yy) + tail[2];
+    stats[3] = hadd_pd(mean) + tail[3];
+    stats[4] = hadd_pd(var) + tail[4];
+}
+
+void eb_aom_noise_model_add_observation_avx2(double *A, double *b, const double *buffer,
+                                             double val, int32_t n, double norm_sq) {
+    // Each element is still computed as (buffer[i] * buffer[j]) / norm_sq, so
+    // that the equations are the same as the C version
+    const __m256d norm = _mm256_set1_pd(norm_sq);
+    const __m256d v    = _mm256_set1_pd(val);
+    int32_t       i;
+
+    for (i = 0; i < n; ++i) {
+        const __m256d bi    = _mm256_set1_pd(buffer[i]);
+        double *      a_row = A + i * n;
+        int32_t       j     = i;
+
+        for (; j + 4 <= n; j += 4) {
+            const __m256d prod =
+                _mm256_div_pd(_mm256_mul_pd(bi, _mm256_loadu_pd(buffer + j)), norm);
+            _mm256_storeu_pd(a_row + j, _mm256_add_pd(_mm256_loadu_pd(a_row + j), prod));
+        }
+        for (; j < n; ++j) a_row[j] += (buffer[i] * buffer[j]) / norm_sq;
+    }
+    for (i = 0; i + 4 <= n; i += 4) {
+        const __m256d prod = _mm256_div_pd(_mm256_mul_pd(_mm256_loadu_pd(buffer + i), v), norm);
+        _mm256_storeu_pd(b + i, _mm256_add_pd(_mm256_loadu_pd(b + i), prod));
+    }
+    for (; i < n; ++i) b[i] += (buffer[i] * val) / norm_sq;
+}
@@ -0,0 +1,73 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <math.h>
+#include <immintrin.h>
+#include "ransac.h"
+
+static INLINE __m256d project_two_points(const __m256d points, const __m256d mul_a,
+                                         const __m256d mul_b, const __m256d offset) {
+    // points holds x0 y0 x1 y1, the swapped copy y0 x0 y1 x1. The products are
+    // added in the order of the C version so that the result is the same.
+    const __m256d swapped = _mm256_permute_pd(points, 0x5);
+    const __m256d proj =
+        _mm256_add_pd(_mm256_mul_pd(mul_a, points), _mm256_mul_pd(mul_b, swapped));
+    return _mm256_add_pd(proj, offset);
+}
+
+int av1_ransac_score_inliers_avx2(const double *mat, const double *corners1,
+                                  const double *corners2, int npoints, int *inlier_indices,
+                                  double *sum_distance, double *sum_distance_squared) {
+    // x' = mat[2] * x + mat[3] * y + mat[0], y' = mat[5] * y + mat[4] * x + mat[1]
+    const __m256d mul_a     = _mm256_setr_pd(mat[2], mat[5], mat[2], mat[5]);
+    const __m256d mul_b     = _mm256_setr_pd(mat[3], mat[4], mat[3], mat[4]);
+    const __m256d offset    = _mm256_setr_pd(mat[0], mat[1], mat[0], mat[1]);
+    const __m256d threshold = _mm256_set1_pd(INLIER_THRESHOLD);
+    // The horizontal add leaves the points in the order 0 2 1 3
+    static const int lane_of_point[4] = {0, 2, 1, 3};
+    DECLARE_ALIGNED(32, double, distance[4]);
+    int num_inliers = 0;
+    int i;
+
+    for (i = 0; i + 4 <= npoints; i += 4) {
+        const __m256d d01 = _mm256_sub_pd(
+            project_two_points(_mm256_loadu_pd(corners1 + i * 2), mul_a, mul_b, offset),
+            _mm256_loadu_pd(corners2 + i * 2));
+        const __m256d d23 = _mm256_sub_pd(
+            project_two_points(_mm256_loadu_pd(corners1 + i * 2 + 4), mul_a, mul_b, offset),
+            _mm256_loadu_pd(corners2 + i * 2 + 4));
+        const __m256d dist = _mm256_sqrt_pd(
+            _mm256_hadd_pd(_mm256_mul_pd(d01, d01), _mm256_mul_pd(d23, d23)));
+        const int mask = _mm256_movemask_pd(_mm256_cmp_pd(dist, threshold, _CMP_LT_OQ));
+
+        if (!mask) continue;
+        _mm256_store_pd(distance, dist);
+        for (int k = 0; k < 4; ++k) {
+            const int lane = lane_of_point[k];
+            if (mask & (1 << lane)) {
+                inlier_indices[num_inliers++] = i + k;
+                *sum_distance += distance[lane];
+                *sum_distance_squared += distance[lane] * distance[lane];
+            }
+        }
+    }
+
+    for (; i < npoints; ++i) {
+        const double x      = corners1[i * 2];
+        const double y      = corners1[i * 2 + 1];
+        const double proj_x = mat[2] * x + mat[3] * y + mat[0];
+        const double proj_y = mat[4] * x + mat[5] * y + mat[1];
+        const double dx     = proj_x - corners2[i * 2];
+        const double dy     = proj_y - corners2[i * 2 + 1];
+        const double dist   = sqrt(dx * dx + dy * dy);
+
+        if (dist < INLIER_THRESHOLD) {
+            inlier_indices[num_inliers++] = i;
+            *sum_distance += dist;
+            *sum_distance_squared += dist * dist;
+        }
+    }
+    return num_inliers;
+}
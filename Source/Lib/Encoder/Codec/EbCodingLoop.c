@@ -2078,6 +2078,47 @@ void av1_copy_frame_mvs(PictureControlSet *pcs_ptr, const Av1Common *const cm, M
         frame_mvs += frame_mvs_stride;
     }
 }
+
+// Luma samples read around the block and the motion vector: filter taps and 4:2:0 chroma rounding
+#define CREF_MCP_MARGIN 16
+
+/* Far references that carry a compressed copy are read through a window
+ * assembled from the thread's block cache. The window spans the block at zero
+ * motion and at the motion vector, which covers the clamped vector as well. */
+static EbPictureBufferDesc *compressed_reference_window(EncDecContext *    context_ptr,
+                                                        PictureControlSet *pcs_ptr,
+                                                        EbReferenceObject *ref_obj,
+                                                        EbPictureBufferDesc *ref_pic,
+                                                        uint32_t             list_idx) {
+    if (!ref_pic || !ref_obj->compressed_reference || !ref_obj->compressed_reference->valid)
+        return ref_pic;
+    const uint64_t picture_number = pcs_ptr->parent_pcs_ptr->picture_number;
+    const uint64_t distance       = picture_number > ref_obj->ref_poc
+                                  ? picture_number - ref_obj->ref_poc
+                                  : ref_obj->ref_poc - picture_number;
+    if (distance <= COMPRESSED_REF_DISTANCE)
+        return ref_pic;
+
+    const Mv *    mv = &context_ptr->mv_unit.mv[list_idx];
+    const int32_t mv_x = mv->x >> 3;
+    const int32_t mv_y = mv->y >> 3;
+    const int32_t x0   = context_ptr->blk_origin_x + AOMMIN(0, mv_x) - CREF_MCP_MARGIN;
+    const int32_t y0   = context_ptr->blk_origin_y + AOMMIN(0, mv_y) - CREF_MCP_MARGIN;
+    const int32_t x1 = context_ptr->blk_origin_x + context_ptr->blk_geom->bwidth + AOMMAX(0, mv_x) +
+                       CREF_MCP_MARGIN;
+    const int32_t y1 = context_ptr->blk_origin_y + context_ptr->blk_geom->bheight +
+                       AOMMAX(0, mv_y) + CREF_MCP_MARGIN;
+    EbPictureBufferDesc *window = eb_compressed_ref_window(context_ptr->cref_cache,
+                                                           list_idx,
+                                                           ref_obj->compressed_reference,
+                                                           ref_pic,
+                                                           x0,
+                                                           y0,
+                                                           x1 - x0,
+                                                           y1 - y0);
+    return window ? window : ref_pic;
+}
+
 /*******************************************
 * Encode Pass
 *
@@ -2921,6 +2962,13 @@ EB_EXTERN void av1_encode_pass(SequenceControlSet *scs_ptr, PictureControlSet *p
                                     blk_ptr->prediction_unit_array->ref_frame_index_l1 >= 0
                                         ? ref_obj_1->reference_picture
                                         : (EbPictureBufferDesc *)EB_NULL;
+                                if (context_ptr->cref_cache &&
+                                    pu_ptr->motion_mode == SIMPLE_TRANSLATION) {
+                                    ref_pic_list0 = compressed_reference_window(
+                                        context_ptr, pcs_ptr, ref_obj_0, ref_pic_list0, REF_LIST_0);
+                                    ref_pic_list1 = compressed_reference_window(
+                                        context_ptr, pcs_ptr, ref_obj_1, ref_pic_list1, REF_LIST_1);
+                                }
                             } else {
                                 ref_pic_list0 =
                                     blk_ptr->prediction_unit_array->ref_frame_index_l0 >= 0
@@ -11,10 +11,18 @@
 
 static void largest_coding_unit_dctor(EbPtr p) {
     SuperBlock *obj = (SuperBlock *)p;
+    // The block arrays belong to the PCS arena
     EB_DELETE(obj->quantized_coeff);
-    EB_FREE_ARRAY(obj->av1xd);
-    EB_FREE_ARRAY(obj->final_blk_arr);
-    EB_FREE_ARRAY(obj->cu_partition_array);
+}
+
+/* Arena bytes needed by one SB, including the SuperBlock itself */
+size_t largest_coding_unit_arena_size(uint8_t sb_size_pix) {
+    uint32_t tot_blk_num     = sb_size_pix == 128 ? 1024 : 256;
+    uint32_t max_block_count = sb_size_pix == 128 ? BLOCK_MAX_COUNT_SB_128 : BLOCK_MAX_COUNT_SB_64;
+
+    return EB_ARENA_SIZE(sizeof(SuperBlock)) + EB_ARENA_SIZE(sizeof(BlkStruct) * tot_blk_num) +
+           EB_ARENA_SIZE(sizeof(MacroBlockD) * tot_blk_num) +
+           EB_ARENA_SIZE(sizeof(PartitionType) * max_block_count);
 }
 /*
 Tasks & Questions
@@ -25,8 +33,9 @@ Tasks & Questions
     -Need a ReconPicture for each candidate.
     -I don't see a way around doing the copies in temp memory and then copying it in...
 */
-EbErrorType largest_coding_unit_ctor(SuperBlock *larget_coding_unit_ptr, uint8_t sb_size_pix,
-                                     uint16_t sb_origin_x, uint16_t sb_origin_y, uint16_t sb_index,
+EbErrorType largest_coding_unit_ctor(SuperBlock *larget_coding_unit_ptr, EbArena *arena,
+                                     uint8_t sb_size_pix, uint16_t sb_origin_x,
+                                     uint16_t sb_origin_y, uint16_t sb_index,
                                      PictureControlSet *picture_control_set)
 
 {
@@ -48,8 +57,8 @@ EbErrorType largest_coding_unit_ctor(SuperBlock *larget_coding_unit_ptr, uint8_t
 
     uint32_t cu_i;
     uint32_t tot_blk_num                    = sb_size_pix == 128 ? 1024 : 256;
-    EB_MALLOC_ARRAY(larget_coding_unit_ptr->final_blk_arr, tot_blk_num);
-    EB_MALLOC_ARRAY(larget_coding_unit_ptr->av1xd, tot_blk_num);
+    EB_ARENA_ALLOC_ARRAY(arena, larget_coding_unit_ptr->final_blk_arr, tot_blk_num);
+    EB_ARENA_ALLOC_ARRAY(arena, larget_coding_unit_ptr->av1xd, tot_blk_num);
 
     for (cu_i = 0; cu_i < tot_blk_num; ++cu_i) {
         for (txb_index = 0; txb_index < TRANSFORM_UNIT_MAX_COUNT; ++txb_index)
@@ -60,7 +69,7 @@ EbErrorType largest_coding_unit_ctor(SuperBlock *larget_coding_unit_ptr, uint8_t
 
     uint32_t max_block_count = sb_size_pix == 128 ? BLOCK_MAX_COUNT_SB_128 : BLOCK_MAX_COUNT_SB_64;
 
-    EB_MALLOC_ARRAY(larget_coding_unit_ptr->cu_partition_array, max_block_count);
+    EB_ARENA_ALLOC_ARRAY(arena, larget_coding_unit_ptr->cu_partition_array, max_block_count);
 
     coeff_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_FULL_MASK;
     coeff_init_data.max_width          = SB_STRIDE_Y;
@@ -440,9 +440,10 @@ typedef struct SuperBlock {
     TileInfo             tile_info;
 } SuperBlock;
 
-extern EbErrorType largest_coding_unit_ctor(SuperBlock *larget_coding_unit_ptr, uint8_t sb_sz,
-                                            uint16_t sb_origin_x, uint16_t sb_origin_y,
-                                            uint16_t                  sb_index,
+extern size_t      largest_coding_unit_arena_size(uint8_t sb_sz);
+extern EbErrorType largest_coding_unit_ctor(SuperBlock *larget_coding_unit_ptr, EbArena *arena,
+                                            uint8_t sb_sz, uint16_t sb_origin_x,
+                                            uint16_t sb_origin_y, uint16_t sb_index,
                                             struct PictureControlSet *picture_control_set);
 
 #ifdef __cplusplus
@@ -0,0 +1,266 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <string.h>
+
+#include "EbCompressedReference.h"
+
+#define CREF_CODED 0
+#define CREF_RAW 1
+// Longest coded block: header, then a width byte and 8 bits per sample for every row
+#define CREF_MAX_CODED_BLOCK (1 + CREF_BLOCK_SIZE * (1 + CREF_BLOCK_SIZE))
+
+static INLINE uint8_t zigzag_residual(int32_t residual) {
+    const int32_t s = (int8_t)residual;
+    return (uint8_t)((s << 1) ^ (s >> 7));
+}
+
+static INLINE int32_t unzigzag_residual(uint32_t z) { return (int32_t)(z >> 1) ^ -(int32_t)(z & 1); }
+
+/* Median edge detector of LOCO-I, restricted to the samples of the block so
+ * that every block decodes on its own. */
+static INLINE int32_t med_predict(const uint8_t *cur, uint32_t stride, uint32_t x, uint32_t y) {
+    if (!y) return x ? cur[-1] : 128;
+    if (!x) return cur[-(int32_t)stride];
+    const int32_t a  = cur[-1];
+    const int32_t b  = cur[-(int32_t)stride];
+    const int32_t c  = cur[-(int32_t)stride - 1];
+    const int32_t mx = AOMMAX(a, b);
+    const int32_t mn = AOMMIN(a, b);
+    if (c >= mx) return mn;
+    if (c <= mn) return mx;
+    return a + b - c;
+}
+
+static uint32_t encode_block(const uint8_t *src, uint32_t stride, uint32_t bw, uint32_t bh,
+                             uint8_t *out) {
+    uint8_t  zz[CREF_BLOCK_SIZE];
+    uint32_t pos = 1;
+
+    out[0] = CREF_CODED;
+    for (uint32_t y = 0; y < bh; y++) {
+        const uint8_t *row  = src + y * stride;
+        uint32_t       mask = 0;
+        for (uint32_t x = 0; x < bw; x++) {
+            zz[x] = zigzag_residual(row[x] - med_predict(row + x, stride, x, y));
+            mask |= zz[x];
+        }
+        uint32_t bits = 0;
+        while (mask >> bits) bits++;
+        out[pos++] = (uint8_t)bits;
+
+        uint32_t acc = 0, acc_bits = 0;
+        for (uint32_t x = 0; bits && x < bw; x++) {
+            acc |= (uint32_t)zz[x] << acc_bits;
+            acc_bits += bits;
+            while (acc_bits >= 8) {
+                out[pos++] = (uint8_t)acc;
+                acc >>= 8;
+                acc_bits -= 8;
+            }
+        }
+        if (acc_bits) out[pos++] = (uint8_t)acc;
+    }
+    if (pos > 1 + bw * bh) {
+        out[0] = CREF_RAW;
+        for (uint32_t y = 0; y < bh; y++) memcpy(out + 1 + y * bw, src + y * stride, bw);
+        pos = 1 + bw * bh;
+    }
+    return pos;
+}
+
+static void decode_block(const uint8_t *in, uint32_t bw, uint32_t bh, uint8_t *dst) {
+    if (in[0] == CREF_RAW) {
+        for (uint32_t y = 0; y < bh; y++) memcpy(dst + y * CREF_BLOCK_SIZE, in + 1 + y * bw, bw);
+        return;
+    }
+    in++;
+    for (uint32_t y = 0; y < bh; y++) {
+        uint8_t *      row  = dst + y * CREF_BLOCK_SIZE;
+        const uint32_t bits = *in++;
+        const uint32_t mask = (1 << bits) - 1;
+        uint32_t       acc = 0, acc_bits = 0;
+        for (uint32_t x = 0; x < bw; x++) {
+            while (acc_bits < bits) {
+                acc |= (uint32_t)*in++ << acc_bits;
+                acc_bits += 8;
+            }
+            const uint32_t z = acc & mask;
+            acc >>= bits;
+            acc_bits -= bits;
+            row[x] = (uint8_t)(med_predict(row + x, CREF_BLOCK_SIZE, x, y) + unzigzag_residual(z));
+        }
+    }
+}
+
+static void compressed_reference_dctor(EbPtr p) {
+    EbCompressedReference *obj = (EbCompressedReference *)p;
+    for (int32_t i = 0; i < 3; i++) {
+        EB_FREE_ARRAY(obj->plane[i].data);
+        EB_FREE_ARRAY(obj->plane[i].offset);
+    }
+}
+
+static EbErrorType compressed_plane_ctor(CompressedPlane *plane, uint32_t width,
+                                         uint32_t height) {
+    plane->width    = (uint16_t)width;
+    plane->height   = (uint16_t)height;
+    plane->blk_cols = (uint16_t)((width + CREF_BLOCK_SIZE - 1) >> CREF_BLOCK_LOG2);
+    plane->blk_rows = (uint16_t)((height + CREF_BLOCK_SIZE - 1) >> CREF_BLOCK_LOG2);
+    // The block streams are given half of the plane; a picture that does not
+    // compress that well is left uncompressed
+    plane->capacity = ((width * height) >> 1) + plane->blk_cols * plane->blk_rows;
+    EB_MALLOC_ARRAY(plane->data, plane->capacity);
+    EB_MALLOC_ARRAY(plane->offset, plane->blk_cols * plane->blk_rows + 1);
+    return EB_ErrorNone;
+}
+
+EbErrorType eb_compressed_reference_ctor(EbCompressedReference *cref,
+                                         EbPtr                  object_init_data_ptr) {
+    const EbPictureBufferDesc *ref_pic = (const EbPictureBufferDesc *)object_init_data_ptr;
+    const uint32_t luma_height = ref_pic->origin_y + ref_pic->height + ref_pic->origin_bot_y;
+    EbErrorType    return_error;
+
+    cref->dctor = compressed_reference_dctor;
+    cref->valid = EB_FALSE;
+
+    return_error = compressed_plane_ctor(&cref->plane[0], ref_pic->stride_y, luma_height);
+    if (return_error != EB_ErrorNone) return return_error;
+    return_error = compressed_plane_ctor(&cref->plane[1], ref_pic->stride_cb, luma_height >> 1);
+    if (return_error != EB_ErrorNone) return return_error;
+    return compressed_plane_ctor(&cref->plane[2], ref_pic->stride_cr, luma_height >> 1);
+}
+
+static EbBool compress_plane(CompressedPlane *plane, const uint8_t *src, uint32_t stride) {
+    uint8_t  coded[CREF_MAX_CODED_BLOCK];
+    uint32_t used = 0;
+    uint32_t idx  = 0;
+
+    for (uint32_t by = 0; by < plane->blk_rows; by++) {
+        for (uint32_t bx = 0; bx < plane->blk_cols; bx++, idx++) {
+            const uint32_t x  = bx << CREF_BLOCK_LOG2;
+            const uint32_t y  = by << CREF_BLOCK_LOG2;
+            const uint32_t bw = AOMMIN(CREF_BLOCK_SIZE, plane->width - x);
+            const uint32_t bh = AOMMIN(CREF_BLOCK_SIZE, plane->height - y);
+            const uint32_t size = encode_block(src + y * stride + x, stride, bw, bh, coded);
+            if (used + size > plane->capacity) return EB_FALSE;
+            plane->offset[idx] = used;
+            memcpy(plane->data + used, coded, size);
+            used += size;
+        }
+    }
+    plane->offset[idx] = used;
+    return EB_TRUE;
+}
+
+void eb_compressed_reference_compress(EbCompressedReference *    cref,
+                                      const EbPictureBufferDesc *ref_pic) {
+    cref->generation++;
+    cref->valid = compress_plane(&cref->plane[0], ref_pic->buffer_y, ref_pic->stride_y) &&
+                  compress_plane(&cref->plane[1], ref_pic->buffer_cb, ref_pic->stride_cb) &&
+                  compress_plane(&cref->plane[2], ref_pic->buffer_cr, ref_pic->stride_cr);
+}
+
+EbErrorType eb_compressed_ref_cache_ctor(EbCompressedRefCache *cache) {
+    cache->dctor = NULL;
+    return EB_ErrorNone;
+}
+
+static const uint8_t *get_block(EbCompressedRefCache *cache, const EbCompressedReference *cref,
+                                uint32_t plane_idx, uint32_t bx, uint32_t by) {
+    const CompressedPlane * plane = &cref->plane[plane_idx];
+    const uint32_t          idx   = by * plane->blk_cols + bx;
+    const uint32_t          key   = (plane_idx << 24) | idx;
+    CompressedRefCacheSlot *slot =
+        &cache->slot[(by * 5 + bx + plane_idx * 23) & (CREF_CACHE_SLOTS - 1)];
+
+    if (slot->owner != cref || slot->generation != cref->generation || slot->key != key) {
+        const uint32_t x = bx << CREF_BLOCK_LOG2;
+        const uint32_t y = by << CREF_BLOCK_LOG2;
+        decode_block(plane->data + plane->offset[idx],
+                     AOMMIN(CREF_BLOCK_SIZE, plane->width - x),
+                     AOMMIN(CREF_BLOCK_SIZE, plane->height - y),
+                     slot->samples);
+        slot->owner      = cref;
+        slot->generation = cref->generation;
+        slot->key        = key;
+    }
+    return slot->samples;
+}
+
+// Copy [x0, x1) x [y0, y1) of the padded plane to dst
+static void fetch_area(EbCompressedRefCache *cache, const EbCompressedReference *cref,
+                       uint32_t plane_idx, int32_t x0, int32_t y0, int32_t x1, int32_t y1,
+                       uint8_t *dst, uint32_t dst_stride) {
+    for (int32_t by = y0 >> CREF_BLOCK_LOG2; by <= (y1 - 1) >> CREF_BLOCK_LOG2; by++) {
+        const int32_t top    = AOMMAX(y0, by << CREF_BLOCK_LOG2);
+        const int32_t bottom = AOMMIN(y1, (by + 1) << CREF_BLOCK_LOG2);
+        for (int32_t bx = x0 >> CREF_BLOCK_LOG2; bx <= (x1 - 1) >> CREF_BLOCK_LOG2; bx++) {
+            const int32_t  left  = AOMMAX(x0, bx << CREF_BLOCK_LOG2);
+            const int32_t  right = AOMMIN(x1, (bx + 1) << CREF_BLOCK_LOG2);
+            const uint8_t *blk   = get_block(cache, cref, plane_idx, bx, by);
+            for (int32_t y = top; y < bottom; y++)
+                memcpy(dst + (y - y0) * dst_stride + (left - x0),
+                       blk + ((y & (CREF_BLOCK_SIZE - 1)) << CREF_BLOCK_LOG2) +
+                           (left & (CREF_BLOCK_SIZE - 1)),
+                       right - left);
+        }
+    }
+}
+
+EbPictureBufferDesc *eb_compressed_ref_window(EbCompressedRefCache *       cache,
+                                              uint32_t                     window_idx,
+                                              const EbCompressedReference *cref,
+                                              const EbPictureBufferDesc *ref_pic, int32_t x,
+                                              int32_t y, int32_t w, int32_t h) {
+    const CompressedPlane *luma   = &cref->plane[0];
+    EbPictureBufferDesc *  window = &cache->window[window_idx];
+
+    // Move to padded plane coordinates, 4:2:0 aligned, and stay inside the padding
+    const int32_t x0 = AOMMAX(0, (x + ref_pic->origin_x) & ~1);
+    const int32_t y0 = AOMMAX(0, (y + ref_pic->origin_y) & ~1);
+    const int32_t x1 = AOMMIN(luma->width, (x + w + ref_pic->origin_x + 1) & ~1);
+    const int32_t y1 = AOMMIN(luma->height, (y + h + ref_pic->origin_y + 1) & ~1);
+    if (x1 <= x0 || y1 <= y0 || x1 - x0 > CREF_WINDOW_SIZE || y1 - y0 > CREF_WINDOW_SIZE)
+        return NULL;
+
+    const uint32_t stride        = (uint32_t)(x1 - x0);
+    const uint32_t stride_chroma = stride >> 1;
+    fetch_area(cache, cref, 0, x0, y0, x1, y1, cache->scratch_y[window_idx], stride);
+    fetch_area(cache,
+               cref,
+               1,
+               x0 >> 1,
+               y0 >> 1,
+               x1 >> 1,
+               y1 >> 1,
+               cache->scratch_cb[window_idx],
+               stride_chroma);
+    fetch_area(cache,
+               cref,
+               2,
+               x0 >> 1,
+               y0 >> 1,
+               x1 >> 1,
+               y1 >> 1,
+               cache->scratch_cr[window_idx],
+               stride_chroma);
+
+    // Bias the buffer pointers so that origin and picture coordinates land in the scratch planes
+    *window           = *ref_pic;
+    window->dctor     = NULL;
+    window->stride_y  = (uint16_t)stride;
+    window->stride_cb = (uint16_t)stride_chroma;
+    window->stride_cr = (uint16_t)stride_chroma;
+    window->buffer_y  = cache->scratch_y[window_idx] - x0 - y0 * (int32_t)stride;
+    window->buffer_cb =
+        cache->scratch_cb[window_idx] - (x0 >> 1) - (y0 >> 1) * (int32_t)stride_chroma;
+    window->buffer_cr =
+        cache->scratch_cr[window_idx] - (x0 >> 1) - (y0 >> 1) * (int32_t)stride_chroma;
+    window->buffer_bit_inc_y  = NULL;
+    window->buffer_bit_inc_cb = NULL;
+    window->buffer_bit_inc_cr = NULL;
+    return window;
+}
@@ -0,0 +1,102 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbCompressedReference_h
+#define EbCompressedReference_h
+
+#include "EbDefinitions.h"
+#include "EbObject.h"
+#include "EbPictureBufferDesc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Experimental, compile time only. When above 0, every 8-bit reference keeps a
+ * compressed copy and the final motion compensation reads the references
+ * further than this many pictures away through it. Mode decision and the loop
+ * filters still read the full picture, so the copy adds memory and is slower
+ * on the tested configurations. 0 = off. */
+#ifndef COMPRESSED_REF_DISTANCE
+#define COMPRESSED_REF_DISTANCE 0
+#endif
+
+#define CREF_BLOCK_LOG2 6
+#define CREF_BLOCK_SIZE (1 << CREF_BLOCK_LOG2)
+#define CREF_CACHE_SLOTS 64 // power of 2
+#define CREF_WINDOW_SIZE 256 // largest luma window assembled from the cache
+#define CREF_WINDOW_COUNT 2 // one window per reference list
+
+/**************************************
+ * Compressed reference
+ *  8 bit planes stored losslessly as independent 64x64 blocks (LOCO-I
+ *  prediction inside the block, bit packed residuals per row) so any block
+ *  can be decoded on its own. The planes include the padding, which costs
+ *  next to nothing once predicted.
+ **************************************/
+typedef struct CompressedPlane {
+    uint8_t * data; // block streams
+    uint32_t *offset; // start of each block in data, blk_count + 1 entries
+    uint32_t  capacity; // size of data
+    uint16_t  width; // padded plane width
+    uint16_t  height; // padded plane height
+    uint16_t  blk_cols;
+    uint16_t  blk_rows;
+} CompressedPlane;
+
+typedef struct EbCompressedReference {
+    EbDctor         dctor;
+    CompressedPlane plane[3];
+    EbBool          valid; // EB_FALSE when the last picture did not fit in the block streams
+    uint64_t        generation; // bumped on every compression, invalidates cached blocks
+} EbCompressedReference;
+
+/**************************************
+ * Per thread block cache
+ *  Direct mapped cache of decoded blocks plus the scratch planes the MCP
+ *  windows are assembled in.
+ **************************************/
+typedef struct CompressedRefCacheSlot {
+    const EbCompressedReference *owner;
+    uint64_t                     generation;
+    uint32_t                     key; // plane and block index
+    uint8_t                      samples[CREF_BLOCK_SIZE * CREF_BLOCK_SIZE];
+} CompressedRefCacheSlot;
+
+typedef struct EbCompressedRefCache {
+    EbDctor                dctor;
+    CompressedRefCacheSlot slot[CREF_CACHE_SLOTS];
+    EbPictureBufferDesc    window[CREF_WINDOW_COUNT];
+    uint8_t                scratch_y[CREF_WINDOW_COUNT][CREF_WINDOW_SIZE * CREF_WINDOW_SIZE];
+    uint8_t scratch_cb[CREF_WINDOW_COUNT][(CREF_WINDOW_SIZE >> 1) * (CREF_WINDOW_SIZE >> 1)];
+    uint8_t scratch_cr[CREF_WINDOW_COUNT][(CREF_WINDOW_SIZE >> 1) * (CREF_WINDOW_SIZE >> 1)];
+} EbCompressedRefCache;
+
+/**************************************
+ * Extern Function Declarations
+ **************************************/
+// object_init_data_ptr is the 8 bit EbPictureBufferDesc of the reference to compress
+extern EbErrorType eb_compressed_reference_ctor(EbCompressedReference *cref,
+                                                EbPtr                  object_init_data_ptr);
+
+extern void eb_compressed_reference_compress(EbCompressedReference *    cref,
+                                             const EbPictureBufferDesc *ref_pic);
+
+extern EbErrorType eb_compressed_ref_cache_ctor(EbCompressedRefCache *cache);
+
+/* Assemble the luma area [x, x + w) x [y, y + h) of the reference (picture
+ * coordinates, may reach into the padding) and the matching chroma area into
+ * window window_idx. The returned descriptor addresses the samples exactly as
+ * ref_pic does; NULL when the area does not fit in the window. */
+extern EbPictureBufferDesc *eb_compressed_ref_window(EbCompressedRefCache *       cache,
+                                                     uint32_t                     window_idx,
+                                                     const EbCompressedReference *cref,
+                                                     const EbPictureBufferDesc *  ref_pic,
+                                                     int32_t x, int32_t y, int32_t w, int32_t h);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbCompressedReference_h
@@ -616,21 +616,40 @@ void loop_filter_sb(EbPictureBufferDesc *frame_buffer, //reconpicture,
     }
 }
 
-void eb_av1_loop_filter_frame(EbPictureBufferDesc *frame_buffer, PictureControlSet *pcs_ptr,
-                              int32_t plane_start, int32_t plane_end) {
+void eb_av1_loop_filter_sb_row(EbPictureBufferDesc *frame_buffer, PictureControlSet *pcs_ptr,
+                               uint32_t y_sb_index, int32_t plane_start, int32_t plane_end) {
     SequenceControlSet *scs_ptr =
         (SequenceControlSet *)pcs_ptr->parent_pcs_ptr->scs_wrapper_ptr->object_ptr;
-    //SuperBlock                     *sb_ptr;
-    //uint16_t                                   sb_index;
     uint8_t  sb_size_log2 = (uint8_t)Log2f(scs_ptr->sb_size_pix);
+    uint32_t sb_origin_y  = y_sb_index << sb_size_log2;
     uint32_t x_sb_index;
-    uint32_t y_sb_index;
     uint32_t sb_origin_x;
-    uint32_t sb_origin_y;
     EbBool   end_of_row_flag;
 
     uint32_t pic_width_in_sb =
         (scs_ptr->seq_header.max_frame_width + scs_ptr->sb_size_pix - 1) / scs_ptr->sb_size_pix;
+
+    for (x_sb_index = 0; x_sb_index < pic_width_in_sb; ++x_sb_index) {
+        sb_origin_x     = x_sb_index << sb_size_log2;
+        end_of_row_flag = (x_sb_index == pic_width_in_sb - 1) ? EB_TRUE : EB_FALSE;
+
+        loop_filter_sb(frame_buffer,
+                       pcs_ptr,
+                       NULL,
+                       sb_origin_y >> 2,
+                       sb_origin_x >> 2,
+                       plane_start,
+                       plane_end,
+                       end_of_row_flag);
+    }
+}
+
+void eb_av1_loop_filter_frame(EbPictureBufferDesc *frame_buffer, PictureControlSet *pcs_ptr,
+                              int32_t plane_start, int32_t plane_end) {
+    SequenceControlSet *scs_ptr =
+        (SequenceControlSet *)pcs_ptr->parent_pcs_ptr->scs_wrapper_ptr->object_ptr;
+    uint32_t y_sb_index;
+
     uint32_t picture_height_in_sb =
         (scs_ptr->seq_header.max_frame_height + scs_ptr->sb_size_pix - 1) / scs_ptr->sb_size_pix;
 
@@ -639,24 +658,8 @@ void eb_av1_loop_filter_frame(EbPictureBufferDesc *frame_buffer, PictureControlS
                                   plane_start,
                                   plane_end);
 
-    for (y_sb_index = 0; y_sb_index < picture_height_in_sb; ++y_sb_index) {
-        for (x_sb_index = 0; x_sb_index < pic_width_in_sb; ++x_sb_index) {
-            //sb_index        = (uint16_t)(y_sb_index * pic_width_in_sb + x_sb_index);
-            //sb_ptr          = pcs_ptr->sb_ptr_array[sb_index];
-            sb_origin_x     = x_sb_index << sb_size_log2;
-            sb_origin_y     = y_sb_index << sb_size_log2;
-            end_of_row_flag = (x_sb_index == pic_width_in_sb - 1) ? EB_TRUE : EB_FALSE;
-
-            loop_filter_sb(frame_buffer,
-                           pcs_ptr,
-                           NULL,
-                           sb_origin_y >> 2,
-                           sb_origin_x >> 2,
-                           plane_start,
-                           plane_end,
-                           end_of_row_flag);
-        }
-    }
+    for (y_sb_index = 0; y_sb_index < picture_height_in_sb; ++y_sb_index)
+        eb_av1_loop_filter_sb_row(frame_buffer, pcs_ptr, y_sb_index, plane_start, plane_end);
 }
 extern int16_t eb_av1_ac_quant_q3(int32_t qindex, int32_t delta, AomBitDepth bit_depth);
 
@@ -51,6 +51,11 @@ void loop_filter_sb(EbPictureBufferDesc *frame_buffer, //reconpicture,
                     PictureControlSet *pcs_ptr, MacroBlockD *xd, int32_t mi_row, int32_t mi_col,
                     int32_t plane_start, int32_t plane_end, uint8_t last_col);
 
+/* Deblock the SBs of the SB row y_sb_index, eb_av1_loop_filter_frame_init() must
+ * have been called for the frame */
+void eb_av1_loop_filter_sb_row(EbPictureBufferDesc *frame_buffer, PictureControlSet *pcs_ptr,
+                               uint32_t y_sb_index, int32_t plane_start, int32_t plane_end);
+
 void eb_av1_loop_filter_frame(
         EbPictureBufferDesc *frame_buffer,//reconpicture,
         //Yv12BufferConfig *frame_buffer,
@@ -0,0 +1,154 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <stdlib.h>
+
+#include "EbDenoiseWorkers.h"
+#include "EbThreads.h"
+
+/* Wake ups a worker may have pending, posts past it are dropped on some
+ * platforms which is harmless as the workers drain all the queued tasks */
+#define DENOISE_MAX_PENDING_WAKE_UPS 1024
+
+static void denoise_workers_dctor(EbPtr p) {
+    DenoiseWorkers *obj = (DenoiseWorkers *)p;
+
+    obj->exit = EB_TRUE;
+    for (uint32_t i = 0; i < obj->num_threads; i++) eb_post_semaphore(obj->work_semaphore);
+    for (uint32_t i = 0; i < obj->num_threads; i++) eb_block_on_semaphore(obj->exit_semaphore);
+    EB_DESTROY_THREAD_ARRAY(obj->thread_handle_array, obj->num_threads);
+    EB_FREE_ARRAY(obj->lane_array);
+    EB_DESTROY_SEMAPHORE(obj->exit_semaphore);
+    EB_DESTROY_SEMAPHORE(obj->work_semaphore);
+    EB_DESTROY_MUTEX(obj->mutex);
+}
+
+/* Remove a task whose jobs have all been handed out, called under the mutex */
+static void unlink_task(DenoiseWorkers *workers, DenoiseTask *task) {
+    DenoiseTask *prev = NULL;
+    DenoiseTask *cur  = workers->task_head;
+
+    while (cur != task) {
+        prev = cur;
+        cur  = cur->next;
+    }
+    if (prev)
+        prev->next = task->next;
+    else
+        workers->task_head = task->next;
+    if (workers->task_tail == task) workers->task_tail = prev;
+    task->next = NULL;
+}
+
+/* Run the jobs of task, or of any queued task when task is NULL, until none
+ * is left to hand out */
+static void run_jobs(DenoiseWorkers *workers, DenoiseTask *task, int32_t lane) {
+    for (;;) {
+        DenoiseTask *job_task;
+        int32_t      job;
+        EbBool       done;
+
+        eb_block_on_mutex(workers->mutex);
+        job_task = task ? task : workers->task_head;
+        if (job_task == NULL || job_task->next_job == job_task->num_jobs) {
+            eb_release_mutex(workers->mutex);
+            return;
+        }
+        job = job_task->next_job++;
+        if (job_task->next_job == job_task->num_jobs) unlink_task(workers, job_task);
+        eb_release_mutex(workers->mutex);
+
+        job_task->fcn(job_task->job_ctxt, job, lane);
+
+        eb_block_on_mutex(workers->mutex);
+        done = ++job_task->done_jobs == job_task->num_jobs;
+        eb_release_mutex(workers->mutex);
+        // The waiter may release the task as soon as it is posted
+        if (done) eb_post_semaphore(job_task->done_semaphore);
+    }
+}
+
+static void *denoise_worker_kernel(void *input_ptr) {
+    DenoiseWorkerLane *lane    = (DenoiseWorkerLane *)input_ptr;
+    DenoiseWorkers *   workers = lane->workers;
+
+    for (;;) {
+        eb_block_on_semaphore(workers->work_semaphore);
+        if (workers->exit) break;
+        run_jobs(workers, NULL, lane->lane);
+    }
+    eb_post_semaphore(workers->exit_semaphore);
+    return EB_NULL;
+}
+
+EbErrorType denoise_workers_ctor(DenoiseWorkers *workers, uint32_t num_threads) {
+    workers->dctor = denoise_workers_dctor;
+
+    EB_CREATE_MUTEX(workers->mutex);
+    EB_CREATE_SEMAPHORE(
+        workers->work_semaphore, 0, num_threads * DENOISE_MAX_PENDING_WAKE_UPS);
+    EB_CREATE_SEMAPHORE(workers->exit_semaphore, 0, num_threads);
+    EB_MALLOC_ARRAY(workers->lane_array, num_threads);
+    EB_ALLOC_PTR_ARRAY(workers->thread_handle_array, num_threads);
+    for (uint32_t i = 0; i < num_threads; i++) {
+        workers->lane_array[i].workers = workers;
+        workers->lane_array[i].lane    = i + 1;
+        EB_CREATE_THREAD(
+            workers->thread_handle_array[i], denoise_worker_kernel, &workers->lane_array[i]);
+        workers->num_threads++;
+    }
+    return EB_ErrorNone;
+}
+
+int32_t denoise_workers_num_lanes(const DenoiseWorkers *workers) {
+    return workers ? (int32_t)workers->num_threads + 1 : 1;
+}
+
+void denoise_workers_submit(DenoiseWorkers *workers, DenoiseTask *task, DenoiseJobFcn fcn,
+                            void *job_ctxt, int32_t num_jobs) {
+    task->fcn            = fcn;
+    task->job_ctxt       = job_ctxt;
+    task->num_jobs       = num_jobs;
+    task->next_job       = 0;
+    task->done_jobs      = 0;
+    task->done_semaphore = NULL;
+    task->next           = NULL;
+
+    // Without workers, or a semaphore to wait on, the waiter runs every job
+    if (workers == NULL || workers->num_threads == 0 || num_jobs <= 1) return;
+    task->done_semaphore = eb_create_semaphore(0, 1);
+    if (task->done_semaphore == NULL) return;
+
+    eb_block_on_mutex(workers->mutex);
+    if (workers->task_tail)
+        workers->task_tail->next = task;
+    else
+        workers->task_head = task;
+    workers->task_tail = task;
+    eb_release_mutex(workers->mutex);
+
+    const int32_t num_wake_ups = AOMMIN(num_jobs, (int32_t)workers->num_threads);
+    for (int32_t i = 0; i < num_wake_ups; i++) eb_post_semaphore(workers->work_semaphore);
+}
+
+void denoise_workers_wait(DenoiseWorkers *workers, DenoiseTask *task) {
+    if (task->done_semaphore == NULL) {
+        for (; task->next_job < task->num_jobs; task->next_job++)
+            task->fcn(task->job_ctxt, task->next_job, 0);
+        return;
+    }
+    run_jobs(workers, task, 0);
+    eb_block_on_semaphore(task->done_semaphore);
+    eb_destroy_semaphore(task->done_semaphore);
+    task->done_semaphore = NULL;
+}
+
+void denoise_workers_run(DenoiseWorkers *workers, DenoiseJobFcn fcn, void *job_ctxt,
+                         int32_t num_jobs) {
+    DenoiseTask task;
+
+    denoise_workers_submit(workers, &task, fcn, job_ctxt, num_jobs);
+    denoise_workers_wait(workers, &task);
+}
@@ -0,0 +1,75 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbDenoiseWorkers_h
+#define EbDenoiseWorkers_h
+
+#include "EbDefinitions.h"
+#include "EbObject.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Runs one job of a task. lane is unique among the threads running jobs of
+ * the same task, it is 0 for the thread that waits on the task. */
+typedef void (*DenoiseJobFcn)(void *job_ctxt, int32_t job, int32_t lane);
+
+/* Jobs [0, num_jobs) handed to the workers, owned by the submitting thread */
+typedef struct DenoiseTask {
+    DenoiseJobFcn       fcn;
+    void *              job_ctxt;
+    int32_t             num_jobs;
+    int32_t             next_job;
+    int32_t             done_jobs;
+    EbHandle            done_semaphore;
+    struct DenoiseTask *next;
+} DenoiseTask;
+
+struct DenoiseWorkers;
+
+/* Thread context of a worker */
+typedef struct DenoiseWorkerLane {
+    struct DenoiseWorkers *workers;
+    int32_t                lane;
+} DenoiseWorkerLane;
+
+/* Worker threads shared by the picture analysis threads for the film grain
+ * denoiser and noise model */
+typedef struct DenoiseWorkers {
+    EbDctor            dctor;
+    EbHandle           mutex;
+    EbHandle           work_semaphore;
+    EbHandle           exit_semaphore;
+    EbHandle *         thread_handle_array;
+    DenoiseWorkerLane *lane_array;
+    uint32_t           num_threads;
+    EbBool             exit;
+    DenoiseTask *      task_head;
+    DenoiseTask *      task_tail;
+} DenoiseWorkers;
+
+EbErrorType denoise_workers_ctor(DenoiseWorkers *workers, uint32_t num_threads);
+
+/* Number of lanes the jobs of a task may see, workers may be NULL */
+int32_t denoise_workers_num_lanes(const DenoiseWorkers *workers);
+
+/* Queue the jobs of a task, the calling thread keeps going. With NULL
+ * workers the jobs are all run by denoise_workers_wait(). */
+void denoise_workers_submit(DenoiseWorkers *workers, DenoiseTask *task, DenoiseJobFcn fcn,
+                            void *job_ctxt, int32_t num_jobs);
+
+/* Run the jobs of the task not yet taken by a worker and return once all of
+ * them are done */
+void denoise_workers_wait(DenoiseWorkers *workers, DenoiseTask *task);
+
+/* Submit and wait */
+void denoise_workers_run(DenoiseWorkers *workers, DenoiseJobFcn fcn, void *job_ctxt,
+                         int32_t num_jobs);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbDenoiseWorkers_h
@@ -23,6 +23,10 @@
 #include "EbDefinitions.h"
 #include "EbSequenceControlSet.h"
 #include "EbPictureControlSet.h"
+#include "EbCdef.h"
+
+/* Rows above a SB row that deblocking the SB row may still change */
+#define DLF_ROWS_ABOVE 8
 
 void eb_av1_loop_restoration_save_boundary_lines(const Yv12BufferConfig *frame, Av1Common *cm,
                                                  int32_t after_cdef);
@@ -84,6 +88,41 @@ EbErrorType dlf_context_ctor(EbThreadContext *thread_context_ptr, const EbEncHan
     return EB_ErrorNone;
 }
 
+/******************************************************
+ * Post the CDEF search segments of the segment rows, from *next_seg_row on,
+ * whose rows and the rows the search reads below them are below done_rows
+ ******************************************************/
+static void post_cdef_segments(DlfContext *context_ptr, PictureControlSet *pcs_ptr,
+                               EbObjectWrapper *pcs_wrapper_ptr, uint32_t *next_seg_row,
+                               uint32_t done_rows) {
+    SequenceControlSet *scs_ptr = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
+    uint32_t picture_height_in_b64 = (scs_ptr->seq_header.max_frame_height + 64 - 1) / 64;
+    uint8_t  sb_size_log2          = (uint8_t)Log2f(scs_ptr->sb_size_pix);
+
+    for (; *next_seg_row < pcs_ptr->cdef_segments_row_count; ++*next_seg_row) {
+        uint32_t y_b64_end_idx =
+            SEGMENT_END_IDX(*next_seg_row, picture_height_in_b64, pcs_ptr->cdef_segments_row_count);
+        // The search of a 64x64 block of a 128x128 SB may read the whole SB
+        uint32_t end_row = ALIGN_POWER_OF_TWO(y_b64_end_idx << 6, sb_size_log2) + CDEF_VBORDER;
+        if (end_row > done_rows) break;
+
+        for (uint32_t x_seg_idx = 0; x_seg_idx < pcs_ptr->cdef_segments_column_count;
+             ++x_seg_idx) {
+            EbObjectWrapper *  dlf_results_wrapper_ptr;
+            struct DlfResults *dlf_results_ptr;
+
+            // Get Empty DLF Results to Cdef
+            eb_get_empty_object(context_ptr->dlf_output_fifo_ptr, &dlf_results_wrapper_ptr);
+            dlf_results_ptr = (struct DlfResults *)dlf_results_wrapper_ptr->object_ptr;
+            dlf_results_ptr->pcs_wrapper_ptr = pcs_wrapper_ptr;
+            dlf_results_ptr->segment_index =
+                *next_seg_row * pcs_ptr->cdef_segments_column_count + x_seg_idx;
+            // Post DLF Results
+            eb_post_full_object(dlf_results_wrapper_ptr);
+        }
+    }
+}
+
 /******************************************************
  * Dlf Kernel
  ******************************************************/
@@ -98,10 +137,6 @@ void *dlf_kernel(void *input_ptr) {
     EbObjectWrapper *enc_dec_results_wrapper_ptr;
     EncDecResults *  enc_dec_results_ptr;
 
-    //// Output
-    EbObjectWrapper *  dlf_results_wrapper_ptr;
-    struct DlfResults *dlf_results_ptr;
-
     // SB Loop variables
     for (;;) {
         // Get EncDec Results
@@ -113,52 +148,15 @@ void *dlf_kernel(void *input_ptr) {
 
         EbBool is_16bit = (EbBool)(scs_ptr->static_config.encoder_bit_depth > EB_8BIT);
 
-        EbBool dlf_enable_flag = (EbBool)pcs_ptr->parent_pcs_ptr->loop_filter_mode;
-        if (dlf_enable_flag && pcs_ptr->parent_pcs_ptr->loop_filter_mode >= 2) {
-            EbPictureBufferDesc *recon_buffer =
-                is_16bit ? pcs_ptr->recon_picture16bit_ptr : pcs_ptr->recon_picture_ptr;
-
-            if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
-                //get the 16bit form of the input SB
-                if (is_16bit)
-                    recon_buffer =
-                        ((EbReferenceObject *)
-                             pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)
-                            ->reference_picture16bit;
-                else
-                    recon_buffer =
-                        ((EbReferenceObject *)
-                             pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)
-                            ->reference_picture;
-            else // non ref pictures
-                recon_buffer =
-                    is_16bit ? pcs_ptr->recon_picture16bit_ptr : pcs_ptr->recon_picture_ptr;
-
-            eb_av1_loop_filter_init(pcs_ptr);
-
-            if (pcs_ptr->parent_pcs_ptr->loop_filter_mode == 2) {
-                eb_av1_pick_filter_level(
-                    context_ptr,
-                    (EbPictureBufferDesc *)pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr,
-                    pcs_ptr,
-                    LPF_PICK_FROM_Q);
-            }
-
-            eb_av1_pick_filter_level(
-                context_ptr,
-                (EbPictureBufferDesc *)pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr,
-                pcs_ptr,
-                LPF_PICK_FROM_FULL_IMAGE);
-
-#if NO_ENCDEC
-            //NO DLF
-            pcs_ptr->parent_pcs_ptr->lf.filter_level[0] = 0;
-            pcs_ptr->parent_pcs_ptr->lf.filter_level[1] = 0;
-            pcs_ptr->parent_pcs_ptr->lf.filter_level_u  = 0;
-            pcs_ptr->parent_pcs_ptr->lf.filter_level_v  = 0;
-#endif
-            eb_av1_loop_filter_frame(recon_buffer, pcs_ptr, 0, 3);
-        }
+        pcs_ptr->cdef_segments_column_count = scs_ptr->cdef_segment_column_count;
+        pcs_ptr->cdef_segments_row_count    = scs_ptr->cdef_segment_row_count;
+        pcs_ptr->cdef_segments_total_count =
+            (uint16_t)(pcs_ptr->cdef_segments_column_count * pcs_ptr->cdef_segments_row_count);
+        pcs_ptr->tot_seg_searched_cdef = 0;
+        uint32_t next_seg_row          = 0;
+        uint32_t picture_height_in_sb =
+            (scs_ptr->seq_header.max_frame_height + scs_ptr->sb_size_pix - 1) /
+            scs_ptr->sb_size_pix;
 
         //pre-cdef prep
         {
@@ -184,8 +182,6 @@ void *dlf_kernel(void *input_ptr) {
 
             link_eb_to_aom_buffer_desc(recon_picture_ptr, cm->frame_to_show);
 
-            if (scs_ptr->seq_header.enable_restoration)
-                eb_av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 0);
             if (scs_ptr->seq_header.enable_cdef && pcs_ptr->parent_pcs_ptr->cdef_filter_mode) {
                 if (is_16bit) {
                     pcs_ptr->src[0] = (uint16_t *)recon_picture_ptr->buffer_y +
@@ -253,23 +249,79 @@ void *dlf_kernel(void *input_ptr) {
             }
         }
 
-        pcs_ptr->cdef_segments_column_count = scs_ptr->cdef_segment_column_count;
-        pcs_ptr->cdef_segments_row_count    = scs_ptr->cdef_segment_row_count;
-        pcs_ptr->cdef_segments_total_count =
-            (uint16_t)(pcs_ptr->cdef_segments_column_count * pcs_ptr->cdef_segments_row_count);
-        pcs_ptr->tot_seg_searched_cdef = 0;
-        uint32_t segment_index;
+        EbBool dlf_enable_flag = (EbBool)pcs_ptr->parent_pcs_ptr->loop_filter_mode;
+        if (dlf_enable_flag && pcs_ptr->parent_pcs_ptr->loop_filter_mode >= 2) {
+            EbPictureBufferDesc *recon_buffer =
+                is_16bit ? pcs_ptr->recon_picture16bit_ptr : pcs_ptr->recon_picture_ptr;
 
-        for (segment_index = 0; segment_index < pcs_ptr->cdef_segments_total_count;
-             ++segment_index) {
-            // Get Empty DLF Results to Cdef
-            eb_get_empty_object(context_ptr->dlf_output_fifo_ptr, &dlf_results_wrapper_ptr);
-            dlf_results_ptr = (struct DlfResults *)dlf_results_wrapper_ptr->object_ptr;
-            dlf_results_ptr->pcs_wrapper_ptr = enc_dec_results_ptr->pcs_wrapper_ptr;
-            dlf_results_ptr->segment_index   = segment_index;
-            // Post DLF Results
-            eb_post_full_object(dlf_results_wrapper_ptr);
+            if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
+                //get the 16bit form of the input SB
+                if (is_16bit)
+                    recon_buffer =
+                        ((EbReferenceObject *)
+                             pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)
+                            ->reference_picture16bit;
+                else
+                    recon_buffer =
+                        ((EbReferenceObject *)
+                             pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)
+                            ->reference_picture;
+            else // non ref pictures
+                recon_buffer =
+                    is_16bit ? pcs_ptr->recon_picture16bit_ptr : pcs_ptr->recon_picture_ptr;
+
+            eb_av1_loop_filter_init(pcs_ptr);
+
+            if (pcs_ptr->parent_pcs_ptr->loop_filter_mode == 2) {
+                eb_av1_pick_filter_level(
+                    context_ptr,
+                    (EbPictureBufferDesc *)pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr,
+                    pcs_ptr,
+                    LPF_PICK_FROM_Q);
+            }
+
+            eb_av1_pick_filter_level(
+                context_ptr,
+                (EbPictureBufferDesc *)pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr,
+                pcs_ptr,
+                LPF_PICK_FROM_FULL_IMAGE);
+
+#if NO_ENCDEC
+            //NO DLF
+            pcs_ptr->parent_pcs_ptr->lf.filter_level[0] = 0;
+            pcs_ptr->parent_pcs_ptr->lf.filter_level[1] = 0;
+            pcs_ptr->parent_pcs_ptr->lf.filter_level_u  = 0;
+            pcs_ptr->parent_pcs_ptr->lf.filter_level_v  = 0;
+#endif
+            eb_av1_loop_filter_frame_init(&pcs_ptr->parent_pcs_ptr->frm_hdr,
+                                          &pcs_ptr->parent_pcs_ptr->lf_info,
+                                          0,
+                                          3);
+            // The CDEF search of the segments whose rows are deblocked overlaps
+            // the deblocking of the rows below. Only the search does: the CDEF
+            // application and the restoration statistics wait for the whole frame
+            for (uint32_t y_sb_index = 0; y_sb_index + 1 < picture_height_in_sb; ++y_sb_index) {
+                eb_av1_loop_filter_sb_row(recon_buffer, pcs_ptr, y_sb_index, 0, 3);
+                post_cdef_segments(context_ptr,
+                                   pcs_ptr,
+                                   enc_dec_results_ptr->pcs_wrapper_ptr,
+                                   &next_seg_row,
+                                   (y_sb_index + 1) * scs_ptr->sb_size_pix - DLF_ROWS_ABOVE);
+            }
+            eb_av1_loop_filter_sb_row(recon_buffer, pcs_ptr, picture_height_in_sb - 1, 0, 3);
+        }
+
+        // The boundary lines are saved before the last segment row is posted,
+        // CDEF is applied once all the segments are searched
+        if (scs_ptr->seq_header.enable_restoration) {
+            Av1Common *cm = pcs_ptr->parent_pcs_ptr->av1_cm;
+            eb_av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 0);
         }
+        post_cdef_segments(context_ptr,
+                           pcs_ptr,
+                           enc_dec_results_ptr->pcs_wrapper_ptr,
+                           &next_seg_row,
+                           (uint32_t)~0);
 
         // Release EncDec Results
         eb_release_object(enc_dec_results_wrapper_ptr);
@@ -23,6 +23,8 @@
 #include "EbSvtAv1ErrorCodes.h"
 #include "EbUtility.h"
 #include "grainSynthesis.h"
+#include "EbPackUnPack.h"
+#include "common_dsp_rtcd.h"
 
 #define FC_SKIP_TX_SR_TH025 125 // Fast cost skip tx search threshold.
 #define FC_SKIP_TX_SR_TH010 110 // Fast cost skip tx search threshold.
@@ -43,12 +45,14 @@ static void enc_dec_context_dctor(EbPtr p) {
     EbThreadContext *thread_context_ptr = (EbThreadContext *)p;
     EncDecContext *  obj                = (EncDecContext *)thread_context_ptr->priv;
     EB_DELETE(obj->md_context);
+    EB_DELETE(obj->cref_cache);
     EB_DELETE(obj->residual_buffer);
     EB_DELETE(obj->transform_buffer);
     EB_DELETE(obj->inverse_quant_buffer);
     EB_DELETE(obj->input_sample16bit_buffer);
     if (obj->is_md_rate_estimation_ptr_owner) EB_FREE(obj->md_rate_estimation_ptr);
     EB_FREE_ARRAY(obj->transform_inner_array_ptr);
+    EB_FREE_ARRAY(obj->intra_coded_area_sb);
     EB_FREE_ARRAY(obj);
 }
 
@@ -90,6 +94,13 @@ EbErrorType enc_dec_context_ctor(EbThreadContext *  thread_context_ptr,
     // MD rate Estimation tables
     EB_MALLOC(context_ptr->md_rate_estimation_ptr, sizeof(MdRateEstimationContext));
     context_ptr->is_md_rate_estimation_ptr_owner = EB_TRUE;
+    // Intra coded area, one entry per 64x64 SB of the largest picture
+    {
+        const SequenceControlSet *scs_ptr = enc_handle_ptr->scs_instance_array[0]->scs_ptr;
+        EB_MALLOC_ARRAY(context_ptr->intra_coded_area_sb,
+                        ((scs_ptr->max_input_luma_width + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64) *
+                            ((scs_ptr->max_input_luma_height + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64));
+    }
 
     // Prediction Buffer
     {
@@ -163,6 +174,9 @@ EbErrorType enc_dec_context_ctor(EbThreadContext *  thread_context_ptr,
 
     context_ptr->md_context->enc_dec_context_ptr = context_ptr;
 
+    if (COMPRESSED_REF_DISTANCE && !context_ptr->is_16bit)
+        EB_NEW(context_ptr->cref_cache, eb_compressed_ref_cache_ctor);
+
     return EB_ErrorNone;
 }
 
@@ -1085,6 +1099,20 @@ void psnr_calculations(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr)
     }
 }
 
+// The kernels unpack rows in pairs, an odd last row is done separately
+static void un_pack_ref_msb(uint16_t *in16_bit_buffer, uint32_t in_stride, uint8_t *out8_bit_buffer,
+                            uint32_t out8_stride, uint32_t width, uint32_t height) {
+    un_pack8_bit_data(
+        in16_bit_buffer, in_stride, out8_bit_buffer, out8_stride, width, height & ~1u);
+    if (height & 1)
+        un_pack8_bit_data_c(in16_bit_buffer + (height - 1) * in_stride,
+                            in_stride,
+                            out8_bit_buffer + (height - 1) * out8_stride,
+                            out8_stride,
+                            width,
+                            1);
+}
+
 void pad_ref_and_set_flags(PictureControlSet *pcs_ptr, SequenceControlSet *scs_ptr) {
     EbReferenceObject *reference_object =
         (EbReferenceObject *)pcs_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr;
@@ -1117,6 +1145,10 @@ void pad_ref_and_set_flags(PictureControlSet *pcs_ptr, SequenceControlSet *scs_p
                          ref_pic_ptr->height >> 1,
                          ref_pic_ptr->origin_x >> 1,
                          ref_pic_ptr->origin_y >> 1);
+
+        // The reference is final once padded
+        if (reference_object->compressed_reference)
+            eb_compressed_reference_compress(reference_object->compressed_reference, ref_pic_ptr);
     }
 
     //We need this for MCP
@@ -1145,33 +1177,27 @@ void pad_ref_and_set_flags(PictureControlSet *pcs_ptr, SequenceControlSet *scs_p
                                ref_pic_16bit_ptr->origin_x,
                                ref_pic_16bit_ptr->origin_y >> 1);
 
-        // Hsan: unpack ref samples (to be used @ MD)
-        un_pack2d((uint16_t *)ref_pic_16bit_ptr->buffer_y,
-                  ref_pic_16bit_ptr->stride_y,
-                  ref_pic_ptr->buffer_y,
-                  ref_pic_ptr->stride_y,
-                  ref_pic_ptr->buffer_bit_inc_y,
-                  ref_pic_ptr->stride_bit_inc_y,
-                  ref_pic_16bit_ptr->width + (ref_pic_ptr->origin_x << 1),
-                  ref_pic_16bit_ptr->height + (ref_pic_ptr->origin_y << 1));
-
-        un_pack2d((uint16_t *)ref_pic_16bit_ptr->buffer_cb,
-                  ref_pic_16bit_ptr->stride_cb,
-                  ref_pic_ptr->buffer_cb,
-                  ref_pic_ptr->stride_cb,
-                  ref_pic_ptr->buffer_bit_inc_cb,
-                  ref_pic_ptr->stride_bit_inc_cb,
-                  (ref_pic_16bit_ptr->width + (ref_pic_ptr->origin_x << 1)) >> 1,
-                  (ref_pic_16bit_ptr->height + (ref_pic_ptr->origin_y << 1)) >> 1);
-
-        un_pack2d((uint16_t *)ref_pic_16bit_ptr->buffer_cr,
-                  ref_pic_16bit_ptr->stride_cr,
-                  ref_pic_ptr->buffer_cr,
-                  ref_pic_ptr->stride_cr,
-                  ref_pic_ptr->buffer_bit_inc_cr,
-                  ref_pic_ptr->stride_bit_inc_cr,
-                  (ref_pic_16bit_ptr->width + (ref_pic_ptr->origin_x << 1)) >> 1,
-                  (ref_pic_16bit_ptr->height + (ref_pic_ptr->origin_y << 1)) >> 1);
+        // Hsan: unpack the 8 most significant bits of the ref samples (to be used @ MD)
+        un_pack_ref_msb((uint16_t *)ref_pic_16bit_ptr->buffer_y,
+                        ref_pic_16bit_ptr->stride_y,
+                        ref_pic_ptr->buffer_y,
+                        ref_pic_ptr->stride_y,
+                        ref_pic_16bit_ptr->width + (ref_pic_ptr->origin_x << 1),
+                        ref_pic_16bit_ptr->height + (ref_pic_ptr->origin_y << 1));
+
+        un_pack_ref_msb((uint16_t *)ref_pic_16bit_ptr->buffer_cb,
+                        ref_pic_16bit_ptr->stride_cb,
+                        ref_pic_ptr->buffer_cb,
+                        ref_pic_ptr->stride_cb,
+                        (ref_pic_16bit_ptr->width + (ref_pic_ptr->origin_x << 1)) >> 1,
+                        (ref_pic_16bit_ptr->height + (ref_pic_ptr->origin_y << 1)) >> 1);
+
+        un_pack_ref_msb((uint16_t *)ref_pic_16bit_ptr->buffer_cr,
+                        ref_pic_16bit_ptr->stride_cr,
+                        ref_pic_ptr->buffer_cr,
+                        ref_pic_ptr->stride_cr,
+                        (ref_pic_16bit_ptr->width + (ref_pic_ptr->origin_x << 1)) >> 1,
+                        (ref_pic_16bit_ptr->height + (ref_pic_ptr->origin_y << 1)) >> 1);
     }
     // set up the ref POC
     reference_object->ref_poc = pcs_ptr->parent_pcs_ptr->picture_number;
@@ -143,6 +143,10 @@ typedef struct EncodeContext {
     EbHandle         shared_reference_mutex;
     uint64_t picture_number_alt; // The picture number overlay includes all the overlay frames
     EbHandle stat_file_mutex;
+    // Fast first pass statistics loaded for the second pass
+    FirstPassFrameStats *first_pass_stats;
+    uint64_t             first_pass_stats_count;
+    uint64_t             first_pass_avg_cost;
 } EncodeContext;
 
 typedef struct EncodeContextInitData {
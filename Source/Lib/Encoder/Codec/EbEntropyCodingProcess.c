@@ -349,12 +349,18 @@ static EbBool update_entropy_coding_rows(PictureControlSet *pcs_ptr, uint32_t *r
  * Write Stat to File
  * write stat_struct per frame in the first pass
  ******************************************************/
-void write_stat_to_file(SequenceControlSet *scs_ptr, StatStruct stat_struct, uint64_t ref_poc) {
+void write_stat_to_file(SequenceControlSet *scs_ptr, const StatStruct *stat_struct,
+                        uint64_t ref_poc) {
     eb_block_on_mutex(scs_ptr->encode_context_ptr->stat_file_mutex);
-    int32_t fseek_return_value = fseek(
-        scs_ptr->static_config.output_stat_file, (long)ref_poc * sizeof(StatStruct), SEEK_SET);
+    int32_t fseek_return_value = fseek(scs_ptr->static_config.output_stat_file,
+                                       (long)(ref_poc * STAT_STRUCT_RECORD_SIZE),
+                                       SEEK_SET);
     if (fseek_return_value != 0) SVT_LOG("Error in fseek  returnVal %i\n", fseek_return_value);
-    fwrite(&stat_struct, sizeof(StatStruct), (size_t)1, scs_ptr->static_config.output_stat_file);
+    // Records keep their fixed stride, only the SBs of the picture are written
+    fwrite(stat_struct->referenced_area,
+           sizeof(uint32_t),
+           scs_ptr->sb_total_count,
+           scs_ptr->static_config.output_stat_file);
     eb_release_mutex(scs_ptr->encode_context_ptr->stat_file_mutex);
 }
 
@@ -479,7 +485,7 @@ void *entropy_coding_kernel(void *input_ptr) {
                         if (scs_ptr->use_output_stat_file &&
                             !pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag)
                             write_stat_to_file(scs_ptr,
-                                               *pcs_ptr->parent_pcs_ptr->stat_struct_first_pass_ptr,
+                                               pcs_ptr->parent_pcs_ptr->stat_struct_first_pass_ptr,
                                                pcs_ptr->parent_pcs_ptr->picture_number);
                         // Release the List 0 Reference Pictures
                         for (ref_idx = 0; ref_idx < pcs_ptr->parent_pcs_ptr->ref_list0_count;
@@ -489,9 +495,9 @@ void *entropy_coding_kernel(void *input_ptr) {
                                 pcs_ptr->ref_pic_ptr_array[0][ref_idx]->live_count == 1)
                                 write_stat_to_file(
                                     scs_ptr,
-                                    ((EbReferenceObject *)pcs_ptr->ref_pic_ptr_array[0][ref_idx]
-                                         ->object_ptr)
-                                        ->stat_struct,
+                                    &((EbReferenceObject *)pcs_ptr->ref_pic_ptr_array[0][ref_idx]
+                                          ->object_ptr)
+                                         ->stat_struct,
                                     ((EbReferenceObject *)pcs_ptr->ref_pic_ptr_array[0][ref_idx]
                                          ->object_ptr)
                                         ->ref_poc);
@@ -508,9 +514,9 @@ void *entropy_coding_kernel(void *input_ptr) {
                                 pcs_ptr->ref_pic_ptr_array[1][ref_idx]->live_count == 1)
                                 write_stat_to_file(
                                     scs_ptr,
-                                    ((EbReferenceObject *)pcs_ptr->ref_pic_ptr_array[1][ref_idx]
-                                         ->object_ptr)
-                                        ->stat_struct,
+                                    &((EbReferenceObject *)pcs_ptr->ref_pic_ptr_array[1][ref_idx]
+                                          ->object_ptr)
+                                         ->stat_struct,
                                     ((EbReferenceObject *)pcs_ptr->ref_pic_ptr_array[1][ref_idx]
                                          ->object_ptr)
                                         ->ref_poc);
@@ -0,0 +1,148 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "EbFirstPassStats.h"
+#include "EbEncodeContext.h"
+#include "EbMotionEstimationContext.h"
+#include "EbUtility.h"
+#include "EbThreads.h"
+#include "EbLog.h"
+
+// Range of the window budget scaling, the VBR buffer feedback corrects the remaining drift
+#define FIRST_PASS_MIN_WINDOW_SCALE 0.5
+#define FIRST_PASS_MAX_WINDOW_SCALE 2.0
+
+/************************************************
+ * Cost of a picture: the cheapest of the intra and inter estimates
+ ************************************************/
+static uint64_t first_pass_frame_cost(const FirstPassFrameStats *stats) {
+    if (stats->slice_type == I_SLICE) return stats->intra_cost;
+    return MIN(stats->intra_cost, stats->inter_cost);
+}
+
+EbBool first_pass_stats_detect(FILE *file) {
+    FirstPassStatsHeader header;
+    EbBool               detected = EB_FALSE;
+
+    if (file == NULL) return EB_FALSE;
+    if (fread(&header, sizeof(FirstPassStatsHeader), 1, file) == 1)
+        detected = header.magic == FIRST_PASS_STATS_MAGIC ? EB_TRUE : EB_FALSE;
+    rewind(file);
+    return detected;
+}
+
+void write_first_pass_stats_header(SequenceControlSet *scs_ptr) {
+    FirstPassStatsHeader header;
+
+    header.magic   = FIRST_PASS_STATS_MAGIC;
+    header.version = FIRST_PASS_STATS_VERSION;
+    header.width   = scs_ptr->max_input_luma_width;
+    header.height  = scs_ptr->max_input_luma_height;
+    rewind(scs_ptr->static_config.output_stat_file);
+    fwrite(&header, sizeof(FirstPassStatsHeader), 1, scs_ptr->static_config.output_stat_file);
+}
+
+void write_first_pass_frame_stats(SequenceControlSet *scs_ptr, PictureParentControlSet *pcs_ptr) {
+    EncodeContext *     encode_context_ptr = scs_ptr->encode_context_ptr;
+    FirstPassFrameStats stats;
+    uint16_t            sb_index;
+
+    memset(&stats, 0, sizeof(FirstPassFrameStats));
+    stats.picture_number = pcs_ptr->picture_number;
+    // The square root of the 64x64 variance approximates the mean absolute deviation,
+    // which keeps the intra estimate on the same scale as the 64x64 ME SAD
+    for (sb_index = 0; sb_index < pcs_ptr->sb_total_count; ++sb_index) {
+        stats.intra_cost += (uint64_t)(
+            sqrt((double)pcs_ptr->variance[sb_index][ME_TIER_ZERO_PU_64x64]) * 64 * 64);
+        if (pcs_ptr->slice_type != I_SLICE)
+            stats.inter_cost += pcs_ptr->rc_me_distortion[sb_index];
+    }
+    if (pcs_ptr->slice_type == I_SLICE) stats.inter_cost = stats.intra_cost;
+    stats.avg_variance             = pcs_ptr->pic_avg_variance;
+    stats.non_moving_index_average = pcs_ptr->non_moving_index_average;
+    stats.slice_type               = (uint8_t)pcs_ptr->slice_type;
+    stats.temporal_layer_index     = (uint8_t)pcs_ptr->temporal_layer_index;
+    stats.scene_change_flag        = (uint8_t)pcs_ptr->scene_change_flag;
+    stats.valid                    = 1;
+
+    eb_block_on_mutex(encode_context_ptr->stat_file_mutex);
+    int32_t fseek_return_value = fseek(
+        scs_ptr->static_config.output_stat_file,
+        (long)(sizeof(FirstPassStatsHeader) + pcs_ptr->picture_number * sizeof(FirstPassFrameStats)),
+        SEEK_SET);
+    if (fseek_return_value != 0) SVT_LOG("Error in fseek  returnVal %i\n", fseek_return_value);
+    fwrite(&stats, sizeof(FirstPassFrameStats), 1, scs_ptr->static_config.output_stat_file);
+    eb_release_mutex(encode_context_ptr->stat_file_mutex);
+}
+
+EbErrorType load_first_pass_stats(SequenceControlSet *scs_ptr) {
+    EncodeContext *      encode_context_ptr = scs_ptr->encode_context_ptr;
+    FILE *               file               = scs_ptr->static_config.input_stat_file;
+    FirstPassStatsHeader header;
+    uint64_t             count;
+    uint64_t             valid_count = 0;
+    uint64_t             total_cost  = 0;
+    long                 file_size;
+
+    EB_FREE_ARRAY(encode_context_ptr->first_pass_stats);
+    encode_context_ptr->first_pass_stats_count = 0;
+    encode_context_ptr->first_pass_avg_cost    = 0;
+
+    if (fread(&header, sizeof(FirstPassStatsHeader), 1, file) != 1 ||
+        header.magic != FIRST_PASS_STATS_MAGIC || header.version != FIRST_PASS_STATS_VERSION) {
+        SVT_LOG("Error: invalid first pass statistics file\n");
+        return EB_ErrorBadParameter;
+    }
+    if (header.width != scs_ptr->max_input_luma_width ||
+        header.height != scs_ptr->max_input_luma_height)
+        SVT_LOG("Warning: first pass statistics resolution %ux%u differs from the input\n",
+                header.width,
+                header.height);
+
+    fseek(file, 0, SEEK_END);
+    file_size = ftell(file);
+    count     = file_size > (long)sizeof(FirstPassStatsHeader)
+                ? (uint64_t)(file_size - sizeof(FirstPassStatsHeader)) / sizeof(FirstPassFrameStats)
+                : 0;
+    fseek(file, sizeof(FirstPassStatsHeader), SEEK_SET);
+    if (count == 0) return EB_ErrorNone;
+
+    EB_MALLOC_ARRAY(encode_context_ptr->first_pass_stats, count);
+    count = fread(encode_context_ptr->first_pass_stats, sizeof(FirstPassFrameStats), (size_t)count, file);
+    for (uint64_t i = 0; i < count; ++i) {
+        if (!encode_context_ptr->first_pass_stats[i].valid) continue;
+        total_cost += first_pass_frame_cost(&encode_context_ptr->first_pass_stats[i]);
+        valid_count++;
+    }
+    encode_context_ptr->first_pass_stats_count = count;
+    encode_context_ptr->first_pass_avg_cost    = valid_count ? total_cost / valid_count : 0;
+    return EB_ErrorNone;
+}
+
+uint64_t first_pass_stats_scale_window_bits(EncodeContext *encode_context_ptr,
+                                            uint64_t picture_number, uint32_t frames_in_sw,
+                                            uint64_t bits) {
+    uint64_t window_cost  = 0;
+    uint64_t window_count = 0;
+    double   scale;
+
+    if (encode_context_ptr->first_pass_avg_cost == 0) return bits;
+    for (uint64_t i = picture_number;
+         i < picture_number + frames_in_sw && i < encode_context_ptr->first_pass_stats_count;
+         ++i) {
+        if (!encode_context_ptr->first_pass_stats[i].valid) continue;
+        window_cost += first_pass_frame_cost(&encode_context_ptr->first_pass_stats[i]);
+        window_count++;
+    }
+    if (window_count == 0) return bits;
+    // Bits grow sub-linearly with the prediction error, hence the square root
+    scale = sqrt((double)window_cost /
+                 ((double)window_count * encode_context_ptr->first_pass_avg_cost));
+    scale = CLIP3(FIRST_PASS_MIN_WINDOW_SCALE, FIRST_PASS_MAX_WINDOW_SCALE, scale);
+    return (uint64_t)(bits * scale);
+}
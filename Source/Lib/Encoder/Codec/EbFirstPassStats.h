@@ -0,0 +1,37 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbFirstPassStats_h
+#define EbFirstPassStats_h
+
+#include <stdio.h>
+#include "EbDefinitions.h"
+#include "EbSequenceControlSet.h"
+#include "EbPictureControlSet.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/**************************************
+ * Extern Function Declarations
+ **************************************/
+// Returns EB_TRUE when the file starts with a fast first pass statistics header
+extern EbBool first_pass_stats_detect(FILE *file);
+// Writes the statistics header at the source resolution, called once before the first pass starts
+extern void write_first_pass_stats_header(SequenceControlSet *scs_ptr);
+// Writes the analysis statistics of one picture at its picture number
+extern void write_first_pass_frame_stats(SequenceControlSet *     scs_ptr,
+                                         PictureParentControlSet *pcs_ptr);
+// Loads the whole statistics file in the encode context for the second pass, called at the
+// source resolution as well
+extern EbErrorType load_first_pass_stats(SequenceControlSet *scs_ptr);
+// Scales the sliding window bit budget by the window complexity relative to the sequence
+extern uint64_t first_pass_stats_scale_window_bits(EncodeContext *encode_context_ptr,
+                                                   uint64_t picture_number, uint32_t frames_in_sw,
+                                                   uint64_t bits);
+#ifdef __cplusplus
+}
+#endif
+#endif // EbFirstPassStats_h
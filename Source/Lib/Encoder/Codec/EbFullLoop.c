@@ -1642,69 +1642,69 @@ int32_t av1_quantize_inv_quantize(
                                  segmentation_qp_offset;
     if (bit_increment == 0) {
         if (component_type == COMPONENT_LUMA) {
-            candidate_plane.quant_qtx    = pcs_ptr->parent_pcs_ptr->quants_md.y_quant[q_index];
-            candidate_plane.quant_fp_qtx = pcs_ptr->parent_pcs_ptr->quants_md.y_quant_fp[q_index];
-            candidate_plane.round_fp_qtx = pcs_ptr->parent_pcs_ptr->quants_md.y_round_fp[q_index];
+            candidate_plane.quant_qtx    = pcs_ptr->parent_pcs_ptr->quants_md->y_quant[q_index];
+            candidate_plane.quant_fp_qtx = pcs_ptr->parent_pcs_ptr->quants_md->y_quant_fp[q_index];
+            candidate_plane.round_fp_qtx = pcs_ptr->parent_pcs_ptr->quants_md->y_round_fp[q_index];
             candidate_plane.quant_shift_qtx =
-                pcs_ptr->parent_pcs_ptr->quants_md.y_quant_shift[q_index];
-            candidate_plane.zbin_qtx    = pcs_ptr->parent_pcs_ptr->quants_md.y_zbin[q_index];
-            candidate_plane.round_qtx   = pcs_ptr->parent_pcs_ptr->quants_md.y_round[q_index];
-            candidate_plane.dequant_qtx = pcs_ptr->parent_pcs_ptr->deq_md.y_dequant_qtx[q_index];
+                pcs_ptr->parent_pcs_ptr->quants_md->y_quant_shift[q_index];
+            candidate_plane.zbin_qtx    = pcs_ptr->parent_pcs_ptr->quants_md->y_zbin[q_index];
+            candidate_plane.round_qtx   = pcs_ptr->parent_pcs_ptr->quants_md->y_round[q_index];
+            candidate_plane.dequant_qtx = pcs_ptr->parent_pcs_ptr->deq_md->y_dequant_qtx[q_index];
         }
 
         if (component_type == COMPONENT_CHROMA_CB) {
-            candidate_plane.quant_qtx    = pcs_ptr->parent_pcs_ptr->quants_md.u_quant[q_index];
-            candidate_plane.quant_fp_qtx = pcs_ptr->parent_pcs_ptr->quants_md.u_quant_fp[q_index];
-            candidate_plane.round_fp_qtx = pcs_ptr->parent_pcs_ptr->quants_md.u_round_fp[q_index];
+            candidate_plane.quant_qtx    = pcs_ptr->parent_pcs_ptr->quants_md->u_quant[q_index];
+            candidate_plane.quant_fp_qtx = pcs_ptr->parent_pcs_ptr->quants_md->u_quant_fp[q_index];
+            candidate_plane.round_fp_qtx = pcs_ptr->parent_pcs_ptr->quants_md->u_round_fp[q_index];
             candidate_plane.quant_shift_qtx =
-                pcs_ptr->parent_pcs_ptr->quants_md.u_quant_shift[q_index];
-            candidate_plane.zbin_qtx    = pcs_ptr->parent_pcs_ptr->quants_md.u_zbin[q_index];
-            candidate_plane.round_qtx   = pcs_ptr->parent_pcs_ptr->quants_md.u_round[q_index];
-            candidate_plane.dequant_qtx = pcs_ptr->parent_pcs_ptr->deq_md.u_dequant_qtx[q_index];
+                pcs_ptr->parent_pcs_ptr->quants_md->u_quant_shift[q_index];
+            candidate_plane.zbin_qtx    = pcs_ptr->parent_pcs_ptr->quants_md->u_zbin[q_index];
+            candidate_plane.round_qtx   = pcs_ptr->parent_pcs_ptr->quants_md->u_round[q_index];
+            candidate_plane.dequant_qtx = pcs_ptr->parent_pcs_ptr->deq_md->u_dequant_qtx[q_index];
         }
 
         if (component_type == COMPONENT_CHROMA_CR) {
-            candidate_plane.quant_qtx    = pcs_ptr->parent_pcs_ptr->quants_md.v_quant[q_index];
-            candidate_plane.quant_fp_qtx = pcs_ptr->parent_pcs_ptr->quants_md.v_quant_fp[q_index];
-            candidate_plane.round_fp_qtx = pcs_ptr->parent_pcs_ptr->quants_md.v_round_fp[q_index];
+            candidate_plane.quant_qtx    = pcs_ptr->parent_pcs_ptr->quants_md->v_quant[q_index];
+            candidate_plane.quant_fp_qtx = pcs_ptr->parent_pcs_ptr->quants_md->v_quant_fp[q_index];
+            candidate_plane.round_fp_qtx = pcs_ptr->parent_pcs_ptr->quants_md->v_round_fp[q_index];
             candidate_plane.quant_shift_qtx =
-                pcs_ptr->parent_pcs_ptr->quants_md.v_quant_shift[q_index];
-            candidate_plane.zbin_qtx    = pcs_ptr->parent_pcs_ptr->quants_md.v_zbin[q_index];
-            candidate_plane.round_qtx   = pcs_ptr->parent_pcs_ptr->quants_md.v_round[q_index];
-            candidate_plane.dequant_qtx = pcs_ptr->parent_pcs_ptr->deq_md.v_dequant_qtx[q_index];
+                pcs_ptr->parent_pcs_ptr->quants_md->v_quant_shift[q_index];
+            candidate_plane.zbin_qtx    = pcs_ptr->parent_pcs_ptr->quants_md->v_zbin[q_index];
+            candidate_plane.round_qtx   = pcs_ptr->parent_pcs_ptr->quants_md->v_round[q_index];
+            candidate_plane.dequant_qtx = pcs_ptr->parent_pcs_ptr->deq_md->v_dequant_qtx[q_index];
         }
     } else {
         if (component_type == COMPONENT_LUMA) {
-            candidate_plane.quant_qtx    = pcs_ptr->parent_pcs_ptr->quants.y_quant[q_index];
-            candidate_plane.quant_fp_qtx = pcs_ptr->parent_pcs_ptr->quants.y_quant_fp[q_index];
-            candidate_plane.round_fp_qtx = pcs_ptr->parent_pcs_ptr->quants.y_round_fp[q_index];
+            candidate_plane.quant_qtx    = pcs_ptr->parent_pcs_ptr->quants->y_quant[q_index];
+            candidate_plane.quant_fp_qtx = pcs_ptr->parent_pcs_ptr->quants->y_quant_fp[q_index];
+            candidate_plane.round_fp_qtx = pcs_ptr->parent_pcs_ptr->quants->y_round_fp[q_index];
             candidate_plane.quant_shift_qtx =
-                pcs_ptr->parent_pcs_ptr->quants.y_quant_shift[q_index];
-            candidate_plane.zbin_qtx    = pcs_ptr->parent_pcs_ptr->quants.y_zbin[q_index];
-            candidate_plane.round_qtx   = pcs_ptr->parent_pcs_ptr->quants.y_round[q_index];
-            candidate_plane.dequant_qtx = pcs_ptr->parent_pcs_ptr->deq.y_dequant_qtx[q_index];
+                pcs_ptr->parent_pcs_ptr->quants->y_quant_shift[q_index];
+            candidate_plane.zbin_qtx    = pcs_ptr->parent_pcs_ptr->quants->y_zbin[q_index];
+            candidate_plane.round_qtx   = pcs_ptr->parent_pcs_ptr->quants->y_round[q_index];
+            candidate_plane.dequant_qtx = pcs_ptr->parent_pcs_ptr->deq->y_dequant_qtx[q_index];
         }
 
         if (component_type == COMPONENT_CHROMA_CB) {
-            candidate_plane.quant_qtx    = pcs_ptr->parent_pcs_ptr->quants.u_quant[q_index];
-            candidate_plane.quant_fp_qtx = pcs_ptr->parent_pcs_ptr->quants.u_quant_fp[q_index];
-            candidate_plane.round_fp_qtx = pcs_ptr->parent_pcs_ptr->quants.u_round_fp[q_index];
+            candidate_plane.quant_qtx    = pcs_ptr->parent_pcs_ptr->quants->u_quant[q_index];
+            candidate_plane.quant_fp_qtx = pcs_ptr->parent_pcs_ptr->quants->u_quant_fp[q_index];
+            candidate_plane.round_fp_qtx = pcs_ptr->parent_pcs_ptr->quants->u_round_fp[q_index];
             candidate_plane.quant_shift_qtx =
-                pcs_ptr->parent_pcs_ptr->quants.u_quant_shift[q_index];
-            candidate_plane.zbin_qtx    = pcs_ptr->parent_pcs_ptr->quants.u_zbin[q_index];
-            candidate_plane.round_qtx   = pcs_ptr->parent_pcs_ptr->quants.u_round[q_index];
-            candidate_plane.dequant_qtx = pcs_ptr->parent_pcs_ptr->deq.u_dequant_qtx[q_index];
+                pcs_ptr->parent_pcs_ptr->quants->u_quant_shift[q_index];
+            candidate_plane.zbin_qtx    = pcs_ptr->parent_pcs_ptr->quants->u_zbin[q_index];
+            candidate_plane.round_qtx   = pcs_ptr->parent_pcs_ptr->quants->u_round[q_index];
+            candidate_plane.dequant_qtx = pcs_ptr->parent_pcs_ptr->deq->u_dequant_qtx[q_index];
         }
 
         if (component_type == COMPONENT_CHROMA_CR) {
-            candidate_plane.quant_qtx    = pcs_ptr->parent_pcs_ptr->quants.v_quant[q_index];
-            candidate_plane.quant_fp_qtx = pcs_ptr->parent_pcs_ptr->quants.v_quant_fp[q_index];
-            candidate_plane.round_fp_qtx = pcs_ptr->parent_pcs_ptr->quants.v_round_fp[q_index];
+            candidate_plane.quant_qtx    = pcs_ptr->parent_pcs_ptr->quants->v_quant[q_index];
+            candidate_plane.quant_fp_qtx = pcs_ptr->parent_pcs_ptr->quants->v_quant_fp[q_index];
+            candidate_plane.round_fp_qtx = pcs_ptr->parent_pcs_ptr->quants->v_round_fp[q_index];
             candidate_plane.quant_shift_qtx =
-                pcs_ptr->parent_pcs_ptr->quants.v_quant_shift[q_index];
-            candidate_plane.zbin_qtx    = pcs_ptr->parent_pcs_ptr->quants.v_zbin[q_index];
-            candidate_plane.round_qtx   = pcs_ptr->parent_pcs_ptr->quants.v_round[q_index];
-            candidate_plane.dequant_qtx = pcs_ptr->parent_pcs_ptr->deq.v_dequant_qtx[q_index];
+                pcs_ptr->parent_pcs_ptr->quants->v_quant_shift[q_index];
+            candidate_plane.zbin_qtx    = pcs_ptr->parent_pcs_ptr->quants->v_zbin[q_index];
+            candidate_plane.round_qtx   = pcs_ptr->parent_pcs_ptr->quants->v_round[q_index];
+            candidate_plane.dequant_qtx = pcs_ptr->parent_pcs_ptr->deq->v_dequant_qtx[q_index];
         }
     }
 
@@ -24,6 +24,28 @@
 #include "EbUtility.h"
 #include "global_motion.h"
 #include "corner_detect.h"
+#include "corner_match.h"
+
+EbBool gm_search_enabled(SequenceControlSet *scs_ptr, PictureParentControlSet *pcs_ptr) {
+    uint8_t enc_mode =
+        scs_ptr->use_output_stat_file ? pcs_ptr->snd_pass_enc_mode : pcs_ptr->enc_mode;
+    return (EbBool)(scs_ptr->static_config.enable_global_motion && enc_mode <= ENC_M1);
+}
+
+void gm_detect_corners(SequenceControlSet *scs_ptr, PictureParentControlSet *pcs_ptr,
+                       EbPaReferenceObject *pa_reference_object) {
+    // The object may be recycled from a picture that had corners
+    pa_reference_object->num_gm_corners = -1;
+    if (pa_reference_object->gm_corners == NULL || !gm_search_enabled(scs_ptr, pcs_ptr)) return;
+    EbPictureBufferDesc *pic = pa_reference_object->input_padded_picture_ptr;
+    pa_reference_object->num_gm_corners =
+        av1_fast_corner_detect(pic->buffer_y + pic->origin_x + pic->origin_y * pic->stride_y,
+                               pic->width,
+                               pic->height,
+                               pic->stride_y,
+                               pa_reference_object->gm_corners,
+                               MAX_CORNERS);
+}
 
 void global_motion_estimation(PictureParentControlSet *pcs_ptr, MeContext *context_ptr,
                               EbPictureBufferDesc *input_picture_ptr) {
@@ -40,6 +62,11 @@ void global_motion_estimation(PictureParentControlSet *pcs_ptr, MeContext *conte
         (scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED)
             ? (EbPictureBufferDesc *)pa_reference_object->quarter_filtered_picture_ptr
             : (EbPictureBufferDesc *)pa_reference_object->quarter_decimated_picture_ptr;
+    // The corners of the picture were detected on its padded copy, which only
+    // differs from the input when the film grain denoiser changed it
+    const EbBool use_frm_corners = pcs_ptr->gm_level == GM_FULL &&
+                                   !scs_ptr->film_grain_denoise_strength &&
+                                   pa_reference_object->num_gm_corners >= 0;
 #endif
     uint32_t num_of_list_to_search =
         (pcs_ptr->slice_type == P_SLICE) ? (uint32_t)REF_LIST_0 : (uint32_t)REF_LIST_1;
@@ -82,15 +109,31 @@ void global_motion_estimation(PictureParentControlSet *pcs_ptr, MeContext *conte
             } else {
                 ref_picture_ptr = (EbPictureBufferDesc *)reference_object->input_padded_picture_ptr;
             }
+            const EbBool use_ref_corners =
+                ref_picture_ptr == reference_object->input_padded_picture_ptr &&
+                reference_object->num_gm_corners >= 0;
+
+            compute_global_motion(input_picture_ptr,
+                                  ref_picture_ptr,
+                                  use_frm_corners ? pa_reference_object->gm_corners : NULL,
+                                  pa_reference_object->num_gm_corners,
+                                  use_ref_corners ? reference_object->gm_corners : NULL,
+                                  reference_object->num_gm_corners,
+                                  &pcs_ptr->global_motion_estimation[list_index][ref_pic_index],
+                                  pcs_ptr->frm_hdr.allow_high_precision_mv);
 #else
             EbPictureBufferDesc *ref_picture_ptr =
                 (EbPictureBufferDesc *)reference_object->input_padded_picture_ptr;
-#endif
 
             compute_global_motion(input_picture_ptr,
                                   ref_picture_ptr,
+                                  NULL,
+                                  0,
+                                  NULL,
+                                  0,
                                   &pcs_ptr->global_motion_estimation[list_index][ref_pic_index],
                                   pcs_ptr->frm_hdr.allow_high_precision_mv);
+#endif
         }
     }
 }
@@ -103,6 +146,8 @@ static INLINE int convert_to_trans_prec(int allow_hp, int coor) {
 }
 
 void compute_global_motion(EbPictureBufferDesc *input_pic, EbPictureBufferDesc *ref_pic,
+                           const int *frm_corners_in, int num_frm_corners_in,
+                           const int *ref_corners_in, int num_ref_corners_in,
                            EbWarpedMotionParams *bestWarpedMotion, int allow_high_precision_mv) {
     MotionModel params_by_motion[RANSAC_NUM_MOTIONS];
     for (int m = 0; m < RANSAC_NUM_MOTIONS; m++) {
@@ -121,6 +166,7 @@ void compute_global_motion(EbPictureBufferDesc *input_pic, EbPictureBufferDesc *
     // clang-format on
 
     int            frm_corners[2 * MAX_CORNERS];
+    int            ref_corners[2 * MAX_CORNERS];
     unsigned char *frm_buffer =
         input_pic->buffer_y + input_pic->origin_x + input_pic->origin_y * input_pic->stride_y;
     unsigned char *ref_buffer =
@@ -132,13 +178,44 @@ void compute_global_motion(EbPictureBufferDesc *input_pic, EbPictureBufferDesc *
     const EbWarpedMotionParams *ref_params = &default_warp_params;
 
     {
-        // compute interest points using FAST features
-        int num_frm_corners = av1_fast_corner_detect(frm_buffer,
+        // compute interest points using FAST features, unless cached with the pictures
+        int *frm_corners_ptr = (int *)frm_corners_in;
+        int  num_frm_corners = num_frm_corners_in;
+        if (frm_corners_ptr == NULL) {
+            frm_corners_ptr = frm_corners;
+            num_frm_corners = av1_fast_corner_detect(frm_buffer,
                                                      input_pic->width,
                                                      input_pic->height,
                                                      input_pic->stride_y,
                                                      frm_corners,
                                                      MAX_CORNERS);
+        }
+        int *ref_corners_ptr = (int *)ref_corners_in;
+        int  num_ref_corners = num_ref_corners_in;
+        if (ref_corners_ptr == NULL) {
+            ref_corners_ptr = ref_corners;
+            num_ref_corners = av1_fast_corner_detect(ref_buffer,
+                                                     input_pic->width,
+                                                     input_pic->height,
+                                                     ref_pic->stride_y,
+                                                     ref_corners,
+                                                     MAX_CORNERS);
+        }
+
+        // find correspondences between the two images, the same for every model
+        int *correspondences =
+            (int *)malloc(AOMMAX(num_frm_corners, 1) * 4 * sizeof(*correspondences));
+        const int num_correspondences = av1_determine_correspondence(frm_buffer,
+                                                                     frm_corners_ptr,
+                                                                     num_frm_corners,
+                                                                     ref_buffer,
+                                                                     ref_corners_ptr,
+                                                                     num_ref_corners,
+                                                                     input_pic->width,
+                                                                     input_pic->height,
+                                                                     input_pic->stride_y,
+                                                                     ref_pic->stride_y,
+                                                                     correspondences);
 
         TransformationType model;
 #define GLOBAL_TRANS_TYPES_ENC 3
@@ -154,15 +231,8 @@ void compute_global_motion(EbPictureBufferDesc *input_pic, EbPictureBufferDesc *
             }
 
             av1_compute_global_motion(model,
-                                      frm_buffer,
-                                      input_pic->width,
-                                      input_pic->height,
-                                      input_pic->stride_y,
-                                      frm_corners,
-                                      num_frm_corners,
-                                      ref_buffer,
-                                      ref_pic->stride_y,
-                                      EB_8BIT,
+                                      correspondences,
+                                      num_correspondences,
                                       gm_estimation_type,
                                       inliers_by_motion,
                                       params_by_motion,
@@ -233,6 +303,7 @@ void compute_global_motion(EbPictureBufferDesc *input_pic, EbPictureBufferDesc *
             }
             if (global_motion.wmtype != IDENTITY) { break; }
         }
+        free(correspondences);
     }
 
     *bestWarpedMotion = global_motion;
@@ -19,10 +19,20 @@
 
 #include "EbPictureBufferDesc.h"
 #include "EbMotionEstimationContext.h"
+#include "EbReferenceObject.h"
+#include "EbSequenceControlSet.h"
 
+// Global motion is only searched with enable_global_motion at ENC_M1 and below
+EbBool gm_search_enabled(SequenceControlSet *scs_ptr, PictureParentControlSet *pcs_ptr);
+// Detect the FAST corners of the padded picture once, when the picture enters the pipeline
+void gm_detect_corners(SequenceControlSet *scs_ptr, PictureParentControlSet *pcs_ptr,
+                       EbPaReferenceObject *pa_reference_object);
 void global_motion_estimation(PictureParentControlSet *pcs_ptr, MeContext *context_ptr,
                               EbPictureBufferDesc *input_picture_ptr);
+// frm_corners_in / ref_corners_in are the cached corners of the pictures, detected here when NULL
 void compute_global_motion(EbPictureBufferDesc *input_pic, EbPictureBufferDesc *ref_pic,
+                           const int *frm_corners_in, int num_frm_corners_in,
+                           const int *ref_corners_in, int num_ref_corners_in,
                            EbWarpedMotionParams *bestWarpedMotion, int allow_high_precision_mv);
 
 #endif // EbGlobalMotionEstimation_h
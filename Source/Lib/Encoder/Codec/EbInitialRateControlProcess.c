@@ -11,6 +11,8 @@
 #include "EbMotionEstimationContext.h"
 #include "EbUtility.h"
 #include "EbReferenceObject.h"
+#include "EbFirstPassStats.h"
+#include "EbSvtAv1ErrorCodes.h"
 
 /**************************************
  * Context
@@ -878,7 +880,8 @@ void *initial_rate_control_kernel(void *input_ptr) {
                 queue_entry_ptr =
                     determine_picture_offset_in_queue(encode_context_ptr, pcs_ptr, in_results_ptr);
 
-            if (scs_ptr->static_config.rate_control_mode) {
+            if (scs_ptr->static_config.rate_control_mode == 1 ||
+                scs_ptr->static_config.rate_control_mode == 2) {
                 if (scs_ptr->static_config.look_ahead_distance != 0) {
                     // Getting the Histogram Queue Data
                     get_histogram_queue_data(scs_ptr, encode_context_ptr, pcs_ptr);
@@ -997,7 +1000,8 @@ void *initial_rate_control_kernel(void *input_ptr) {
                         else
                             pcs_ptr->end_of_sequence_region = EB_FALSE;
 
-                        if (scs_ptr->static_config.rate_control_mode) {
+                        if (scs_ptr->static_config.rate_control_mode == 1 ||
+                            scs_ptr->static_config.rate_control_mode == 2) {
                             // Determine offset from the Head Ptr for HLRC histogram queue and set the life count
                             if (scs_ptr->static_config.look_ahead_distance != 0) {
                                 // Update Histogram Queue Entry Life count
@@ -1035,9 +1039,16 @@ void *initial_rate_control_kernel(void *input_ptr) {
                                 encode_context_ptr, scs_ptr, pcs_ptr);
                         }
                         // Get Empty Reference Picture Object
-                        eb_get_empty_object(
-                            scs_ptr->encode_context_ptr->reference_picture_pool_fifo_ptr,
-                            &reference_picture_wrapper_ptr);
+                        if (eb_get_empty_object(
+                                scs_ptr->encode_context_ptr->reference_picture_pool_fifo_ptr,
+                                &reference_picture_wrapper_ptr) != EB_ErrorNone) {
+                            // The object could not be built on demand, the error is reported to
+                            // the API
+                            encode_context_ptr->app_callback_ptr->error_handler(
+                                encode_context_ptr->app_callback_ptr->handle,
+                                EB_ENC_SRM_OBJECT_CTOR_ERROR);
+                            return EB_NULL;
+                        }
                         if (loop_index) {
                             pcs_ptr->reference_picture_wrapper_ptr = reference_picture_wrapper_ptr;
                             // Give the new Reference a nominal live_count of 1
@@ -1060,7 +1071,11 @@ void *initial_rate_control_kernel(void *input_ptr) {
                                        ->stat_struct
                                 : &pcs_ptr->stat_struct;
                         if (scs_ptr->use_output_stat_file)
-                            memset(pcs_ptr->stat_struct_first_pass_ptr, 0, sizeof(StatStruct));
+                            memset(pcs_ptr->stat_struct_first_pass_ptr->referenced_area,
+                                   0,
+                                   sizeof(uint32_t) * pcs_ptr->sb_total_count);
+                        if (scs_ptr->use_output_first_pass_stats && !pcs_ptr->is_overlay)
+                            write_first_pass_frame_stats(scs_ptr, pcs_ptr);
                         // Get Empty Results Object
                         eb_get_empty_object(
                             context_ptr->initialrate_control_results_output_fifo_ptr,
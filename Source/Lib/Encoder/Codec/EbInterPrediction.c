@@ -2244,8 +2244,8 @@ static void model_rd_with_curvfit(PictureControlSet *picture_control_set_ptr, Bl
     const int dequant_shift = 3;
     int32_t   current_q_index =
         picture_control_set_ptr->parent_pcs_ptr->frm_hdr.quantization_params.base_q_idx;
-    Dequants *const dequants  = &picture_control_set_ptr->parent_pcs_ptr->deq;
-    int16_t         quantizer = dequants->y_dequant_q3[current_q_index][1];
+    const Dequants *const dequants  = picture_control_set_ptr->parent_pcs_ptr->deq;
+    int16_t               quantizer = dequants->y_dequant_q3[current_q_index][1];
 
     const int qstep = AOMMAX(quantizer >> dequant_shift, 1);
 
@@ -6835,7 +6835,7 @@ extern void model_rd_for_sb(PictureControlSet *  picture_control_set_ptr,
 
         int32_t current_q_index =
             picture_control_set_ptr->parent_pcs_ptr->frm_hdr.quantization_params.base_q_idx;
-        Dequants *const dequants = &picture_control_set_ptr->parent_pcs_ptr->deq;
+        const Dequants *const dequants = picture_control_set_ptr->parent_pcs_ptr->deq;
 
         int16_t quantizer = dequants->y_dequant_q3[current_q_index][1];
         model_rd_from_sse(
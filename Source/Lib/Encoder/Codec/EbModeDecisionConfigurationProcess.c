@@ -30,6 +30,7 @@
 #include "EbLog.h"
 #include "EbCoefficients.h"
 #include "EbCommonUtils.h"
+#include "EbSharedTables.h"
 
 #define MAX_MESH_SPEED 5 // Max speed setting for mesh motion method
 static MeshPattern good_quality_mesh_patterns[MAX_MESH_SPEED + 1][MAX_MESH_STEP] = {
@@ -514,7 +515,8 @@ void eb_av1_build_quantizer(AomBitDepth bit_depth, int32_t y_dc_delta_q, int32_t
     }
 }
 
-void eb_av1_qm_init(PictureParentControlSet *pcs_ptr) {
+void eb_av1_qm_init(const QmVal *gqmatrix[NUM_QM_LEVELS][3][TX_SIZES_ALL],
+                    const QmVal *giqmatrix[NUM_QM_LEVELS][3][TX_SIZES_ALL]) {
     const uint8_t num_planes = 3; // MAX_MB_PLANE;// NM- No monochroma
     uint8_t       q, c, t;
     int32_t       current;
@@ -525,15 +527,15 @@ void eb_av1_qm_init(PictureParentControlSet *pcs_ptr) {
                 const int32_t size       = tx_size_2d[t];
                 const TxSize  qm_tx_size = av1_get_adjusted_tx_size(t);
                 if (q == NUM_QM_LEVELS - 1) {
-                    pcs_ptr->gqmatrix[q][c][t]  = NULL;
-                    pcs_ptr->giqmatrix[q][c][t] = NULL;
+                    gqmatrix[q][c][t]  = NULL;
+                    giqmatrix[q][c][t] = NULL;
                 } else if (t != qm_tx_size) { // Reuse matrices for 'qm_tx_size'
-                    pcs_ptr->gqmatrix[q][c][t]  = pcs_ptr->gqmatrix[q][c][qm_tx_size];
-                    pcs_ptr->giqmatrix[q][c][t] = pcs_ptr->giqmatrix[q][c][qm_tx_size];
+                    gqmatrix[q][c][t]  = gqmatrix[q][c][qm_tx_size];
+                    giqmatrix[q][c][t] = giqmatrix[q][c][qm_tx_size];
                 } else {
                     assert(current + size <= QM_TOTAL_SIZE);
-                    pcs_ptr->gqmatrix[q][c][t]  = &wt_matrix_ref[q][c >= 1][current];
-                    pcs_ptr->giqmatrix[q][c][t] = &iwt_matrix_ref[q][c >= 1][current];
+                    gqmatrix[q][c][t]  = &wt_matrix_ref[q][c >= 1][current];
+                    giqmatrix[q][c][t] = &iwt_matrix_ref[q][c >= 1][current];
                     current += size;
                 }
             }
@@ -1695,32 +1697,20 @@ void *mode_decision_configuration_kernel(void *input_ptr) {
         set_reference_sg_ep(pcs_ptr);
         set_global_motion_field(pcs_ptr);
 
-        eb_av1_qm_init(pcs_ptr->parent_pcs_ptr);
-
-        Quants *const   quants   = &pcs_ptr->parent_pcs_ptr->quants;
-        Dequants *const dequants = &pcs_ptr->parent_pcs_ptr->deq;
+        // The delta q values are always 0, so the quantizers only depend on the bit depth and
+        // are shared by all the pictures and encoder instances
+        const EbSharedTables *shared_tables = eb_get_shared_tables();
+        const uint8_t         bd_index = scs_ptr->static_config.encoder_bit_depth > EB_8BIT ? 1 : 0;
+        const uint8_t         md_bd_index = pcs_ptr->hbd_mode_decision ? 1 : 0;
+        pcs_ptr->parent_pcs_ptr->gqmatrix  = shared_tables->gqmatrix;
+        pcs_ptr->parent_pcs_ptr->giqmatrix = shared_tables->giqmatrix;
 
         eb_av1_set_quantizer(pcs_ptr->parent_pcs_ptr, frm_hdr->quantization_params.base_q_idx);
 
-        eb_av1_build_quantizer((AomBitDepth)scs_ptr->static_config.encoder_bit_depth,
-                               frm_hdr->quantization_params.delta_q_dc[AOM_PLANE_Y],
-                               frm_hdr->quantization_params.delta_q_dc[AOM_PLANE_U],
-                               frm_hdr->quantization_params.delta_q_ac[AOM_PLANE_U],
-                               frm_hdr->quantization_params.delta_q_dc[AOM_PLANE_V],
-                               frm_hdr->quantization_params.delta_q_ac[AOM_PLANE_V],
-                               quants,
-                               dequants);
-
-        Quants *const   quants_md   = &pcs_ptr->parent_pcs_ptr->quants_md;
-        Dequants *const dequants_md = &pcs_ptr->parent_pcs_ptr->deq_md;
-        eb_av1_build_quantizer(pcs_ptr->hbd_mode_decision ? AOM_BITS_10 : AOM_BITS_8,
-                               frm_hdr->quantization_params.delta_q_dc[AOM_PLANE_Y],
-                               frm_hdr->quantization_params.delta_q_dc[AOM_PLANE_U],
-                               frm_hdr->quantization_params.delta_q_ac[AOM_PLANE_U],
-                               frm_hdr->quantization_params.delta_q_dc[AOM_PLANE_V],
-                               frm_hdr->quantization_params.delta_q_ac[AOM_PLANE_V],
-                               quants_md,
-                               dequants_md);
+        pcs_ptr->parent_pcs_ptr->quants    = &shared_tables->quants[bd_index];
+        pcs_ptr->parent_pcs_ptr->deq       = &shared_tables->deq[bd_index];
+        pcs_ptr->parent_pcs_ptr->quants_md = &shared_tables->quants[md_bd_index];
+        pcs_ptr->parent_pcs_ptr->deq_md    = &shared_tables->deq[md_bd_index];
 
         // Hsan: collapse spare code
         MdRateEstimationContext *md_rate_estimation_array;
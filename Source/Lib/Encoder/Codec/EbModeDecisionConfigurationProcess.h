@@ -82,6 +82,13 @@ EbErrorType mode_decision_configuration_context_ctor(EbThreadContext *  thread_c
                                                      int input_index, int output_index);
 
 extern void *mode_decision_configuration_kernel(void *input_ptr);
+
+extern void eb_av1_build_quantizer(AomBitDepth bit_depth, int32_t y_dc_delta_q,
+                                   int32_t u_dc_delta_q, int32_t u_ac_delta_q,
+                                   int32_t v_dc_delta_q, int32_t v_ac_delta_q,
+                                   Quants *const quants, Dequants *const deq);
+extern void eb_av1_qm_init(const QmVal *gqmatrix[NUM_QM_LEVELS][3][TX_SIZES_ALL],
+                           const QmVal *giqmatrix[NUM_QM_LEVELS][3][TX_SIZES_ALL]);
 #ifdef __cplusplus
 }
 #endif
@@ -268,13 +268,7 @@ EbErrorType signal_derivation_me_kernel_oq(SequenceControlSet *       scs_ptr,
     else
         context_ptr->me_context_ptr->me_search_method = SUB_SAD_SEARCH;
 
-    if (scs_ptr->static_config.enable_global_motion == EB_TRUE) {
-        if (enc_mode <= ENC_M1)
-            context_ptr->me_context_ptr->compute_global_motion = EB_TRUE;
-        else
-            context_ptr->me_context_ptr->compute_global_motion = EB_FALSE;
-    } else
-        context_ptr->me_context_ptr->compute_global_motion = EB_FALSE;
+    context_ptr->me_context_ptr->compute_global_motion = gm_search_enabled(scs_ptr, pcs_ptr);
 
     return return_error;
 };
@@ -876,7 +870,8 @@ void *motion_estimation_kernel(void *input_ptr) {
 
             eb_block_on_mutex(pcs_ptr->rc_distortion_histogram_mutex);
 
-            if (scs_ptr->static_config.rate_control_mode) {
+            if (scs_ptr->static_config.rate_control_mode == 1 ||
+                scs_ptr->static_config.rate_control_mode == 2) {
                 if (pcs_ptr->slice_type != I_SLICE) {
                     uint16_t sad_interval_index;
                     for (y_sb_index = y_sb_start_index; y_sb_index < y_sb_end_index; ++y_sb_index) {
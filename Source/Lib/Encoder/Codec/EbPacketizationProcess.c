@@ -119,7 +119,8 @@ void update_rc_rate_tables(PictureControlSet *pcs_ptr, SequenceControlSet *scs_p
     FrameHeader *frm_hdr = &pcs_ptr->parent_pcs_ptr->frm_hdr;
 
     // SB Loop
-    if (scs_ptr->static_config.rate_control_mode > 0) {
+    if (scs_ptr->static_config.rate_control_mode == 1 ||
+        scs_ptr->static_config.rate_control_mode == 2) {
         uint64_t sad_bits[NUMBER_OF_SAD_INTERVALS] = {0};
         uint32_t count[NUMBER_OF_SAD_INTERVALS]    = {0};
 
@@ -150,7 +151,7 @@ void update_rc_rate_tables(PictureControlSet *pcs_ptr, SequenceControlSet *scs_p
 
             uint64_t ref_qindex_dequant =
                 (uint64_t)pcs_ptr->parent_pcs_ptr->deq
-                    .y_dequant_qtx[frm_hdr->quantization_params.base_q_idx][1];
+                    ->y_dequant_qtx[frm_hdr->quantization_params.base_q_idx][1];
             uint64_t sad_bits_ref_dequant = 0;
             uint64_t weight               = 0;
             {
@@ -177,7 +178,7 @@ void update_rc_rate_tables(PictureControlSet *pcs_ptr, SequenceControlSet *scs_p
                                                              [sad_interval_index] = (EbBitNumber)(
                                         ((weight * sad_bits_ref_dequant /
                                           pcs_ptr->parent_pcs_ptr->deq
-                                              .y_dequant_qtx[quantizer_to_qindex[qp_index]][1]) +
+                                              ->y_dequant_qtx[quantizer_to_qindex[qp_index]][1]) +
                                          (10 - weight) *
                                              (uint32_t)encode_context_ptr
                                                  ->rate_control_tables_array[qp_index]
@@ -220,7 +221,7 @@ void update_rc_rate_tables(PictureControlSet *pcs_ptr, SequenceControlSet *scs_p
                                                              [sad_interval_index] = (EbBitNumber)(
                                         ((weight * sad_bits_ref_dequant /
                                           pcs_ptr->parent_pcs_ptr->deq
-                                              .y_dequant_qtx[quantizer_to_qindex[qp_index]][1]) +
+                                              ->y_dequant_qtx[quantizer_to_qindex[qp_index]][1]) +
                                          (10 - weight) *
                                              (uint32_t)encode_context_ptr
                                                  ->rate_control_tables_array[qp_index]
@@ -264,7 +265,7 @@ void update_rc_rate_tables(PictureControlSet *pcs_ptr, SequenceControlSet *scs_p
                                                        [sad_interval_index] = (EbBitNumber)(
                                         ((weight * sad_bits_ref_dequant /
                                           pcs_ptr->parent_pcs_ptr->deq
-                                              .y_dequant_qtx[quantizer_to_qindex[qp_index]][1]) +
+                                              ->y_dequant_qtx[quantizer_to_qindex[qp_index]][1]) +
                                          (10 - weight) *
                                              (uint32_t)encode_context_ptr
                                                  ->rate_control_tables_array[qp_index]
@@ -305,7 +306,7 @@ void update_rc_rate_tables(PictureControlSet *pcs_ptr, SequenceControlSet *scs_p
                                                        [sad_interval_index] = (EbBitNumber)(
                                         ((weight * sad_bits_ref_dequant /
                                           pcs_ptr->parent_pcs_ptr->deq
-                                              .y_dequant_qtx[quantizer_to_qindex[qp_index]][1]) +
+                                              ->y_dequant_qtx[quantizer_to_qindex[qp_index]][1]) +
                                          (10 - weight) *
                                              (uint32_t)encode_context_ptr
                                                  ->rate_control_tables_array[qp_index]
@@ -22,6 +22,7 @@
 #include "EbComputeMean_SSE2.h"
 #include "EbUtility.h"
 #include "EbMotionEstimationContext.h"
+#include "EbGlobalMotionEstimation.h"
 
 #define VARIANCE_PRECISION 16
 #define SB_LOW_VAR_TH 5
@@ -47,6 +48,7 @@ typedef struct PictureAnalysisContext {
     EbPictureBufferDesc *denoised_picture_ptr;
     EbPictureBufferDesc *noise_picture_ptr;
     double               pic_noise_variance_float;
+    DenoiseWorkers *     denoise_workers;
 } PictureAnalysisContext;
 
 static void picture_analysis_context_dctor(EbPtr p) {
@@ -73,6 +75,7 @@ EbErrorType picture_analysis_context_ctor(EbThreadContext *  thread_context_ptr,
             enc_handle_ptr->resource_coordination_results_resource_ptr, index);
     context_ptr->picture_analysis_results_output_fifo_ptr = eb_system_resource_get_producer_fifo(
         enc_handle_ptr->picture_analysis_results_resource_ptr, index);
+    context_ptr->denoise_workers = enc_handle_ptr->denoise_workers;
 
     if (denoise_flag == EB_TRUE) {
         EbPictureBufferDescInitData desc;
@@ -2939,16 +2942,19 @@ EbErrorType compute_block_mean_compute_variance(
 }
 
 static int32_t apply_denoise_2d(SequenceControlSet *scs_ptr, PictureParentControlSet *pcs_ptr,
-                                EbPictureBufferDesc *inputPicturePointer) {
+                                EbPictureBufferDesc *inputPicturePointer,
+                                DenoiseWorkers *     denoise_workers) {
     if (eb_aom_denoise_and_model_run(pcs_ptr->denoise_and_model,
                                      inputPicturePointer,
                                      &pcs_ptr->frm_hdr.film_grain_params,
-                                     scs_ptr->static_config.encoder_bit_depth > EB_8BIT)) {}
+                                     scs_ptr->static_config.encoder_bit_depth > EB_8BIT,
+                                     denoise_workers)) {}
     return 0;
 }
 
 EbErrorType denoise_estimate_film_grain(SequenceControlSet *     scs_ptr,
-                                        PictureParentControlSet *pcs_ptr) {
+                                        PictureParentControlSet *pcs_ptr,
+                                        DenoiseWorkers *         denoise_workers) {
     EbErrorType return_error = EB_ErrorNone;
 
     FrameHeader *frm_hdr = &pcs_ptr->frm_hdr;
@@ -2957,7 +2963,7 @@ EbErrorType denoise_estimate_film_grain(SequenceControlSet *     scs_ptr,
     frm_hdr->film_grain_params.apply_grain = 0;
 
     if (scs_ptr->film_grain_denoise_strength) {
-        if (apply_denoise_2d(scs_ptr, pcs_ptr, input_picture_ptr) < 0) return 1;
+        if (apply_denoise_2d(scs_ptr, pcs_ptr, input_picture_ptr, denoise_workers) < 0) return 1;
     }
 
     scs_ptr->seq_header.film_grain_params_present |= frm_hdr->film_grain_params.apply_grain;
@@ -2988,9 +2994,10 @@ void set_picture_parameters_for_statistics_gathering(SequenceControlSet *scs_ptr
  ***** Denoising
  ************************************************/
 void picture_pre_processing_operations(PictureParentControlSet *pcs_ptr,
-                                       SequenceControlSet *scs_ptr, uint32_t sb_total_count) {
+                                       SequenceControlSet *scs_ptr, uint32_t sb_total_count,
+                                       DenoiseWorkers *denoise_workers) {
     if (scs_ptr->film_grain_denoise_strength) {
-        denoise_estimate_film_grain(scs_ptr, pcs_ptr);
+        denoise_estimate_film_grain(scs_ptr, pcs_ptr, denoise_workers);
     } else {
         //Reset the flat noise flag array to False for both RealTime/HighComplexity Modes
         for (uint32_t sb_coding_order = 0; sb_coding_order < sb_total_count; ++sb_coding_order)
@@ -3779,7 +3786,8 @@ void *picture_analysis_kernel(void *input_ptr) {
             pad_picture_to_multiple_of_min_blk_size_dimensions(scs_ptr, input_picture_ptr);
 
             // Pre processing operations performed on the input picture
-            picture_pre_processing_operations(pcs_ptr, scs_ptr, sb_total_count);
+            picture_pre_processing_operations(
+                pcs_ptr, scs_ptr, sb_total_count, context_ptr->denoise_workers);
             if (input_picture_ptr->color_format >= EB_YUV422) {
                 // Jing: Do the conversion of 422/444=>420 here since it's multi-threaded kernel
                 //       Reuse the Y, only add cb/cr in the newly created buffer desc
@@ -3805,6 +3813,8 @@ void *picture_analysis_kernel(void *input_ptr) {
                     (EbPictureBufferDesc *)pa_ref_obj_->quarter_filtered_picture_ptr,
                     (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_filtered_picture_ptr);
             }
+            // Global motion corners, shared by all the pictures using this one as reference
+            gm_detect_corners(scs_ptr, pcs_ptr, pa_ref_obj_);
             // Gathering statistics of input picture, including Variance Calculation, Histogram Bins
             gathering_picture_statistics(
                 scs_ptr,
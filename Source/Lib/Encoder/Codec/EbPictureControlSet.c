@@ -62,32 +62,35 @@ EbErrorType segmentation_map_ctor(SegmentationNeighborMap *seg_neighbor_map, uin
     return EB_ErrorNone;
 }
 
-static void me_sb_results_dctor(EbPtr p) {
-    MeSbResults *obj = (MeSbResults *)p;
-
-    EB_FREE_ARRAY(obj->me_candidate);
-    if (obj->me_mv_array) { EB_FREE_ARRAY(obj->me_mv_array[0]); }
-    EB_FREE_ARRAY(obj->me_mv_array);
-    EB_FREE_ARRAY(obj->me_candidate_array);
-    EB_FREE_ARRAY(obj->total_me_candidate_index);
-
-    EB_FREE_ARRAY(obj->me_nsq_0);
-    EB_FREE_ARRAY(obj->me_nsq_1);
+/* Arena bytes needed by one SB worth of ME results, including the MeSbResults itself */
+size_t me_sb_results_arena_size(uint32_t max_number_of_blks_per_sb, uint8_t mrp_mode,
+                                uint32_t maxNumberOfMeCandidatesPerPU) {
+    size_t count = ((mrp_mode == 0) ? ME_MV_MRP_MODE_0 : ME_MV_MRP_MODE_1);
+
+    return EB_ARENA_SIZE(sizeof(MeSbResults)) +
+           EB_ARENA_SIZE(sizeof(MeCandidate *) * max_number_of_blks_per_sb) +
+           EB_ARENA_SIZE(sizeof(MvCandidate *) * max_number_of_blks_per_sb) +
+           EB_ARENA_SIZE(sizeof(MeCandidate) * max_number_of_blks_per_sb *
+                         maxNumberOfMeCandidatesPerPU) +
+           EB_ARENA_SIZE(sizeof(MvCandidate) * max_number_of_blks_per_sb * count) +
+           3 * EB_ARENA_SIZE(sizeof(uint8_t) * max_number_of_blks_per_sb);
 }
 
-EbErrorType me_sb_results_ctor(MeSbResults *obj_ptr, uint32_t max_number_of_blks_per_sb,
-                               uint8_t mrp_mode, uint32_t maxNumberOfMeCandidatesPerPU) {
+/* The MeSbResults and its arrays are carved out of the parent PCS arena and released with it */
+EbErrorType me_sb_results_ctor(MeSbResults *obj_ptr, EbArena *arena,
+                               uint32_t max_number_of_blks_per_sb, uint8_t mrp_mode,
+                               uint32_t maxNumberOfMeCandidatesPerPU) {
     uint32_t pu_index;
 
     size_t count                      = ((mrp_mode == 0) ? ME_MV_MRP_MODE_0 : ME_MV_MRP_MODE_1);
-    obj_ptr->dctor                    = me_sb_results_dctor;
+    obj_ptr->dctor                    = NULL;
     obj_ptr->max_number_of_pus_per_sb = max_number_of_blks_per_sb;
 
-    EB_MALLOC_ARRAY(obj_ptr->me_candidate, max_number_of_blks_per_sb);
-    EB_MALLOC_ARRAY(obj_ptr->me_mv_array, max_number_of_blks_per_sb);
-    EB_MALLOC_ARRAY(obj_ptr->me_candidate_array,
-                    max_number_of_blks_per_sb * maxNumberOfMeCandidatesPerPU);
-    EB_MALLOC_ARRAY(obj_ptr->me_mv_array[0], max_number_of_blks_per_sb * count);
+    EB_ARENA_ALLOC_ARRAY(arena, obj_ptr->me_candidate, max_number_of_blks_per_sb);
+    EB_ARENA_ALLOC_ARRAY(arena, obj_ptr->me_mv_array, max_number_of_blks_per_sb);
+    EB_ARENA_ALLOC_ARRAY(arena, obj_ptr->me_candidate_array,
+                         max_number_of_blks_per_sb * maxNumberOfMeCandidatesPerPU);
+    EB_ARENA_ALLOC_ARRAY(arena, obj_ptr->me_mv_array[0], max_number_of_blks_per_sb * count);
 
     for (pu_index = 0; pu_index < max_number_of_blks_per_sb; ++pu_index) {
         obj_ptr->me_candidate[pu_index] =
@@ -105,10 +108,10 @@ EbErrorType me_sb_results_ctor(MeSbResults *obj_ptr, uint32_t max_number_of_blks
         obj_ptr->me_candidate[pu_index][2].direction = 2;
         obj_ptr->me_mv_array[pu_index]               = obj_ptr->me_mv_array[0] + pu_index * count;
     }
-    EB_MALLOC_ARRAY(obj_ptr->total_me_candidate_index, max_number_of_blks_per_sb);
+    EB_ARENA_ALLOC_ARRAY(arena, obj_ptr->total_me_candidate_index, max_number_of_blks_per_sb);
 
-    EB_MALLOC_ARRAY(obj_ptr->me_nsq_0, max_number_of_blks_per_sb);
-    EB_MALLOC_ARRAY(obj_ptr->me_nsq_1, max_number_of_blks_per_sb);
+    EB_ARENA_ALLOC_ARRAY(arena, obj_ptr->me_nsq_0, max_number_of_blks_per_sb);
+    EB_ARENA_ALLOC_ARRAY(arena, obj_ptr->me_nsq_1, max_number_of_blks_per_sb);
 
     return EB_ErrorNone;
 }
@@ -181,7 +184,15 @@ void picture_control_set_dctor(EbPtr p) {
         EB_DELETE(obj->md_ref_frame_type_neighbor_array[depth]);
         EB_DELETE(obj->md_interpolation_type_neighbor_array[depth]);
     }
-    EB_DELETE_PTR_ARRAY(obj->sb_ptr_array, obj->sb_total_count);
+    if (obj->sb_ptr_array) {
+        // The SBs live in the arena, only their owned buffers need releasing
+        for (uint32_t sb_index = 0; sb_index < obj->sb_total_count; ++sb_index) {
+            SuperBlock *sb_ptr = obj->sb_ptr_array[sb_index];
+            if (sb_ptr && sb_ptr->dctor) sb_ptr->dctor(sb_ptr);
+        }
+        EB_FREE_ARRAY(obj->sb_ptr_array);
+    }
+    eb_arena_dctor(&obj->sb_arena);
     EB_DELETE(obj->coeff_est_entropy_coder_ptr);
     EB_DELETE(obj->bitstream_ptr);
     EB_DELETE(obj->entropy_coder_ptr);
@@ -380,14 +391,22 @@ EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr object
                    init_data_ptr->sb_size_pix);
     const uint16_t all_sb = picture_sb_w * picture_sb_h;
 
+    // One arena holds every SB and its block arrays instead of several allocations per SB
+    return_error = eb_arena_ctor(
+        &object_ptr->sb_arena,
+        all_sb * largest_coding_unit_arena_size((uint8_t)init_data_ptr->sb_size_pix));
+    if (return_error != EB_ErrorNone) return return_error;
+
     for (sb_index = 0; sb_index < all_sb; ++sb_index) {
-        EB_NEW(object_ptr->sb_ptr_array[sb_index],
-               largest_coding_unit_ctor,
-               (uint8_t)init_data_ptr->sb_size_pix,
-               (uint16_t)(sb_origin_x * max_blk_size),
-               (uint16_t)(sb_origin_y * max_blk_size),
-               (uint16_t)sb_index,
-               object_ptr);
+        EB_ARENA_CALLOC_ARRAY(&object_ptr->sb_arena, object_ptr->sb_ptr_array[sb_index], 1);
+        return_error = largest_coding_unit_ctor(object_ptr->sb_ptr_array[sb_index],
+                                                &object_ptr->sb_arena,
+                                                (uint8_t)init_data_ptr->sb_size_pix,
+                                                (uint16_t)(sb_origin_x * max_blk_size),
+                                                (uint16_t)(sb_origin_y * max_blk_size),
+                                                (uint16_t)sb_index,
+                                                object_ptr);
+        if (return_error != EB_ErrorNone) return return_error;
         // Increment the Order in coding order (Raster Scan Order)
         sb_origin_y = (sb_origin_x == picture_sb_w - 1) ? sb_origin_y + 1 : sb_origin_y;
         sb_origin_x = (sb_origin_x == picture_sb_w - 1) ? 0 : sb_origin_x + 1;
@@ -1029,7 +1048,9 @@ static void picture_parent_control_set_dctor(EbPtr p) {
 
     EB_DELETE(obj->denoise_and_model);
 
-    EB_DELETE_PTR_ARRAY(obj->me_results, obj->sb_total_count);
+    // The ME results live in the arena
+    EB_FREE_ARRAY(obj->me_results);
+    eb_arena_dctor(&obj->me_results_arena);
     if (obj->is_chroma_downsampled_picture_ptr_owner)
         EB_DELETE(obj->chroma_downsampled_picture_ptr);
 
@@ -1069,6 +1090,7 @@ static void picture_parent_control_set_dctor(EbPtr p) {
     // SB noise variance array
     EB_FREE_ARRAY(obj->sb_flat_noise_array);
     EB_FREE_ARRAY(obj->sb_depth_mode_array);
+    EB_FREE_ARRAY(obj->stat_struct.referenced_area);
 
     if (obj->av1_cm) {
         const int32_t num_planes = 3; // av1_num_planes(cm);
@@ -1190,12 +1212,25 @@ EbErrorType picture_parent_control_set_ctor(PictureParentControlSet *object_ptr,
 
     EB_ALLOC_PTR_ARRAY(object_ptr->me_results, object_ptr->sb_total_count);
 
-    for (sb_index = 0; sb_index < object_ptr->sb_total_count; ++sb_index) {
-        EB_NEW(object_ptr->me_results[sb_index],
-               me_sb_results_ctor,
-               (init_data_ptr->nsq_present) ? MAX_ME_PU_COUNT : SQUARE_PU_COUNT,
-               init_data_ptr->mrp_mode,
-               object_ptr->max_number_of_candidates_per_block);
+    // One arena holds the ME results of every SB instead of several allocations per SB
+    {
+        const uint32_t max_pus = (init_data_ptr->nsq_present) ? MAX_ME_PU_COUNT : SQUARE_PU_COUNT;
+        EbErrorType    err     = eb_arena_ctor(
+            &object_ptr->me_results_arena,
+            object_ptr->sb_total_count *
+                me_sb_results_arena_size(
+                    max_pus, init_data_ptr->mrp_mode, object_ptr->max_number_of_candidates_per_block));
+        if (err != EB_ErrorNone) return err;
+
+        for (sb_index = 0; sb_index < object_ptr->sb_total_count; ++sb_index) {
+            EB_ARENA_CALLOC_ARRAY(&object_ptr->me_results_arena, object_ptr->me_results[sb_index], 1);
+            err = me_sb_results_ctor(object_ptr->me_results[sb_index],
+                                     &object_ptr->me_results_arena,
+                                     max_pus,
+                                     init_data_ptr->mrp_mode,
+                                     object_ptr->max_number_of_candidates_per_block);
+            if (err != EB_ErrorNone) return err;
+        }
     }
 
     EB_MALLOC_ARRAY(object_ptr->rc_me_distortion, object_ptr->sb_total_count);
@@ -1210,6 +1245,8 @@ EbErrorType picture_parent_control_set_ctor(PictureParentControlSet *object_ptr,
     EB_MALLOC_ARRAY(object_ptr->sb_flat_noise_array, object_ptr->sb_total_count);
     EB_CREATE_MUTEX(object_ptr->rc_distortion_histogram_mutex);
     EB_MALLOC_ARRAY(object_ptr->sb_depth_mode_array, object_ptr->sb_total_count);
+    // Second pass statistics
+    EB_CALLOC_ARRAY(object_ptr->stat_struct.referenced_area, object_ptr->sb_total_count);
     EB_CREATE_SEMAPHORE(object_ptr->temp_filt_done_semaphore, 0, 1);
     EB_CREATE_MUTEX(object_ptr->temp_filt_mutex);
     EB_CREATE_MUTEX(object_ptr->debug_mutex);
@@ -340,6 +340,7 @@ typedef struct PictureControlSet {
     uint8_t      sb_max_depth;
     uint16_t     sb_total_count;
     SuperBlock **sb_ptr_array;
+    EbArena      sb_arena; // backing memory of sb_ptr_array
     // DLF
     uint8_t *qp_array;
     uint16_t qp_array_stride;
@@ -632,6 +633,7 @@ typedef struct PictureParentControlSet {
     uint8_t       max_number_of_pus_per_sb;
     uint8_t       max_number_of_candidates_per_block;
     MeSbResults **me_results;
+    EbArena       me_results_arena; // backing memory of me_results
     uint32_t *    rc_me_distortion;
 
     // Global motion estimation results
@@ -699,13 +701,13 @@ typedef struct PictureParentControlSet {
 #endif
     int32_t separate_uv_delta_q;
 
-    // Global quant matrix tables
-    const QmVal *giqmatrix[NUM_QM_LEVELS][3][TX_SIZES_ALL];
-    const QmVal *gqmatrix[NUM_QM_LEVELS][3][TX_SIZES_ALL];
-    Quants       quants;
-    Dequants     deq;
-    Quants       quants_md;
-    Dequants     deq_md;
+    // Global quant matrix and quantizer tables, shared by all the encoder instances
+    const QmVal *const (*giqmatrix)[3][TX_SIZES_ALL];
+    const QmVal *const (*gqmatrix)[3][TX_SIZES_ALL];
+    const Quants *  quants;
+    const Dequants *deq;
+    const Quants *  quants_md;
+    const Dequants *deq_md;
     int32_t      min_qmlevel;
     int32_t      max_qmlevel;
     // Encoder
@@ -861,8 +863,11 @@ extern EbErrorType picture_control_set_creator(EbPtr *object_dbl_ptr, EbPtr obje
 extern EbErrorType picture_parent_control_set_creator(EbPtr *object_dbl_ptr,
                                                       EbPtr  object_init_data_ptr);
 
-extern EbErrorType me_sb_results_ctor(MeSbResults *obj_ptr, uint32_t max_number_of_blks_per_sb,
-                                      uint8_t mrp_mode, uint32_t maxNumberOfMeCandidatesPerPU);
+extern size_t      me_sb_results_arena_size(uint32_t max_number_of_blks_per_sb, uint8_t mrp_mode,
+                                             uint32_t maxNumberOfMeCandidatesPerPU);
+extern EbErrorType me_sb_results_ctor(MeSbResults *obj_ptr, EbArena *arena,
+                                      uint32_t max_number_of_blks_per_sb, uint8_t mrp_mode,
+                                      uint32_t maxNumberOfMeCandidatesPerPU);
 #ifdef __cplusplus
 }
 #endif
@@ -2526,7 +2526,8 @@ void perform_simple_picture_analysis_for_overlay(PictureParentControlSet     *pc
     picture_pre_processing_operations(
         pcs_ptr,
         scs_ptr,
-        sb_total_count);
+        sb_total_count,
+        NULL);
 
     if (input_picture_ptr->color_format >= EB_YUV422) {
         // Jing: Do the conversion of 422/444=>420 here since it's multi-threaded kernel
@@ -2910,7 +2911,7 @@ void* picture_decision_kernel(void *input_ptr)
                 encode_context_ptr->pre_assignment_buffer_idr_count += pcs_ptr->idr_flag;
                 encode_context_ptr->pre_assignment_buffer_count += 1;
 
-                if (scs_ptr->static_config.rate_control_mode)
+                if (scs_ptr->static_config.rate_control_mode == 1 || scs_ptr->static_config.rate_control_mode == 2)
                 {
                     // Increment the Intra Period Position
                     encode_context_ptr->intra_period_position = (encode_context_ptr->intra_period_position == (uint32_t)scs_ptr->intra_period_length) ? 0 : encode_context_ptr->intra_period_position + 1;
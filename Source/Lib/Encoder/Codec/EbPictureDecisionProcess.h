@@ -26,7 +26,8 @@ void downsample_decimation_input_picture(PictureParentControlSet *pcs_ptr,
 void pad_picture_to_multiple_of_min_blk_size_dimensions(SequenceControlSet * scs_ptr,
                                                         EbPictureBufferDesc *input_picture_ptr);
 void picture_pre_processing_operations(PictureParentControlSet *pcs_ptr,
-                                       SequenceControlSet *scs_ptr, uint32_t sb_total_count);
+                                       SequenceControlSet *scs_ptr, uint32_t sb_total_count,
+                                       DenoiseWorkers *denoise_workers);
 void pad_picture_to_multiple_of_sb_dimensions(EbPictureBufferDesc *input_padded_picture_ptr);
 
 void gathering_picture_statistics(SequenceControlSet *scs_ptr, PictureParentControlSet *pcs_ptr,
@@ -62,7 +62,8 @@ static void configure_picture_edges(SequenceControlSet *scs_ptr, PictureControlS
 
     return;
 }
-void write_stat_to_file(SequenceControlSet *scs_ptr, StatStruct stat_struct, uint64_t ref_poc);
+void write_stat_to_file(SequenceControlSet *scs_ptr, const StatStruct *stat_struct,
+                        uint64_t ref_poc);
 
 static void picture_manager_context_dctor(EbPtr p) {
     EbThreadContext *      thread_context_ptr = (EbThreadContext *)p;
@@ -699,7 +700,8 @@ void *picture_manager_kernel(void *input_ptr) {
                                         ? EB_FALSE
                                         : // The Reference has not been received as an Input Picture yet, then its availability is false
                                         (!encode_context_ptr->terminating_sequence_flag_received &&
-                                         (scs_ptr->static_config.rate_control_mode &&
+                                         ((scs_ptr->static_config.rate_control_mode == 1 ||
+                                           scs_ptr->static_config.rate_control_mode == 2) &&
                                           entry_pcs_ptr->slice_type != I_SLICE &&
                                           entry_pcs_ptr->temporal_layer_index == 0 &&
                                           !reference_entry_ptr->feedback_arrived))
@@ -756,7 +758,8 @@ void *picture_manager_kernel(void *input_ptr) {
                                                 : // The Reference has not been received as an Input Picture yet, then its availability is false
                                                 (!encode_context_ptr
                                                       ->terminating_sequence_flag_received &&
-                                                 (scs_ptr->static_config.rate_control_mode &&
+                                                 ((scs_ptr->static_config.rate_control_mode == 1 ||
+                                                   scs_ptr->static_config.rate_control_mode == 2) &&
                                                   entry_pcs_ptr->slice_type != I_SLICE &&
                                                   entry_pcs_ptr->temporal_layer_index == 0 &&
                                                   !reference_entry_ptr->feedback_arrived))
@@ -776,8 +779,15 @@ void *picture_manager_kernel(void *input_ptr) {
 
                     if (availability_flag == EB_TRUE) {
                         // Get New  Empty Child PCS from PCS Pool
-                        eb_get_empty_object(context_ptr->picture_control_set_fifo_ptr,
-                                            &child_pcs_wrapper_ptr);
+                        if (eb_get_empty_object(context_ptr->picture_control_set_fifo_ptr,
+                                                &child_pcs_wrapper_ptr) != EB_ErrorNone) {
+                            // The object could not be built on demand, the error is reported to
+                            // the API
+                            encode_context_ptr->app_callback_ptr->error_handler(
+                                encode_context_ptr->app_callback_ptr->handle,
+                                EB_ENC_SRM_OBJECT_CTOR_ERROR);
+                            return EB_NULL;
+                        }
 
                         // Child PCS is released by Packetization
                         eb_object_inc_live_count(child_pcs_wrapper_ptr, 1);
@@ -1156,9 +1166,9 @@ void *picture_manager_kernel(void *input_ptr) {
                         reference_entry_ptr->reference_object_ptr->live_count == 1)
                         write_stat_to_file(
                             scs_ptr,
-                            ((EbReferenceObject *)
-                                 reference_entry_ptr->reference_object_ptr->object_ptr)
-                                ->stat_struct,
+                            &((EbReferenceObject *)
+                                  reference_entry_ptr->reference_object_ptr->object_ptr)
+                                 ->stat_struct,
                             ((EbReferenceObject *)
                                  reference_entry_ptr->reference_object_ptr->object_ptr)
                                 ->ref_poc);
@@ -29,6 +29,7 @@
 
 #include "EbSegmentation.h"
 #include "EbLog.h"
+#include "EbFirstPassStats.h"
 
 static const uint32_t rate_percentage_layer_array[EB_MAX_TEMPORAL_LAYERS][EB_MAX_TEMPORAL_LAYERS] =
     {{100, 0, 0, 0, 0, 0},
@@ -150,6 +151,12 @@ typedef struct RateControlContext {
 
     uint32_t qp_scaling_map[EB_MAX_TEMPORAL_LAYERS][MAX_REF_QP_NUM];
     uint32_t qp_scaling_map_i_slice[MAX_REF_QP_NUM];
+
+    // CRF max bitrate cap (leaky bucket drained at max_bit_rate)
+    int64_t crf_vbv_buffer_size;
+    int64_t crf_vbv_level;
+    int64_t crf_max_bits_per_frame;
+    int32_t crf_vbv_qindex_offset;
 } RateControlContext;
 
 // calculate the QP based on the QP scaling
@@ -690,6 +697,13 @@ void high_level_rc_input_picture_vbr(PictureParentControlSet *pcs_ptr, SequenceC
             bit_constraint_per_sw = high_level_rate_control_ptr->bit_constraint_per_sw *
                                     pcs_ptr->frames_in_sw /
                                     (scs_ptr->static_config.look_ahead_distance + 1);
+            // Redistribute the budget using the first pass complexity of the window
+            if (scs_ptr->use_input_first_pass_stats)
+                bit_constraint_per_sw =
+                    first_pass_stats_scale_window_bits(encode_context_ptr,
+                                                       pcs_ptr->picture_number,
+                                                       pcs_ptr->frames_in_sw,
+                                                       bit_constraint_per_sw);
 
             // Update the target rate for the sliding window based on the status of RC
             if ((context_ptr->extra_bits_gen > (int64_t)(context_ptr->virtual_buffer_size * 10)))
@@ -3836,6 +3850,17 @@ void init_rc(RateControlContext *context_ptr, PictureControlSet *pcs_ptr,
                                           (context_ptr->virtual_buffer_size / 3);
         context_ptr->base_layer_frames_avg_qp       = scs_ptr->static_config.qp;
         context_ptr->base_layer_intra_frames_avg_qp = scs_ptr->static_config.qp;
+    } else if (scs_ptr->static_config.rate_control_mode == 3 &&
+               scs_ptr->static_config.max_bit_rate > 0) {
+        const uint64_t frame_rate = scs_ptr->frame_rate > 1000 ? scs_ptr->frame_rate
+                                                               : scs_ptr->frame_rate << 16;
+        context_ptr->crf_max_bits_per_frame = (int64_t)MAX(
+            1, ((uint64_t)scs_ptr->static_config.max_bit_rate << RC_PRECISION) / frame_rate);
+        context_ptr->crf_vbv_buffer_size = (scs_ptr->static_config.vbv_bufsize > 0)
+                                               ? (int64_t)scs_ptr->static_config.vbv_bufsize
+                                               : (int64_t)scs_ptr->static_config.max_bit_rate;
+        context_ptr->crf_vbv_level         = 0;
+        context_ptr->crf_vbv_qindex_offset = 0;
     }
 
     for (uint32_t base_qp = 0; base_qp < MAX_REF_QP_NUM; base_qp++) {
@@ -3861,6 +3886,28 @@ void init_rc(RateControlContext *context_ptr, PictureControlSet *pcs_ptr,
     }
 }
 
+#define CRF_VBV_MAX_QINDEX_OFFSET 96
+/******************************************************
+ * crf_vbv_update
+ * Updates the CRF max bitrate buffer with the actual size of a coded
+ * frame. The qindex offset starts to rise once the buffer is half full
+ * and reaches CRF_VBV_MAX_QINDEX_OFFSET when the buffer is full.
+ ******************************************************/
+static void crf_vbv_update(RateControlContext *context_ptr, uint64_t frame_bits) {
+    const int64_t half_buffer_size = MAX(1, context_ptr->crf_vbv_buffer_size >> 1);
+
+    context_ptr->crf_vbv_level += (int64_t)frame_bits - context_ptr->crf_max_bits_per_frame;
+    context_ptr->crf_vbv_level = MAX(0, context_ptr->crf_vbv_level);
+
+    if (context_ptr->crf_vbv_level <= half_buffer_size)
+        context_ptr->crf_vbv_qindex_offset = 0;
+    else
+        context_ptr->crf_vbv_qindex_offset = (int32_t)MIN(
+            CRF_VBV_MAX_QINDEX_OFFSET,
+            ((context_ptr->crf_vbv_level - half_buffer_size) * CRF_VBV_MAX_QINDEX_OFFSET) /
+                half_buffer_size);
+}
+
 #define MAX_Q_INDEX 255
 #define MIN_Q_INDEX 0
 
@@ -5047,7 +5094,8 @@ void *rate_control_kernel(void *input_ptr) {
 
             // Frame level RC. Find the ParamPtr for the current GOP
             if (scs_ptr->intra_period_length == -1 ||
-                scs_ptr->static_config.rate_control_mode == 0) {
+                scs_ptr->static_config.rate_control_mode == 0 ||
+                scs_ptr->static_config.rate_control_mode == 3) {
                 rate_control_param_ptr          = context_ptr->rate_control_param_queue[0];
                 prev_gop_rate_control_param_ptr = context_ptr->rate_control_param_queue[0];
                 next_gop_rate_control_param_ptr = context_ptr->rate_control_param_queue[0];
@@ -5082,12 +5130,15 @@ void *rate_control_kernel(void *input_ptr) {
             rate_control_layer_ptr =
                 rate_control_param_ptr->rate_control_layer_array[pcs_ptr->temporal_layer_index];
 
-            if (scs_ptr->static_config.rate_control_mode == 0) {
+            if (scs_ptr->static_config.rate_control_mode == 0 ||
+                scs_ptr->static_config.rate_control_mode == 3) {
                 // if RC mode is 0,  fixed QP is used
                 // QP scaling based on POC number for Flat IPPP structure
+                // if RC mode is 3 (CRF), the lookahead based QP scaling is always used
                 frm_hdr->quantization_params.base_q_idx = quantizer_to_qindex[pcs_ptr->picture_qp];
 
-                if (scs_ptr->static_config.enable_qp_scaling_flag &&
+                if ((scs_ptr->static_config.enable_qp_scaling_flag ||
+                     scs_ptr->static_config.rate_control_mode == 3) &&
                     pcs_ptr->parent_pcs_ptr->qp_on_the_fly == EB_FALSE) {
                     const int32_t qindex = quantizer_to_qindex[(uint8_t)scs_ptr->static_config.qp];
                     const double  q_val  = eb_av1_convert_qindex_to_q(
@@ -5123,6 +5174,9 @@ void *rate_control_kernel(void *input_ptr) {
 
                         new_qindex = (int32_t)(qindex + delta_qindex);
                     }
+                    // CRF max bitrate cap
+                    if (scs_ptr->static_config.rate_control_mode == 3)
+                        new_qindex += context_ptr->crf_vbv_qindex_offset;
                     frm_hdr->quantization_params.base_q_idx = (uint8_t)CLIP3(
                         (int32_t)quantizer_to_qindex[scs_ptr->static_config.min_qp_allowed],
                         (int32_t)quantizer_to_qindex[scs_ptr->static_config.max_qp_allowed],
@@ -5257,7 +5311,8 @@ void *rate_control_kernel(void *input_ptr) {
 
             // Frame level RC
             if (scs_ptr->intra_period_length == -1 ||
-                scs_ptr->static_config.rate_control_mode == 0) {
+                scs_ptr->static_config.rate_control_mode == 0 ||
+                scs_ptr->static_config.rate_control_mode == 3) {
                 rate_control_param_ptr          = context_ptr->rate_control_param_queue[0];
                 prev_gop_rate_control_param_ptr = context_ptr->rate_control_param_queue[0];
                 if (parentpicture_control_set_ptr->slice_type == I_SLICE) {
@@ -5294,7 +5349,10 @@ void *rate_control_kernel(void *input_ptr) {
                         ? context_ptr->rate_control_param_queue[PARALLEL_GOP_MAX_NUMBER - 1]
                         : context_ptr->rate_control_param_queue[interval_index_temp - 1];
             }
-            if (scs_ptr->static_config.rate_control_mode != 0) {
+            if (scs_ptr->static_config.rate_control_mode == 3) {
+                if (context_ptr->crf_max_bits_per_frame)
+                    crf_vbv_update(context_ptr, parentpicture_control_set_ptr->total_num_bits);
+            } else if (scs_ptr->static_config.rate_control_mode != 0) {
                 context_ptr->previous_virtual_buffer_level = context_ptr->virtual_buffer_level;
 
                 context_ptr->virtual_buffer_level =
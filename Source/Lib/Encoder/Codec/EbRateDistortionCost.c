@@ -765,8 +765,8 @@ uint64_t av1_intra_fast_cost(BlkStruct *blk_ptr, ModeDecisionCandidate *candidat
         candidate_ptr->fast_chroma_rate = (full_cost_shut_fast_rate_flag) ? 0 : chroma_rate;
 
         if (use_ssd) {
-            int32_t         current_q_index = frm_hdr->quantization_params.base_q_idx;
-            Dequants *const dequants        = &pcs_ptr->parent_pcs_ptr->deq;
+            int32_t               current_q_index = frm_hdr->quantization_params.base_q_idx;
+            const Dequants *const dequants        = pcs_ptr->parent_pcs_ptr->deq;
 
             int16_t quantizer = dequants->y_dequant_q3[current_q_index][1];
             rate              = 0;
@@ -1658,8 +1658,8 @@ uint64_t av1_inter_fast_cost(BlkStruct *blk_ptr, ModeDecisionCandidate *candidat
     candidate_ptr->fast_luma_rate   = (full_cost_shut_fast_rate_flag) ? 0 : luma_rate;
     candidate_ptr->fast_chroma_rate = (full_cost_shut_fast_rate_flag) ? 0 : chroma_rate;
     if (use_ssd) {
-        int32_t         current_q_index = frm_hdr->quantization_params.base_q_idx;
-        Dequants *const dequants        = &pcs_ptr->parent_pcs_ptr->deq;
+        int32_t               current_q_index = frm_hdr->quantization_params.base_q_idx;
+        const Dequants *const dequants        = pcs_ptr->parent_pcs_ptr->deq;
 
         int16_t quantizer = dequants->y_dequant_q3[current_q_index][1];
         rate              = 0;
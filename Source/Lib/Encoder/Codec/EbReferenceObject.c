@@ -9,6 +9,7 @@
 #include "EbThreads.h"
 #include "EbReferenceObject.h"
 #include "EbPictureBufferDesc.h"
+#include "global_motion.h"
 
 void initialize_samples_neighboring_reference_picture16_bit(EbByte   recon_samples_buffer_ptr,
                                                             uint16_t stride, uint16_t recon_width,
@@ -122,11 +123,18 @@ void initialize_samples_neighboring_reference_picture(
     }
 }
 
+static uint32_t get_sb64_count(const EbPictureBufferDescInitData *init_data_ptr) {
+    return ((init_data_ptr->max_width + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64) *
+           ((init_data_ptr->max_height + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64);
+}
+
 static void eb_reference_object_dctor(EbPtr p) {
     EbReferenceObject *obj = (EbReferenceObject *)p;
     EB_DELETE(obj->reference_picture16bit);
     EB_DELETE(obj->reference_picture);
+    EB_DELETE(obj->compressed_reference);
     EB_FREE_ALIGNED_ARRAY(obj->mvs);
+    EB_FREE_ARRAY(obj->sb_stats);
     EB_DESTROY_MUTEX(obj->referenced_area_mutex);
 }
 
@@ -157,8 +165,10 @@ EbErrorType eb_reference_object_ctor(EbReferenceObject *reference_object,
             &picture_buffer_desc_init_data_16bit_ptr,
             picture_buffer_desc_init_data_16bit_ptr.bit_depth);
 
-        // Hsan: set split_mode to 1 to construct the unpacked reference buffer (used @ MD)
-        picture_buffer_desc_init_data_16bit_ptr.split_mode = EB_TRUE;
+        // The packed buffer is the reference, MD only reads the 8 most significant bits so
+        // the unpacked copy (used @ MD) is built without the 2 bit increment planes
+        picture_buffer_desc_init_data_16bit_ptr.bit_depth  = EB_8BIT;
+        picture_buffer_desc_init_data_16bit_ptr.split_mode = EB_FALSE;
         EB_NEW(reference_object->reference_picture,
                eb_picture_buffer_desc_ctor,
                (EbPtr)&picture_buffer_desc_init_data_16bit_ptr);
@@ -173,6 +183,11 @@ EbErrorType eb_reference_object_ctor(EbReferenceObject *reference_object,
             reference_object,
             picture_buffer_desc_init_data_ptr,
             picture_buffer_desc_init_data_16bit_ptr.bit_depth);
+
+        if (((EbReferenceObjectDescInitData *)object_init_data_ptr)->compressed_reference)
+            EB_NEW(reference_object->compressed_reference,
+                   eb_compressed_reference_ctor,
+                   (EbPtr)reference_object->reference_picture);
     }
     if (picture_buffer_desc_init_data_ptr->mfmv) {
         //MFMV map is 8x8 based.
@@ -181,6 +196,15 @@ EbErrorType eb_reference_object_ctor(EbReferenceObject *reference_object,
         const int mem_size = ((mi_rows + 1) >> 1) * ((mi_cols + 1) >> 1);
         EB_CALLOC_ALIGNED_ARRAY(reference_object->mvs, mem_size);
     }
+    // The per SB statistics are carved out of a single allocation sized to the picture
+    const uint32_t sb_count = get_sb64_count(picture_buffer_desc_init_data_ptr);
+    EB_CALLOC_ARRAY(reference_object->sb_stats,
+                    sb_count * (2 * sizeof(uint32_t) + sizeof(uint8_t)));
+    reference_object->stat_struct.referenced_area = (uint32_t *)reference_object->sb_stats;
+    reference_object->non_moving_index_array =
+        reference_object->stat_struct.referenced_area + sb_count;
+    reference_object->intra_coded_area_sb =
+        (uint8_t *)(reference_object->non_moving_index_array + sb_count);
     memset(&reference_object->film_grain_params, 0, sizeof(reference_object->film_grain_params));
     EB_CREATE_MUTEX(reference_object->referenced_area_mutex);
     return EB_ErrorNone;
@@ -203,6 +227,8 @@ static void eb_pa_reference_object_dctor(EbPtr p) {
     EB_DELETE(obj->sixteenth_decimated_picture_ptr);
     EB_DELETE(obj->quarter_filtered_picture_ptr);
     EB_DELETE(obj->sixteenth_filtered_picture_ptr);
+    EB_FREE_ARRAY(obj->sb_stats);
+    EB_FREE_ARRAY(obj->gm_corners);
 }
 
 /*****************************************
@@ -241,6 +267,15 @@ EbErrorType eb_pa_reference_object_ctor(EbPaReferenceObject *pa_ref_obj_,
                eb_picture_buffer_desc_ctor,
                (EbPtr)(picture_buffer_desc_init_data_ptr + 2));
     }
+    // The per SB statistics are carved out of a single allocation sized to the picture
+    const uint32_t sb_count = get_sb64_count(picture_buffer_desc_init_data_ptr);
+    EB_CALLOC_ARRAY(pa_ref_obj_->sb_stats, sb_count * (sizeof(uint16_t) + sizeof(uint8_t)));
+    pa_ref_obj_->variance = (uint16_t *)pa_ref_obj_->sb_stats;
+    pa_ref_obj_->y_mean   = (uint8_t *)(pa_ref_obj_->variance + sb_count);
+
+    pa_ref_obj_->num_gm_corners = -1;
+    if (((EbPaReferenceObjectDescInitData *)object_init_data_ptr)->gm_corners)
+        EB_MALLOC_ARRAY(pa_ref_obj_->gm_corners, 2 * MAX_CORNERS);
 
     return EB_ErrorNone;
 }
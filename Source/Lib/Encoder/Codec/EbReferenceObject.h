@@ -10,19 +10,20 @@
 #include "EbObject.h"
 #include "EbCabacContextModel.h"
 #include "EbCodingUnit.h"
+#include "EbCompressedReference.h"
 
 typedef struct EbReferenceObject {
     EbDctor              dctor;
     EbPictureBufferDesc *reference_picture;
     EbPictureBufferDesc *reference_picture16bit;
+    EbCompressedReference *compressed_reference; //block compressed copy of the 8 bit reference, NULL when disabled
     uint64_t             ref_poc;
     uint16_t             qp;
     EB_SLICE             slice_type;
     uint8_t              intra_coded_area; //percentage of intra coded area 0-100%
-    uint8_t              intra_coded_area_sb
-        [MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE]; //percentage of intra coded area 0-100%
-    uint32_t non_moving_index_array
-        [MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE]; //array to hold non-moving blocks in reference frames
+    uint8_t *            intra_coded_area_sb; //percentage of intra coded area 0-100%
+    uint32_t *non_moving_index_array; //array to hold non-moving blocks in reference frames
+    uint8_t * sb_stats; //backing allocation of the per SB arrays, sized to the picture
     uint8_t              tmp_layer_idx;
     EbBool               is_scene_change;
     uint16_t             pic_avg_variance;
@@ -43,6 +44,7 @@ typedef struct EbReferenceObject {
 
 typedef struct EbReferenceObjectDescInitData {
     EbPictureBufferDescInitData reference_picture_desc_init_data;
+    EbBool                      compressed_reference; // keep a block compressed copy (8 bit only)
 } EbReferenceObjectDescInitData;
 
 typedef struct EbPaReferenceObject {
@@ -52,8 +54,11 @@ typedef struct EbPaReferenceObject {
     EbPictureBufferDesc *sixteenth_decimated_picture_ptr;
     EbPictureBufferDesc *quarter_filtered_picture_ptr;
     EbPictureBufferDesc *sixteenth_filtered_picture_ptr;
-    uint16_t             variance[MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE];
-    uint8_t              y_mean[MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE];
+    uint16_t *           variance;
+    uint8_t *            y_mean;
+    uint8_t *            sb_stats; //backing allocation of the per SB arrays, sized to the picture
+    int *                gm_corners; //FAST corners of input_padded_picture_ptr for global motion, (x, y) pairs
+    int                  num_gm_corners; //-1 when the corners have not been detected
     EB_SLICE             slice_type;
     uint32_t             dependent_pictures_count; //number of pic using this reference frame
 
@@ -63,6 +68,7 @@ typedef struct EbPaReferenceObjectDescInitData {
     EbPictureBufferDescInitData reference_picture_desc_init_data;
     EbPictureBufferDescInitData quarter_picture_desc_init_data;
     EbPictureBufferDescInitData sixteenth_picture_desc_init_data;
+    EbBool                      gm_corners; //keep the corners used by global motion
 } EbPaReferenceObjectDescInitData;
 
 /**************************************
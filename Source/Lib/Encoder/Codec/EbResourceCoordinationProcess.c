@@ -18,6 +18,7 @@
 #include "EbEntropyCoding.h"
 #include "EbObject.h"
 #include "EbLog.h"
+#include "EbSvtAv1ErrorCodes.h"
 
 typedef struct ResourceCoordinationContext {
     EbFifo *                       input_buffer_fifo_ptr;
@@ -628,17 +629,18 @@ static void read_stat_from_file(PictureParentControlSet *pcs_ptr, SequenceContro
     eb_block_on_mutex(scs_ptr->encode_context_ptr->stat_file_mutex);
 
     int32_t fseek_return_value = fseek(scs_ptr->static_config.input_stat_file,
-                                       (long)pcs_ptr->picture_number * sizeof(StatStruct),
+                                       (long)(pcs_ptr->picture_number * STAT_STRUCT_RECORD_SIZE),
                                        SEEK_SET);
 
     if (fseek_return_value != 0) {
         SVT_LOG("Error in fseek  returnVal %i\n", (int)fseek_return_value);
     }
-    size_t fread_return_value = fread(&pcs_ptr->stat_struct,
-                                      (size_t)1,
-                                      sizeof(StatStruct),
+    // Only the SBs of the picture are stored in the record
+    size_t fread_return_value = fread(pcs_ptr->stat_struct.referenced_area,
+                                      sizeof(uint32_t),
+                                      scs_ptr->sb_total_count,
                                       scs_ptr->static_config.input_stat_file);
-    if (fread_return_value != sizeof(StatStruct)) {
+    if (fread_return_value != scs_ptr->sb_total_count) {
         SVT_LOG("Error in freed  returnVal %i\n", (int)fread_return_value);
     }
 
@@ -838,8 +840,14 @@ void *resource_coordination_kernel(void *input_ptr) {
         for (uint8_t loop_index = 0; loop_index <= has_overlay && !end_of_sequence_flag;
              loop_index++) {
             //Get a New ParentPCS where we will hold the new input_picture
-            eb_get_empty_object(context_ptr->picture_control_set_fifo_ptr_array[instance_index],
-                                &pcs_wrapper_ptr);
+            if (eb_get_empty_object(context_ptr->picture_control_set_fifo_ptr_array[instance_index],
+                                    &pcs_wrapper_ptr) != EB_ErrorNone) {
+                // The object could not be built on demand, the error is reported to the API
+                scs_ptr->encode_context_ptr->app_callback_ptr->error_handler(
+                    scs_ptr->encode_context_ptr->app_callback_ptr->handle,
+                    EB_ENC_SRM_OBJECT_CTOR_ERROR);
+                return EB_NULL;
+            }
 
             // Parent PCS is released by the Rate Control after passing through MDC->MD->ENCDEC->Packetization
             eb_object_inc_live_count(pcs_wrapper_ptr, 1);
@@ -899,9 +907,14 @@ void *resource_coordination_kernel(void *input_ptr) {
                 EbObjectWrapper *input_pic_wrapper_ptr;
 
                 // Get a new input picture for overlay.
-                eb_get_empty_object(
-                    scs_ptr->encode_context_ptr->overlay_input_picture_pool_fifo_ptr,
-                    &input_pic_wrapper_ptr);
+                if (eb_get_empty_object(
+                        scs_ptr->encode_context_ptr->overlay_input_picture_pool_fifo_ptr,
+                        &input_pic_wrapper_ptr) != EB_ErrorNone) {
+                    scs_ptr->encode_context_ptr->app_callback_ptr->error_handler(
+                        scs_ptr->encode_context_ptr->app_callback_ptr->handle,
+                        EB_ENC_SRM_OBJECT_CTOR_ERROR);
+                    return EB_NULL;
+                }
 
                 // Copy from original picture (pcs_ptr->input_picture_wrapper_ptr), which is shared between overlay and alt_ref up to this point, to the new input picture.
                 if (pcs_ptr->alt_ref_ppcs_ptr->input_picture_wrapper_ptr->object_ptr != NULL) {
@@ -950,7 +963,8 @@ void *resource_coordination_kernel(void *input_ptr) {
             pcs_ptr->filtered_sse_uv = 0;
             // Rate Control
             // Set the ME Distortion and OIS Historgrams to zero
-            if (scs_ptr->static_config.rate_control_mode) {
+            if (scs_ptr->static_config.rate_control_mode == 1 ||
+                scs_ptr->static_config.rate_control_mode == 2) {
                 EB_MEMSET(pcs_ptr->me_distortion_histogram,
                           0,
                           NUMBER_OF_SAD_INTERVALS * sizeof(uint16_t));
@@ -982,13 +996,20 @@ void *resource_coordination_kernel(void *input_ptr) {
             if (scs_ptr->use_input_stat_file && !end_of_sequence_flag)
                 read_stat_from_file(pcs_ptr, scs_ptr);
             else {
-                memset(&pcs_ptr->stat_struct, 0, sizeof(StatStruct));
+                memset(pcs_ptr->stat_struct.referenced_area,
+                       0,
+                       sizeof(uint32_t) * pcs_ptr->sb_total_count);
             }
             scs_ptr->encode_context_ptr->initial_picture = EB_FALSE;
 
             // Get Empty Reference Picture Object
-            eb_get_empty_object(scs_ptr->encode_context_ptr->pa_reference_picture_pool_fifo_ptr,
-                                &reference_picture_wrapper_ptr);
+            if (eb_get_empty_object(scs_ptr->encode_context_ptr->pa_reference_picture_pool_fifo_ptr,
+                                    &reference_picture_wrapper_ptr) != EB_ErrorNone) {
+                scs_ptr->encode_context_ptr->app_callback_ptr->error_handler(
+                    scs_ptr->encode_context_ptr->app_callback_ptr->handle,
+                    EB_ENC_SRM_OBJECT_CTOR_ERROR);
+                return EB_NULL;
+            }
 
             pcs_ptr->pa_reference_picture_wrapper_ptr = reference_picture_wrapper_ptr;
             // Since overlay pictures are not added to PA_Reference queue in PD and not released there, the life count is only set to 1
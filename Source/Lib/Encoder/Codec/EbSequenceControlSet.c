@@ -292,6 +292,8 @@ EbErrorType copy_sequence_control_set(SequenceControlSet *dst, SequenceControlSe
     write_count += sizeof(int32_t);
     dst->overlay_input_picture_buffer_init_count = src->overlay_input_picture_buffer_init_count;
     write_count += sizeof(int32_t);
+    dst->memory_footprint = src->memory_footprint;
+    write_count += sizeof(uint64_t);
 
     dst->output_stream_buffer_fifo_init_count = src->output_stream_buffer_fifo_init_count;
     write_count += sizeof(int32_t);
@@ -368,6 +370,9 @@ EbErrorType copy_sequence_control_set(SequenceControlSet *dst, SequenceControlSe
     dst->mfmv_enabled                   = src->mfmv_enabled;
     dst->use_input_stat_file            = src->use_input_stat_file;
     dst->use_output_stat_file           = src->use_output_stat_file;
+    dst->use_input_first_pass_stats     = src->use_input_first_pass_stats;
+    dst->use_output_first_pass_stats    = src->use_output_first_pass_stats;
+    dst->first_pass_downscale           = src->first_pass_downscale;
     dst->scd_delay                      = src->scd_delay;
     return EB_ErrorNone;
 }
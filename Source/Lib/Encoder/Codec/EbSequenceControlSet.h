@@ -122,6 +122,7 @@ typedef struct SequenceControlSet {
     uint32_t reference_picture_buffer_init_count;
     uint32_t input_buffer_fifo_init_count;
     uint32_t overlay_input_picture_buffer_init_count;
+    uint64_t memory_footprint; // estimated picture pool memory in bytes
     uint32_t output_stream_buffer_fifo_init_count;
     uint32_t output_recon_buffer_fifo_init_count;
     uint32_t resource_coordination_fifo_init_count;
@@ -196,6 +197,9 @@ typedef struct SequenceControlSet {
     uint8_t   compound_mode;
     EbBool    use_input_stat_file;
     EbBool    use_output_stat_file;
+    EbBool    use_input_first_pass_stats;
+    EbBool    use_output_first_pass_stats;
+    EbBool    first_pass_downscale; // the fast first pass codes the input at half resolution
 } SequenceControlSet;
 
 typedef struct EbSequenceControlSetInitData {
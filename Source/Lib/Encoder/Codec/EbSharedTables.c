@@ -0,0 +1,78 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include "EbSharedTables.h"
+#include "EbModeDecisionConfigurationProcess.h"
+#include "EbMalloc.h"
+#include "EbThreads.h"
+
+static EbSharedTables *g_shared_tables;
+static uint32_t        g_shared_tables_ref_count;
+static EbHandle        g_shared_tables_mutex;
+
+#ifdef _WIN32
+
+#include <windows.h>
+
+static INIT_ONCE g_shared_tables_once = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK create_shared_tables_mutex(PINIT_ONCE InitOnce, PVOID Parameter,
+                                                PVOID *lpContext) {
+    (void)InitOnce;
+    (void)Parameter;
+    (void)lpContext;
+    g_shared_tables_mutex = eb_create_mutex();
+    return TRUE;
+}
+
+static EbHandle get_shared_tables_mutex(void) {
+    InitOnceExecuteOnce(&g_shared_tables_once, create_shared_tables_mutex, NULL, NULL);
+    return g_shared_tables_mutex;
+}
+#else
+#include <pthread.h>
+static void create_shared_tables_mutex(void) { g_shared_tables_mutex = eb_create_mutex(); }
+
+static pthread_once_t g_shared_tables_once = PTHREAD_ONCE_INIT;
+
+static EbHandle get_shared_tables_mutex(void) {
+    pthread_once(&g_shared_tables_once, create_shared_tables_mutex);
+    return g_shared_tables_mutex;
+}
+#endif // _WIN32
+
+static EbErrorType shared_tables_build(void) {
+    EbSharedTables *tables;
+    EB_MALLOC_ALIGNED(tables, sizeof(EbSharedTables));
+    eb_av1_build_quantizer(AOM_BITS_8, 0, 0, 0, 0, 0, &tables->quants[0], &tables->deq[0]);
+    eb_av1_build_quantizer(AOM_BITS_10, 0, 0, 0, 0, 0, &tables->quants[1], &tables->deq[1]);
+    eb_av1_qm_init(tables->gqmatrix, tables->giqmatrix);
+    g_shared_tables = tables;
+    return EB_ErrorNone;
+}
+
+EbErrorType eb_shared_tables_acquire(void) {
+    EbErrorType return_error = EB_ErrorNone;
+    EbHandle    mutex        = get_shared_tables_mutex();
+
+    if (!mutex) return EB_ErrorInsufficientResources;
+    eb_block_on_mutex(mutex);
+    if (!g_shared_tables) return_error = shared_tables_build();
+    if (return_error == EB_ErrorNone) g_shared_tables_ref_count++;
+    eb_release_mutex(mutex);
+    return return_error;
+}
+
+void eb_shared_tables_release(void) {
+    EbHandle mutex = get_shared_tables_mutex();
+
+    eb_block_on_mutex(mutex);
+    if (g_shared_tables_ref_count && --g_shared_tables_ref_count == 0) {
+        EB_FREE_ALIGNED(g_shared_tables);
+    }
+    eb_release_mutex(mutex);
+}
+
+const EbSharedTables *eb_get_shared_tables(void) { return g_shared_tables; }
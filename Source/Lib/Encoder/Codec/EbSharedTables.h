@@ -0,0 +1,40 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbSharedTables_h
+#define EbSharedTables_h
+
+#include "EbDefinitions.h"
+#include "EbPictureControlSet.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/**************************************
+ * Shared Tables
+ *
+ * Immutable tables built once per process and shared by every encoder
+ * handle, instead of one copy per picture control set and per instance.
+ **************************************/
+typedef struct EbSharedTables {
+    // Quantizers for 8-bit [0] and 10-bit [1], built with zero delta q
+    Quants   quants[2];
+    Dequants deq[2];
+    // Global quant matrix tables
+    const QmVal *giqmatrix[NUM_QM_LEVELS][3][TX_SIZES_ALL];
+    const QmVal *gqmatrix[NUM_QM_LEVELS][3][TX_SIZES_ALL];
+} EbSharedTables;
+
+/**************************************
+ * Extern Function Declarations
+ **************************************/
+// Builds the tables on the first call, every successful call must be matched by a release
+extern EbErrorType eb_shared_tables_acquire(void);
+extern void        eb_shared_tables_release(void);
+extern const EbSharedTables *eb_get_shared_tables(void);
+#ifdef __cplusplus
+}
+#endif
+#endif // EbSharedTables_h
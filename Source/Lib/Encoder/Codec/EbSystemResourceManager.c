@@ -4,10 +4,12 @@
 */
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "EbSystemResourceManager.h"
 #include "EbDefinitions.h"
 #include "EbThreads.h"
+#include "EbLog.h"
 
 static void eb_fifo_dctor(EbPtr p) {
     EbFifo *obj = (EbFifo *)p;
@@ -393,16 +395,17 @@ void eb_object_wrapper_dctor(EbPtr p) {
 }
 
 static EbErrorType eb_object_wrapper_ctor(EbObjectWrapper *wrapper, EbSystemResource *resource,
-                                          EbCreator object_creator, EbPtr object_init_data_ptr,
-                                          EbDctor object_destroyer) {
+                                          EbBool lazy) {
     EbErrorType ret;
 
     wrapper->dctor = eb_object_wrapper_dctor;
-    ret            = object_creator(&wrapper->object_ptr, object_init_data_ptr);
-    if (ret != EB_ErrorNone) return ret;
+    if (!lazy) {
+        ret = resource->object_creator(&wrapper->object_ptr, resource->object_init_data_ptr);
+        if (ret != EB_ErrorNone) return ret;
+    }
     wrapper->release_enable      = EB_TRUE;
     wrapper->system_resource_ptr = resource;
-    wrapper->object_destroyer    = object_destroyer;
+    wrapper->object_destroyer    = resource->object_destroyer;
     return EB_ErrorNone;
 }
 
@@ -411,6 +414,50 @@ static void eb_system_resource_dctor(EbPtr p) {
     EB_DELETE(obj->full_queue);
     EB_DELETE(obj->empty_queue);
     EB_DELETE_PTR_ARRAY(obj->wrapper_ptr_pool, obj->object_total_count);
+    if (obj->object_init_data_size) EB_FREE(obj->object_init_data_ptr);
+}
+
+static EbErrorType eb_system_resource_init(EbSystemResource *resource_ptr,
+                                           uint32_t          object_total_count,
+                                           uint32_t          producer_process_total_count,
+                                           uint32_t consumer_process_total_count, EbBool lazy) {
+    uint32_t wrapper_index;
+
+    resource_ptr->object_total_count = object_total_count;
+
+    // Allocate array for wrapper pointers
+    EB_ALLOC_PTR_ARRAY(resource_ptr->wrapper_ptr_pool, resource_ptr->object_total_count);
+
+    // Initialize each wrapper
+    for (wrapper_index = 0; wrapper_index < resource_ptr->object_total_count; ++wrapper_index) {
+        EB_NEW(resource_ptr->wrapper_ptr_pool[wrapper_index],
+               eb_object_wrapper_ctor,
+               resource_ptr,
+               lazy);
+    }
+
+    // Initialize the Empty Queue
+    EB_NEW(resource_ptr->empty_queue,
+           eb_muxing_queue_ctor,
+           resource_ptr->object_total_count,
+           producer_process_total_count);
+    // Fill the Empty Fifo with every ObjectWrapper
+    for (wrapper_index = 0; wrapper_index < resource_ptr->object_total_count; ++wrapper_index) {
+        eb_muxing_queue_object_push_back(resource_ptr->empty_queue,
+                                         resource_ptr->wrapper_ptr_pool[wrapper_index]);
+    }
+
+    // Initialize the Full Queue
+    if (consumer_process_total_count) {
+        EB_NEW(resource_ptr->full_queue,
+               eb_muxing_queue_ctor,
+               resource_ptr->object_total_count,
+               consumer_process_total_count);
+    } else {
+        resource_ptr->full_queue = (EbMuxingQueue *)EB_NULL;
+    }
+
+    return EB_ErrorNone;
 }
 
 /*********************************************************************
@@ -442,47 +489,105 @@ EbErrorType eb_system_resource_ctor(EbSystemResource *resource_ptr, uint32_t obj
                                     uint32_t producer_process_total_count,
                                     uint32_t consumer_process_total_count, EbCreator object_creator,
                                     EbPtr object_init_data_ptr, EbDctor object_destroyer) {
-    uint32_t    wrapper_index;
-    EbErrorType return_error = EB_ErrorNone;
-    resource_ptr->dctor      = eb_system_resource_dctor;
+    resource_ptr->dctor                = eb_system_resource_dctor;
+    resource_ptr->object_creator       = object_creator;
+    resource_ptr->object_init_data_ptr = object_init_data_ptr;
+    resource_ptr->object_destroyer     = object_destroyer;
 
-    resource_ptr->object_total_count = object_total_count;
+    return eb_system_resource_init(resource_ptr,
+                                   object_total_count,
+                                   producer_process_total_count,
+                                   consumer_process_total_count,
+                                   EB_FALSE);
+}
 
-    // Allocate array for wrapper pointers
-    EB_ALLOC_PTR_ARRAY(resource_ptr->wrapper_ptr_pool, resource_ptr->object_total_count);
+/*********************************************************************
+ * eb_system_resource_lazy_ctor
+ *   Same as eb_system_resource_ctor, except that the objects are built
+ *   by eb_get_empty_object the first time they are handed out.
+ *
+ *   object_init_data_size
+ *     size of the data block pointed by object_init_data_ptr, which is
+ *     copied. If zero, the pointer is kept as is.
+ *********************************************************************/
+EbErrorType eb_system_resource_lazy_ctor(EbSystemResource *resource_ptr,
+                                         uint32_t          object_total_count,
+                                         uint32_t          producer_process_total_count,
+                                         uint32_t          consumer_process_total_count,
+                                         EbCreator object_creator, EbPtr object_init_data_ptr,
+                                         size_t object_init_data_size, EbDctor object_destroyer) {
+    resource_ptr->dctor            = eb_system_resource_dctor;
+    resource_ptr->object_creator   = object_creator;
+    resource_ptr->object_destroyer = object_destroyer;
+    if (object_init_data_size) {
+        EB_MALLOC(resource_ptr->object_init_data_ptr, object_init_data_size);
+        resource_ptr->object_init_data_size = object_init_data_size;
+        EB_MEMCPY(resource_ptr->object_init_data_ptr, object_init_data_ptr, object_init_data_size);
+    } else
+        resource_ptr->object_init_data_ptr = object_init_data_ptr;
+
+    return eb_system_resource_init(resource_ptr,
+                                   object_total_count,
+                                   producer_process_total_count,
+                                   consumer_process_total_count,
+                                   EB_TRUE);
+}
+
+EbBool eb_system_resource_reusable(const EbSystemResource *resource_ptr,
+                                   uint32_t                object_total_count,
+                                   uint32_t                producer_process_total_count,
+                                   uint32_t                consumer_process_total_count,
+                                   EbCreator object_creator, EbPtr object_init_data_ptr,
+                                   size_t object_init_data_size, EbDctor object_destroyer) {
+    const uint32_t consumer_count =
+        resource_ptr->full_queue ? resource_ptr->full_queue->process_total_count : 0;
+
+    // Only a copied init data block can be compared
+    if (!object_init_data_size || resource_ptr->object_init_data_size != object_init_data_size)
+        return EB_FALSE;
+    return (resource_ptr->object_total_count == object_total_count &&
+            resource_ptr->empty_queue->process_total_count == producer_process_total_count &&
+            consumer_count == consumer_process_total_count &&
+            resource_ptr->object_creator == object_creator &&
+            resource_ptr->object_destroyer == object_destroyer &&
+            !memcmp(resource_ptr->object_init_data_ptr, object_init_data_ptr, object_init_data_size))
+               ? EB_TRUE
+               : EB_FALSE;
+}
 
-    // Initialize each wrapper
-    for (wrapper_index = 0; wrapper_index < resource_ptr->object_total_count; ++wrapper_index) {
-        EB_NEW(resource_ptr->wrapper_ptr_pool[wrapper_index],
-               eb_object_wrapper_ctor,
-               resource_ptr,
-               object_creator,
-               object_init_data_ptr,
-               object_destroyer);
-    }
+EbErrorType eb_system_resource_reset(EbSystemResource *resource_ptr) {
+    const uint32_t producer_count = resource_ptr->empty_queue->process_total_count;
+    const uint32_t consumer_count =
+        resource_ptr->full_queue ? resource_ptr->full_queue->process_total_count : 0;
+    uint32_t wrapper_index;
+    uint32_t pass;
+
+    EB_DELETE(resource_ptr->full_queue);
+    EB_DELETE(resource_ptr->empty_queue);
 
-    // Initialize the Empty Queue
     EB_NEW(resource_ptr->empty_queue,
            eb_muxing_queue_ctor,
            resource_ptr->object_total_count,
-           producer_process_total_count);
-    // Fill the Empty Fifo with every ObjectWrapper
-    for (wrapper_index = 0; wrapper_index < resource_ptr->object_total_count; ++wrapper_index) {
-        eb_muxing_queue_object_push_back(resource_ptr->empty_queue,
-                                         resource_ptr->wrapper_ptr_pool[wrapper_index]);
+           producer_count);
+    // Queue the constructed objects first so that they are reused before new ones get built
+    for (pass = 0; pass < 2; ++pass) {
+        for (wrapper_index = 0; wrapper_index < resource_ptr->object_total_count; ++wrapper_index) {
+            EbObjectWrapper *wrapper_ptr = resource_ptr->wrapper_ptr_pool[wrapper_index];
+            if ((wrapper_ptr->object_ptr != EB_NULL) != (pass == 0)) continue;
+            wrapper_ptr->live_count     = 0;
+            wrapper_ptr->release_enable = EB_TRUE;
+            eb_muxing_queue_object_push_back(resource_ptr->empty_queue, wrapper_ptr);
+        }
     }
 
-    // Initialize the Full Queue
-    if (consumer_process_total_count) {
+    if (consumer_count) {
         EB_NEW(resource_ptr->full_queue,
                eb_muxing_queue_ctor,
                resource_ptr->object_total_count,
-               consumer_process_total_count);
-    } else {
-        resource_ptr->full_queue = (EbMuxingQueue *)EB_NULL;
+               consumer_count);
     }
 
-    return return_error;
+    return EB_ErrorNone;
 }
 
 EbFifo *eb_system_resource_get_producer_fifo(const EbSystemResource *resource_ptr, uint32_t index) {
@@ -620,6 +725,20 @@ EbErrorType eb_get_empty_object(EbFifo *empty_fifo_ptr, EbObjectWrapper **wrappe
     // Release Mutex
     eb_release_mutex(empty_fifo_ptr->lockout_mutex);
 
+    // First use of a lazily constructed object, build it outside of the lock
+    if ((*wrapper_dbl_ptr)->object_ptr == EB_NULL) {
+        EbSystemResource *resource_ptr = (*wrapper_dbl_ptr)->system_resource_ptr;
+        return_error                   = resource_ptr->object_creator(
+            &(*wrapper_dbl_ptr)->object_ptr, resource_ptr->object_init_data_ptr);
+        if (return_error != EB_ErrorNone) {
+            SVT_ERROR("failed to construct a pool object on demand\n");
+            // Hand the wrapper back so that the pool keeps its count, the caller gets no object
+            (*wrapper_dbl_ptr)->object_ptr = EB_NULL;
+            eb_release_object(*wrapper_dbl_ptr);
+            *wrapper_dbl_ptr = (EbObjectWrapper *)EB_NULL;
+        }
+    }
+
     return return_error;
 }
 
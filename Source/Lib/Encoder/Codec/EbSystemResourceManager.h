@@ -125,6 +125,15 @@ typedef struct EbSystemResource {
 
     // The full FIFO contains a queue of completed buffers
     EbMuxingQueue *full_queue;
+
+    // object_creator, object_init_data_ptr, object_destroyer - kept so that a
+    //   lazily constructed SystemResource can build its objects on first
+    //   demand. object_init_data_size is non-zero when object_init_data_ptr
+    //   is a copy owned by the SystemResource.
+    EbCreator object_creator;
+    EbPtr     object_init_data_ptr;
+    size_t    object_init_data_size;
+    EbDctor   object_destroyer;
 } EbSystemResource;
 
 /*********************************************************************
@@ -208,6 +217,49 @@ extern EbErrorType eb_system_resource_ctor(EbSystemResource *resource_ptr,
                                            EbCreator object_ctor, EbPtr object_init_data_ptr,
                                            EbDctor object_destroyer);
 
+/*********************************************************************
+     * eb_system_resource_lazy_ctor
+     *   Same as eb_system_resource_ctor, except that the objects are not
+     *   constructed up front. Each EbObjectWrapper constructs its object
+     *   the first time it is handed out by eb_get_empty_object, so a
+     *   SystemResource only ever holds as many objects as the pipeline
+     *   had in flight at once, up to object_total_count.
+     *
+     *   object_init_data_size
+     *     Size of the data block pointed by object_init_data_ptr. The block
+     *     is copied so that it can live on the caller's stack. If zero, the
+     *     pointer itself is kept and must outlive the SystemResource.
+     *********************************************************************/
+extern EbErrorType eb_system_resource_lazy_ctor(EbSystemResource *resource_ptr,
+                                                uint32_t          object_total_count,
+                                                uint32_t          producer_process_total_count,
+                                                uint32_t          consumer_process_total_count,
+                                                EbCreator object_ctor, EbPtr object_init_data_ptr,
+                                                size_t object_init_data_size,
+                                                EbDctor object_destroyer);
+
+/*********************************************************************
+     * eb_system_resource_reusable
+     *   Returns EB_TRUE when a SystemResource built by
+     *   eb_system_resource_lazy_ctor with a copied init data block would be
+     *   built identically from the passed arguments, so that its objects
+     *   can be kept for a new sequence.
+     *********************************************************************/
+extern EbBool eb_system_resource_reusable(const EbSystemResource *resource_ptr,
+                                          uint32_t                object_total_count,
+                                          uint32_t                producer_process_total_count,
+                                          uint32_t                consumer_process_total_count,
+                                          EbCreator object_ctor, EbPtr object_init_data_ptr,
+                                          size_t object_init_data_size, EbDctor object_destroyer);
+
+/*********************************************************************
+     * eb_system_resource_reset
+     *   Returns every EbObjectWrapper to the empty queue and rebuilds the
+     *   process fifos, keeping the objects already constructed. None of
+     *   the processes using the SystemResource may be running.
+     *********************************************************************/
+extern EbErrorType eb_system_resource_reset(EbSystemResource *resource_ptr);
+
 /*********************************************************************
      * eb_system_resource_get_producer_fifo
      *   get producer fifo
@@ -247,6 +299,11 @@ EbFifo *eb_system_resource_get_consumer_fifo(const EbSystemResource *resource_pt
      *   wrapper_dbl_ptr
      *      Double pointer used to pass the pointer to the empty
      *      EbObjectWrapper pointer.
+     *
+     *   The object of a lazily constructed SystemResource is built here
+     *   the first time its EbObjectWrapper is dequeued. If it cannot be
+     *   built, the EbObjectWrapper is released, *wrapper_dbl_ptr is set
+     *   to NULL and the error of the object creator is returned.
      *********************************************************************/
 extern EbErrorType eb_get_empty_object(EbFifo *empty_fifo_ptr, EbObjectWrapper **wrapper_dbl_ptr);
 
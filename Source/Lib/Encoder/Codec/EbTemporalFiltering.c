@@ -34,6 +34,7 @@
 #include "EbObject.h"
 #include "EbInterPrediction.h"
 #include "EbComputeVariance_C.h"
+#include "EbGlobalMotionEstimation.h"
 
 #undef _MM_HINT_T2
 #define _MM_HINT_T2 1
@@ -2045,6 +2046,9 @@ static void pad_and_decimate_filtered_pic(
                                            padded_pic_ptr,
                                            src_object->quarter_filtered_picture_ptr,
                                            src_object->sixteenth_filtered_picture_ptr);
+
+    // The corners of the unfiltered picture are stale
+    gm_detect_corners(scs_ptr, picture_control_set_ptr_central, src_object);
 }
 
 // save original enchanced_picture_ptr buffer in a separate buffer (to be replaced by the temporally filtered pic)
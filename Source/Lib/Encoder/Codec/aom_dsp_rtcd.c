@@ -1797,6 +1797,17 @@ void setup_rtcd_internal(CPU_FLAGS flags) {
     SET_AVX2(av1_compute_cross_correlation,
              av1_compute_cross_correlation_c,
              av1_compute_cross_correlation_avx2);
+    SET_AVX2(
+        av1_ransac_score_inliers, av1_ransac_score_inliers_c, av1_ransac_score_inliers_avx2);
+    SET_AVX2(eb_aom_flat_block_finder_extract_block,
+             eb_aom_flat_block_finder_extract_block_c,
+             eb_aom_flat_block_finder_extract_block_avx2);
+    SET_AVX2(eb_aom_flat_block_gradient_stats,
+             eb_aom_flat_block_gradient_stats_c,
+             eb_aom_flat_block_gradient_stats_avx2);
+    SET_AVX2(eb_aom_noise_model_add_observation,
+             eb_aom_noise_model_add_observation_c,
+             eb_aom_noise_model_add_observation_avx2);
     SET_AVX2(av1_k_means_dim1, av1_k_means_dim1_c, av1_k_means_dim1_avx2);
     SET_AVX2(av1_k_means_dim2, av1_k_means_dim2_c, av1_k_means_dim2_avx2);
     SET_AVX2(av1_calc_indices_dim1, av1_calc_indices_dim1_c, av1_calc_indices_dim1_avx2);
@@ -2716,6 +2716,23 @@ extern "C" {
     double av1_compute_cross_correlation_avx2(unsigned char *im1, int stride1, int x1, int y1, unsigned char *im2, int stride2, int x2, int y2);
     RTCD_EXTERN double(*av1_compute_cross_correlation)(unsigned char *im1, int stride1, int x1, int y1, unsigned char *im2, int stride2, int x2, int y2);
 
+    int av1_ransac_score_inliers_c(const double *mat, const double *corners1, const double *corners2, int npoints, int *inlier_indices, double *sum_distance, double *sum_distance_squared);
+    int av1_ransac_score_inliers_avx2(const double *mat, const double *corners1, const double *corners2, int npoints, int *inlier_indices, double *sum_distance, double *sum_distance_squared);
+    RTCD_EXTERN int(*av1_ransac_score_inliers)(const double *mat, const double *corners1, const double *corners2, int npoints, int *inlier_indices, double *sum_distance, double *sum_distance_squared);
+
+    struct AomFlatBlockFinder;
+    void eb_aom_flat_block_finder_extract_block_c(const struct AomFlatBlockFinder *block_finder, const uint8_t *const data, int32_t w, int32_t h, int32_t stride, int32_t offsx, int32_t offsy, double *plane, double *block);
+    void eb_aom_flat_block_finder_extract_block_avx2(const struct AomFlatBlockFinder *block_finder, const uint8_t *const data, int32_t w, int32_t h, int32_t stride, int32_t offsx, int32_t offsy, double *plane, double *block);
+    RTCD_EXTERN void(*eb_aom_flat_block_finder_extract_block)(const struct AomFlatBlockFinder *block_finder, const uint8_t *const data, int32_t w, int32_t h, int32_t stride, int32_t offsx, int32_t offsy, double *plane, double *block);
+
+    void eb_aom_flat_block_gradient_stats_c(const double *block, int32_t block_size, double *stats);
+    void eb_aom_flat_block_gradient_stats_avx2(const double *block, int32_t block_size, double *stats);
+    RTCD_EXTERN void(*eb_aom_flat_block_gradient_stats)(const double *block, int32_t block_size, double *stats);
+
+    void eb_aom_noise_model_add_observation_c(double *A, double *b, const double *buffer, double val, int32_t n, double norm_sq);
+    void eb_aom_noise_model_add_observation_avx2(double *A, double *b, const double *buffer, double val, int32_t n, double norm_sq);
+    RTCD_EXTERN void(*eb_aom_noise_model_add_observation)(double *A, double *b, const double *buffer, double val, int32_t n, double norm_sq);
+
     void av1_k_means_dim1_c(const int* data, int* centroids, uint8_t* indices, int n, int k, int max_itr);
     void av1_k_means_dim1_avx2(const int* data, int* centroids, uint8_t* indices, int n, int k, int max_itr);
     RTCD_EXTERN void(*av1_k_means_dim1)(const int* data, int* centroids, uint8_t* indices, int n, int k, int max_itr);
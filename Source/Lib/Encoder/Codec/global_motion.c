@@ -272,38 +272,12 @@ static void get_inliers_from_indices(MotionModel *params, int *correspondences)
     eb_aom_free(inliers_tmp);
 }
 
-static int compute_global_motion_feature_based(TransformationType type, unsigned char *frm_buffer,
-                                               int frm_width, int frm_height, int frm_stride,
-                                               int *frm_corners, int num_frm_corners, uint8_t *ref,
-                                               int ref_stride, int bit_depth,
+static int compute_global_motion_feature_based(TransformationType type, int *correspondences,
+                                               int num_correspondences,
                                                int *        num_inliers_by_motion,
                                                MotionModel *params_by_motion, int num_motions) {
-    (void)bit_depth;
-    assert(bit_depth == EB_8BIT);
-    int            i;
-    int            num_ref_corners;
-    int            num_correspondences;
-    int *          correspondences;
-    int            ref_corners[2 * MAX_CORNERS];
-    unsigned char *ref_buffer = ref;
-    RansacFunc     ransac     = av1_get_ransac_type(type);
-
-    num_ref_corners = av1_fast_corner_detect(
-        ref_buffer, frm_width, frm_height, ref_stride, ref_corners, MAX_CORNERS);
-
-    // find correspondences between the two images
-    correspondences     = (int *)malloc(num_frm_corners * 4 * sizeof(*correspondences));
-    num_correspondences = av1_determine_correspondence(frm_buffer,
-                                                       (int *)frm_corners,
-                                                       num_frm_corners,
-                                                       ref_buffer,
-                                                       (int *)ref_corners,
-                                                       num_ref_corners,
-                                                       frm_width,
-                                                       frm_height,
-                                                       frm_stride,
-                                                       ref_stride,
-                                                       correspondences);
+    int        i;
+    RansacFunc ransac = av1_get_ransac_type(type);
 
     ransac(
         correspondences, num_correspondences, num_inliers_by_motion, params_by_motion, num_motions);
@@ -318,8 +292,6 @@ static int compute_global_motion_feature_based(TransformationType type, unsigned
         }
     }
 
-    free(correspondences);
-
     // Return true if any one of the motions has inliers.
     for (i = 0; i < num_motions; ++i) {
         if (num_inliers_by_motion[i] > 0) return 1;
@@ -327,24 +299,16 @@ static int compute_global_motion_feature_based(TransformationType type, unsigned
     return 0;
 }
 
-int av1_compute_global_motion(TransformationType type, unsigned char *frm_buffer, int frm_width,
-                              int frm_height, int frm_stride, int *frm_corners, int num_frm_corners,
-                              uint8_t *ref, int ref_stride, int bit_depth,
+int av1_compute_global_motion(TransformationType type, int *correspondences,
+                              int num_correspondences,
                               GlobalMotionEstimationType gm_estimation_type,
                               int *num_inliers_by_motion, MotionModel *params_by_motion,
                               int num_motions) {
     switch (gm_estimation_type) {
     case GLOBAL_MOTION_FEATURE_BASED:
         return compute_global_motion_feature_based(type,
-                                                   frm_buffer,
-                                                   frm_width,
-                                                   frm_height,
-                                                   frm_stride,
-                                                   frm_corners,
-                                                   num_frm_corners,
-                                                   ref,
-                                                   ref_stride,
-                                                   bit_depth,
+                                                   correspondences,
+                                                   num_correspondences,
                                                    num_inliers_by_motion,
                                                    params_by_motion,
                                                    num_motions);
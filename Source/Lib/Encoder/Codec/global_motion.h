@@ -80,10 +80,13 @@ int64_t av1_refine_integerized_param(EbWarpedMotionParams *wm, TransformationTyp
   "num_inliers" should be length "num_motions", and will be populated with the
   number of inlier feature points for each motion. Params for which the
   num_inliers entry is 0 should be ignored by the caller.
+
+  "correspondences" are the matched corners of the two frames as returned by
+  av1_determine_correspondence(), they do not depend on "type" and are shared
+  by all the models tried for a reference.
 */
-int av1_compute_global_motion(TransformationType type, unsigned char *frm_buffer, int frm_width,
-                              int frm_height, int frm_stride, int *frm_corners, int num_frm_corners,
-                              uint8_t *ref, int ref_stride, int bit_depth,
+int av1_compute_global_motion(TransformationType type, int *correspondences,
+                              int num_correspondences,
                               GlobalMotionEstimationType gm_estimation_type,
                               int *num_inliers_by_motion, MotionModel *params_by_motion,
                               int num_motions);
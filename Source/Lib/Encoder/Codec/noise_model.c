@@ -15,6 +15,7 @@
 #include "noise_model.h"
 #include "noise_util.h"
 #include "mathutils.h"
+#include "aom_dsp_rtcd.h"
 #include "EbLog.h"
 
 #define kLowPolyNumParams 3
@@ -476,10 +477,10 @@ void eb_aom_flat_block_finder_free(AomFlatBlockFinder *block_finder) {
     memset(block_finder, 0, sizeof(*block_finder));
 }
 
-void eb_aom_flat_block_finder_extract_block(const AomFlatBlockFinder *block_finder,
-                                            const uint8_t *const data, int32_t w, int32_t h,
-                                            int32_t stride, int32_t offsx, int32_t offsy,
-                                            double *plane, double *block) {
+void eb_aom_flat_block_finder_extract_block_c(const AomFlatBlockFinder *block_finder,
+                                              const uint8_t *const data, int32_t w, int32_t h,
+                                              int32_t stride, int32_t offsx, int32_t offsy,
+                                              double *plane, double *block) {
     const int32_t block_size = block_finder->block_size;
     const int32_t n          = block_size * block_size;
     const double *A          = block_finder->A;
@@ -529,127 +530,204 @@ static int32_t compare_scores(const void *a, const void *b) {
     return 0;
 }
 
-int32_t eb_aom_flat_block_finder_run(const AomFlatBlockFinder *block_finder,
-                                     const uint8_t *const data, int32_t w, int32_t h,
-                                     int32_t stride, uint8_t *flat_blocks) {
+// Sums of the gradient covariance, mean and variance terms over the block
+// interior, in the order {g_xx, g_xy, g_yy, mean, var}
+void eb_aom_flat_block_gradient_stats_c(const double *block, int32_t block_size, double *stats) {
+    double  g_xx = 0, g_xy = 0, g_yy = 0;
+    double  var  = 0;
+    double  mean = 0;
+    int32_t xi, yi;
+
+    for (yi = 1; yi < block_size - 1; ++yi) {
+        for (xi = 1; xi < block_size - 1; ++xi) {
+            const double gx =
+                (block[yi * block_size + xi + 1] - block[yi * block_size + xi - 1]) / 2;
+            const double gy = (block[yi * block_size + xi + block_size] -
+                               block[yi * block_size + xi - block_size]) /
+                              2;
+            g_xx += gx * gx;
+            g_xy += gx * gy;
+            g_yy += gy * gy;
+
+            mean += block[yi * block_size + xi];
+            var += block[yi * block_size + xi] * block[yi * block_size + xi];
+        }
+    }
+    stats[0] = g_xx;
+    stats[1] = g_xy;
+    stats[2] = g_yy;
+    stats[3] = mean;
+    stats[4] = var;
+}
+
+// The block rows of the flat block finder are independent jobs, the flat
+// blocks are only picked once all the scores are known
+typedef struct FlatBlockFinderJobs {
+    const AomFlatBlockFinder *block_finder;
+    const uint8_t *           data;
+    int32_t                   w;
+    int32_t                   h;
+    int32_t                   stride;
+    int32_t                   num_blocks_w;
+    int32_t                   num_blocks_h;
+    uint8_t *                 flat_blocks;
+    IndexAndscore *           scores;
+    // plane and block of each lane
+    double *scratch;
+    DenoiseTask task;
+} FlatBlockFinderJobs;
+
+static void flat_block_finder_row(void *job_ctxt, int32_t by, int32_t lane) {
     // The gradient-based features used in this code are based on:
     //  A. Kokaram, D. Kelly, H. Denman and A. Crawford, "Measuring noise
     //  correlation for improved video denoising," 2012 19th, ICIP.
     // The thresholds are more lenient to allow for correct grain modeling
     // if extreme cases.
-    const int32_t  block_size        = block_finder->block_size;
-    const int32_t  n                 = block_size * block_size;
-    const double   k_trace_threshold = 0.15 / (32 * 32);
-    const double   k_ratio_threshold = 1.25;
-    const double   k_norm_threshold  = 0.08 / (32 * 32);
-    const double   k_var_threshold   = 0.005 / (double)n;
-    const int32_t  num_blocks_w      = (w + block_size - 1) / block_size;
-    const int32_t  num_blocks_h      = (h + block_size - 1) / block_size;
-    int32_t        num_flat          = 0;
-    int32_t        bx = 0, by = 0;
-    double *       plane  = (double *)malloc(n * sizeof(*plane));
-    double *       block  = (double *)malloc(n * sizeof(*block));
-    IndexAndscore *scores = (IndexAndscore *)malloc(num_blocks_w * num_blocks_h * sizeof(*scores));
-    if (plane == NULL || block == NULL || scores == NULL) {
-        SVT_ERROR("Failed to allocate memory for block of size %d\n", n);
-        free(plane);
-        free(block);
-        free(scores);
-        return -1;
-    }
-
-#ifdef NOISE_MODEL_LOG_SCORE
-    SVT_ERROR("score = [");
-#endif
-    for (by = 0; by < num_blocks_h; ++by) {
-        for (bx = 0; bx < num_blocks_w; ++bx) {
-            // Compute gradient covariance matrix.
-            double  g_xx = 0, g_xy = 0, g_yy = 0;
-            double  var  = 0;
-            double  mean = 0;
-            int32_t xi, yi;
-            eb_aom_flat_block_finder_extract_block(
-                block_finder, data, w, h, stride, bx * block_size, by * block_size, plane, block);
-
-            for (yi = 1; yi < block_size - 1; ++yi) {
-                for (xi = 1; xi < block_size - 1; ++xi) {
-                    const double gx =
-                        (block[yi * block_size + xi + 1] - block[yi * block_size + xi - 1]) / 2;
-                    const double gy = (block[yi * block_size + xi + block_size] -
-                                       block[yi * block_size + xi - block_size]) /
-                                      2;
-                    g_xx += gx * gx;
-                    g_xy += gx * gy;
-                    g_yy += gy * gy;
-
-                    mean += block[yi * block_size + xi];
-                    var += block[yi * block_size + xi] * block[yi * block_size + xi];
-                }
-            }
-            mean /= (block_size - 2) * (block_size - 2);
-
-            // Normalize gradients by BlockSize.
-            g_xx /= ((block_size - 2) * (block_size - 2));
-            g_xy /= ((block_size - 2) * (block_size - 2));
-            g_yy /= ((block_size - 2) * (block_size - 2));
-            var = var / ((block_size - 2) * (block_size - 2)) - mean * mean;
-
-            {
-                const double  trace   = g_xx + g_yy;
-                const double  det     = g_xx * g_yy - g_xy * g_xy;
-                const double  e1      = (trace + sqrt(trace * trace - 4 * det)) / 2.;
-                const double  e2      = (trace - sqrt(trace * trace - 4 * det)) / 2.;
-                const double  norm    = e1; // Spectral norm
-                const double  ratio   = (e1 / AOMMAX(e2, 1e-6));
-                const int32_t is_flat = (trace < k_trace_threshold) &&
-                                        (ratio < k_ratio_threshold) && (norm < k_norm_threshold) &&
-                                        (var > k_var_threshold);
-                // The following weights are used to combine the above features to give
-                // a sigmoid score for flatness. If the input was normalized to [0,100]
-                // the magnitude of these values would be close to 1 (e.g., weights
-                // corresponding to variance would be a factor of 10000x smaller).
-                // The weights are given in the following order:
-                //    [{var}, {ratio}, {trace}, {norm}, offset]
-                // with one of the most discriminative being simply the variance.
-                const double weights[5] = {-6682, -0.2056, 13087, -12434, 2.5694};
-                const float  score =
-                    (float)(1.0 /
-                            (1 + exp(-(weights[0] * var + weights[1] * ratio + weights[2] * trace +
-                                       weights[3] * norm + weights[4]))));
-                flat_blocks[by * num_blocks_w + bx]  = is_flat ? 255 : 0;
-                scores[by * num_blocks_w + bx].score = var > k_var_threshold ? score : 0;
-                scores[by * num_blocks_w + bx].index = by * num_blocks_w + bx;
+    const FlatBlockFinderJobs *jobs              = (const FlatBlockFinderJobs *)job_ctxt;
+    const AomFlatBlockFinder * block_finder      = jobs->block_finder;
+    const int32_t              block_size        = block_finder->block_size;
+    const int32_t              n                 = block_size * block_size;
+    const double               k_trace_threshold = 0.15 / (32 * 32);
+    const double               k_ratio_threshold = 1.25;
+    const double               k_norm_threshold  = 0.08 / (32 * 32);
+    const double               k_var_threshold   = 0.005 / (double)n;
+    const int32_t              num_blocks_w      = jobs->num_blocks_w;
+    double *                   plane             = jobs->scratch + 2 * n * lane;
+    double *                   block             = plane + n;
+    int32_t                    bx                = 0;
+
+    for (bx = 0; bx < num_blocks_w; ++bx) {
+        // Compute gradient covariance matrix.
+        double stats[5];
+        double g_xx, g_xy, g_yy;
+        double var;
+        double mean;
+        eb_aom_flat_block_finder_extract_block(block_finder,
+                                               jobs->data,
+                                               jobs->w,
+                                               jobs->h,
+                                               jobs->stride,
+                                               bx * block_size,
+                                               by * block_size,
+                                               plane,
+                                               block);
+        eb_aom_flat_block_gradient_stats(block, block_size, stats);
+        mean = stats[3] / ((block_size - 2) * (block_size - 2));
+
+        // Normalize gradients by BlockSize.
+        g_xx = stats[0] / ((block_size - 2) * (block_size - 2));
+        g_xy = stats[1] / ((block_size - 2) * (block_size - 2));
+        g_yy = stats[2] / ((block_size - 2) * (block_size - 2));
+        var  = stats[4] / ((block_size - 2) * (block_size - 2)) - mean * mean;
+
+        {
+            const double  trace   = g_xx + g_yy;
+            const double  det     = g_xx * g_yy - g_xy * g_xy;
+            const double  e1      = (trace + sqrt(trace * trace - 4 * det)) / 2.;
+            const double  e2      = (trace - sqrt(trace * trace - 4 * det)) / 2.;
+            const double  norm    = e1; // Spectral norm
+            const double  ratio   = (e1 / AOMMAX(e2, 1e-6));
+            const int32_t is_flat = (trace < k_trace_threshold) && (ratio < k_ratio_threshold) &&
+                                    (norm < k_norm_threshold) && (var > k_var_threshold);
+            // The following weights are used to combine the above features to give
+            // a sigmoid score for flatness. If the input was normalized to [0,100]
+            // the magnitude of these values would be close to 1 (e.g., weights
+            // corresponding to variance would be a factor of 10000x smaller).
+            // The weights are given in the following order:
+            //    [{var}, {ratio}, {trace}, {norm}, offset]
+            // with one of the most discriminative being simply the variance.
+            const double weights[5] = {-6682, -0.2056, 13087, -12434, 2.5694};
+            const float  score =
+                (float)(1.0 /
+                        (1 + exp(-(weights[0] * var + weights[1] * ratio + weights[2] * trace +
+                                   weights[3] * norm + weights[4]))));
+            jobs->flat_blocks[by * num_blocks_w + bx]  = is_flat ? 255 : 0;
+            jobs->scores[by * num_blocks_w + bx].score = var > k_var_threshold ? score : 0;
+            jobs->scores[by * num_blocks_w + bx].index = by * num_blocks_w + bx;
 #ifdef NOISE_MODEL_LOG_SCORE
-                SVT_ERROR("%g %g %g %g %g %d ", score, var, ratio, trace, norm, is_flat);
+            SVT_ERROR("%g %g %g %g %g %d ", score, var, ratio, trace, norm, is_flat);
 #endif
-                num_flat += is_flat;
-            }
         }
+    }
 #ifdef NOISE_MODEL_LOG_SCORE
-        SVT_ERROR("\n");
+    SVT_ERROR("\n");
 #endif
+}
+
+// Allocate the buffers and queue the block rows on the workers
+static int32_t flat_block_finder_submit(FlatBlockFinderJobs *jobs,
+                                        const AomFlatBlockFinder *block_finder,
+                                        const uint8_t *const data, int32_t w, int32_t h,
+                                        int32_t stride, uint8_t *flat_blocks,
+                                        DenoiseWorkers *workers) {
+    const int32_t block_size = block_finder->block_size;
+    const int32_t n          = block_size * block_size;
+    const int32_t num_lanes  = denoise_workers_num_lanes(workers);
+
+    jobs->block_finder = block_finder;
+    jobs->data         = data;
+    jobs->w            = w;
+    jobs->h            = h;
+    jobs->stride       = stride;
+    jobs->num_blocks_w = (w + block_size - 1) / block_size;
+    jobs->num_blocks_h = (h + block_size - 1) / block_size;
+    jobs->flat_blocks  = flat_blocks;
+    jobs->scratch      = (double *)malloc(2 * n * num_lanes * sizeof(*jobs->scratch));
+    jobs->scores =
+        (IndexAndscore *)malloc(jobs->num_blocks_w * jobs->num_blocks_h * sizeof(*jobs->scores));
+    if (jobs->scratch == NULL || jobs->scores == NULL) {
+        SVT_ERROR("Failed to allocate memory for block of size %d\n", n);
+        free(jobs->scratch);
+        free(jobs->scores);
+        return 0;
     }
+
+#ifdef NOISE_MODEL_LOG_SCORE
+    SVT_ERROR("score = [");
+#endif
+    denoise_workers_submit(
+        workers, &jobs->task, flat_block_finder_row, jobs, jobs->num_blocks_h);
+    return 1;
+}
+
+// Wait for the block rows and pick the flat blocks
+static int32_t flat_block_finder_finish(FlatBlockFinderJobs *jobs, DenoiseWorkers *workers) {
+    const int32_t  num_blocks = jobs->num_blocks_w * jobs->num_blocks_h;
+    IndexAndscore *scores     = jobs->scores;
+    int32_t        num_flat   = 0;
+
+    denoise_workers_wait(workers, &jobs->task);
 #ifdef NOISE_MODEL_LOG_SCORE
     SVT_ERROR("];\n");
 #endif
+    for (int32_t i = 0; i < num_blocks; ++i) num_flat += jobs->flat_blocks[i] != 0;
+
     // Find the top-scored blocks (most likely to be flat) and set the flat blocks
     // be the union of the thresholded results and the top 10th percentile of the
     // scored results.
-    qsort(scores, num_blocks_w * num_blocks_h, sizeof(*scores), &compare_scores);
-    const int32_t top_nth_percentile = num_blocks_w * num_blocks_h * 90 / 100;
+    qsort(scores, num_blocks, sizeof(*scores), &compare_scores);
+    const int32_t top_nth_percentile = num_blocks * 90 / 100;
     const float   score_threshold    = scores[top_nth_percentile].score;
-    for (int32_t i = 0; i < num_blocks_w * num_blocks_h; ++i) {
+    for (int32_t i = 0; i < num_blocks; ++i) {
         if (scores[i].score >= score_threshold) {
-            num_flat += flat_blocks[scores[i].index] == 0;
-            flat_blocks[scores[i].index] |= 1;
+            num_flat += jobs->flat_blocks[scores[i].index] == 0;
+            jobs->flat_blocks[scores[i].index] |= 1;
         }
     }
-    free(block);
-    free(plane);
-    free(scores);
+    free(jobs->scratch);
+    free(jobs->scores);
     return num_flat;
 }
 
+int32_t eb_aom_flat_block_finder_run(const AomFlatBlockFinder *block_finder,
+                                     const uint8_t *const data, int32_t w, int32_t h,
+                                     int32_t stride, uint8_t *flat_blocks) {
+    FlatBlockFinderJobs jobs;
+    if (!flat_block_finder_submit(&jobs, block_finder, data, w, h, stride, flat_blocks, NULL))
+        return -1;
+    return flat_block_finder_finish(&jobs, NULL);
+}
+
 int32_t eb_aom_noise_model_init(AomNoiseModel *model, const AomNoiseModelParams params) {
     const int32_t n         = num_coeffs(params);
     const int32_t lag       = params.lag;
@@ -766,6 +844,16 @@ void eb_aom_noise_model_free(AomNoiseModel *model) {
 EXTRACT_AR_ROW(uint8_t, lowbd);
 EXTRACT_AR_ROW(uint16_t, highbd);
 
+// Accumulate an observation of the AR model in the upper triangle of A, the
+// lower one is filled in once all the observations were added
+void eb_aom_noise_model_add_observation_c(double *A, double *b, const double *buffer, double val,
+                                          int32_t n, double norm_sq) {
+    for (int32_t i = 0; i < n; ++i) {
+        for (int32_t j = i; j < n; ++j) A[i * n + j] += (buffer[i] * buffer[j]) / norm_sq;
+        b[i] += (buffer[i] * val) / norm_sq;
+    }
+}
+
 static int32_t add_block_observations(AomNoiseModel *noise_model, int32_t c,
                                       const uint8_t *const data, const uint8_t *const denoised,
                                       int32_t w, int32_t h, int32_t stride, int32_t sub_log2[2],
@@ -827,18 +915,17 @@ static int32_t add_block_observations(AomNoiseModel *noise_model, int32_t c,
                                                    x + x_o,
                                                    y + y_o,
                                                    buffer);
-                    for (int32_t i = 0; i < n; ++i) {
-                        for (int32_t j = 0; j < n; ++j) {
-                            A[i * n + j] +=
-                                (buffer[i] * buffer[j]) / (normalization * normalization);
-                        }
-                        b[i] += (buffer[i] * val) / (normalization * normalization);
-                    }
+                    eb_aom_noise_model_add_observation(
+                        A, b, buffer, val, n, normalization * normalization);
                     noise_model->latest_state[c].num_observations++;
                 }
             }
         }
     }
+    // Only the upper triangle was accumulated, A stays symmetric
+    for (int32_t i = 1; i < n; ++i) {
+        for (int32_t j = 0; j < i; ++j) A[i * n + j] = A[j * n + i];
+    }
     free(buffer);
     return 1;
 }
@@ -947,15 +1034,60 @@ static int32_t ar_equation_system_solve(AomNoiseState *state, int32_t is_chroma)
     return ret;
 }
 
+// Each channel adds its observations to its own equation system, so the
+// channels are independent jobs
+typedef struct BlockObservationJobs {
+    AomNoiseModel *       noise_model;
+    const uint8_t *const *data;
+    const uint8_t *const *denoised;
+    int32_t               w;
+    int32_t               h;
+    const int32_t *       stride;
+    int32_t *             chroma_sub_log2;
+    const uint8_t *       flat_blocks;
+    int32_t               block_size;
+    int32_t               num_blocks_w;
+    int32_t               num_blocks_h;
+    int32_t               added[3];
+} BlockObservationJobs;
+
+static void add_block_observations_job(void *job_ctxt, int32_t channel, int32_t lane) {
+    BlockObservationJobs *jobs              = (BlockObservationJobs *)job_ctxt;
+    int32_t               no_subsampling[2] = {0, 0};
+    const uint8_t *       alt_data          = channel > 0 ? jobs->data[0] : 0;
+    const uint8_t *       alt_denoised      = channel > 0 ? jobs->denoised[0] : 0;
+    int32_t *             sub               = channel > 0 ? jobs->chroma_sub_log2 : no_subsampling;
+    (void)lane;
+
+    jobs->added[channel] = add_block_observations(jobs->noise_model,
+                                                  channel,
+                                                  jobs->data[channel],
+                                                  jobs->denoised[channel],
+                                                  jobs->w,
+                                                  jobs->h,
+                                                  jobs->stride[channel],
+                                                  sub,
+                                                  alt_data,
+                                                  alt_denoised,
+                                                  jobs->stride[0],
+                                                  jobs->flat_blocks,
+                                                  jobs->block_size,
+                                                  jobs->num_blocks_w,
+                                                  jobs->num_blocks_h);
+}
+
 AomNoiseStatus eb_aom_noise_model_update(AomNoiseModel *const noise_model,
                                          const uint8_t *const data[3],
                                          const uint8_t *const denoised[3], int32_t w, int32_t h,
                                          int32_t stride[3], int32_t chroma_sub_log2[2],
-                                         const uint8_t *const flat_blocks, int32_t block_size) {
-    const int32_t num_blocks_w = (w + block_size - 1) / block_size;
-    const int32_t num_blocks_h = (h + block_size - 1) / block_size;
+                                         const uint8_t *const flat_blocks, int32_t block_size,
+                                         DenoiseWorkers *workers) {
+    const int32_t        num_blocks_w = (w + block_size - 1) / block_size;
+    const int32_t        num_blocks_h = (h + block_size - 1) / block_size;
+    BlockObservationJobs jobs;
     //  int32_t y_model_different = 0;
-    int32_t num_blocks = 0;
+    int32_t num_blocks   = 0;
+    int32_t num_channels = 0;
     int32_t i = 0, channel = 0;
 
     if (block_size <= 1) {
@@ -985,28 +1117,26 @@ AomNoiseStatus eb_aom_noise_model_update(AomNoiseModel *const noise_model,
         return AOM_NOISE_STATUS_INSUFFICIENT_FLAT_BLOCKS;
     }
 
-    for (channel = 0; channel < 3; ++channel) {
+    while (num_channels < 3 && data[num_channels] && denoised[num_channels]) num_channels++;
+    jobs.noise_model     = noise_model;
+    jobs.data            = data;
+    jobs.denoised        = denoised;
+    jobs.w               = w;
+    jobs.h               = h;
+    jobs.stride          = stride;
+    jobs.chroma_sub_log2 = chroma_sub_log2;
+    jobs.flat_blocks     = flat_blocks;
+    jobs.block_size      = block_size;
+    jobs.num_blocks_w    = num_blocks_w;
+    jobs.num_blocks_h    = num_blocks_h;
+    denoise_workers_run(workers, add_block_observations_job, &jobs, num_channels);
+
+    for (channel = 0; channel < num_channels; ++channel) {
         int32_t        no_subsampling[2] = {0, 0};
         const uint8_t *alt_data          = channel > 0 ? data[0] : 0;
-        const uint8_t *alt_denoised      = channel > 0 ? denoised[0] : 0;
         int32_t *      sub               = channel > 0 ? chroma_sub_log2 : no_subsampling;
         const int32_t  is_chroma         = channel != 0;
-        if (!data[channel] || !denoised[channel]) break;
-        if (!add_block_observations(noise_model,
-                                    channel,
-                                    data[channel],
-                                    denoised[channel],
-                                    w,
-                                    h,
-                                    stride[channel],
-                                    sub,
-                                    alt_data,
-                                    alt_denoised,
-                                    stride[0],
-                                    flat_blocks,
-                                    block_size,
-                                    num_blocks_w,
-                                    num_blocks_h)) {
+        if (!jobs.added[channel]) {
             SVT_ERROR("Adding block observation failed\n");
             return AOM_NOISE_STATUS_INTERNAL_ERROR;
         }
@@ -1279,21 +1409,103 @@ static float *get_half_cos_window(int32_t block_size) {
 DITHER_AND_QUANTIZE(uint8_t, lowbd);
 DITHER_AND_QUANTIZE(uint16_t, highbd);
 
+// Buffers and transforms of a lane of the Wiener denoiser, reused for all
+// the blocks the lane filters
+typedef struct WienerDenoiseLane {
+    float *                block; // 32-byte aligned for the transform
+    float *                plane;
+    double *               block_d;
+    double *               plane_d;
+    struct aom_noise_tx_t *tx_full;
+    struct aom_noise_tx_t *tx_chroma;
+} WienerDenoiseLane;
+
+// One block set (offsx, offsy) of a plane. The blocks of a set do not
+// overlap, so its block rows are independent jobs, while the sets are run one
+// after the other to keep the order in which the windowed blocks are added.
+typedef struct WienerDenoiseJobs {
+    const uint8_t *           data;
+    int32_t                   w;
+    int32_t                   h;
+    int32_t                   stride;
+    int32_t                   chroma_sub_w;
+    int32_t                   chroma_sub_h;
+    int32_t                   block_size;
+    int32_t                   num_blocks_w;
+    int32_t                   offsx;
+    int32_t                   offsy;
+    int32_t                   use_tx_chroma;
+    const AomFlatBlockFinder *block_finder;
+    const float *             window_function;
+    const float *             noise_psd;
+    float *                   result;
+    int32_t                   result_stride;
+    WienerDenoiseLane *       lanes;
+} WienerDenoiseJobs;
+
+static void wiener_denoise_row(void *job_ctxt, int32_t job, int32_t lane_idx) {
+    const WienerDenoiseJobs *jobs             = (const WienerDenoiseJobs *)job_ctxt;
+    const WienerDenoiseLane *lane             = jobs->lanes + lane_idx;
+    const int32_t            block_size_w     = jobs->block_size >> jobs->chroma_sub_w;
+    const int32_t            block_size_h     = jobs->block_size >> jobs->chroma_sub_h;
+    const int32_t            pixels_per_block = block_size_w * block_size_h;
+    const float *            window_function  = jobs->window_function;
+    struct aom_noise_tx_t *  tx = jobs->use_tx_chroma ? lane->tx_chroma : lane->tx_full;
+    float *                  block            = lane->block;
+    float *                  plane            = lane->plane;
+    float *                  result           = jobs->result;
+    const int32_t            by               = job - 1;
+    const int32_t            offsx            = jobs->offsx;
+    const int32_t            offsy            = jobs->offsy;
+
+    // Pad the boundary when processing each block-set.
+    for (int32_t bx = -1; bx < jobs->num_blocks_w; ++bx) {
+        eb_aom_flat_block_finder_extract_block(jobs->block_finder,
+                                               jobs->data,
+                                               jobs->w >> jobs->chroma_sub_w,
+                                               jobs->h >> jobs->chroma_sub_h,
+                                               jobs->stride,
+                                               bx * block_size_w + offsx,
+                                               by * block_size_h + offsy,
+                                               lane->plane_d,
+                                               lane->block_d);
+        for (int32_t j = 0; j < pixels_per_block; ++j) {
+            block[j] = (float)lane->block_d[j];
+            plane[j] = (float)lane->plane_d[j];
+        }
+        pointwise_multiply(window_function, block, pixels_per_block);
+        eb_aom_noise_tx_forward(tx, block);
+        eb_aom_noise_tx_filter(tx, jobs->noise_psd);
+        eb_aom_noise_tx_inverse(tx, block);
+
+        // Apply window function to the plane approximation (we will apply
+        // it to the sum of plane + block when composing the results).
+        pointwise_multiply(window_function, plane, pixels_per_block);
+
+        for (int32_t y = 0; y < block_size_h; ++y) {
+            const int32_t y_result = y + (by + 1) * block_size_h + offsy;
+            for (int32_t x = 0; x < block_size_w; ++x) {
+                const int32_t x_result = x + (bx + 1) * block_size_w + offsx;
+                result[y_result * jobs->result_stride + x_result] +=
+                    (block[y * block_size_w + x] + plane[y * block_size_w + x]) *
+                    window_function[y * block_size_w + x];
+            }
+        }
+    }
+}
+
 int32_t eb_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised[3], int32_t w,
                                  int32_t h, int32_t stride[3], int32_t chroma_sub[2],
                                  float *noise_psd[3], int32_t block_size, int32_t bit_depth,
-                                 int32_t use_highbd) {
-    float *plane = NULL, *window_full = NULL, *window_chroma = NULL;
-    DECLARE_ALIGNED(32, float, *block);
-    block                          = NULL;
-    double *               block_d = NULL, *plane_d = NULL;
-    struct aom_noise_tx_t *tx_full       = NULL;
-    struct aom_noise_tx_t *tx_chroma     = NULL;
+                                 int32_t use_highbd, DenoiseWorkers *workers) {
+    float *window_full = NULL, *window_chroma = NULL;
     const int32_t          num_blocks_w  = (w + block_size - 1) / block_size;
     const int32_t          num_blocks_h  = (h + block_size - 1) / block_size;
     const int32_t          result_stride = (num_blocks_w + 2) * block_size;
     const int32_t          result_height = (num_blocks_h + 2) * block_size;
+    const int32_t          num_lanes     = denoise_workers_num_lanes(workers);
     float *                result        = NULL;
+    WienerDenoiseLane *    lanes         = NULL;
     int32_t                init_success  = 1;
     AomFlatBlockFinder     block_finder_full;
     AomFlatBlockFinder     block_finder_chroma;
@@ -1306,84 +1518,64 @@ int32_t eb_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised
     }
     init_success &=
         eb_aom_flat_block_finder_init(&block_finder_full, block_size, bit_depth, use_highbd);
-    result  = (float *)malloc((num_blocks_h + 2) * block_size * result_stride * sizeof(*result));
-    plane   = (float *)malloc(block_size * block_size * sizeof(*plane));
-    block   = (float *)eb_aom_memalign(32, 2 * block_size * block_size * sizeof(*block));
-    block_d = (double *)malloc(block_size * block_size * sizeof(*block_d));
-    plane_d = (double *)malloc(block_size * block_size * sizeof(*plane_d));
+    result = (float *)malloc((num_blocks_h + 2) * block_size * result_stride * sizeof(*result));
+    lanes  = (WienerDenoiseLane *)calloc(num_lanes, sizeof(*lanes));
     window_full = get_half_cos_window(block_size);
-    tx_full     = eb_aom_noise_tx_malloc(block_size);
 
     if (chroma_sub[0] != 0) {
         init_success &= eb_aom_flat_block_finder_init(
             &block_finder_chroma, block_size >> chroma_sub[0], bit_depth, use_highbd);
         window_chroma = get_half_cos_window(block_size >> chroma_sub[0]);
-        tx_chroma     = eb_aom_noise_tx_malloc(block_size >> chroma_sub[0]);
-    } else {
+    } else
         window_chroma = window_full;
-        tx_chroma     = tx_full;
-    }
 
-    init_success &= (int32_t)((tx_full != NULL) && (tx_chroma != NULL) && (plane != NULL) &&
-                              (plane_d != NULL) && (block != NULL) && (block_d != NULL) &&
-                              (window_full != NULL) && (window_chroma != NULL) && (result != NULL));
+    init_success &= (int32_t)((lanes != NULL) && (window_full != NULL) &&
+                              (window_chroma != NULL) && (result != NULL));
+    for (int32_t l = 0; init_success && l < num_lanes; ++l) {
+        WienerDenoiseLane *lane  = lanes + l;
+        const int32_t      n     = block_size * block_size;
+        lane->plane              = (float *)malloc(n * sizeof(*lane->plane));
+        lane->block              = (float *)eb_aom_memalign(32, 2 * n * sizeof(*lane->block));
+        lane->block_d            = (double *)malloc(n * sizeof(*lane->block_d));
+        lane->plane_d            = (double *)malloc(n * sizeof(*lane->plane_d));
+        lane->tx_full            = eb_aom_noise_tx_malloc(block_size);
+        lane->tx_chroma          = chroma_sub[0] != 0
+                                       ? eb_aom_noise_tx_malloc(block_size >> chroma_sub[0])
+                                       : lane->tx_full;
+        init_success &= (int32_t)((lane->tx_full != NULL) && (lane->tx_chroma != NULL) &&
+                                  (lane->plane != NULL) && (lane->plane_d != NULL) &&
+                                  (lane->block != NULL) && (lane->block_d != NULL));
+    }
     for (int32_t c = init_success ? 0 : 3; c < 3; ++c) {
-        float *                window_function = c == 0 ? window_full : window_chroma;
-        AomFlatBlockFinder *   block_finder    = &block_finder_full;
-        const int32_t          chroma_sub_h    = c > 0 ? chroma_sub[1] : 0;
-        const int32_t          chroma_sub_w    = c > 0 ? chroma_sub[0] : 0;
-        struct aom_noise_tx_t *tx              = (c > 0 && chroma_sub[0] > 0) ? tx_chroma : tx_full;
+        const int32_t     chroma_sub_h = c > 0 ? chroma_sub[1] : 0;
+        const int32_t     chroma_sub_w = c > 0 ? chroma_sub[0] : 0;
+        WienerDenoiseJobs jobs;
         if (!data[c] || !denoised[c]) continue;
-        if (c > 0 && chroma_sub[0] != 0) block_finder = &block_finder_chroma;
+        jobs.data            = data[c];
+        jobs.w               = w;
+        jobs.h               = h;
+        jobs.stride          = stride[c];
+        jobs.chroma_sub_w    = chroma_sub_w;
+        jobs.chroma_sub_h    = chroma_sub_h;
+        jobs.block_size      = block_size;
+        jobs.num_blocks_w    = num_blocks_w;
+        jobs.use_tx_chroma   = c > 0 && chroma_sub[0] > 0;
+        jobs.block_finder    = jobs.use_tx_chroma ? &block_finder_chroma : &block_finder_full;
+        jobs.window_function = c == 0 ? window_full : window_chroma;
+        jobs.noise_psd       = noise_psd[c];
+        jobs.result          = result;
+        jobs.result_stride   = result_stride;
+        jobs.lanes           = lanes;
         memset(result, 0, sizeof(*result) * result_stride * result_height);
-        // Do overlapped block processing (half overlapped). The block rows can
-        // easily be done in parallel
+        // Do overlapped block processing (half overlapped). The block rows of
+        // a block-set are done in parallel
         for (int32_t offsy = 0; offsy < (block_size >> chroma_sub_h);
              offsy += (block_size >> chroma_sub_h) / 2) {
             for (int32_t offsx = 0; offsx < (block_size >> chroma_sub_w);
                  offsx += (block_size >> chroma_sub_w) / 2) {
-                // Pad the boundary when processing each block-set.
-                for (int32_t by = -1; by < num_blocks_h; ++by) {
-                    for (int32_t bx = -1; bx < num_blocks_w; ++bx) {
-                        const int32_t pixels_per_block =
-                            (block_size >> chroma_sub_w) * (block_size >> chroma_sub_h);
-                        eb_aom_flat_block_finder_extract_block(
-                            block_finder,
-                            data[c],
-                            w >> chroma_sub_w,
-                            h >> chroma_sub_h,
-                            stride[c],
-                            bx * (block_size >> chroma_sub_w) + offsx,
-                            by * (block_size >> chroma_sub_h) + offsy,
-                            plane_d,
-                            block_d);
-                        for (int32_t j = 0; j < pixels_per_block; ++j) {
-                            block[j] = (float)block_d[j];
-                            plane[j] = (float)plane_d[j];
-                        }
-                        pointwise_multiply(window_function, block, pixels_per_block);
-                        eb_aom_noise_tx_forward(tx, block);
-                        eb_aom_noise_tx_filter(tx, noise_psd[c]);
-                        eb_aom_noise_tx_inverse(tx, block);
-
-                        // Apply window function to the plane approximation (we will apply
-                        // it to the sum of plane + block when composing the results).
-                        pointwise_multiply(window_function, plane, pixels_per_block);
-
-                        for (int32_t y = 0; y < (block_size >> chroma_sub_h); ++y) {
-                            const int32_t y_result =
-                                y + (by + 1) * (block_size >> chroma_sub_h) + offsy;
-                            for (int32_t x = 0; x < (block_size >> chroma_sub_w); ++x) {
-                                const int32_t x_result =
-                                    x + (bx + 1) * (block_size >> chroma_sub_w) + offsx;
-                                result[y_result * result_stride + x_result] +=
-                                    (block[y * (block_size >> chroma_sub_w) + x] +
-                                     plane[y * (block_size >> chroma_sub_w) + x]) *
-                                    window_function[y * (block_size >> chroma_sub_w) + x];
-                            }
-                        }
-                    }
-                }
+                jobs.offsx = offsx;
+                jobs.offsy = offsy;
+                denoise_workers_run(workers, wiener_denoise_row, &jobs, num_blocks_h + 1);
             }
         }
         if (use_highbd) {
@@ -1410,20 +1602,22 @@ int32_t eb_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised
                                       k_block_normalization);
         }
     }
+    for (int32_t l = 0; lanes && l < num_lanes; ++l) {
+        free(lanes[l].plane);
+        eb_aom_free(lanes[l].block);
+        free(lanes[l].block_d);
+        free(lanes[l].plane_d);
+        if (lanes[l].tx_chroma != lanes[l].tx_full) eb_aom_noise_tx_free(lanes[l].tx_chroma);
+        eb_aom_noise_tx_free(lanes[l].tx_full);
+    }
+    free(lanes);
     free(result);
-    free(plane);
-    eb_aom_free(block);
-    free(plane_d);
-    free(block_d);
     free(window_full);
 
-    eb_aom_noise_tx_free(tx_full);
-
     eb_aom_flat_block_finder_free(&block_finder_full);
     if (chroma_sub[0] != 0) {
         eb_aom_flat_block_finder_free(&block_finder_chroma);
         free(window_chroma);
-        eb_aom_noise_tx_free(tx_chroma);
     }
     return init_success;
 }
@@ -1621,11 +1815,13 @@ static void unpack_2d_pic(uint8_t *packed[3], EbPictureBufferDesc *outputPicture
 }
 
 int32_t eb_aom_denoise_and_model_run(struct AomDenoiseAndModel *ctx, EbPictureBufferDesc *sd,
-                                     AomFilmGrain *film_grain, int32_t use_highbd) {
-    const int32_t block_size = ctx->block_size;
-    uint8_t *     raw_data[3];
-    int32_t       chroma_sub_log2[2] = {1, 1}; //todo: send chroma subsampling
-    int32_t       strides[3]         = {sd->stride_y, sd->stride_cb, sd->stride_cr};
+                                     AomFilmGrain *film_grain, int32_t use_highbd,
+                                     DenoiseWorkers *workers) {
+    const int32_t       block_size = ctx->block_size;
+    uint8_t *           raw_data[3];
+    int32_t             chroma_sub_log2[2] = {1, 1}; //todo: send chroma subsampling
+    int32_t             strides[3]         = {sd->stride_y, sd->stride_cb, sd->stride_cr};
+    FlatBlockFinderJobs flat_block_jobs;
 
     if (!denoise_and_model_realloc_if_necessary(ctx, sd, use_highbd)) {
         SVT_ERROR("Unable to realloc buffers\n");
@@ -1648,19 +1844,32 @@ int32_t eb_aom_denoise_and_model_run(struct AomDenoiseAndModel *ctx, EbPictureBu
 
     const uint8_t *const data[3] = {raw_data[0], raw_data[1], raw_data[2]};
 
-    eb_aom_flat_block_finder_run(
-        &ctx->flat_block_finder, data[0], sd->width, sd->height, strides[0], ctx->flat_blocks);
-
-    if (!eb_aom_wiener_denoise_2d(data,
-                                  ctx->denoised,
+    // The flat blocks are searched by the workers while the image is denoised
+    if (!flat_block_finder_submit(&flat_block_jobs,
+                                  &ctx->flat_block_finder,
+                                  data[0],
                                   sd->width,
                                   sd->height,
-                                  strides,
-                                  chroma_sub_log2,
-                                  ctx->noise_psd,
-                                  block_size,
-                                  ctx->bit_depth,
-                                  use_highbd)) {
+                                  strides[0],
+                                  ctx->flat_blocks,
+                                  workers)) {
+        SVT_ERROR("Unable to find flat blocks\n");
+        return 0;
+    }
+
+    const int32_t denoised = eb_aom_wiener_denoise_2d(data,
+                                                      ctx->denoised,
+                                                      sd->width,
+                                                      sd->height,
+                                                      strides,
+                                                      chroma_sub_log2,
+                                                      ctx->noise_psd,
+                                                      block_size,
+                                                      ctx->bit_depth,
+                                                      use_highbd,
+                                                      workers);
+    flat_block_finder_finish(&flat_block_jobs, workers);
+    if (!denoised) {
         SVT_ERROR("Unable to denoise image\n");
         return 0;
     }
@@ -1673,7 +1882,8 @@ int32_t eb_aom_denoise_and_model_run(struct AomDenoiseAndModel *ctx, EbPictureBu
                                                             strides,
                                                             chroma_sub_log2,
                                                             ctx->flat_blocks,
-                                                            block_size);
+                                                            block_size,
+                                                            workers);
 
     int32_t have_noise_estimate = 0;
     if (status == AOM_NOISE_STATUS_OK || status == AOM_NOISE_STATUS_DIFFERENT_NOISE_TYPE) {
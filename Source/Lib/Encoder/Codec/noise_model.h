@@ -20,6 +20,7 @@ extern "C" {
 #include "grainSynthesis.h"
 #include "EbPictureBufferDesc.h"
 #include "EbObject.h"
+#include "EbDenoiseWorkers.h"
 
 #define DENOISING_BlockSize 32
 
@@ -118,7 +119,7 @@ int32_t eb_aom_noise_strength_solver_fit_piecewise(const AomNoiseStrengthSolver
      * is maintained as is the inverse, inv(A'*A), so that the plane parameters
      * can be fit for each block.
      */
-typedef struct {
+typedef struct AomFlatBlockFinder {
     double *at_a_inv;
     double *A;
     int32_t num_params; // The number of parameters used for internal low-order model
@@ -132,12 +133,6 @@ int32_t eb_aom_flat_block_finder_init(AomFlatBlockFinder *block_finder, int32_t
                                       int32_t bit_depth, int32_t use_highbd);
 void    eb_aom_flat_block_finder_free(AomFlatBlockFinder *block_finder);
 
-/*!\brief Helper to extract a block and low order "planar" model. */
-void eb_aom_flat_block_finder_extract_block(const AomFlatBlockFinder *block_finder,
-                                            const uint8_t *const data, int32_t w, int32_t h,
-                                            int32_t stride, int32_t offsx, int32_t offsy,
-                                            double *plane, double *block);
-
 /*!\brief Runs the flat block finder on the input data.
      *
      * Find flat blocks in the input image data. Returns a map of
@@ -272,12 +267,14 @@ void    eb_aom_noise_model_free(AomNoiseModel *model);
      * \param[in]     chroma_sub_log2 Chroma subsampling for planes != 0.
      * \param[in]     flat_blocks     A map to blocks that have been determined flat
      * \param[in]     block_size      The size of blocks.
+     * \param[in]     workers         Threads sharing the planes, may be NULL
      */
 AomNoiseStatus eb_aom_noise_model_update(AomNoiseModel *const noise_model,
                                          const uint8_t *const data[3],
                                          const uint8_t *const denoised[3], int32_t w, int32_t h,
                                          int32_t strides[3], int32_t chroma_sub_log2[2],
-                                         const uint8_t *const flat_blocks, int32_t block_size);
+                                         const uint8_t *const flat_blocks, int32_t block_size,
+                                         DenoiseWorkers *workers);
 
 /*\brief Save the "latest" estimate into the "combined" estimate.
      *
@@ -311,11 +308,12 @@ int32_t eb_aom_noise_model_get_grain_parameters(AomNoiseModel *const noise_model
      * \param[in]     use_highbd      If true, uint8 pointers are interpreted as
      *                                uint16 and stride is measured in uint16.
      *                                This must be true when bit_depth >= 10.
+     * \param[in]     workers         Threads sharing the block rows, may be NULL
      */
 int32_t eb_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised[3], int32_t w,
                                  int32_t h, int32_t stride[3], int32_t chroma_sub_log2[2],
                                  float *noise_psd[3], int32_t block_size, int32_t bit_depth,
-                                 int32_t use_highbd);
+                                 int32_t use_highbd, DenoiseWorkers *workers);
 
 struct AomDenoiseAndModel;
 
@@ -332,9 +330,12 @@ struct AomDenoiseAndModel;
      *                       noise estimate.
      * \param[in/out]   buf  The raw input buffer to be denoised.
      * \param[out]    grain  Output film grain parameters
+     * \param[in]   workers  Threads running the block jobs along with the
+     *                       calling thread, may be NULL
      */
 int32_t eb_aom_denoise_and_model_run(struct AomDenoiseAndModel *ctx, EbPictureBufferDesc *sd,
-                                     AomFilmGrain *film_grain, int32_t use_highbd);
+                                     AomFilmGrain *film_grain, int32_t use_highbd,
+                                     DenoiseWorkers *workers);
 
 /*!\brief Allocates a context that can be used for denoising and noise modeling.
      *
@@ -17,55 +17,66 @@
 #include "ransac.h"
 #include "mathutils.h"
 #include "random.h"
+#include "aom_dsp_rtcd.h"
 
 #define MAX_MINPTS 4
 #define MAX_DEGENERATE_ITER 10
 #define MINPTS_MULTIPLIER 5
-
-#define INLIER_THRESHOLD 1.25
 #define MIN_TRIALS 20
 
 ////////////////////////////////////////////////////////////////////////////////
 // ransac
 typedef int (*IsDegenerateFunc)(double *p);
 typedef int (*FindTransformationFunc)(int points, double *points1, double *points2, double *params);
-typedef void (*ProjectPointsDoubleFunc)(double *mat, double *points, double *proj, int n,
-                                        int stride_points, int stride_proj);
-
-static void project_points_double_translation(double *mat, double *points, double *proj, int n,
-                                              int stride_points, int stride_proj) {
-    int i;
-    for (i = 0; i < n; ++i) {
-        const double x = *(points++), y = *(points++);
-        *(proj++) = x + mat[0];
-        *(proj++) = y + mat[1];
-        points += stride_points - 2;
-        proj += stride_proj - 2;
-    }
+
+// Expands the parameters of a model to the affine matrix layout used to score it
+typedef void (*ToAffineFunc)(const double *params, double *mat);
+
+static void to_affine_translation(const double *params, double *mat) {
+    mat[0] = params[0];
+    mat[1] = params[1];
+    mat[2] = 1.0;
+    mat[3] = 0.0;
+    mat[4] = 0.0;
+    mat[5] = 1.0;
 }
 
-static void project_points_double_rotzoom(double *mat, double *points, double *proj, int n,
-                                          int stride_points, int stride_proj) {
-    int i;
-    for (i = 0; i < n; ++i) {
-        const double x = *(points++), y = *(points++);
-        *(proj++) = mat[2] * x + mat[3] * y + mat[0];
-        *(proj++) = -mat[3] * x + mat[2] * y + mat[1];
-        points += stride_points - 2;
-        proj += stride_proj - 2;
-    }
+static void to_affine_rotzoom(const double *params, double *mat) {
+    mat[0] = params[0];
+    mat[1] = params[1];
+    mat[2] = params[2];
+    mat[3] = params[3];
+    mat[4] = -params[3];
+    mat[5] = params[2];
+}
+
+static void to_affine_affine(const double *params, double *mat) {
+    memcpy(mat, params, sizeof(*mat) * 6);
 }
 
-static void project_points_double_affine(double *mat, double *points, double *proj, int n,
-                                         int stride_points, int stride_proj) {
-    int i;
-    for (i = 0; i < n; ++i) {
-        const double x = *(points++), y = *(points++);
-        *(proj++) = mat[2] * x + mat[3] * y + mat[0];
-        *(proj++) = mat[4] * x + mat[5] * y + mat[1];
-        points += stride_points - 2;
-        proj += stride_proj - 2;
+// Projects the points of corners1 with the affine matrix mat and keeps the ones
+// landing within INLIER_THRESHOLD of their match in corners2. The distances of
+// the inliers are accumulated in point order, which the SIMD versions preserve.
+int av1_ransac_score_inliers_c(const double *mat, const double *corners1, const double *corners2,
+                               int npoints, int *inlier_indices, double *sum_distance,
+                               double *sum_distance_squared) {
+    int num_inliers = 0;
+    for (int i = 0; i < npoints; ++i) {
+        const double x        = corners1[i * 2];
+        const double y        = corners1[i * 2 + 1];
+        const double proj_x   = mat[2] * x + mat[3] * y + mat[0];
+        const double proj_y   = mat[4] * x + mat[5] * y + mat[1];
+        const double dx       = proj_x - corners2[i * 2];
+        const double dy       = proj_y - corners2[i * 2 + 1];
+        const double distance = sqrt(dx * dx + dy * dy);
+
+        if (distance < INLIER_THRESHOLD) {
+            inlier_indices[num_inliers++] = i;
+            *sum_distance += distance;
+            *sum_distance_squared += distance * distance;
+        }
     }
+    return num_inliers;
 }
 
 static void normalize_homography(double *pts, int n, double *T) {
@@ -358,7 +369,7 @@ static void clear_motion(RANSAC_MOTION *motion, int num_points) {
 static int ransac(const int *matched_points, int npoints, int *num_inliers_by_motion,
                   MotionModel *params_by_motion, int num_desired_motions, int minpts,
                   IsDegenerateFunc is_degenerate, FindTransformationFunc find_transformation,
-                  ProjectPointsDoubleFunc projectpoints) {
+                  ToAffineFunc to_affine) {
     int trial_count = 0;
     int i           = 0;
     int ret_val     = 0;
@@ -369,7 +380,6 @@ static int ransac(const int *matched_points, int npoints, int *num_inliers_by_mo
 
     double *points1, *points2;
     double *corners1, *corners2;
-    double *image1_coord;
 
     // Store information for the num_desired_motions best transformations found
     // and the worst motion among them, as well as the motion currently under
@@ -380,6 +390,7 @@ static int ransac(const int *matched_points, int npoints, int *num_inliers_by_mo
     // Store the parameters and the indices of the inlier points for the motion
     // currently under consideration.
     double params_this_motion[MAX_PARAMDIM];
+    double mat_this_motion[6];
 
     double *cnp1, *cnp2;
 
@@ -390,7 +401,6 @@ static int ransac(const int *matched_points, int npoints, int *num_inliers_by_mo
     points2      = (double *)malloc(sizeof(*points2) * npoints * 2);
     corners1     = (double *)malloc(sizeof(*corners1) * npoints * 2);
     corners2     = (double *)malloc(sizeof(*corners2) * npoints * 2);
-    image1_coord = (double *)malloc(sizeof(*image1_coord) * npoints * 2);
 
     motions = (RANSAC_MOTION *)malloc(sizeof(RANSAC_MOTION) * num_desired_motions);
     for (i = 0; i < num_desired_motions; ++i) {
@@ -402,7 +412,7 @@ static int ransac(const int *matched_points, int npoints, int *num_inliers_by_mo
 
     worst_kept_motion = motions;
 
-    if (!(points1 && points2 && corners1 && corners2 && image1_coord && motions &&
+    if (!(points1 && points2 && corners1 && corners2 && motions &&
           current_motion.inlier_indices)) {
         ret_val = 1;
         goto finish_ransac;
@@ -448,19 +458,14 @@ static int ransac(const int *matched_points, int npoints, int *num_inliers_by_mo
             continue;
         }
 
-        projectpoints(params_this_motion, corners1, image1_coord, npoints, 2, 2);
-
-        for (i = 0; i < npoints; ++i) {
-            double dx       = image1_coord[i * 2] - corners2[i * 2];
-            double dy       = image1_coord[i * 2 + 1] - corners2[i * 2 + 1];
-            double distance = sqrt(dx * dx + dy * dy);
-
-            if (distance < INLIER_THRESHOLD) {
-                current_motion.inlier_indices[current_motion.num_inliers++] = i;
-                sum_distance += distance;
-                sum_distance_squared += distance * distance;
-            }
-        }
+        to_affine(params_this_motion, mat_this_motion);
+        current_motion.num_inliers = av1_ransac_score_inliers(mat_this_motion,
+                                                              corners1,
+                                                              corners2,
+                                                              npoints,
+                                                              current_motion.inlier_indices,
+                                                              &sum_distance,
+                                                              &sum_distance_squared);
 
         if (current_motion.num_inliers >= worst_kept_motion->num_inliers &&
             current_motion.num_inliers > 1) {
@@ -489,6 +494,10 @@ static int ransac(const int *matched_points, int npoints, int *num_inliers_by_mo
             }
         }
         trial_count++;
+        // The inlier ratio has converged when every kept motion has all the points
+        // as inliers: the later trials could only lower the variances, and the
+        // motions are refit below on the very same inliers.
+        if (worst_kept_motion->num_inliers == npoints) break;
     }
 
     // Sort the motions, best first.
@@ -518,7 +527,6 @@ finish_ransac:
     free(points2);
     free(corners1);
     free(corners2);
-    free(image1_coord);
     free(current_motion.inlier_indices);
     for (i = 0; i < num_desired_motions; ++i) { free(motions[i].inlier_indices); }
     free(motions);
@@ -528,9 +536,8 @@ finish_ransac:
 
 static int ransac_double_prec(const double *matched_points, int npoints, int *num_inliers_by_motion,
                               MotionModel *params_by_motion, int num_desired_motions, int minpts,
-                              IsDegenerateFunc        is_degenerate,
-                              FindTransformationFunc  find_transformation,
-                              ProjectPointsDoubleFunc projectpoints) {
+                              IsDegenerateFunc       is_degenerate,
+                              FindTransformationFunc find_transformation, ToAffineFunc to_affine) {
     int trial_count = 0;
     int i           = 0;
     int ret_val     = 0;
@@ -541,7 +548,6 @@ static int ransac_double_prec(const double *matched_points, int npoints, int *nu
 
     double *points1, *points2;
     double *corners1, *corners2;
-    double *image1_coord;
 
     // Store information for the num_desired_motions best transformations found
     // and the worst motion among them, as well as the motion currently under
@@ -552,6 +558,7 @@ static int ransac_double_prec(const double *matched_points, int npoints, int *nu
     // Store the parameters and the indices of the inlier points for the motion
     // currently under consideration.
     double params_this_motion[MAX_PARAMDIM];
+    double mat_this_motion[6];
 
     double *cnp1, *cnp2;
 
@@ -562,7 +569,6 @@ static int ransac_double_prec(const double *matched_points, int npoints, int *nu
     points2      = (double *)malloc(sizeof(*points2) * npoints * 2);
     corners1     = (double *)malloc(sizeof(*corners1) * npoints * 2);
     corners2     = (double *)malloc(sizeof(*corners2) * npoints * 2);
-    image1_coord = (double *)malloc(sizeof(*image1_coord) * npoints * 2);
 
     motions = (RANSAC_MOTION *)malloc(sizeof(RANSAC_MOTION) * num_desired_motions);
     for (i = 0; i < num_desired_motions; ++i) {
@@ -574,7 +580,7 @@ static int ransac_double_prec(const double *matched_points, int npoints, int *nu
 
     worst_kept_motion = motions;
 
-    if (!(points1 && points2 && corners1 && corners2 && image1_coord && motions &&
+    if (!(points1 && points2 && corners1 && corners2 && motions &&
           current_motion.inlier_indices)) {
         ret_val = 1;
         goto finish_ransac;
@@ -620,19 +626,14 @@ static int ransac_double_prec(const double *matched_points, int npoints, int *nu
             continue;
         }
 
-        projectpoints(params_this_motion, corners1, image1_coord, npoints, 2, 2);
-
-        for (i = 0; i < npoints; ++i) {
-            double dx       = image1_coord[i * 2] - corners2[i * 2];
-            double dy       = image1_coord[i * 2 + 1] - corners2[i * 2 + 1];
-            double distance = sqrt(dx * dx + dy * dy);
-
-            if (distance < INLIER_THRESHOLD) {
-                current_motion.inlier_indices[current_motion.num_inliers++] = i;
-                sum_distance += distance;
-                sum_distance_squared += distance * distance;
-            }
-        }
+        to_affine(params_this_motion, mat_this_motion);
+        current_motion.num_inliers = av1_ransac_score_inliers(mat_this_motion,
+                                                              corners1,
+                                                              corners2,
+                                                              npoints,
+                                                              current_motion.inlier_indices,
+                                                              &sum_distance,
+                                                              &sum_distance_squared);
 
         if (current_motion.num_inliers >= worst_kept_motion->num_inliers &&
             current_motion.num_inliers > 1) {
@@ -661,6 +662,10 @@ static int ransac_double_prec(const double *matched_points, int npoints, int *nu
             }
         }
         trial_count++;
+        // The inlier ratio has converged when every kept motion has all the points
+        // as inliers: the later trials could only lower the variances, and the
+        // motions are refit below on the very same inliers.
+        if (worst_kept_motion->num_inliers == npoints) break;
     }
 
     // Sort the motions, best first.
@@ -688,7 +693,6 @@ finish_ransac:
     free(points2);
     free(corners1);
     free(corners2);
-    free(image1_coord);
     free(current_motion.inlier_indices);
     for (i = 0; i < num_desired_motions; ++i) { free(motions[i].inlier_indices); }
     free(motions);
@@ -718,7 +722,7 @@ static int ransac_translation(int *matched_points, int npoints, int *num_inliers
                   3,
                   is_degenerate_translation,
                   find_translation,
-                  project_points_double_translation);
+                  to_affine_translation);
 }
 
 static int ransac_rotzoom(int *matched_points, int npoints, int *num_inliers_by_motion,
@@ -731,7 +735,7 @@ static int ransac_rotzoom(int *matched_points, int npoints, int *num_inliers_by_
                   3,
                   is_degenerate_affine,
                   find_rotzoom,
-                  project_points_double_rotzoom);
+                  to_affine_rotzoom);
 }
 
 static int ransac_affine(int *matched_points, int npoints, int *num_inliers_by_motion,
@@ -744,7 +748,7 @@ static int ransac_affine(int *matched_points, int npoints, int *num_inliers_by_m
                   3,
                   is_degenerate_affine,
                   find_affine,
-                  project_points_double_affine);
+                  to_affine_affine);
 }
 
 RansacFunc av1_get_ransac_type(TransformationType type) {
@@ -767,7 +771,7 @@ static int ransac_translation_double_prec(double *matched_points, int npoints,
                               3,
                               is_degenerate_translation,
                               find_translation,
-                              project_points_double_translation);
+                              to_affine_translation);
 }
 
 static int ransac_rotzoom_double_prec(double *matched_points, int npoints,
@@ -781,7 +785,7 @@ static int ransac_rotzoom_double_prec(double *matched_points, int npoints,
                               3,
                               is_degenerate_affine,
                               find_rotzoom,
-                              project_points_double_rotzoom);
+                              to_affine_rotzoom);
 }
 
 static int ransac_affine_double_prec(double *matched_points, int npoints,
@@ -795,7 +799,7 @@ static int ransac_affine_double_prec(double *matched_points, int npoints,
                               3,
                               is_degenerate_affine,
                               find_affine,
-                              project_points_double_affine);
+                              to_affine_affine);
 }
 
 RansacFuncDouble av1_get_ransac_double_prec_type(TransformationType type) {
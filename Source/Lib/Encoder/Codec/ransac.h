@@ -19,6 +19,8 @@
 
 #include "global_motion.h"
 
+#define INLIER_THRESHOLD 1.25
+
 typedef int (*RansacFunc)(int *matched_points, int npoints, int *num_inliers_by_motion,
                           MotionModel *params_by_motion, int num_motions);
 typedef int (*RansacFuncDouble)(double *matched_points, int npoints, int *num_inliers_by_motion,
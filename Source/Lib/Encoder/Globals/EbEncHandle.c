@@ -48,6 +48,9 @@
 #include "EbCdefProcess.h"
 #include "EbDlfProcess.h"
 #include "EbRateControlResults.h"
+#include "EbFirstPassStats.h"
+#include "EbSharedTables.h"
+#include "global_motion.h"
 
 #include "EbLog.h"
 
@@ -107,6 +110,8 @@ typedef struct logicalProcessorGroup {
 }processorGroup;
 #define INITIAL_PROCESSOR_GROUP 16
 processorGroup                  *lp_group = NULL;
+// Encoder handles sharing lp_group; the last eb_deinit_handle() frees it.
+static uint32_t                  lp_group_users = 0;
 #endif
 
 static const char *get_asm_level_name_str(CPU_FLAGS cpu_flags) {
@@ -374,6 +379,108 @@ int32_t set_parent_pcs(EbSvtAv1EncConfiguration*   config, uint32_t core_count,
         return -1;
     }
 }
+/*
+ * Picture pool footprint, estimated from the same dimensions and flags the pool constructors in
+ * eb_init_encoder use. Per-thread contexts and the lazily touched entropy coding buffers are not
+ * counted, so the estimate is a lower bound on the encoder's resident memory.
+ */
+static uint64_t picture_buffer_size(SequenceControlSet *scs_ptr, uint32_t width, uint32_t height,
+                                    uint32_t pad_w, uint32_t pad_h, uint32_t bytes_per_sample,
+                                    EbBool luma_only) {
+    const uint64_t luma   = (uint64_t)(width + pad_w) * (height + pad_h);
+    const uint64_t chroma = luma_only ? 0 : luma >> (scs_ptr->subsampling_x + scs_ptr->subsampling_y);
+    return (luma + 2 * chroma) * bytes_per_sample;
+}
+
+static uint64_t input_object_size(SequenceControlSet *scs_ptr) {
+    // 10-bit input is stored split: an 8-bit plane plus the unpacked 2-bit remainder
+    return picture_buffer_size(scs_ptr,
+                               scs_ptr->max_input_luma_width,
+                               scs_ptr->max_input_luma_height,
+                               scs_ptr->left_padding + scs_ptr->right_padding,
+                               scs_ptr->top_padding + scs_ptr->bot_padding,
+                               scs_ptr->encoder_bit_depth > EB_8BIT ? 2 : 1,
+                               EB_FALSE);
+}
+
+static uint64_t parent_pcs_object_size(SequenceControlSet *scs_ptr) {
+    const uint64_t sb_count = (uint64_t)((scs_ptr->max_input_luma_width + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64) *
+        ((scs_ptr->max_input_luma_height + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64);
+    const uint64_t pu_count   = scs_ptr->nsq_present ? MAX_ME_PU_COUNT : SQUARE_PU_COUNT;
+    const uint64_t cand_count = scs_ptr->mrp_mode == 0 ? ME_RES_CAND_MRP_MODE_0 : ME_RES_CAND_MRP_MODE_1;
+    const uint64_t mv_count   = scs_ptr->mrp_mode == 0 ? ME_MV_MRP_MODE_0 : ME_MV_MRP_MODE_1;
+    const uint64_t me_results = pu_count * (cand_count * sizeof(MeCandidate) + mv_count * sizeof(MvCandidate));
+    const uint64_t pu_stats   = MAX_ME_PU_COUNT * (sizeof(uint16_t) + sizeof(uint8_t)) + 2 * 21;
+    return sb_count * (me_results + pu_stats);
+}
+
+static uint64_t child_pcs_object_size(SequenceControlSet *scs_ptr) {
+    const uint32_t sb_size        = scs_ptr->static_config.super_block_size;
+    const uint32_t width          = scs_ptr->max_input_luma_width;
+    const uint32_t height         = scs_ptr->max_input_luma_height;
+    const uint32_t bytes          = scs_ptr->encoder_bit_depth > EB_8BIT ? 2 : 1;
+    const uint64_t sb_count       = (uint64_t)((width + sb_size - 1) / sb_size) * ((height + sb_size - 1) / sb_size);
+    const uint64_t blk_count      = sb_size == 128 ? 1024 : 256;
+    const uint64_t partition_count = sb_size == 128 ? BLOCK_MAX_COUNT_SB_128 : BLOCK_MAX_COUNT_SB_64;
+    uint64_t       size;
+
+    // 32-bit coefficient picture and the reconstruction
+    size = picture_buffer_size(scs_ptr, width, height, 0, 0, 4, EB_FALSE);
+    size += picture_buffer_size(scs_ptr, width, height, 2 * PAD_VALUE, 2 * PAD_VALUE, bytes, EB_FALSE);
+    if (bytes > 1)
+        size += picture_buffer_size(scs_ptr, width, height, 2 * PAD_VALUE, 2 * PAD_VALUE, bytes, EB_FALSE);
+    if (scs_ptr->film_grain_denoise_strength)
+        size += picture_buffer_size(scs_ptr, width, height, 2 * PAD_VALUE, 2 * PAD_VALUE, bytes, EB_FALSE);
+    size += sb_count * (blk_count * (sizeof(BlkStruct) + sizeof(MacroBlockD)) +
+                        partition_count * sizeof(PartitionType) +
+                        picture_buffer_size(scs_ptr, SB_STRIDE_Y, SB_STRIDE_Y, 0, 0, 4, EB_FALSE) +
+                        sizeof(FRAME_CONTEXT) + sizeof(MdRateEstimationContext));
+    return size;
+}
+
+static uint64_t reference_object_size(SequenceControlSet *scs_ptr) {
+    const uint32_t width  = scs_ptr->max_input_luma_width;
+    const uint32_t height = scs_ptr->max_input_luma_height;
+    uint64_t       size;
+
+    // 10-bit references keep the 16-bit picture and an 8-bit copy for mode decision
+    size = picture_buffer_size(scs_ptr, width, height, 2 * PAD_VALUE, 2 * PAD_VALUE,
+                               scs_ptr->encoder_bit_depth > EB_8BIT ? 3 : 1, EB_FALSE);
+    if (scs_ptr->mfmv_enabled)
+        size += (uint64_t)(((height >> MI_SIZE_LOG2) + 1) >> 1) *
+            (((width >> MI_SIZE_LOG2) + 1) >> 1) * sizeof(MV_REF);
+    // The compressed copy gets half of the 8-bit picture
+    if (COMPRESSED_REF_DISTANCE && scs_ptr->encoder_bit_depth == EB_8BIT)
+        size += picture_buffer_size(scs_ptr, width, height, 2 * PAD_VALUE, 2 * PAD_VALUE, 1, EB_FALSE) >> 1;
+    return size;
+}
+
+static uint64_t pa_reference_object_size(SequenceControlSet *scs_ptr) {
+    const uint32_t width    = scs_ptr->max_input_luma_width;
+    const uint32_t height   = scs_ptr->max_input_luma_height;
+    const uint32_t bytes    = scs_ptr->encoder_bit_depth > EB_8BIT ? 2 : 1;
+    const uint32_t pad      = 2 * (scs_ptr->sb_sz + ME_FILTER_TAP);
+    const uint64_t quarter  = picture_buffer_size(scs_ptr, width >> 1, height >> 1, scs_ptr->sb_sz,
+                                                  scs_ptr->sb_sz, bytes, EB_TRUE);
+    const uint64_t sixteenth = picture_buffer_size(scs_ptr, width >> 2, height >> 2, scs_ptr->sb_sz >> 1,
+                                                   scs_ptr->sb_sz >> 1, bytes, EB_TRUE);
+    uint64_t size = picture_buffer_size(scs_ptr, width, height, pad, pad, bytes, EB_TRUE) + quarter + sixteenth;
+    if (scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED)
+        size += quarter + sixteenth;
+    if (scs_ptr->static_config.enable_global_motion)
+        size += 2 * MAX_CORNERS * sizeof(int);
+    return size;
+}
+
+static uint64_t estimate_memory_footprint(SequenceControlSet *scs_ptr) {
+    return scs_ptr->input_buffer_fifo_init_count * input_object_size(scs_ptr) +
+        scs_ptr->overlay_input_picture_buffer_init_count * input_object_size(scs_ptr) +
+        scs_ptr->picture_control_set_pool_init_count * parent_pcs_object_size(scs_ptr) +
+        scs_ptr->picture_control_set_pool_init_count_child * child_pcs_object_size(scs_ptr) +
+        scs_ptr->reference_picture_buffer_init_count * reference_object_size(scs_ptr) +
+        scs_ptr->pa_reference_picture_buffer_init_count * pa_reference_object_size(scs_ptr);
+}
+
 EbErrorType load_default_buffer_configuration_settings(
     SequenceControlSet       *scs_ptr){
     EbErrorType           return_error = EB_ErrorNone;
@@ -395,6 +502,10 @@ EbErrorType load_default_buffer_configuration_settings(
     if (scs_ptr->static_config.logical_processors != 0)
         core_count = scs_ptr->static_config.logical_processors < core_count ?
             scs_ptr->static_config.logical_processors: core_count;
+    // Channels running in the same process split the cores instead of each sizing its threads and
+    // pools for the whole machine
+    else if (scs_ptr->static_config.active_channel_count > 1)
+        core_count = MAX(core_count / scs_ptr->static_config.active_channel_count, 1);
 
 #ifdef _WIN32
     //Handle special case on Windows
@@ -547,6 +658,57 @@ EbErrorType load_default_buffer_configuration_settings(
         scs_ptr->overlay_input_picture_buffer_init_count   = MAX(min_overlay, scs_ptr->overlay_input_picture_buffer_init_count);
     }
 
+    //#====================== Memory budget ======================
+    scs_ptr->memory_footprint = estimate_memory_footprint(scs_ptr);
+    if (scs_ptr->static_config.max_memory_mb) {
+        const uint64_t budget  = (uint64_t)scs_ptr->static_config.max_memory_mb << 20;
+        const uint32_t mg_size = 1 << scs_ptr->static_config.hierarchical_levels;
+        const int32_t  ip_len  = scs_ptr->static_config.intra_period_length;
+        // VBR needs at least one mini-GOP of look-ahead to distribute the bits, constraint VBR
+        // distributes them over the whole intra period
+        const uint32_t min_lad = scs_ptr->static_config.rate_control_mode == 2 && ip_len >= 0 ?
+            (uint32_t)ip_len :
+            (scs_ptr->static_config.rate_control_mode == 1 ||
+             scs_ptr->static_config.rate_control_mode == 2) ? mg_size : 0;
+
+        // First give up the extra pictures kept in flight for throughput
+        if (scs_ptr->memory_footprint > budget) {
+            scs_ptr->input_buffer_fifo_init_count              = min_input;
+            scs_ptr->picture_control_set_pool_init_count       = min_parent;
+            scs_ptr->pa_reference_picture_buffer_init_count    = min_paref;
+            scs_ptr->reference_picture_buffer_init_count       = min_ref;
+            scs_ptr->picture_control_set_pool_init_count_child = min_child;
+            scs_ptr->overlay_input_picture_buffer_init_count   = min_overlay;
+            scs_ptr->output_recon_buffer_fifo_init_count       = scs_ptr->reference_picture_buffer_init_count;
+            scs_ptr->memory_footprint = estimate_memory_footprint(scs_ptr);
+        }
+        // Then shorten the look-ahead one mini-GOP at a time
+        while (scs_ptr->memory_footprint > budget &&
+               scs_ptr->static_config.look_ahead_distance > min_lad) {
+            const uint32_t lad     = scs_ptr->static_config.look_ahead_distance;
+            const uint32_t new_lad = lad > min_lad + mg_size ? lad - mg_size : min_lad;
+            const uint32_t removed = ((lad + mg_size - 1) / mg_size - (new_lad + mg_size - 1) / mg_size) * mg_size;
+
+            scs_ptr->static_config.look_ahead_distance = new_lad;
+            scs_ptr->input_buffer_fifo_init_count -= removed;
+            scs_ptr->picture_control_set_pool_init_count -= removed +
+                (scs_ptr->static_config.enable_overlays ? removed / mg_size : 0);
+            scs_ptr->memory_footprint = estimate_memory_footprint(scs_ptr);
+        }
+        // Constraint VBR cannot run with less look-ahead, the parameters are rejected
+        if (scs_ptr->memory_footprint > budget && scs_ptr->static_config.rate_control_mode == 2) {
+            SVT_LOG("Error Instance %u: MaxMemoryMb %u is below the minimum footprint of %u MB for rate control mode 2, its look ahead distance must cover the intra period \n",
+                    scs_ptr->static_config.channel_id + 1,
+                    scs_ptr->static_config.max_memory_mb,
+                    (uint32_t)((scs_ptr->memory_footprint + (1 << 20) - 1) >> 20));
+            return_error = EB_ErrorBadParameter;
+        }
+        else if (scs_ptr->memory_footprint > budget)
+            SVT_LOG("SVT [warning]: MaxMemoryMb %u is below the minimum footprint of %u MB for this configuration\n",
+                    scs_ptr->static_config.max_memory_mb,
+                    (uint32_t)((scs_ptr->memory_footprint + (1 << 20) - 1) >> 20));
+    }
+
     //#====================== Inter process Fifos ======================
     scs_ptr->resource_coordination_fifo_init_count       = 300;
     scs_ptr->picture_analysis_fifo_init_count            = 300;
@@ -718,19 +880,18 @@ static void eb_enc_handle_stop_threads(EbEncHandle *enc_handle_ptr)
     EB_DESTROY_THREAD(enc_handle_ptr->packetization_thread_handle);
 }
 /**********************************
-* Encoder Library Handle Deonstructor
+* Stops the threads and releases everything holding sequence state:
+* contexts, fifos, sequence control sets. The picture pools are kept.
 **********************************/
-static void eb_enc_handle_dctor(EbPtr p)
+static void eb_enc_handle_release_pipeline(EbEncHandle *enc_handle_ptr)
 {
-    EbEncHandle *enc_handle_ptr = (EbEncHandle *)p;
+    uint32_t instance_index;
 
+    // Nothing was built past a failed eb_svt_enc_reset()
+    if (!enc_handle_ptr->scs_instance_array || !enc_handle_ptr->scs_instance_array[0])
+        return;
     eb_enc_handle_stop_threads(enc_handle_ptr);
-    EB_FREE_PTR_ARRAY(enc_handle_ptr->app_callback_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE(enc_handle_ptr->scs_pool_ptr);
-    EB_DELETE_PTR_ARRAY(enc_handle_ptr->picture_parent_control_set_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
-
-    EB_DELETE_PTR_ARRAY(enc_handle_ptr->picture_control_set_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
-    EB_DELETE_PTR_ARRAY(enc_handle_ptr->pa_reference_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->overlay_input_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE(enc_handle_ptr->input_buffer_resource_ptr);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->output_stream_buffer_resource_ptr_array, enc_handle_ptr->encode_instance_total_count);
@@ -752,6 +913,7 @@ static void eb_enc_handle_dctor(EbPtr p)
 
     EB_DELETE(enc_handle_ptr->resource_coordination_context_ptr);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->picture_analysis_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->picture_analysis_process_init_count);
+    EB_DELETE(enc_handle_ptr->denoise_workers);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->motion_estimation_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->motion_estimation_process_init_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->source_based_operations_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->source_based_operations_process_init_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->mode_decision_configuration_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->mode_decision_configuration_process_init_count);
@@ -760,14 +922,33 @@ static void eb_enc_handle_dctor(EbPtr p)
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->cdef_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->cdef_process_init_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->rest_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->rest_process_init_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->entropy_coding_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->entropy_coding_process_init_count);
-    EB_DELETE_PTR_ARRAY(enc_handle_ptr->scs_instance_array, enc_handle_ptr->encode_instance_total_count);
+    for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index)
+        EB_DELETE(enc_handle_ptr->scs_instance_array[instance_index]);
     EB_DELETE(enc_handle_ptr->picture_decision_context_ptr);
     EB_DELETE(enc_handle_ptr->initial_rate_control_context_ptr);
     EB_DELETE(enc_handle_ptr->picture_manager_context_ptr);
     EB_DELETE(enc_handle_ptr->rate_control_context_ptr);
     EB_DELETE(enc_handle_ptr->packetization_context_ptr);
-    EB_DELETE_PTR_ARRAY(enc_handle_ptr->reference_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
+}
+
+/**********************************
+* Encoder Library Handle Deonstructor
+**********************************/
+static void eb_enc_handle_dctor(EbPtr p)
+{
+    EbEncHandle *enc_handle_ptr = (EbEncHandle *)p;
 
+    eb_enc_handle_release_pipeline(enc_handle_ptr);
+    if (enc_handle_ptr->shared_tables_acquired) {
+        eb_shared_tables_release();
+        enc_handle_ptr->shared_tables_acquired = EB_FALSE;
+    }
+    EB_FREE_PTR_ARRAY(enc_handle_ptr->app_callback_ptr_array, enc_handle_ptr->encode_instance_total_count);
+    EB_DELETE_PTR_ARRAY(enc_handle_ptr->picture_parent_control_set_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
+    EB_DELETE_PTR_ARRAY(enc_handle_ptr->picture_control_set_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
+    EB_DELETE_PTR_ARRAY(enc_handle_ptr->pa_reference_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
+    EB_DELETE_PTR_ARRAY(enc_handle_ptr->reference_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
+    EB_DELETE_PTR_ARRAY(enc_handle_ptr->scs_instance_array, enc_handle_ptr->encode_instance_total_count);
 }
 
 /**********************************
@@ -889,6 +1070,39 @@ EbErrorType rest_results_creator(
 }
 
 void init_fn_ptr(void);
+
+/**********************************
+* Creates a picture pool, or keeps the pool of the previous sequence
+* when it would be built identically (see eb_svt_enc_reset)
+**********************************/
+static EbErrorType picture_pool_ctor(
+    EbSystemResource **pool_ptr,
+    uint32_t           object_total_count,
+    uint32_t           producer_process_total_count,
+    uint32_t           consumer_process_total_count,
+    EbCreator          object_creator,
+    EbPtr              object_init_data_ptr,
+    size_t             object_init_data_size)
+{
+    if (*pool_ptr) {
+        if (eb_system_resource_reusable(*pool_ptr, object_total_count, producer_process_total_count,
+                consumer_process_total_count, object_creator, object_init_data_ptr,
+                object_init_data_size, NULL))
+            return eb_system_resource_reset(*pool_ptr);
+        EB_DELETE(*pool_ptr);
+    }
+    EB_NEW(
+        *pool_ptr,
+        eb_system_resource_lazy_ctor,
+        object_total_count,
+        producer_process_total_count,
+        consumer_process_total_count,
+        object_creator,
+        object_init_data_ptr,
+        object_init_data_size,
+        NULL);
+    return EB_ErrorNone;
+}
 extern void av1_init_wedge_masks(void);
 /**********************************
 * Initialize Encoder Library
@@ -926,6 +1140,14 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     eb_av1_init_me_luts();
     init_fn_ptr();
     av1_init_wedge_masks();
+
+    // Quantizer and quant matrix tables are shared by all the encoder handles of the process
+    if (!enc_handle_ptr->shared_tables_acquired) {
+        return_error = eb_shared_tables_acquire();
+        if (return_error != EB_ErrorNone)
+            return return_error;
+        enc_handle_ptr->shared_tables_acquired = EB_TRUE;
+    }
     /************************************
     * Sequence Control Set
     ************************************/
@@ -941,12 +1163,15 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     /************************************
     * Picture Control Set: Parent
     ************************************/
-    EB_ALLOC_PTR_ARRAY(enc_handle_ptr->picture_parent_control_set_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
+    if (!enc_handle_ptr->picture_parent_control_set_pool_ptr_array)
+        EB_ALLOC_PTR_ARRAY(enc_handle_ptr->picture_parent_control_set_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
 
     for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
         // The segment Width & Height Arrays are in units of SBs, not samples
         PictureControlSetInitData input_data;
 
+        // Zeroed so that the pool of the previous sequence can be matched byte-wise
+        memset(&input_data, 0, sizeof(input_data));
         input_data.picture_width = enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->max_input_luma_width;
         input_data.picture_height = enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->max_input_luma_height;
         input_data.left_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->left_padding;
@@ -967,27 +1192,30 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         input_data.ext_block_flag = (uint8_t)enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->static_config.ext_block_flag;
         input_data.mrp_mode = enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->mrp_mode;
         input_data.nsq_present = enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->nsq_present;
-        EB_NEW(
-            enc_handle_ptr->picture_parent_control_set_pool_ptr_array[instance_index],
-            eb_system_resource_ctor,
+        return_error = picture_pool_ctor(
+            &enc_handle_ptr->picture_parent_control_set_pool_ptr_array[instance_index],
             enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->picture_control_set_pool_init_count,//enc_handle_ptr->pcs_pool_total_count,
             1,
             0,
             picture_parent_control_set_creator,
             &input_data,
-            NULL);
+            sizeof(input_data));
+        if (return_error != EB_ErrorNone)
+            return return_error;
     }
 
     /************************************
     * Picture Control Set: Child
     ************************************/
-    EB_ALLOC_PTR_ARRAY(enc_handle_ptr->picture_control_set_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
+    if (!enc_handle_ptr->picture_control_set_pool_ptr_array)
+        EB_ALLOC_PTR_ARRAY(enc_handle_ptr->picture_control_set_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
 
     for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
         // The segment Width & Height Arrays are in units of SBs, not samples
         PictureControlSetInitData input_data;
         unsigned i;
 
+        memset(&input_data, 0, sizeof(input_data));
         input_data.enc_dec_segment_col = 0;
         input_data.enc_dec_segment_row = 0;
         for (i = 0; i <= enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->static_config.hierarchical_levels; ++i) {
@@ -1015,15 +1243,16 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         input_data.cdf_mode = enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->cdf_mode;
         input_data.mfmv = enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->mfmv_enabled;
         input_data.cfg_palette = enc_handle_ptr->scs_instance_array[0]->scs_ptr->static_config.screen_content_mode;
-        EB_NEW(
-            enc_handle_ptr->picture_control_set_pool_ptr_array[instance_index],
-            eb_system_resource_ctor,
+        return_error = picture_pool_ctor(
+            &enc_handle_ptr->picture_control_set_pool_ptr_array[instance_index],
             enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->picture_control_set_pool_init_count_child, //EB_PictureControlSetPoolInitCountChild,
             1,
             0,
             picture_control_set_creator,
             &input_data,
-            NULL);
+            sizeof(input_data));
+        if (return_error != EB_ErrorNone)
+            return return_error;
     }
 
     /************************************
@@ -1031,8 +1260,10 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     ************************************/
 
     // Allocate Resource Arrays
-    EB_ALLOC_PTR_ARRAY(enc_handle_ptr->reference_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
-    EB_ALLOC_PTR_ARRAY(enc_handle_ptr->pa_reference_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
+    if (!enc_handle_ptr->reference_picture_pool_ptr_array)
+        EB_ALLOC_PTR_ARRAY(enc_handle_ptr->reference_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
+    if (!enc_handle_ptr->pa_reference_picture_pool_ptr_array)
+        EB_ALLOC_PTR_ARRAY(enc_handle_ptr->pa_reference_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
 
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->overlay_input_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
 
@@ -1051,6 +1282,11 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         EbPictureBufferDescInitData       ref_pic_buf_desc_init_data;
         EbPictureBufferDescInitData       quart_pic_buf_desc_init_data;
         EbPictureBufferDescInitData       sixteenth_pic_buf_desc_init_data;
+        memset(&eb_ref_obj_ect_desc_init_data_structure, 0, sizeof(eb_ref_obj_ect_desc_init_data_structure));
+        memset(&eb_pa_ref_obj_ect_desc_init_data_structure, 0, sizeof(eb_pa_ref_obj_ect_desc_init_data_structure));
+        memset(&ref_pic_buf_desc_init_data, 0, sizeof(ref_pic_buf_desc_init_data));
+        memset(&quart_pic_buf_desc_init_data, 0, sizeof(quart_pic_buf_desc_init_data));
+        memset(&sixteenth_pic_buf_desc_init_data, 0, sizeof(sixteenth_pic_buf_desc_init_data));
         // Initialize the various Picture types
         ref_pic_buf_desc_init_data.max_width = enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->max_input_luma_width;
         ref_pic_buf_desc_init_data.max_height = enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->max_input_luma_height;
@@ -1069,17 +1305,20 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             ref_pic_buf_desc_init_data.bit_depth = EB_10BIT;
 
         eb_ref_obj_ect_desc_init_data_structure.reference_picture_desc_init_data = ref_pic_buf_desc_init_data;
+        eb_ref_obj_ect_desc_init_data_structure.compressed_reference =
+            (EbBool)(COMPRESSED_REF_DISTANCE && !is_16bit);
 
         // Reference Picture Buffers
-        EB_NEW(
-            enc_handle_ptr->reference_picture_pool_ptr_array[instance_index],
-            eb_system_resource_ctor,
+        return_error = picture_pool_ctor(
+            &enc_handle_ptr->reference_picture_pool_ptr_array[instance_index],
             enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->reference_picture_buffer_init_count,//enc_handle_ptr->ref_pic_pool_total_count,
             EB_PictureManagerProcessInitCount,
             0,
             eb_reference_object_creator,
             &(eb_ref_obj_ect_desc_init_data_structure),
-            NULL);
+            sizeof(eb_ref_obj_ect_desc_init_data_structure));
+        if (return_error != EB_ErrorNone)
+            return return_error;
 
         // PA Reference Picture Buffers
         // Currently, only Luma samples are needed in the PA
@@ -1120,15 +1359,23 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         eb_pa_ref_obj_ect_desc_init_data_structure.reference_picture_desc_init_data = ref_pic_buf_desc_init_data;
         eb_pa_ref_obj_ect_desc_init_data_structure.quarter_picture_desc_init_data = quart_pic_buf_desc_init_data;
         eb_pa_ref_obj_ect_desc_init_data_structure.sixteenth_picture_desc_init_data = sixteenth_pic_buf_desc_init_data;
+        // Corners are only kept when a picture can be encoded at a preset searching global motion
+        SequenceControlSet *scs_ptr = enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr;
+        eb_pa_ref_obj_ect_desc_init_data_structure.gm_corners = (EbBool)(
+            scs_ptr->static_config.enable_global_motion &&
+            (scs_ptr->static_config.enc_mode <= ENC_M1 || scs_ptr->static_config.speed_control_flag ||
+             (scs_ptr->use_output_stat_file && scs_ptr->static_config.snd_pass_enc_mode <= ENC_M1)));
         // Reference Picture Buffers
-        EB_NEW(enc_handle_ptr->pa_reference_picture_pool_ptr_array[instance_index],
-            eb_system_resource_ctor,
+        return_error = picture_pool_ctor(
+            &enc_handle_ptr->pa_reference_picture_pool_ptr_array[instance_index],
             enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->pa_reference_picture_buffer_init_count,
             EB_PictureDecisionProcessInitCount,
             0,
             eb_pa_reference_object_creator,
             &(eb_pa_ref_obj_ect_desc_init_data_structure),
-            NULL);
+            sizeof(eb_pa_ref_obj_ect_desc_init_data_structure));
+        if (return_error != EB_ErrorNone)
+            return return_error;
         // Set the SequenceControlSet Picture Pool Fifo Ptrs
         enc_handle_ptr->scs_instance_array[instance_index]->encode_context_ptr->reference_picture_pool_fifo_ptr = eb_system_resource_get_producer_fifo(enc_handle_ptr->reference_picture_pool_ptr_array[instance_index], 0);
         enc_handle_ptr->scs_instance_array[instance_index]->encode_context_ptr->pa_reference_picture_pool_fifo_ptr = eb_system_resource_get_producer_fifo(enc_handle_ptr->pa_reference_picture_pool_ptr_array[instance_index], 0);
@@ -1137,12 +1384,13 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             // Overlay Input Picture Buffers
             EB_NEW(
                 enc_handle_ptr->overlay_input_picture_pool_ptr_array[instance_index],
-                eb_system_resource_ctor,
+                eb_system_resource_lazy_ctor,
                 enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr->overlay_input_picture_buffer_init_count,
                 1,
                 0,
                 eb_input_buffer_header_creator,
                 enc_handle_ptr->scs_instance_array[instance_index]->scs_ptr,
+                0,
                 eb_input_buffer_header_destroyer);
            // Set the SequenceControlSet Overlay input Picture Pool Fifo Ptrs
             enc_handle_ptr->scs_instance_array[instance_index]->encode_context_ptr->overlay_input_picture_pool_fifo_ptr = eb_system_resource_get_producer_fifo(enc_handle_ptr->overlay_input_picture_pool_ptr_array[instance_index], 0);
@@ -1156,12 +1404,13 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     // EbBufferHeaderType Input
     EB_NEW(
         enc_handle_ptr->input_buffer_resource_ptr,
-        eb_system_resource_ctor,
+        eb_system_resource_lazy_ctor,
         enc_handle_ptr->scs_instance_array[0]->scs_ptr->input_buffer_fifo_init_count,
         1,
         EB_ResourceCoordinationProcessInitCount,
         eb_input_buffer_header_creator,
         enc_handle_ptr->scs_instance_array[0]->scs_ptr,
+        0,
         eb_input_buffer_header_destroyer);
 
     enc_handle_ptr->input_buffer_producer_fifo_ptr = eb_system_resource_get_producer_fifo(enc_handle_ptr->input_buffer_resource_ptr, 0);
@@ -1438,6 +1687,14 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         resource_coordination_context_ctor,
         enc_handle_ptr);
 
+    // Film Grain Denoiser Workers
+    if (enc_handle_ptr->scs_instance_array[0]->scs_ptr->film_grain_denoise_strength) {
+        EB_NEW(
+            enc_handle_ptr->denoise_workers,
+            denoise_workers_ctor,
+            enc_handle_ptr->scs_instance_array[0]->scs_ptr->picture_analysis_process_init_count);
+    }
+
     // Picture Analysis Context
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->picture_analysis_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->picture_analysis_process_init_count);
 
@@ -1679,6 +1936,37 @@ EB_API EbErrorType eb_deinit_encoder(EbComponentType *svt_enc_component){
     return EB_ErrorNone;
 }
 
+/**********************************
+* Restart the Encoder Library on a new sequence
+**********************************/
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_enc_reset(
+    EbComponentType          *svt_enc_component,
+    EbSvtAv1EncConfiguration *config_ptr)
+{
+    if (svt_enc_component == NULL || config_ptr == NULL)
+        return EB_ErrorBadParameter;
+    EbEncHandle *enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
+    EbErrorType  return_error;
+
+    if (enc_handle_ptr->stream_in_progress) {
+        SVT_ERROR("eb_svt_enc_reset: the EOS packet of the current sequence was not received\n");
+        return EB_ErrorUndefined;
+    }
+
+    // The threads, contexts and fifos carry the state of the finished sequence, rebuild them.
+    // The picture pools are matched against the new configuration in eb_init_encoder().
+    eb_enc_handle_release_pipeline(enc_handle_ptr);
+    EB_NEW(enc_handle_ptr->scs_instance_array[0], eb_sequence_control_set_instance_ctor);
+
+    return_error = eb_svt_enc_set_parameter(svt_enc_component, config_ptr);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    return eb_init_encoder(svt_enc_component);
+}
+
 EbErrorType eb_svt_enc_init_parameter(
     EbSvtAv1EncConfiguration * config_ptr);
 
@@ -1705,6 +1993,7 @@ EB_API EbErrorType eb_init_handle(
         if(lp_group == NULL) {
             EB_MALLOC(lp_group, INITIAL_PROCESSOR_GROUP * sizeof(processorGroup));
         }
+        lp_group_users++;
     #endif
 
     *p_handle = (EbComponentType*)malloc(sizeof(EbComponentType));
@@ -1763,7 +2052,8 @@ EB_API EbErrorType eb_deinit_handle(
 
         free(svt_enc_component);
 #if  defined(__linux__)
-        EB_FREE(lp_group);
+        if (lp_group_users && !--lp_group_users)
+            EB_FREE(lp_group);
 #endif
         eb_decrease_component_count();
     }
@@ -1815,7 +2105,8 @@ void set_default_configuration_parameters(
 static uint32_t compute_default_look_ahead(
     EbSvtAv1EncConfiguration*   config){
     int32_t lad = 0;
-    if (config->rate_control_mode == 0 || config->intra_period_length < 0)
+    if (config->rate_control_mode == 0 || config->rate_control_mode == 3 ||
+        config->intra_period_length < 0)
         lad = (2 << config->hierarchical_levels)+1;
     else
         lad = config->intra_period_length;
@@ -1835,9 +2126,9 @@ static uint32_t cap_look_ahead_distance(
         uint32_t max_cqp_lad = (2 << config->hierarchical_levels) + 1;
         uint32_t max_rc_lad  = fps << 1;
         lad = config->look_ahead_distance;
-        if (config->rate_control_mode == 0 && lad > max_cqp_lad)
+        if ((config->rate_control_mode == 0 || config->rate_control_mode == 3) && lad > max_cqp_lad)
             lad = max_cqp_lad;
-        else if (config->rate_control_mode != 0 && lad > max_rc_lad)
+        else if ((config->rate_control_mode == 1 || config->rate_control_mode == 2) && lad > max_rc_lad)
             lad = max_rc_lad;
     }
 
@@ -1846,11 +2137,48 @@ static uint32_t cap_look_ahead_distance(
     return lad;
 }
 
+// The fast first pass only keeps the analysis statistics: it codes the input at half resolution,
+// with the coding stages at their cheapest settings. Every setting it changes is reported.
+static void set_fast_first_pass_settings(SequenceControlSet *scs_ptr)
+{
+    EbSvtAv1EncConfiguration *config      = &scs_ptr->static_config;
+    uint32_t                  half_width  = (scs_ptr->max_input_luma_width >> 1) & ~1;
+    uint32_t                  half_height = (scs_ptr->max_input_luma_height >> 1) & ~1;
+
+    if (half_width >= 64 && half_height >= 64) {
+        SVT_LOG("SVT [Warning]: the fast first pass codes the %ux%u input at %ux%u\n",
+            scs_ptr->max_input_luma_width, scs_ptr->max_input_luma_height, half_width, half_height);
+        scs_ptr->first_pass_downscale = EB_TRUE;
+        scs_ptr->max_input_luma_width = half_width;
+        scs_ptr->max_input_luma_height = half_height;
+    }
+    if (config->enc_mode != MAX_ENC_PRESET) {
+        SVT_LOG("SVT [Warning]: the fast first pass uses EncoderMode %d instead of %d\n",
+            MAX_ENC_PRESET, config->enc_mode);
+        config->enc_mode = MAX_ENC_PRESET;
+    }
+    if (!config->disable_dlf_flag) {
+        SVT_LOG("SVT [Warning]: the fast first pass turns the deblocking filter off\n");
+        config->disable_dlf_flag = EB_TRUE;
+    }
+    if (config->enable_restoration_filtering) {
+        SVT_LOG("SVT [Warning]: the fast first pass turns the restoration filter off\n");
+        config->enable_restoration_filtering = 0;
+    }
+    if (config->enable_altrefs) {
+        SVT_LOG("SVT [Warning]: the fast first pass turns the altrefs off\n");
+        config->enable_altrefs = EB_FALSE;
+    }
+}
+
 void set_param_based_on_input(SequenceControlSet *scs_ptr)
 {
     uint16_t subsampling_x = scs_ptr->subsampling_x;
     uint16_t subsampling_y = scs_ptr->subsampling_y;
 
+    if (scs_ptr->use_output_first_pass_stats)
+        set_fast_first_pass_settings(scs_ptr);
+
     // Update picture width, and picture height
     if (scs_ptr->max_input_luma_width % MIN_BLOCK_SIZE) {
         scs_ptr->max_input_pad_right = MIN_BLOCK_SIZE - (scs_ptr->max_input_luma_width % MIN_BLOCK_SIZE);
@@ -1885,7 +2213,7 @@ void set_param_based_on_input(SequenceControlSet *scs_ptr)
     else
         scs_ptr->static_config.super_block_size = (scs_ptr->static_config.enc_mode <= ENC_M3 && scs_ptr->input_resolution >= INPUT_SIZE_1080i_RANGE) ? 128 : 64;
 
-    scs_ptr->static_config.super_block_size = (scs_ptr->static_config.rate_control_mode > 0) ? 64 : scs_ptr->static_config.super_block_size;
+    scs_ptr->static_config.super_block_size = (scs_ptr->static_config.rate_control_mode == 1 || scs_ptr->static_config.rate_control_mode == 2) ? 64 : scs_ptr->static_config.super_block_size;
    // scs_ptr->static_config.hierarchical_levels = (scs_ptr->static_config.rate_control_mode > 1) ? 3 : scs_ptr->static_config.hierarchical_levels;
     // Configure the padding
     scs_ptr->left_padding = BLOCK_SIZE_64 + 4;
@@ -1894,7 +2222,7 @@ void set_param_based_on_input(SequenceControlSet *scs_ptr)
     scs_ptr->bot_padding = scs_ptr->static_config.super_block_size + 4;
     scs_ptr->static_config.enable_overlays = scs_ptr->static_config.enable_altrefs == EB_FALSE ||
         (scs_ptr->static_config.altref_nframes <= 1) ||
-        (scs_ptr->static_config.rate_control_mode > 0) ||
+        (scs_ptr->static_config.rate_control_mode == 1 || scs_ptr->static_config.rate_control_mode == 2) ||
         scs_ptr->static_config.encoder_bit_depth != EB_8BIT ?
         0 : scs_ptr->static_config.enable_overlays;
 
@@ -2003,8 +2331,15 @@ void copy_api_from_app(
     scs_ptr->static_config.use_qp_file = ((EbSvtAv1EncConfiguration*)config_struct)->use_qp_file;
     scs_ptr->static_config.input_stat_file = ((EbSvtAv1EncConfiguration*)config_struct)->input_stat_file;
     scs_ptr->static_config.output_stat_file = ((EbSvtAv1EncConfiguration*)config_struct)->output_stat_file;
+    scs_ptr->static_config.fast_first_pass = ((EbSvtAv1EncConfiguration*)config_struct)->fast_first_pass;
+    // The input file format is probed in eb_svt_enc_set_parameter(), once the settings are verified
+    scs_ptr->use_input_first_pass_stats = EB_FALSE;
+    scs_ptr->first_pass_downscale = EB_FALSE;
+    scs_ptr->use_output_first_pass_stats =
+        scs_ptr->static_config.output_stat_file && scs_ptr->static_config.fast_first_pass ? 1 : 0;
     scs_ptr->use_input_stat_file = scs_ptr->static_config.input_stat_file ? 1 : 0;
-    scs_ptr->use_output_stat_file = scs_ptr->static_config.output_stat_file ? 1 : 0;
+    scs_ptr->use_output_stat_file =
+        scs_ptr->static_config.output_stat_file && !scs_ptr->use_output_first_pass_stats ? 1 : 0;
     // Deblock Filter
     scs_ptr->static_config.disable_dlf_flag = ((EbSvtAv1EncConfiguration*)config_struct)->disable_dlf_flag;
 
@@ -2122,6 +2457,8 @@ void copy_api_from_app(
 
     scs_ptr->static_config.vbv_bufsize = ((EbSvtAv1EncConfiguration*)config_struct)->vbv_bufsize;
 
+    scs_ptr->static_config.max_bit_rate = ((EbSvtAv1EncConfiguration*)config_struct)->max_bit_rate;
+
     scs_ptr->static_config.max_qp_allowed = (scs_ptr->static_config.rate_control_mode) ?
         ((EbSvtAv1EncConfiguration*)config_struct)->max_qp_allowed :
         63;
@@ -2169,6 +2506,7 @@ void copy_api_from_app(
     scs_ptr->static_config.active_channel_count = ((EbSvtAv1EncConfiguration*)config_struct)->active_channel_count;
     scs_ptr->static_config.logical_processors = ((EbSvtAv1EncConfiguration*)config_struct)->logical_processors;
     scs_ptr->static_config.unpin_lp1 = ((EbSvtAv1EncConfiguration*)config_struct)->unpin_lp1;
+    scs_ptr->static_config.max_memory_mb = ((EbSvtAv1EncConfiguration*)config_struct)->max_memory_mb;
     scs_ptr->static_config.target_socket = ((EbSvtAv1EncConfiguration*)config_struct)->target_socket;
     scs_ptr->static_config.qp = ((EbSvtAv1EncConfiguration*)config_struct)->qp;
     scs_ptr->static_config.recon_enabled = ((EbSvtAv1EncConfiguration*)config_struct)->recon_enabled;
@@ -2252,6 +2590,22 @@ static EbErrorType verify_settings(
         SVT_LOG("Error instance %u: Second pass encoder mode must be in the range of [0-%d]\n", channel_number + 1, MAX_ENC_PRESET + 1);
         return_error = EB_ErrorBadParameter;
     }
+    if (config->fast_first_pass > 1) {
+        SVT_LOG("Error instance %u: Invalid fast first pass flag [0 - 1], your input: %d\n", channel_number + 1, config->fast_first_pass);
+        return_error = EB_ErrorBadParameter;
+    }
+    if (config->fast_first_pass && config->output_stat_file == NULL) {
+        SVT_LOG("Error instance %u: The fast first pass requires an output stat file\n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+    if (config->fast_first_pass && config->recon_enabled) {
+        SVT_LOG("Error instance %u: The fast first pass has no recon output\n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+    if (config->fast_first_pass && config->encoder_bit_depth > EB_8BIT && config->compressed_ten_bit_format) {
+        SVT_LOG("Error instance %u: The fast first pass does not support the compressed ten bit format\n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
     if (config->ext_block_flag > 1) {
         SVT_LOG("Error instance %u: ExtBlockFlag must be [0-1]\n", channel_number + 1);
         return_error = EB_ErrorBadParameter;
@@ -2412,13 +2766,23 @@ static EbErrorType verify_settings(
         SVT_LOG("Error Instance %u: The intra period must be [-2 - 255] \n", channel_number + 1);
         return_error = EB_ErrorBadParameter;
     }
-    if (config->rate_control_mode > 2) {
+    if (config->rate_control_mode > 3) {
 
-        SVT_LOG("Error Instance %u: The rate control mode must be [0 - 2] \n", channel_number + 1);
+        SVT_LOG("Error Instance %u: The rate control mode must be [0 - 3] \n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+    if (config->rate_control_mode == 2 && config->look_ahead_distance != (uint32_t)config->intra_period_length && config->intra_period_length >= 0) {
+        SVT_LOG("Error Instance %u: The rate control mode 2 LAD must be equal to intra_period \n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+    if (config->rate_control_mode == 3 && config->max_bit_rate == 0 && config->vbv_bufsize > 0) {
+        SVT_LOG("Error Instance %u: The rate control mode 3 VBV buffer requires a max bitrate \n", channel_number + 1);
         return_error = EB_ErrorBadParameter;
     }
-    if ((config->rate_control_mode == 3|| config->rate_control_mode == 2) && config->look_ahead_distance != (uint32_t)config->intra_period_length && config->intra_period_length >= 0) {
-        SVT_LOG("Error Instance %u: The rate control mode 2/3 LAD must be equal to intra_period \n", channel_number + 1);
+    if (config->rate_control_mode == 3 &&
+        (config->qp < config->min_qp_allowed || config->qp > config->max_qp_allowed)) {
+        SVT_LOG("Error Instance %u: The rate control mode 3 quality level (QP) must be [MinQpAllowed (%u) - MaxQpAllowed (%u)] \n",
+                channel_number + 1, config->min_qp_allowed, config->max_qp_allowed);
         return_error = EB_ErrorBadParameter;
     }
     if (config->look_ahead_distance > MAX_LAD && config->look_ahead_distance != (uint32_t)~0) {
@@ -2724,11 +3088,13 @@ EbErrorType eb_svt_enc_init_parameter(
     config_ptr->rate_control_mode = 0;
     config_ptr->look_ahead_distance = (uint32_t)~0;
     config_ptr->target_bit_rate = 7000000;
+    config_ptr->max_bit_rate = 0;
     config_ptr->max_qp_allowed = 63;
     config_ptr->min_qp_allowed = 10;
     config_ptr->base_layer_switch_mode = 0;
     config_ptr->enc_mode = MAX_ENC_PRESET;
     config_ptr->snd_pass_enc_mode = MAX_ENC_PRESET + 1;
+    config_ptr->fast_first_pass = 0;
     config_ptr->intra_period_length = -2;
     config_ptr->intra_refresh_type = 1;
     config_ptr->hierarchical_levels = 4;
@@ -2817,6 +3183,7 @@ EbErrorType eb_svt_enc_init_parameter(
     // Channel info
     config_ptr->logical_processors = 0;
     config_ptr->unpin_lp1 = 1;
+    config_ptr->max_memory_mb = 0;
     config_ptr->target_socket = -1;
     config_ptr->channel_id = 0;
     config_ptr->active_channel_count = 1;
@@ -2882,8 +3249,12 @@ static void print_lib_params(
         SVT_LOG("\nSVT [config]: RCMode / TargetBitrate (kbps)/ LookaheadDistance / SceneChange\t\t: VBR / %d / %d / %d ", (int)config->target_bit_rate/1000, config->look_ahead_distance, config->scene_change_detection);
     else if (config->rate_control_mode == 2)
         SVT_LOG("\nSVT [config]: RCMode / TargetBitrate (kbps)/ LookaheadDistance / SceneChange\t\t: Constraint VBR / %d / %d / %d ", (int)config->target_bit_rate/1000, config->look_ahead_distance, config->scene_change_detection);
+    else if (config->rate_control_mode == 3)
+        SVT_LOG("\nSVT [config]: RCMode / CRF / MaxBitrate (kbps)/ LookaheadDistance / SceneChange\t: CRF / %d / %d / %d / %d ", scs->static_config.qp, (int)config->max_bit_rate/1000, config->look_ahead_distance, config->scene_change_detection);
     else
         SVT_LOG("\nSVT [config]: BRC Mode / QP  / LookaheadDistance / SceneChange\t\t\t: CQP / %d / %d / %d ", scs->static_config.qp, config->look_ahead_distance, config->scene_change_detection);
+    if (config->max_memory_mb)
+        SVT_LOG("\nSVT [config]: MaxMemoryMb / EstimatedPoolMemory (MB)\t\t\t\t\t: %d / %d ", config->max_memory_mb, (int)(scs->memory_footprint >> 20));
 #ifdef DEBUG_BUFFERS
     SVT_LOG("\nSVT [config]: INPUT / OUTPUT \t\t\t\t\t\t\t: %d / %d", scs->input_buffer_fifo_init_count, scs->output_stream_buffer_fifo_init_count);
     SVT_LOG("\nSVT [config]: CPCS / PAREF / REF \t\t\t\t\t\t: %d / %d / %d", scs->picture_control_set_pool_init_count_child, scs->pa_reference_picture_buffer_init_count, scs->reference_picture_buffer_init_count);
@@ -2957,6 +3328,20 @@ EB_API EbErrorType eb_svt_enc_set_parameter(
 
     if (return_error == EB_ErrorBadParameter)
         return EB_ErrorBadParameter;
+
+    // The statistics files are accessed at the source resolution, before the fast first pass halves it
+    if (enc_handle->scs_instance_array[instance_index]->scs_ptr->use_output_first_pass_stats)
+        write_first_pass_stats_header(enc_handle->scs_instance_array[instance_index]->scs_ptr);
+    if (first_pass_stats_detect(enc_handle->scs_instance_array[instance_index]->scs_ptr->static_config.input_stat_file)) {
+        enc_handle->scs_instance_array[instance_index]->scs_ptr->use_input_first_pass_stats = EB_TRUE;
+        enc_handle->scs_instance_array[instance_index]->scs_ptr->use_input_stat_file = EB_FALSE;
+        return_error = load_first_pass_stats(enc_handle->scs_instance_array[instance_index]->scs_ptr);
+        if (return_error != EB_ErrorNone) {
+            eb_release_mutex(enc_handle->scs_instance_array[instance_index]->config_mutex);
+            return return_error;
+        }
+    }
+
     set_param_based_on_input(
         enc_handle->scs_instance_array[instance_index]->scs_ptr);
 
@@ -2991,6 +3376,21 @@ EB_API EbErrorType eb_svt_enc_set_parameter(
 #ifdef __GNUC__
 __attribute__((visibility("default")))
 #endif
+EB_API EbErrorType eb_svt_enc_get_memory_footprint(
+    EbComponentType           *svt_enc_component,
+    uint64_t                  *footprint_bytes)
+{
+    if (svt_enc_component == NULL || footprint_bytes == NULL)
+        return EB_ErrorBadParameter;
+
+    EbEncHandle *enc_handle = (EbEncHandle*)svt_enc_component->p_component_private;
+    *footprint_bytes = enc_handle->scs_instance_array[0]->scs_ptr->memory_footprint;
+
+    return EB_ErrorNone;
+}
+#ifdef __GNUC__
+__attribute__((visibility("default")))
+#endif
 EB_API EbErrorType eb_svt_enc_stream_header(
     EbComponentType           *svt_enc_component,
     EbBufferHeaderType        **output_stream_ptr)
@@ -3068,6 +3468,81 @@ EB_API EbErrorType eb_svt_enc_eos_nal(
     return return_error;
 }
 
+/***********************************************
+**** Average each 2x2 block of the source
+**** into one sample of the destination
+************************************************/
+static void downscale_plane(
+    const uint8_t *src, uint32_t src_stride, uint8_t *dst, uint32_t dst_stride,
+    uint32_t width, uint32_t height)
+{
+    for (uint32_t y = 0; y < height; y++) {
+        const uint8_t *src0 = src + 2 * y * src_stride;
+        const uint8_t *src1 = src0 + src_stride;
+        for (uint32_t x = 0; x < width; x++)
+            dst[y * dst_stride + x] = (uint8_t)(
+                (src0[2 * x] + src0[2 * x + 1] + src1[2 * x] + src1[2 * x + 1] + 2) >> 2);
+    }
+}
+
+// 10-bit version, split in the 8 msb and the 2 lsb planes as un_pack2d() does. The input is
+// unpacked 16-bit, verify_settings rejects the compressed ten bit format with the fast first pass
+static void downscale_plane_16bit(
+    const uint16_t *src, uint32_t src_stride, uint8_t *dst, uint32_t dst_stride,
+    uint8_t *dst_bit_inc, uint32_t bit_inc_stride, uint32_t width, uint32_t height)
+{
+    for (uint32_t y = 0; y < height; y++) {
+        const uint16_t *src0 = src + 2 * y * src_stride;
+        const uint16_t *src1 = src0 + src_stride;
+        for (uint32_t x = 0; x < width; x++) {
+            uint16_t sample = (uint16_t)(
+                (src0[2 * x] + src0[2 * x + 1] + src1[2 * x] + src1[2 * x + 1] + 2) >> 2);
+            dst[y * dst_stride + x] = (uint8_t)(sample >> 2);
+            dst_bit_inc[y * bit_inc_stride + x] = (uint8_t)(sample << 6);
+        }
+    }
+}
+
+/***********************************************
+**** Downscale the input buffer of the
+**** fast first pass to half resolution
+************************************************/
+static void downscale_frame_buffer(
+    SequenceControlSet            *scs_ptr,
+    EbPictureBufferDesc           *input_picture_ptr,
+    EbSvtIOFormat                 *input_ptr)
+{
+    uint32_t luma_buffer_offset = input_picture_ptr->stride_y * scs_ptr->top_padding + scs_ptr->left_padding;
+    uint32_t chroma_buffer_offset = input_picture_ptr->stride_cr * (scs_ptr->top_padding >> 1) + (scs_ptr->left_padding >> 1);
+    uint32_t luma_width = input_picture_ptr->width - scs_ptr->max_input_pad_right;
+    uint32_t luma_height = input_picture_ptr->height - scs_ptr->max_input_pad_bottom;
+
+    if (scs_ptr->static_config.encoder_bit_depth > EB_8BIT) {
+        downscale_plane_16bit((uint16_t*)input_ptr->luma, input_ptr->y_stride,
+            input_picture_ptr->buffer_y + luma_buffer_offset, input_picture_ptr->stride_y,
+            input_picture_ptr->buffer_bit_inc_y + luma_buffer_offset, input_picture_ptr->stride_bit_inc_y,
+            luma_width, luma_height);
+        downscale_plane_16bit((uint16_t*)input_ptr->cb, input_ptr->cb_stride,
+            input_picture_ptr->buffer_cb + chroma_buffer_offset, input_picture_ptr->stride_cb,
+            input_picture_ptr->buffer_bit_inc_cb + chroma_buffer_offset, input_picture_ptr->stride_bit_inc_cb,
+            luma_width >> 1, luma_height >> 1);
+        downscale_plane_16bit((uint16_t*)input_ptr->cr, input_ptr->cr_stride,
+            input_picture_ptr->buffer_cr + chroma_buffer_offset, input_picture_ptr->stride_cr,
+            input_picture_ptr->buffer_bit_inc_cr + chroma_buffer_offset, input_picture_ptr->stride_bit_inc_cr,
+            luma_width >> 1, luma_height >> 1);
+    } else {
+        downscale_plane(input_ptr->luma, input_ptr->y_stride,
+            input_picture_ptr->buffer_y + luma_buffer_offset, input_picture_ptr->stride_y,
+            luma_width, luma_height);
+        downscale_plane(input_ptr->cb, input_ptr->cb_stride,
+            input_picture_ptr->buffer_cb + chroma_buffer_offset, input_picture_ptr->stride_cb,
+            luma_width >> 1, luma_height >> 1);
+        downscale_plane(input_ptr->cr, input_ptr->cr_stride,
+            input_picture_ptr->buffer_cr + chroma_buffer_offset, input_picture_ptr->stride_cr,
+            luma_width >> 1, luma_height >> 1);
+    }
+}
+
 /***********************************************
 **** Copy the input buffer from the
 **** sample application to the library buffers
@@ -3087,7 +3562,9 @@ static EbErrorType copy_frame_buffer(
 
     // Need to include for Interlacing on the fly with pictureScanType = 1
 
-    if (!is_16bit_input) {
+    if (scs_ptr->first_pass_downscale)
+        downscale_frame_buffer(scs_ptr, input_picture_ptr, input_ptr);
+    else if (!is_16bit_input) {
         uint32_t     luma_buffer_offset = (input_picture_ptr->stride_y*scs_ptr->top_padding + scs_ptr->left_padding) << is_16bit_input;
         uint32_t     chroma_buffer_offset = (input_picture_ptr->stride_cr*(scs_ptr->top_padding >> 1) + (scs_ptr->left_padding >> 1)) << is_16bit_input;
         uint16_t     luma_stride = input_picture_ptr->stride_y << is_16bit_input;
@@ -3258,10 +3735,14 @@ EB_API EbErrorType eb_svt_enc_send_picture(
     EbEncHandle          *enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
     EbObjectWrapper      *eb_wrapper_ptr;
 
+    enc_handle_ptr->stream_in_progress = EB_TRUE;
+
     // Take the buffer and put it into our internal queue structure
-    eb_get_empty_object(
+    EbErrorType return_error = eb_get_empty_object(
         enc_handle_ptr->input_buffer_producer_fifo_ptr,
         &eb_wrapper_ptr);
+    if (return_error != EB_ErrorNone)
+        return return_error;
 
     if (p_buffer != NULL) {
         copy_input_buffer(
@@ -3323,6 +3804,8 @@ EB_API EbErrorType eb_svt_get_packet(
         packet = (EbBufferHeaderType*)eb_wrapper_ptr->object_ptr;
         if ( packet->flags & 0xfffffff0 )
             return_error = EB_ErrorMax;
+        if (packet->flags & EB_BUFFERFLAG_EOS)
+            enc_handle->stream_in_progress = EB_FALSE;
         // return the output stream buffer
         *p_buffer = packet;
 
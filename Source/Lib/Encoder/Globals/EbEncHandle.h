@@ -12,6 +12,7 @@
 #include "EbSystemResourceManager.h"
 #include "EbSequenceControlSet.h"
 #include "EbObject.h"
+#include "EbDenoiseWorkers.h"
 
 struct _EbThreadContext {
     EbDctor dctor;
@@ -87,6 +88,9 @@ struct _EbEncHandle {
     EbThreadContext **rest_context_ptr_array;
     EbThreadContext * packetization_context_ptr;
 
+    // Film grain denoiser workers, shared by the picture analysis threads
+    DenoiseWorkers *denoise_workers;
+
     // System Resource Managers
     EbSystemResource * input_buffer_resource_ptr;
     EbSystemResource **output_stream_buffer_resource_ptr_array;
@@ -113,6 +117,12 @@ struct _EbEncHandle {
     EbFifo *input_buffer_producer_fifo_ptr;
     EbFifo *output_stream_buffer_consumer_fifo_ptr;
     EbFifo *output_recon_buffer_consumer_fifo_ptr;
+
+    // Set when the process wide shared tables were acquired
+    EbBool shared_tables_acquired;
+
+    // Set from the first picture sent until the EOS packet is handed out
+    EbBool stream_in_progress;
 };
 
 #endif // EbEncHandle_h
@@ -0,0 +1,146 @@
+/*
+ * Copyright(c) 2019 Intel Corporation
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file ArenaTest.cc
+ *
+ * @brief Unit test for the bump arena carving the per picture allocations:
+ * - eb_arena_ctor
+ * - eb_arena_alloc
+ * - eb_arena_reset
+ * - EB_ARENA_ALLOC_ARRAY / EB_ARENA_CALLOC_ARRAY
+ *
+ ******************************************************************************/
+
+#include <stdint.h>
+#include "gtest/gtest.h"
+
+// Workaround to eliminate the compiling warning on linux
+// The macro will conflict with definition in gtest.h
+#ifdef __USE_GNU
+#undef __USE_GNU  // defined in EbThreads.h
+#endif
+#ifdef _GNU_SOURCE
+#undef _GNU_SOURCE  // defined in EbThreads.h
+#endif
+
+#include "EbDefinitions.h"
+#include "EbMalloc.h"
+
+namespace {
+
+static EbErrorType alloc_array(EbArena *arena, uint32_t **array,
+                               size_t count) {
+    EB_ARENA_ALLOC_ARRAY(arena, *array, count);
+    return EB_ErrorNone;
+}
+
+static EbErrorType calloc_array(EbArena *arena, uint32_t **array,
+                                size_t count) {
+    EB_ARENA_CALLOC_ARRAY(arena, *array, count);
+    return EB_ErrorNone;
+}
+
+static bool is_aligned(const void *p) {
+    return ((uintptr_t)p & (ALVALUE - 1)) == 0;
+}
+
+TEST(ArenaTest, AllocationIsAlignedAndDisjoint) {
+    const size_t sizes[] = {1, ALVALUE - 1, ALVALUE, ALVALUE + 1, 3 * ALVALUE};
+    const size_t num = sizeof(sizes) / sizeof(sizes[0]);
+    size_t total = 0;
+    for (size_t i = 0; i < num; i++) total += EB_ARENA_SIZE(sizes[i]);
+
+    EbArena arena;
+    ASSERT_EQ(eb_arena_ctor(&arena, total), EB_ErrorNone);
+    ASSERT_NE(arena.base, nullptr);
+    EXPECT_EQ(arena.size, total);
+
+    uint8_t *prev = NULL;
+    for (size_t i = 0; i < num; i++) {
+        uint8_t *p = (uint8_t *)eb_arena_alloc(&arena, sizes[i]);
+        ASSERT_NE(p, nullptr);
+        EXPECT_TRUE(is_aligned(p));
+        // Sub-allocations are laid out back to back, rounded to ALVALUE
+        if (prev)
+            EXPECT_EQ(p, prev + EB_ARENA_SIZE(sizes[i - 1]));
+        memset(p, (int)i, sizes[i]);
+        prev = p;
+    }
+    EXPECT_EQ(arena.used, total);
+
+    eb_arena_dctor(&arena);
+    EXPECT_EQ(arena.size, 0u);
+    EXPECT_EQ(arena.used, 0u);
+}
+
+TEST(ArenaTest, ArrayMacros) {
+    const size_t count = 37;
+    EbArena arena;
+    ASSERT_EQ(eb_arena_ctor(&arena, 2 * EB_ARENA_SIZE(count * sizeof(uint32_t))),
+              EB_ErrorNone);
+
+    uint32_t *a = NULL;
+    uint32_t *b = NULL;
+    ASSERT_EQ(alloc_array(&arena, &a, count), EB_ErrorNone);
+    ASSERT_NE(a, nullptr);
+    EXPECT_TRUE(is_aligned(a));
+    for (size_t i = 0; i < count; i++) a[i] = 0xFFFFFFFF;
+
+    ASSERT_EQ(calloc_array(&arena, &b, count), EB_ErrorNone);
+    ASSERT_NE(b, nullptr);
+    EXPECT_TRUE(is_aligned(b));
+    for (size_t i = 0; i < count; i++) EXPECT_EQ(b[i], 0u);
+    // Filling the first array left the second one untouched
+    for (size_t i = 0; i < count; i++) EXPECT_EQ(a[i], 0xFFFFFFFF);
+
+    // The arena is full, the macros report the failure
+    uint32_t *c = NULL;
+    EXPECT_EQ(alloc_array(&arena, &c, 1), EB_ErrorInsufficientResources);
+    EXPECT_EQ(c, nullptr);
+    EXPECT_EQ(calloc_array(&arena, &c, 1), EB_ErrorInsufficientResources);
+    EXPECT_EQ(c, nullptr);
+
+    eb_arena_dctor(&arena);
+}
+
+TEST(ArenaTest, Exhaustion) {
+    EbArena arena;
+    ASSERT_EQ(eb_arena_ctor(&arena, 2 * ALVALUE), EB_ErrorNone);
+
+    ASSERT_NE(eb_arena_alloc(&arena, ALVALUE + 1), nullptr);
+    // The rounded up request no longer fits, nothing is consumed
+    EXPECT_EQ(eb_arena_alloc(&arena, 1), nullptr);
+    EXPECT_EQ(arena.used, 2u * ALVALUE);
+
+    eb_arena_dctor(&arena);
+
+    // An empty arena owns no memory and hands out nothing
+    ASSERT_EQ(eb_arena_ctor(&arena, 0), EB_ErrorNone);
+    EXPECT_EQ(arena.base, nullptr);
+    EXPECT_EQ(eb_arena_alloc(&arena, 1), nullptr);
+    eb_arena_dctor(&arena);
+}
+
+TEST(ArenaTest, Reset) {
+    EbArena arena;
+    ASSERT_EQ(eb_arena_ctor(&arena, 2 * ALVALUE), EB_ErrorNone);
+
+    void *first = eb_arena_alloc(&arena, ALVALUE);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(eb_arena_alloc(&arena, ALVALUE), nullptr);
+    EXPECT_EQ(eb_arena_alloc(&arena, 1), nullptr);
+
+    // The backing allocation is kept and handed out again from the start
+    eb_arena_reset(&arena);
+    EXPECT_EQ(arena.used, 0u);
+    EXPECT_EQ(arena.size, 2u * ALVALUE);
+    EXPECT_EQ(eb_arena_alloc(&arena, 2 * ALVALUE), first);
+    EXPECT_EQ(eb_arena_alloc(&arena, 1), nullptr);
+
+    eb_arena_dctor(&arena);
+}
+
+}  // namespace
@@ -14,11 +14,13 @@
 #include <math.h>
 #include <stdlib.h>
 #include <random>
+#include <vector>
 #include "EbCabacContextModel.h"
 #if defined(CHAR_BIT)
 #undef CHAR_BIT  // defined in clang/9.1.0/include/limits.h
 #endif
 #include "EbDecBitReader.h"
+#include "EbTime.h"
 #include "gtest/gtest.h"
 #include "random.h"
 /**
@@ -276,4 +278,138 @@ TEST(Entropy_BitstreamWriter, write_symbol_with_update) {
                   rnd(gen));
     }
 }
+
+// Coefficient levels as they are coded: a base level symbol and, for the
+// levels past it, a range symbol, both with 4-symbol CDFs chosen by a context
+class CoeffLevelSymbolTest : public ::testing::Test {
+  public:
+    CoeffLevelSymbolTest() : stream_(num_levels_ * 4) {
+        std::discrete_distribution<int> level_dist({8, 4, 2, 1, 1, 1, 1});
+        std::mt19937 gen(deterministic_seeds);
+        for (int i = 0; i < num_levels_; ++i)
+            levels_.push_back(static_cast<uint8_t>(level_dist(gen)));
+
+        AomWriter bw;
+        memset(&bw, 0, sizeof(bw));
+        bw.allow_update_cdf = 1;
+        reset_cdfs(&write_fc_);
+        aom_start_encode(&bw, stream_.data());
+        for (int i = 0; i < num_levels_; ++i) {
+            const int base_level = AOMMIN(levels_[i], 3);
+            aom_write_symbol(&bw, base_level, base_cdf(&write_fc_, i), 4);
+            if (base_level == 3)
+                aom_write_symbol(&bw, levels_[i] - 3, br_cdf(&write_fc_, i), 4);
+        }
+        aom_stop_encode(&bw);
+        stream_size_ = bw.pos;
+    }
+
+  protected:
+    static void reset_cdfs(FRAME_CONTEXT *fc) {
+        memset(fc, 0, sizeof(*fc));
+        eb_av1_default_coef_probs(fc, base_qindex_);
+    }
+
+    static AomCdfProb *base_cdf(FRAME_CONTEXT *fc, int i) {
+        return fc->coeff_base_cdf[TX_8X8][PLANE_TYPE_Y][i % SIG_COEF_CONTEXTS];
+    }
+
+    static AomCdfProb *br_cdf(FRAME_CONTEXT *fc, int i) {
+        return fc->coeff_br_cdf[TX_8X8][PLANE_TYPE_Y][i % LEVEL_CONTEXTS];
+    }
+
+    // Read all the levels back, with svt_read_symbol4() or svt_read_symbol()
+    void read_levels(FRAME_CONTEXT *fc, bool use_symbol4, uint8_t *levels) {
+        SvtReader br;
+        svt_reader_init(&br, stream_.data(), stream_size_);
+        br.allow_update_cdf = 1;
+        for (int i = 0; i < num_levels_; ++i) {
+            int level = use_symbol4
+                            ? svt_read_symbol4(&br, base_cdf(fc, i), nullptr)
+                            : svt_read_symbol(&br, base_cdf(fc, i), 4, nullptr);
+            if (level == 3) {
+                level += use_symbol4
+                             ? svt_read_symbol4(&br, br_cdf(fc, i), nullptr)
+                             : svt_read_symbol(&br, br_cdf(fc, i), 4, nullptr);
+            }
+            levels[i] = static_cast<uint8_t>(level);
+        }
+    }
+
+    static const int num_levels_ = 20000;
+    static const int base_qindex_ = 120;
+    std::vector<uint8_t> levels_;
+    std::vector<uint8_t> stream_;
+    uint32_t stream_size_;
+    FRAME_CONTEXT write_fc_;
+};
+
+TEST_F(CoeffLevelSymbolTest, read_symbol4_match) {
+    std::vector<uint8_t> levels_ref(num_levels_), levels_tst(num_levels_);
+    FRAME_CONTEXT fc_ref, fc_tst;
+
+    reset_cdfs(&fc_ref);
+    reset_cdfs(&fc_tst);
+    read_levels(&fc_ref, false, levels_ref.data());
+    read_levels(&fc_tst, true, levels_tst.data());
+
+    for (int i = 0; i < num_levels_; ++i) {
+        ASSERT_EQ(levels_ref[i], levels_[i]) << "pos: " << i;
+        ASSERT_EQ(levels_tst[i], levels_[i]) << "pos: " << i;
+    }
+    // the adapted CDFs match the ones of the writer
+    EXPECT_EQ(memcmp(fc_tst.coeff_base_cdf,
+                     write_fc_.coeff_base_cdf,
+                     sizeof(fc_tst.coeff_base_cdf)),
+              0);
+    EXPECT_EQ(memcmp(fc_tst.coeff_br_cdf,
+                     write_fc_.coeff_br_cdf,
+                     sizeof(fc_tst.coeff_br_cdf)),
+              0);
+    EXPECT_EQ(memcmp(fc_ref.coeff_base_cdf,
+                     write_fc_.coeff_base_cdf,
+                     sizeof(fc_ref.coeff_base_cdf)),
+              0);
+}
+
+TEST_F(CoeffLevelSymbolTest, DISABLED_read_symbol4_speed) {
+    std::vector<uint8_t> levels(num_levels_);
+    FRAME_CONTEXT fc;
+    double time_c, time_o;
+    uint64_t start_time_seconds, start_time_useconds;
+    uint64_t middle_time_seconds, middle_time_useconds;
+    uint64_t finish_time_seconds, finish_time_useconds;
+    const int num_loop = 200;
+
+    eb_start_time(&start_time_seconds, &start_time_useconds);
+    for (int i = 0; i < num_loop; ++i) {
+        reset_cdfs(&fc);
+        read_levels(&fc, false, levels.data());
+    }
+
+    eb_start_time(&middle_time_seconds, &middle_time_useconds);
+    for (int i = 0; i < num_loop; ++i) {
+        reset_cdfs(&fc);
+        read_levels(&fc, true, levels.data());
+    }
+
+    eb_start_time(&finish_time_seconds, &finish_time_useconds);
+    eb_compute_overall_elapsed_time_ms(start_time_seconds,
+                                       start_time_useconds,
+                                       middle_time_seconds,
+                                       middle_time_useconds,
+                                       &time_c);
+    eb_compute_overall_elapsed_time_ms(middle_time_seconds,
+                                       middle_time_useconds,
+                                       finish_time_seconds,
+                                       finish_time_useconds,
+                                       &time_o);
+
+    printf("Average Nanoseconds per Coefficient Level\n");
+    printf("    svt_read_symbol(4)  : %6.2f\n",
+           1000000 * time_c / (num_loop * num_levels_));
+    printf("    svt_read_symbol4()  : %6.2f   (Comparison: %5.2fx)\n",
+           1000000 * time_o / (num_loop * num_levels_),
+           time_c / time_o);
+}
 }  // namespace
@@ -0,0 +1,146 @@
+/*
+ * Copyright(c) 2019 Intel Corporation
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file CompressedReferenceTest.cc
+ *
+ * @brief Unit test for the block compressed reference pictures:
+ * - eb_compressed_reference_compress
+ * - eb_compressed_ref_window
+ *
+ ******************************************************************************/
+
+#include <string.h>
+
+#include "gtest/gtest.h"
+
+// Workaround to eliminate the compiling warning on linux
+// The macro will conflict with definition in gtest.h
+#ifdef __USE_GNU
+#undef __USE_GNU  // defined in EbThreads.h
+#endif
+#ifdef _GNU_SOURCE
+#undef _GNU_SOURCE  // defined in EbThreads.h
+#endif
+
+#include "EbDefinitions.h"
+#include "EbCompressedReference.h"
+#include "random.h"
+
+using svt_av1_test_tool::SVTRandom;
+
+namespace {
+
+class CompressedReferenceTest : public ::testing::Test {
+  protected:
+    static const int width_ = 200;
+    static const int height_ = 136;
+    static const int padding_ = 80;
+
+    void SetUp() override {
+        EbPictureBufferDescInitData init_data;
+        memset(&init_data, 0, sizeof(init_data));
+        init_data.max_width = width_;
+        init_data.max_height = height_;
+        init_data.bit_depth = EB_8BIT;
+        init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_FULL_MASK;
+        init_data.left_padding = padding_;
+        init_data.right_padding = padding_;
+        init_data.top_padding = padding_;
+        init_data.bot_padding = padding_;
+        init_data.color_format = EB_YUV420;
+        init_data.split_mode = EB_FALSE;
+        memset(&pic_, 0, sizeof(pic_));
+        ASSERT_EQ(eb_picture_buffer_desc_ctor(&pic_, &init_data), EB_ErrorNone);
+        memset(&cref_, 0, sizeof(cref_));
+        ASSERT_EQ(eb_compressed_reference_ctor(&cref_, &pic_), EB_ErrorNone);
+        cache_ = new EbCompressedRefCache;
+        memset(cache_, 0, sizeof(*cache_));
+        ASSERT_EQ(eb_compressed_ref_cache_ctor(cache_), EB_ErrorNone);
+    }
+
+    void TearDown() override {
+        delete cache_;
+        cref_.dctor(&cref_);
+        pic_.dctor(&pic_);
+    }
+
+    // Gradient plus a little noise, compresses well
+    void fill_plane(uint8_t *buf, int stride, int w, int h, int noise) {
+        SVTRandom rnd(0, noise);
+        for (int y = 0; y < h; y++)
+            for (int x = 0; x < w; x++)
+                buf[y * stride + x] = (uint8_t)((x + 2 * y) / 3 + rnd.random());
+    }
+
+    void fill(int noise) {
+        const int h = height_ + 2 * padding_;
+        fill_plane(pic_.buffer_y, pic_.stride_y, pic_.stride_y, h, noise);
+        fill_plane(pic_.buffer_cb, pic_.stride_cb, pic_.stride_cb, h >> 1, noise);
+        fill_plane(pic_.buffer_cr, pic_.stride_cr, pic_.stride_cr, h >> 1, noise);
+    }
+
+    // Compare the window against the picture over the clamped luma area
+    void check_window(const EbPictureBufferDesc *win, int x, int y, int w,
+                      int h) {
+        const int x0 = AOMMAX(0, (x + padding_) & ~1);
+        const int y0 = AOMMAX(0, (y + padding_) & ~1);
+        const int x1 = AOMMIN(width_ + 2 * padding_, x + w + padding_);
+        const int y1 = AOMMIN(height_ + 2 * padding_, y + h + padding_);
+        for (int yy = y0; yy < y1; yy++)
+            for (int xx = x0; xx < x1; xx++)
+                ASSERT_EQ(win->buffer_y[yy * win->stride_y + xx],
+                          pic_.buffer_y[yy * pic_.stride_y + xx]);
+        for (int yy = y0 >> 1; yy < y1 >> 1; yy++)
+            for (int xx = x0 >> 1; xx < x1 >> 1; xx++) {
+                ASSERT_EQ(win->buffer_cb[yy * win->stride_cb + xx],
+                          pic_.buffer_cb[yy * pic_.stride_cb + xx]);
+                ASSERT_EQ(win->buffer_cr[yy * win->stride_cr + xx],
+                          pic_.buffer_cr[yy * pic_.stride_cr + xx]);
+            }
+    }
+
+    EbPictureBufferDesc pic_;
+    EbCompressedReference cref_;
+    EbCompressedRefCache *cache_;
+};
+
+TEST_F(CompressedReferenceTest, WindowMatchesPicture) {
+    SVTRandom pos_x(-padding_ - 8, width_ + padding_ - 8);
+    SVTRandom pos_y(-padding_ - 8, height_ + padding_ - 8);
+    SVTRandom size(8, CREF_WINDOW_SIZE - 2);
+
+    for (int noise = 0; noise <= 1; noise++) {
+        fill(noise);
+        eb_compressed_reference_compress(&cref_, &pic_);
+        ASSERT_TRUE(cref_.valid);
+        for (int i = 0; i < 200; i++) {
+            const int x = pos_x.random(), y = pos_y.random();
+            const int w = size.random(), h = size.random();
+            const uint32_t idx = i % CREF_WINDOW_COUNT;
+            EbPictureBufferDesc *win =
+                eb_compressed_ref_window(cache_, idx, &cref_, &pic_, x, y, w, h);
+            ASSERT_NE(win, nullptr);
+            check_window(win, x, y, w, h);
+        }
+    }
+}
+
+TEST_F(CompressedReferenceTest, NoiseIsNotKept) {
+    fill(255);
+    eb_compressed_reference_compress(&cref_, &pic_);
+    EXPECT_FALSE(cref_.valid);
+}
+
+TEST_F(CompressedReferenceTest, LargeWindowIsRejected) {
+    fill(0);
+    eb_compressed_reference_compress(&cref_, &pic_);
+    ASSERT_TRUE(cref_.valid);
+    EXPECT_EQ(eb_compressed_ref_window(
+                  cache_, 0, &cref_, &pic_, 0, 0, CREF_WINDOW_SIZE + 2, 16),
+              nullptr);
+}
+
+}  // namespace
@@ -23,6 +23,8 @@
 
 #include "aom_dsp_rtcd.h"
 
+extern "C" const uint8_t *av1_get_obmc_mask(int length);
+
 using libaom_test::ACMRandom;
 
 namespace {
@@ -238,6 +240,10 @@ TEST_CLASS(BlendA64Mask1DTest8B, blend_a64_hmask_ref,
            aom_blend_a64_hmask_sse4_1, Horz_Blend_SSE4_1)
 TEST_CLASS(BlendA64Mask1DTest8B, blend_a64_vmask_ref,
            aom_blend_a64_vmask_sse4_1, Vert_Blend_SSE4_1)
+TEST_CLASS(BlendA64Mask1DTest8B, blend_a64_hmask_ref,
+           aom_blend_a64_hmask_avx2, Horz_Blend_AVX2)
+TEST_CLASS(BlendA64Mask1DTest8B, blend_a64_vmask_ref,
+           aom_blend_a64_vmask_avx2, Vert_Blend_AVX2)
 
 //////////////////////////////////////////////////////////////////////////////
 // HBD version
@@ -342,5 +348,124 @@ TEST_CLASS(BlendA64Mask1DTestHBD, highbd_blend_a64_hmask_ref,
            aom_highbd_blend_a64_hmask_sse4_1, Horz_Blend_Hbd_SSE4_1)
 TEST_CLASS(BlendA64Mask1DTestHBD, highbd_blend_a64_vmask_ref,
            aom_highbd_blend_a64_vmask_sse4_1, Vert_Blend_Hbd_SSE4_1)
+TEST_CLASS(BlendA64Mask1DTestHBD, highbd_blend_a64_hmask_ref,
+           aom_highbd_blend_a64_hmask_avx2, Horz_Blend_Hbd_AVX2)
+TEST_CLASS(BlendA64Mask1DTestHBD, highbd_blend_a64_vmask_ref,
+           aom_highbd_blend_a64_vmask_avx2, Vert_Blend_Hbd_AVX2)
+
+//////////////////////////////////////////////////////////////////////////////
+// Decoder OBMC, the recon is blended in place with the OBMC masks
+//////////////////////////////////////////////////////////////////////////////
+template <typename T>
+class DecObmcBlendTest : public ACMRandom {
+  public:
+    static const int kIterations = 100;
+    static const int kStride = MAX_SB_SIZE + 32;
+    static const int kBufSize = kStride * MAX_SB_SIZE;
+
+    DecObmcBlendTest(int bd) : bd_(bd) {
+    }
+
+    // Blend the luma and the 4:2:0 chroma of every block size allowed to use
+    // OBMC, with the prediction from the above or the left neighbor
+    template <typename Blend>
+    void RunTest(Blend ref, Blend tst, int above) {
+        for (int iter = 0;
+             iter < kIterations && !::testing::Test::HasFatalFailure();
+             iter++) {
+            for (int bsize = 0; bsize < BlockSizeS_ALL; bsize++) {
+                const int bw = block_size_wide[bsize];
+                const int bh = block_size_high[bsize];
+                if (AOMMIN(bw, bh) < 8)
+                    continue;
+                for (int sub = 0; sub < 2; sub++) {
+                    const int overlap = AOMMIN(above ? bh : bw, 64) >> 1;
+                    const int w = (above ? bw : overlap) >> sub;
+                    const int h = (above ? overlap : bh) >> sub;
+                    const uint8_t *mask = av1_get_obmc_mask(above ? h : w);
+
+                    for (int i = 0; i < kBufSize; ++i) {
+                        recon_ref_[i] = this->Rand16() & ((1 << bd_) - 1);
+                        pred_[i] = this->Rand16() & ((1 << bd_) - 1);
+                    }
+                    memcpy(recon_tst_, recon_ref_, sizeof(recon_tst_));
+
+                    ref(recon_ref_, kStride, pred_, kStride, mask, w, h, bd_);
+                    tst(recon_tst_, kStride, pred_, kStride, mask, w, h, bd_);
+                    ASSERT_EQ(0,
+                              memcmp(recon_ref_, recon_tst_, sizeof(recon_ref_)))
+                        << (above ? "above " : "left ") << w << "x" << h
+                        << " bd " << bd_;
+                }
+            }
+        }
+    }
+
+    T recon_ref_[kBufSize];
+    T recon_tst_[kBufSize];
+    T pred_[kBufSize];
+    int bd_;
+};
+
+typedef void (*DecObmcBlend8B)(uint8_t *recon, int stride, const uint8_t *pred,
+                               int pred_stride, const uint8_t *mask, int w,
+                               int h, int bd);
+typedef void (*DecObmcBlendHBD)(uint16_t *recon, int stride,
+                                const uint16_t *pred, int pred_stride,
+                                const uint8_t *mask, int w, int h, int bd);
+
+// The calls of EbDecObmc.c
+#define DEC_OBMC_BLEND_8B(name, blend)                                        \
+    static void name(uint8_t *recon, int stride, const uint8_t *pred,         \
+                     int pred_stride, const uint8_t *mask, int w, int h,      \
+                     int /*bd*/) {                                            \
+        blend(recon, stride, recon, stride, pred, pred_stride, mask, w, h);   \
+    }
+#define DEC_OBMC_BLEND_HBD(name, blend)                                       \
+    static void name(uint16_t *recon, int stride, const uint16_t *pred,       \
+                     int pred_stride, const uint8_t *mask, int w, int h,      \
+                     int bd) {                                                \
+        blend((uint8_t *)recon, stride, (uint8_t *)recon, stride,             \
+              (const uint8_t *)pred, pred_stride, mask, w, h, bd);            \
+    }
+
+DEC_OBMC_BLEND_8B(dec_obmc_above_c, aom_blend_a64_vmask_c)
+DEC_OBMC_BLEND_8B(dec_obmc_above_avx2, aom_blend_a64_vmask_avx2)
+DEC_OBMC_BLEND_8B(dec_obmc_left_c, aom_blend_a64_hmask_c)
+DEC_OBMC_BLEND_8B(dec_obmc_left_avx2, aom_blend_a64_hmask_avx2)
+DEC_OBMC_BLEND_HBD(dec_obmc_above_hbd_c, aom_highbd_blend_a64_vmask_c)
+DEC_OBMC_BLEND_HBD(dec_obmc_above_hbd_avx2, aom_highbd_blend_a64_vmask_avx2)
+DEC_OBMC_BLEND_HBD(dec_obmc_left_hbd_c, aom_highbd_blend_a64_hmask_c)
+DEC_OBMC_BLEND_HBD(dec_obmc_left_hbd_avx2, aom_highbd_blend_a64_hmask_avx2)
+
+TEST(DecObmcBlendTest, Above_AVX2) {
+    DecObmcBlendTest<uint8_t> *test = new DecObmcBlendTest<uint8_t>(8);
+    test->RunTest<DecObmcBlend8B>(dec_obmc_above_c, dec_obmc_above_avx2, 1);
+    delete test;
+}
+
+TEST(DecObmcBlendTest, Left_AVX2) {
+    DecObmcBlendTest<uint8_t> *test = new DecObmcBlendTest<uint8_t>(8);
+    test->RunTest<DecObmcBlend8B>(dec_obmc_left_c, dec_obmc_left_avx2, 0);
+    delete test;
+}
+
+TEST(DecObmcBlendTest, Above_Hbd_AVX2) {
+    for (int bd = 8; bd <= 12; bd += 2) {
+        DecObmcBlendTest<uint16_t> *test = new DecObmcBlendTest<uint16_t>(bd);
+        test->RunTest<DecObmcBlendHBD>(
+            dec_obmc_above_hbd_c, dec_obmc_above_hbd_avx2, 1);
+        delete test;
+    }
+}
+
+TEST(DecObmcBlendTest, Left_Hbd_AVX2) {
+    for (int bd = 8; bd <= 12; bd += 2) {
+        DecObmcBlendTest<uint16_t> *test = new DecObmcBlendTest<uint16_t>(bd);
+        test->RunTest<DecObmcBlendHBD>(
+            dec_obmc_left_hbd_c, dec_obmc_left_hbd_avx2, 0);
+        delete test;
+    }
+}
 
 }; // namespace
@@ -380,6 +380,8 @@ class BlendA64MaskTestHBD : public BlendA64MaskTest<FHBD, uint16_t, uint16_t> {
 
 TEST_CLASS(BlendA64MaskTestHBD, aom_highbd_blend_a64_mask_c,
            aom_highbd_blend_a64_mask_sse4_1, Mask_Blend_Hbd_SSE4_1)
+TEST_CLASS(BlendA64MaskTestHBD, aom_highbd_blend_a64_mask_c,
+           aom_highbd_blend_a64_mask_avx2, Mask_Blend_Hbd_AVX2)
 
 //////////////////////////////////////////////////////////////////////////////
 // HBD _d16 version
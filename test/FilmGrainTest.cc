@@ -31,6 +31,7 @@
 #include "acm_random.h"
 #include "noise_model.h"
 #include "aom_dsp_rtcd.h"
+#include "common_dsp_rtcd.h"
 
 static AomFilmGrain film_grain_test_vectors[3] = {
     /* Test 1 */
@@ -209,6 +210,7 @@ class AddFilmGrainTest : public ::testing::Test {
     static const int chroma_size = luma_size >> 2;
 
     void SetUp() override {
+        setup_common_rtcd_internal(get_cpu_flags_to_use());
         luma_ = (uint8_t *)eb_aom_malloc(luma_size);
         cb_ = (uint8_t *)eb_aom_malloc(chroma_size);
         cr_ = (uint8_t *)eb_aom_malloc(chroma_size);
@@ -271,6 +273,98 @@ TEST_F(AddFilmGrainTest, MatchTest) {
     }
 }
 
+// The stripes of a frame can be processed in any order, check it against the
+// expected output of the whole frame
+TEST_F(AddFilmGrainTest, StripesMatchTest) {
+    for (int i = 0; i < 3; ++i) {
+        FilmGrainFrame fg;
+        init_data();
+        eb_av1_film_grain_frame_init(&fg,
+                                     film_grain_test_vectors + i,
+                                     luma_,
+                                     cb_,
+                                     cr_,
+                                     kHeight,
+                                     kWidth,
+                                     kWidth,     /* luma stride */
+                                     kWidth / 2, /* chroma stride */
+                                     0,
+                                     1,
+                                     1);
+        for (int stripe = fg.num_stripes - 1; stripe >= 0; --stripe)
+            eb_av1_add_film_grain_stripes(&fg, stripe, 1);
+        eb_av1_film_grain_frame_free(&fg);
+        check_output(i);
+        EXPECT_FALSE(HasFailure());
+    }
+}
+
+/**
+ * @brief Check the AVX2 noise blending of the film grain is bit-exact with the
+ * C version, for 8 and 10 bit samples and the three chroma subsamplings.
+ */
+TEST(FilmGrainNoiseTest, AVX2MatchesC) {
+    if (!(get_cpu_flags_to_use() & CPU_FLAGS_AVX2))
+        return;
+    const int width = 37, height = 10, stride = 80;
+    libaom_test::ACMRandom rnd(libaom_test::ACMRandom::DeterministicSeed());
+    int32_t scaling_lut[257], grain[height * stride];
+    uint16_t luma[4 * height * stride];
+    uint16_t ref[height * stride], tst[height * stride];
+    uint8_t luma8[4 * height * stride], ref8[height * stride],
+        tst8[height * stride];
+
+    for (int iter = 0; iter < 100; ++iter) {
+        const int bd = iter & 1 ? 10 : 8;
+        const int ss_x = iter % 3 != 2, ss_y = iter % 3 == 0;
+        const int shift = 8 + iter % 4;
+        const int max_val = (1 << bd) - 1;
+        for (int i = 0; i < 256; ++i)
+            scaling_lut[i] = rnd.Rand8();
+        scaling_lut[256] = scaling_lut[255];
+        for (int i = 0; i < height * stride; ++i) {
+            grain[i] = rnd.PseudoUniform(1 << bd) - (1 << (bd - 1));
+            ref[i] = tst[i] = rnd.PseudoUniform(max_val + 1);
+            ref8[i] = tst8[i] = rnd.Rand8();
+        }
+        for (int i = 0; i < 4 * height * stride; ++i) {
+            luma[i] = rnd.PseudoUniform(max_val + 1);
+            luma8[i] = rnd.Rand8();
+        }
+        const int luma_mult = rnd.PseudoUniform(256) - 128;
+        const int chroma_mult = rnd.PseudoUniform(256) - 128;
+        const int offset = rnd.PseudoUniform(512) - 256;
+
+        eb_av1_add_chroma_noise_c(ref8, stride, luma8, 2 * stride, grain, stride,
+                                  scaling_lut, width, height, luma_mult,
+                                  chroma_mult, offset, shift, 16, 240, ss_y, ss_x);
+        eb_av1_add_chroma_noise_avx2(tst8, stride, luma8, 2 * stride, grain,
+                                     stride, scaling_lut, width, height,
+                                     luma_mult, chroma_mult, offset, shift, 16,
+                                     240, ss_y, ss_x);
+        eb_av1_add_luma_noise_c(
+            ref8, stride, grain, stride, scaling_lut, width, height, shift, 0, 255);
+        eb_av1_add_luma_noise_avx2(
+            tst8, stride, grain, stride, scaling_lut, width, height, shift, 0, 255);
+        eb_av1_add_chroma_noise_hbd_c(ref, stride, luma, 2 * stride, grain,
+                                      stride, scaling_lut, width, height,
+                                      luma_mult, chroma_mult, offset, shift, 0,
+                                      max_val, ss_y, ss_x, bd);
+        eb_av1_add_chroma_noise_hbd_avx2(tst, stride, luma, 2 * stride, grain,
+                                         stride, scaling_lut, width, height,
+                                         luma_mult, chroma_mult, offset, shift,
+                                         0, max_val, ss_y, ss_x, bd);
+        eb_av1_add_luma_noise_hbd_c(ref, stride, grain, stride, scaling_lut,
+                                    width, height, shift, 0, max_val, bd);
+        eb_av1_add_luma_noise_hbd_avx2(tst, stride, grain, stride, scaling_lut,
+                                       width, height, shift, 0, max_val, bd);
+        for (int i = 0; i < height * stride; ++i) {
+            ASSERT_EQ(ref8[i], tst8[i]) << "iter " << iter << " pos " << i;
+            ASSERT_EQ(ref[i], tst[i]) << "iter " << iter << " pos " << i;
+        }
+    }
+}
+
 extern "C" {
 #include "EbPictureControlSet.h"
 #include "EbPictureBufferDesc.h"
@@ -426,6 +520,12 @@ class DenoiseModelRunTest : public ::testing::Test {
             eb_aom_ifft8x8_float = eb_aom_ifft8x8_float_avx2;
             eb_aom_ifft2x2_float = eb_aom_ifft2x2_float_c;
             eb_aom_ifft4x4_float = eb_aom_ifft4x4_float_sse2;
+
+            eb_aom_flat_block_finder_extract_block =
+                eb_aom_flat_block_finder_extract_block_c;
+            eb_aom_flat_block_gradient_stats = eb_aom_flat_block_gradient_stats_c;
+            eb_aom_noise_model_add_observation =
+                eb_aom_noise_model_add_observation_c;
         }
     }
 
@@ -450,11 +550,11 @@ class DenoiseModelRunTest : public ::testing::Test {
             1);
     }
 
-    void run_test() {
+    void run_test(DenoiseWorkers *workers = nullptr) {
         init_data();
 
         eb_aom_denoise_and_model_run(
-            &noise_model, &in_pic_, &output_film_grain, 0);
+            &noise_model, &in_pic_, &output_film_grain, 0, workers);
     }
 
   protected:
@@ -473,3 +573,95 @@ TEST_F(DenoiseModelRunTest, OutputFilmGrainCheck) {
     check_filmgrain();
     EXPECT_FALSE(HasFailure());
 }
+
+/**
+ * @brief Check the denoiser and noise model give the same film grain when
+ * their blocks are shared with worker threads.
+ */
+TEST_F(DenoiseModelRunTest, OutputFilmGrainWithWorkersCheck) {
+    DenoiseWorkers workers;
+    memset(&workers, 0, sizeof(workers));
+    ASSERT_EQ(denoise_workers_ctor(&workers, 3), EB_ErrorNone);
+    run_test(&workers);
+    workers.dctor(&workers);
+    check_filmgrain();
+    EXPECT_FALSE(HasFailure());
+}
+
+/**
+ * @brief Check the AVX2 flat block extraction and gradient statistics are
+ * close to the C version, their sums being reordered, and that the AVX2
+ * equation accumulation is bit-exact with the C version.
+ */
+TEST(NoiseModelTest, AVX2MatchesC) {
+    if (!(get_cpu_flags_to_use() & CPU_FLAGS_AVX2))
+        return;
+    const int width = 50, height = 40, stride = 64;
+    libaom_test::ACMRandom rnd(libaom_test::ACMRandom::DeterministicSeed());
+    uint16_t data16[height * stride];
+    uint8_t data8[height * stride];
+    double plane_ref[32 * 32], block_ref[32 * 32];
+    double plane_tst[32 * 32], block_tst[32 * 32];
+    double stats_ref[5], stats_tst[5];
+
+    for (int use_highbd = 0; use_highbd < 2; ++use_highbd) {
+        const int bd = use_highbd ? 10 : 8;
+        const uint8_t *data =
+            use_highbd ? (const uint8_t *)data16 : data8;
+        for (int i = 0; i < height * stride; ++i) {
+            data16[i] = rnd.PseudoUniform(1 << bd);
+            data8[i] = (uint8_t)data16[i];
+        }
+        for (int block_size = 8; block_size <= 32; block_size *= 2) {
+            AomFlatBlockFinder finder;
+            ASSERT_EQ(eb_aom_flat_block_finder_init(
+                          &finder, block_size, bd, use_highbd),
+                      1);
+            const int n = block_size * block_size;
+            for (int offsy = -block_size / 2; offsy < height;
+                 offsy += block_size / 2) {
+                for (int offsx = -block_size / 2; offsx < width;
+                     offsx += block_size / 2) {
+                    eb_aom_flat_block_finder_extract_block_c(
+                        &finder, data, width, height, stride,
+                        offsx, offsy, plane_ref, block_ref);
+                    eb_aom_flat_block_finder_extract_block_avx2(
+                        &finder, data, width, height, stride,
+                        offsx, offsy, plane_tst, block_tst);
+                    for (int i = 0; i < n; ++i) {
+                        ASSERT_NEAR(plane_ref[i], plane_tst[i], 1e-9);
+                        ASSERT_NEAR(block_ref[i], block_tst[i], 1e-9);
+                    }
+                    eb_aom_flat_block_gradient_stats_c(
+                        block_ref, block_size, stats_ref);
+                    eb_aom_flat_block_gradient_stats_avx2(
+                        block_ref, block_size, stats_tst);
+                    for (int i = 0; i < 5; ++i)
+                        ASSERT_NEAR(stats_ref[i], stats_tst[i], 1e-9);
+                }
+            }
+            eb_aom_flat_block_finder_free(&finder);
+        }
+    }
+
+    for (int n = 1; n <= 29; ++n) {
+        double buffer[29], a_ref[29 * 29], a_tst[29 * 29], b_ref[29],
+            b_tst[29];
+        const double norm_sq = 1023.0 * 1023.0;
+        for (int i = 0; i < n * n; ++i)
+            a_ref[i] = a_tst[i] = rnd.PseudoUniform(1000);
+        for (int i = 0; i < n; ++i) {
+            buffer[i] = rnd.PseudoUniform(2047) - 1023;
+            b_ref[i] = b_tst[i] = rnd.PseudoUniform(1000);
+        }
+        const double val = rnd.PseudoUniform(2047) - 1023;
+        eb_aom_noise_model_add_observation_c(
+            a_ref, b_ref, buffer, val, n, norm_sq);
+        eb_aom_noise_model_add_observation_avx2(
+            a_tst, b_tst, buffer, val, n, norm_sq);
+        for (int i = 0; i < n * n; ++i)
+            ASSERT_EQ(a_ref[i], a_tst[i]) << "n " << n << " pos " << i;
+        for (int i = 0; i < n; ++i)
+            ASSERT_EQ(b_ref[i], b_tst[i]) << "n " << n << " pos " << i;
+    }
+}
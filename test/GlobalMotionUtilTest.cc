@@ -13,6 +13,7 @@
  * - ransac_affine_double_prec
  * - ransac_rotzoom_double_prec
  * - ransac_translation_double_prec
+ * - av1_ransac_score_inliers
  *
  * @author Cidana-Edmond
  *
@@ -29,6 +30,7 @@
 #endif
 #include "EbDefinitions.h"
 #include "EbUtility.h"
+#include "aom_dsp_rtcd.h"
 extern "C" {
 #include "ransac.h"
 }
@@ -377,4 +379,49 @@ TEST_P(RansacDoubleTest, CheckOutput) {
 INSTANTIATE_TEST_CASE_P(GlobalMotion, RansacDoubleTest,
                         ::testing::ValuesIn(transform_table));
 
+/**
+ * @brief Check the SIMD inlier scoring of RANSAC hypotheses is bit-exact with
+ * the C version: same inliers in the same order and same distance sums.
+ */
+TEST(RansacScoreInliersTest, MatchesC) {
+    if (!(get_cpu_flags_to_use() & CPU_FLAGS_AVX2))
+        return;
+    SVTRandom coord(0, CoordinateMax);
+    SVTRandom noise(-3000, 3000);
+    SVTRandom scale(-100, 100);
+    const int max_points = 67;
+    double corners1[2 * max_points], corners2[2 * max_points];
+    int inliers_ref[max_points], inliers_tst[max_points];
+
+    for (int iter = 0; iter < 200; iter++) {
+        const double mat[6] = {noise.random() / 10.0,
+                               noise.random() / 10.0,
+                               1.0 + scale.random() / 1000.0,
+                               scale.random() / 1000.0,
+                               scale.random() / 1000.0,
+                               1.0 + scale.random() / 1000.0};
+        const int npoints = 1 + iter % max_points;
+        for (int i = 0; i < npoints; i++) {
+            const double x = coord.random(), y = coord.random();
+            corners1[2 * i] = x;
+            corners1[2 * i + 1] = y;
+            corners2[2 * i] =
+                mat[2] * x + mat[3] * y + mat[0] + noise.random() / 1000.0;
+            corners2[2 * i + 1] =
+                mat[4] * x + mat[5] * y + mat[1] + noise.random() / 1000.0;
+        }
+
+        double sum_ref = 0, sum_sq_ref = 0, sum_tst = 0, sum_sq_tst = 0;
+        const int num_ref = av1_ransac_score_inliers_c(
+            mat, corners1, corners2, npoints, inliers_ref, &sum_ref, &sum_sq_ref);
+        const int num_tst = av1_ransac_score_inliers_avx2(
+            mat, corners1, corners2, npoints, inliers_tst, &sum_tst, &sum_sq_tst);
+        ASSERT_EQ(num_ref, num_tst);
+        for (int i = 0; i < num_ref; i++)
+            ASSERT_EQ(inliers_ref[i], inliers_tst[i]);
+        ASSERT_EQ(sum_ref, sum_tst);
+        ASSERT_EQ(sum_sq_ref, sum_sq_tst);
+    }
+}
+
 }  // namespace
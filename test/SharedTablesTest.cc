@@ -0,0 +1,69 @@
+/*
+ * Copyright(c) 2019 Intel Corporation
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file SharedTablesTest.cc
+ *
+ * @brief Unit test for the process wide shared encoder tables:
+ * - eb_shared_tables_acquire
+ * - eb_shared_tables_release
+ * - eb_get_shared_tables
+ *
+ ******************************************************************************/
+
+#include <string.h>
+
+#include "gtest/gtest.h"
+
+// Workaround to eliminate the compiling warning on linux
+// The macro will conflict with definition in gtest.h
+#ifdef __USE_GNU
+#undef __USE_GNU  // defined in EbThreads.h
+#endif
+#ifdef _GNU_SOURCE
+#undef _GNU_SOURCE  // defined in EbThreads.h
+#endif
+
+#include "EbDefinitions.h"
+#include "EbPictureControlSet.h"
+#include "EbModeDecisionConfigurationProcess.h"
+#include "EbSharedTables.h"
+
+namespace {
+
+TEST(SharedTablesTest, RefCountedLifetime) {
+    ASSERT_EQ(eb_shared_tables_acquire(), EB_ErrorNone);
+    const EbSharedTables *first = eb_get_shared_tables();
+    ASSERT_NE(first, nullptr);
+
+    // A second handle reuses the same tables
+    ASSERT_EQ(eb_shared_tables_acquire(), EB_ErrorNone);
+    EXPECT_EQ(eb_get_shared_tables(), first);
+
+    eb_shared_tables_release();
+    EXPECT_EQ(eb_get_shared_tables(), first);
+    eb_shared_tables_release();
+    EXPECT_EQ(eb_get_shared_tables(), nullptr);
+}
+
+TEST(SharedTablesTest, MatchPerPictureQuantizers) {
+    static Quants   quants;
+    static Dequants deq;
+    const AomBitDepth bit_depths[2] = {AOM_BITS_8, AOM_BITS_10};
+
+    ASSERT_EQ(eb_shared_tables_acquire(), EB_ErrorNone);
+    const EbSharedTables *tables = eb_get_shared_tables();
+    for (int i = 0; i < 2; ++i) {
+        eb_av1_build_quantizer(bit_depths[i], 0, 0, 0, 0, 0, &quants, &deq);
+        EXPECT_EQ(memcmp(&quants, &tables->quants[i], sizeof(quants)), 0);
+        EXPECT_EQ(memcmp(&deq, &tables->deq[i], sizeof(deq)), 0);
+    }
+    // The last level has no quant matrix
+    EXPECT_EQ(tables->gqmatrix[NUM_QM_LEVELS - 1][0][TX_4X4], nullptr);
+    EXPECT_NE(tables->gqmatrix[0][0][TX_4X4], nullptr);
+    eb_shared_tables_release();
+}
+
+}  // namespace
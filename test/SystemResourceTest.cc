@@ -0,0 +1,101 @@
+/*
+ * Copyright(c) 2019 Intel Corporation
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file SystemResourceTest.cc
+ *
+ * @brief Unit test for the on demand construction of the system resource
+ * objects:
+ * - eb_system_resource_lazy_ctor
+ * - eb_get_empty_object
+ *
+ ******************************************************************************/
+
+#include "gtest/gtest.h"
+
+// Workaround to eliminate the compiling warning on linux
+// The macro will conflict with definition in gtest.h
+#ifdef __USE_GNU
+#undef __USE_GNU  // defined in EbThreads.h
+#endif
+#ifdef _GNU_SOURCE
+#undef _GNU_SOURCE  // defined in EbThreads.h
+#endif
+
+#include "EbDefinitions.h"
+#include "EbSystemResourceManager.h"
+
+namespace {
+
+typedef struct {
+    uint32_t calls;
+    uint32_t fail_calls;  // the first fail_calls constructions fail
+} CreatorState;
+
+static int created_object;
+
+static EbErrorType test_object_creator(EbPtr *object_dbl_ptr,
+                                       EbPtr object_init_data_ptr) {
+    CreatorState *state = (CreatorState *)object_init_data_ptr;
+    *object_dbl_ptr = NULL;
+    if (state->calls++ < state->fail_calls)
+        return EB_ErrorInsufficientResources;
+    *object_dbl_ptr = &created_object;
+    return EB_ErrorNone;
+}
+
+static void test_object_destroyer(EbPtr object_ptr) {
+    (void)object_ptr;
+}
+
+TEST(SystemResourceTest, LazyObjectCreatorFailure) {
+    CreatorState state = {0, 1};
+    EbSystemResource *resource = NULL;
+    EbObjectWrapper *wrapper = NULL;
+    EbErrorType err;
+
+    // The init data is not copied, the creator counts its calls in state
+    EB_NO_THROW_NEW(resource,
+                    eb_system_resource_lazy_ctor,
+                    1,
+                    1,
+                    0,
+                    test_object_creator,
+                    &state,
+                    0,
+                    test_object_destroyer);
+    ASSERT_NE(resource, nullptr);
+    EbFifo *fifo = eb_system_resource_get_producer_fifo(resource, 0);
+
+    // The object is not built until the wrapper is handed out
+    EXPECT_EQ(state.calls, 0u);
+
+    // A failed construction returns the error and no wrapper
+    err = eb_get_empty_object(fifo, &wrapper);
+    EXPECT_EQ(err, EB_ErrorInsufficientResources);
+    EXPECT_EQ(wrapper, nullptr);
+    EXPECT_EQ(state.calls, 1u);
+
+    // The wrapper went back to the pool, the only one of the pool is handed
+    // out again without blocking and its object is built this time
+    err = eb_get_empty_object(fifo, &wrapper);
+    EXPECT_EQ(err, EB_ErrorNone);
+    ASSERT_NE(wrapper, nullptr);
+    EXPECT_EQ(wrapper->object_ptr, (EbPtr)&created_object);
+    EXPECT_EQ(state.calls, 2u);
+
+    // Once built, the object is reused
+    eb_release_object(wrapper);
+    err = eb_get_empty_object(fifo, &wrapper);
+    EXPECT_EQ(err, EB_ErrorNone);
+    ASSERT_NE(wrapper, nullptr);
+    EXPECT_EQ(wrapper->object_ptr, (EbPtr)&created_object);
+    EXPECT_EQ(state.calls, 2u);
+    eb_release_object(wrapper);
+
+    EB_DELETE(resource);
+}
+
+}  // namespace
@@ -0,0 +1,454 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file SvtAv1DecApiTest.cc
+ *
+ * @brief SVT-AV1 decoder api test, check invalid input, decoding and teardown
+ * of the shared decoder pool and of the push api
+ *
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#include "EbSvtAv1Dec.h"
+#include "gtest/gtest.h"
+#include "SvtAv1DecApiTest.h"
+
+using namespace svt_av1_test;
+
+namespace {
+
+typedef std::vector<std::vector<uint8_t>> DecodedPictures;
+
+/** Creates and initializes a decoder running num_threads threads */
+static void open_decoder(SvtAv1DecContext *context, uint32_t num_threads) {
+    memset(context, 0, sizeof(*context));
+    ASSERT_EQ(EB_ErrorNone,
+              eb_dec_init_handle(
+                  &context->dec_handle, context, &context->dec_params))
+        << "eb_dec_init_handle failed";
+    context->dec_params.threads = num_threads;
+    ASSERT_EQ(EB_ErrorNone,
+              eb_svt_dec_set_parameter(context->dec_handle,
+                                       &context->dec_params))
+        << "eb_svt_dec_set_parameter failed";
+    ASSERT_EQ(EB_ErrorNone, eb_init_decoder(context->dec_handle))
+        << "eb_init_decoder failed";
+}
+
+static void close_decoder(SvtAv1DecContext *context) {
+    EXPECT_EQ(EB_ErrorNone, eb_deinit_decoder(context->dec_handle))
+        << "eb_deinit_decoder failed";
+    EXPECT_EQ(EB_ErrorNone, eb_dec_deinit_handle(context->dec_handle))
+        << "eb_dec_deinit_handle failed";
+}
+
+/** Fetches the picture of the last decoded frame, if any, and appends its
+ * planes to pictures */
+static void fetch_picture(EbComponentType *dec_handle,
+                          DecodedPictures *pictures) {
+    EbSvtIOFormat picture;
+    EbBufferHeaderType buffer;
+    EbAV1StreamInfo stream_info;
+    EbAV1FrameInfo frame_info;
+
+    // the decoder allocates the planes for the size of the picture, the test
+    // stream is 8-bit
+    memset(&picture, 0, sizeof(picture));
+    picture.bit_depth = EB_EIGHT_BIT;
+    memset(&buffer, 0, sizeof(buffer));
+    buffer.p_buffer = (uint8_t *)&picture;
+    if (eb_svt_dec_get_picture(
+            dec_handle, &buffer, &stream_info, &frame_info) == EB_ErrorNone &&
+        picture.luma) {
+        const size_t luma_size = picture.y_stride * picture.height;
+        const size_t chroma_size =
+            picture.cb_stride * ((picture.height + 1) >> 1);
+        std::vector<uint8_t> planes(picture.luma, picture.luma + luma_size);
+        planes.insert(planes.end(), picture.cb, picture.cb + chroma_size);
+        planes.insert(planes.end(), picture.cr, picture.cr + chroma_size);
+        pictures->push_back(planes);
+    }
+    free(picture.luma);
+    free(picture.cb);
+    free(picture.cr);
+}
+
+/** Decodes the test stream with eb_svt_decode_frame() */
+static void decode_reference(DecodedPictures *pictures) {
+    SvtAv1DecContext context;
+
+    open_decoder(&context, 1);
+    for (size_t i = 0; i < dec_test_stream_tu_count; i++) {
+        EXPECT_EQ(EB_ErrorNone,
+                  eb_svt_decode_frame(context.dec_handle,
+                                      dec_test_stream[i].data,
+                                      dec_test_stream[i].size,
+                                      0))
+            << "eb_svt_decode_frame failed";
+        fetch_picture(context.dec_handle, pictures);
+    }
+    close_decoder(&context);
+}
+
+/** @brief check_null_pointer is a api test case
+ * DecPoolApiTest.check_null_pointer is a api test case for checking null
+ * pointer and invalid parameters setting into the decoder pool functions and
+ * expect report for a EB_ErrorBadParameter return
+ *
+ * Test strategy: <br>
+ * Input nullptr and a 0 thread count to the decoder pool API and check the
+ * return value.
+ *
+ * Expected result: <br>
+ * Decoder pool API should not crash and report EB_ErrorBadParameter.
+ *
+ * Test coverage:
+ * All the decoder pool functions.
+ */
+TEST(DecPoolApiTest, check_null_pointer) {
+    EbSvtDecPool *pool = nullptr;
+    const uint8_t data[4] = {0};
+
+    EXPECT_EQ(EB_ErrorBadParameter, eb_svt_dec_pool_create(nullptr, 1));
+    EXPECT_EQ(EB_ErrorBadParameter, eb_svt_dec_pool_create(&pool, 0));
+    EXPECT_EQ(nullptr, pool);
+    EXPECT_EQ(EB_ErrorBadParameter, eb_svt_dec_pool_destroy(nullptr));
+    EXPECT_EQ(EB_ErrorBadParameter, eb_svt_dec_pool_attach(nullptr, nullptr));
+    EXPECT_EQ(EB_ErrorBadParameter, eb_svt_dec_pool_detach(nullptr));
+    EXPECT_EQ(EB_ErrorBadParameter,
+              eb_svt_dec_pool_submit(
+                  nullptr, data, sizeof(data), 0, nullptr, nullptr));
+    EXPECT_EQ(EB_ErrorBadParameter, eb_svt_dec_pool_wait(nullptr));
+
+    ASSERT_EQ(EB_ErrorNone, eb_svt_dec_pool_create(&pool, 1));
+    EXPECT_EQ(EB_ErrorBadParameter, eb_svt_dec_pool_attach(pool, nullptr));
+    EXPECT_EQ(EB_ErrorNone, eb_svt_dec_pool_destroy(pool));
+}
+
+/** @brief check_invalid_handle is a api test case
+ * DecPoolApiTest.check_invalid_handle is a api test case for checking the
+ * decoder handles the pool does not accept
+ *
+ * Test strategy: <br>
+ * Submit to a handle that is not attached, attach a multi threaded handle,
+ * attach a handle twice and submit data without a size.
+ *
+ * Expected result: <br>
+ * The calls report EB_ErrorBadParameter and leave the handles usable.
+ *
+ * Test coverage:
+ * eb_svt_dec_pool_attach, eb_svt_dec_pool_detach, eb_svt_dec_pool_submit and
+ * eb_svt_dec_pool_wait.
+ */
+TEST(DecPoolApiTest, check_invalid_handle) {
+    EbSvtDecPool *pool = nullptr;
+    SvtAv1DecContext single, multi;
+
+    ASSERT_EQ(EB_ErrorNone, eb_svt_dec_pool_create(&pool, 2));
+    open_decoder(&single, 1);
+    open_decoder(&multi, 2);
+
+    // not attached yet
+    EXPECT_EQ(EB_ErrorBadParameter,
+              eb_svt_dec_pool_submit(single.dec_handle,
+                                     dec_test_stream[0].data,
+                                     dec_test_stream[0].size,
+                                     0,
+                                     nullptr,
+                                     nullptr));
+    EXPECT_EQ(EB_ErrorBadParameter, eb_svt_dec_pool_wait(single.dec_handle));
+    EXPECT_EQ(EB_ErrorBadParameter, eb_svt_dec_pool_detach(single.dec_handle));
+
+    // attached handles must be single threaded
+    EXPECT_EQ(EB_ErrorBadParameter,
+              eb_svt_dec_pool_attach(pool, multi.dec_handle));
+
+    EXPECT_EQ(EB_ErrorNone, eb_svt_dec_pool_attach(pool, single.dec_handle));
+    EXPECT_EQ(EB_ErrorBadParameter,
+              eb_svt_dec_pool_attach(pool, single.dec_handle));
+    EXPECT_EQ(EB_ErrorBadParameter,
+              eb_svt_dec_pool_submit(
+                  single.dec_handle, nullptr, 16, 0, nullptr, nullptr));
+    EXPECT_EQ(EB_ErrorNone, eb_svt_dec_pool_detach(single.dec_handle));
+    EXPECT_EQ(EB_ErrorBadParameter, eb_svt_dec_pool_detach(single.dec_handle));
+
+    close_decoder(&multi);
+    close_decoder(&single);
+    EXPECT_EQ(EB_ErrorNone, eb_svt_dec_pool_destroy(pool));
+}
+
+typedef struct {
+    DecodedPictures pictures;
+    uint32_t decoded;
+} PoolStream;
+
+static void pool_callback(EbComponentType *dec_handle, EbErrorType error,
+                          void *user_data) {
+    PoolStream *stream = (PoolStream *)user_data;
+    EXPECT_EQ(EB_ErrorNone, error) << "decoding a temporal unit failed";
+    fetch_picture(dec_handle, &stream->pictures);
+    stream->decoded++;
+}
+
+/** @brief decode_streams is a api test case
+ * DecPoolApiTest.decode_streams is a api test case decoding several streams
+ * on the workers of one pool
+ *
+ * Test strategy: <br>
+ * Attach 3 decoders to a pool of 2 workers, submit the temporal units of the
+ * test stream to each of them, wait and detach.
+ *
+ * Expected result: <br>
+ * Every temporal unit is decoded once, in order, and every stream outputs the
+ * pictures of eb_svt_decode_frame().
+ *
+ * Test coverage:
+ * eb_svt_dec_pool_create, eb_svt_dec_pool_attach, eb_svt_dec_pool_submit,
+ * eb_svt_dec_pool_wait, eb_svt_dec_pool_detach and eb_svt_dec_pool_destroy.
+ */
+TEST(DecPoolApiTest, decode_streams) {
+    const size_t stream_count = 3;
+    EbSvtDecPool *pool = nullptr;
+    SvtAv1DecContext contexts[stream_count];
+    PoolStream streams[stream_count];
+    DecodedPictures reference;
+
+    decode_reference(&reference);
+    ASSERT_EQ(dec_test_stream_tu_count, reference.size());
+
+    ASSERT_EQ(EB_ErrorNone, eb_svt_dec_pool_create(&pool, 2));
+    for (size_t s = 0; s < stream_count; s++) {
+        open_decoder(&contexts[s], 1);
+        streams[s].decoded = 0;
+        ASSERT_EQ(EB_ErrorNone,
+                  eb_svt_dec_pool_attach(pool, contexts[s].dec_handle));
+    }
+    for (size_t i = 0; i < dec_test_stream_tu_count; i++) {
+        for (size_t s = 0; s < stream_count; s++) {
+            EXPECT_EQ(EB_ErrorNone,
+                      eb_svt_dec_pool_submit(contexts[s].dec_handle,
+                                             dec_test_stream[i].data,
+                                             dec_test_stream[i].size,
+                                             0,
+                                             pool_callback,
+                                             &streams[s]));
+        }
+    }
+    for (size_t s = 0; s < stream_count; s++) {
+        EXPECT_EQ(EB_ErrorNone, eb_svt_dec_pool_wait(contexts[s].dec_handle));
+        EXPECT_EQ(dec_test_stream_tu_count, streams[s].decoded);
+        EXPECT_TRUE(streams[s].pictures == reference)
+            << "stream " << s << " does not match eb_svt_decode_frame()";
+        EXPECT_EQ(EB_ErrorNone,
+                  eb_svt_dec_pool_detach(contexts[s].dec_handle));
+        close_decoder(&contexts[s]);
+    }
+    EXPECT_EQ(EB_ErrorNone, eb_svt_dec_pool_destroy(pool));
+}
+
+/** @brief check_teardown is a api test case
+ * DecPoolApiTest.check_teardown is a api test case for releasing the pool and
+ * the decoders while work is queued
+ *
+ * Test strategy: <br>
+ * Submit the test stream to two attached decoders, deinit the first decoder
+ * without detaching it, then destroy the pool with the second one attached.
+ *
+ * Expected result: <br>
+ * eb_deinit_decoder detaches the first decoder after its work is done, the
+ * pool decodes the queued work of the second one before detaching it, and the
+ * second decoder can still be deinit.
+ *
+ * Test coverage:
+ * eb_deinit_decoder of an attached decoder and eb_svt_dec_pool_destroy with
+ * attached decoders.
+ */
+TEST(DecPoolApiTest, check_teardown) {
+    EbSvtDecPool *pool = nullptr;
+    SvtAv1DecContext contexts[2];
+    PoolStream streams[2];
+
+    ASSERT_EQ(EB_ErrorNone, eb_svt_dec_pool_create(&pool, 1));
+    for (size_t s = 0; s < 2; s++) {
+        open_decoder(&contexts[s], 1);
+        streams[s].decoded = 0;
+        ASSERT_EQ(EB_ErrorNone,
+                  eb_svt_dec_pool_attach(pool, contexts[s].dec_handle));
+        for (size_t i = 0; i < dec_test_stream_tu_count; i++) {
+            EXPECT_EQ(EB_ErrorNone,
+                      eb_svt_dec_pool_submit(contexts[s].dec_handle,
+                                             dec_test_stream[i].data,
+                                             dec_test_stream[i].size,
+                                             0,
+                                             pool_callback,
+                                             &streams[s]));
+        }
+    }
+
+    close_decoder(&contexts[0]);
+    EXPECT_EQ(dec_test_stream_tu_count, streams[0].decoded);
+
+    EXPECT_EQ(EB_ErrorNone, eb_svt_dec_pool_destroy(pool));
+    EXPECT_EQ(dec_test_stream_tu_count, streams[1].decoded);
+    EXPECT_EQ(EB_ErrorBadParameter,
+              eb_svt_dec_pool_detach(contexts[1].dec_handle));
+    close_decoder(&contexts[1]);
+}
+
+/** @brief check_null_pointer is a api test case
+ * DecPushApiTest.check_null_pointer is a api test case for checking null
+ * pointer parameters setting into eb_svt_dec_push_data and expect report for a
+ * EB_ErrorBadParameter return
+ *
+ * Test strategy: <br>
+ * Input nullptr handle, output pointers and data with a size to the push api,
+ * then push an empty chunk.
+ *
+ * Expected result: <br>
+ * The push api should not crash and report EB_ErrorBadParameter, an empty
+ * chunk is accepted and decodes nothing.
+ *
+ * Test coverage:
+ * eb_svt_dec_push_data.
+ */
+TEST(DecPushApiTest, check_null_pointer) {
+    SvtAv1DecContext context;
+    size_t consumed = 0;
+    EbBool frame_decoded = EB_FALSE;
+
+    EXPECT_EQ(EB_ErrorBadParameter,
+              eb_svt_dec_push_data(nullptr,
+                                   dec_test_stream[0].data,
+                                   dec_test_stream[0].size,
+                                   &consumed,
+                                   &frame_decoded));
+
+    open_decoder(&context, 1);
+    EXPECT_EQ(EB_ErrorBadParameter,
+              eb_svt_dec_push_data(context.dec_handle,
+                                   dec_test_stream[0].data,
+                                   dec_test_stream[0].size,
+                                   nullptr,
+                                   &frame_decoded));
+    EXPECT_EQ(EB_ErrorBadParameter,
+              eb_svt_dec_push_data(context.dec_handle,
+                                   dec_test_stream[0].data,
+                                   dec_test_stream[0].size,
+                                   &consumed,
+                                   nullptr));
+    EXPECT_EQ(EB_ErrorBadParameter,
+              eb_svt_dec_push_data(context.dec_handle,
+                                   nullptr,
+                                   dec_test_stream[0].size,
+                                   &consumed,
+                                   &frame_decoded));
+    EXPECT_EQ(EB_ErrorNone,
+              eb_svt_dec_push_data(
+                  context.dec_handle, nullptr, 0, &consumed, &frame_decoded));
+    EXPECT_EQ(0u, consumed);
+    EXPECT_EQ(EB_FALSE, frame_decoded);
+    close_decoder(&context);
+}
+
+/** Pushes the test stream in chunks of chunk_size bytes */
+static void push_stream(size_t chunk_size, DecodedPictures *pictures) {
+    SvtAv1DecContext context;
+    std::vector<uint8_t> stream;
+
+    for (size_t i = 0; i < dec_test_stream_tu_count; i++) {
+        stream.insert(stream.end(),
+                      dec_test_stream[i].data,
+                      dec_test_stream[i].data + dec_test_stream[i].size);
+    }
+
+    open_decoder(&context, 1);
+    for (size_t offset = 0; offset < stream.size();) {
+        const size_t size = std::min(chunk_size, stream.size() - offset);
+        size_t consumed = 0;
+        EbBool frame_decoded = EB_FALSE;
+
+        ASSERT_EQ(EB_ErrorNone,
+                  eb_svt_dec_push_data(context.dec_handle,
+                                       stream.data() + offset,
+                                       size,
+                                       &consumed,
+                                       &frame_decoded))
+            << "eb_svt_dec_push_data failed at " << offset;
+        ASSERT_LE(consumed, size);
+        offset += consumed;
+        // the whole chunk is used unless decoding stopped after a frame
+        if (frame_decoded)
+            fetch_picture(context.dec_handle, pictures);
+        else
+            ASSERT_EQ(size, consumed);
+    }
+    close_decoder(&context);
+}
+
+/** @brief decode_chunks is a api test case
+ * DecPushApiTest.decode_chunks is a api test case decoding the test stream
+ * pushed in chunks that cut the OBUs at every position
+ *
+ * Test strategy: <br>
+ * Push the test stream 1 byte at a time, in 7 byte chunks, and at once.
+ *
+ * Expected result: <br>
+ * Every chunking outputs the pictures of eb_svt_decode_frame().
+ *
+ * Test coverage:
+ * eb_svt_dec_push_data.
+ */
+TEST(DecPushApiTest, decode_chunks) {
+    const size_t chunk_sizes[] = {1, 7, SIZE_MAX};
+    DecodedPictures reference;
+
+    decode_reference(&reference);
+    ASSERT_EQ(dec_test_stream_tu_count, reference.size());
+
+    for (size_t chunk_size : chunk_sizes) {
+        DecodedPictures pictures;
+        push_stream(chunk_size, &pictures);
+        EXPECT_TRUE(pictures == reference)
+            << "the stream pushed in " << chunk_size
+            << " byte chunks does not match eb_svt_decode_frame()";
+    }
+}
+
+/** @brief check_teardown is a api test case
+ * DecPushApiTest.check_teardown is a api test case for releasing a decoder
+ * while the push api keeps the start of an OBU
+ *
+ * Test strategy: <br>
+ * Push the test stream up to the middle of its first frame, then deinit the
+ * decoder.
+ *
+ * Expected result: <br>
+ * The partial OBU is kept without decoding a frame, and the decoder is
+ * released without crashing.
+ *
+ * Test coverage:
+ * eb_svt_dec_push_data and eb_deinit_decoder.
+ */
+TEST(DecPushApiTest, check_teardown) {
+    SvtAv1DecContext context;
+    size_t consumed = 0;
+    EbBool frame_decoded = EB_FALSE;
+
+    open_decoder(&context, 1);
+    EXPECT_EQ(EB_ErrorNone,
+              eb_svt_dec_push_data(context.dec_handle,
+                                   dec_test_stream[0].data,
+                                   dec_test_stream[0].size / 2,
+                                   &consumed,
+                                   &frame_decoded));
+    EXPECT_EQ(dec_test_stream[0].size / 2, consumed);
+    EXPECT_EQ(EB_FALSE, frame_decoded);
+    close_decoder(&context);
+}
+
+}  // namespace
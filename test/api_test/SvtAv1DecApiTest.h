@@ -0,0 +1,73 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ * SPDX - License - Identifier: BSD - 2 - Clause - Patent
+ */
+
+/******************************************************************************
+ * @file SvtAv1DecApiTest.h
+ *
+ * @brief Define the test stream and the SvtAv1DecContext struct of the decoder
+ * api tests.
+ *
+ ******************************************************************************/
+#include "EbSvtAv1Dec.h"
+#include "gtest/gtest.h"
+
+/** @defgroup svt_av1_test Enums and Structures definition of decoder api test
+ *  Defines the data refered in decoder tests
+ *  @{
+ */
+namespace svt_av1_test {
+
+/** Temporal units of a 3 frame 64x64 8-bit 4:2:0 stream, coded by
+ * SvtAv1EncApp at -enc-mode 8 -q 63 in the low overhead format */
+static const uint8_t tu0[] = {
+    0x12, 0x00, 0x0a, 0x0d, 0x00, 0x00, 0x00, 0x07, 0xf8, 0x01, 0xf8, 0x01,
+    0xf8, 0x95, 0xf2, 0x00, 0x80, 0x32, 0xa6, 0x01, 0x10, 0x00, 0xdc, 0x00,
+    0xe3, 0x87, 0x1c, 0x11, 0xda, 0x80, 0xcd, 0x1d, 0xcf, 0x40, 0xd3, 0x97,
+    0x8a, 0x60, 0x92, 0xc3, 0x24, 0xfa, 0x48, 0x4f, 0x23, 0xaa, 0xd7, 0x43,
+    0x2a, 0x41, 0x42, 0x0b, 0xd0, 0x85, 0x85, 0xab, 0xd7, 0xc3, 0x0c, 0xa9,
+    0x98, 0x20, 0x27, 0x99, 0xa7, 0xdc, 0x46, 0xb0, 0x62, 0x2f, 0x8c, 0x83,
+    0xc2, 0x04, 0xe1, 0xab, 0xd5, 0x1d, 0xdc, 0x02, 0x0c, 0xb2, 0xe1, 0x35,
+    0x40, 0xf9, 0x28, 0xfd, 0x35, 0x13, 0x71, 0x1e, 0x99, 0xc9, 0x83, 0x3a,
+    0x07, 0x21, 0x2d, 0xcc, 0x1a, 0xfc, 0xea, 0xec, 0x1b, 0x95, 0xf9, 0x4c,
+    0xd8, 0x50, 0x82, 0xe5, 0xd0, 0xe8, 0xab, 0x28, 0xca, 0xdd, 0x15, 0xb9,
+    0x28, 0x27, 0xa6, 0xf8, 0xcd, 0xe4, 0x28, 0x5f, 0x53, 0xdf, 0x1d, 0xc9,
+    0xb8, 0xc1, 0x5e, 0x47, 0x3e, 0x3f, 0x96, 0x3e, 0x14, 0x4f, 0xcd, 0xc7,
+    0xbd, 0x78, 0xc5, 0xda, 0xb3, 0x23, 0xd6, 0x35, 0x02, 0xb0, 0x4d, 0x7c,
+    0x7c, 0x3a, 0x38, 0x15, 0x32, 0x40, 0x32, 0x00, 0xe0, 0xd9, 0x44, 0xa6,
+    0x02, 0xff, 0x50, 0x3c, 0xec, 0x18, 0xbe, 0x2f, 0x4c, 0xac, 0xeb, 0xfb,
+    0x1a, 0x46, 0x61, 0xc3, 0xf3, 0x70,
+};
+static const uint8_t tu1[] = {
+    0x12, 0x00, 0x32, 0x11, 0x30, 0x02, 0x20, 0x09, 0x24, 0x92, 0x23, 0xfe,
+    0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x94, 0x97, 0x50,
+};
+static const uint8_t tu2[] = {
+    0x12, 0x00, 0x32, 0x13, 0x30, 0x04, 0x08, 0x09, 0x24, 0x92, 0x23, 0xf0,
+    0x04, 0xb2, 0xa4, 0x90, 0x60, 0xe2, 0x80, 0x00, 0x16, 0x98, 0x49,
+};
+
+typedef struct {
+    const uint8_t *data; /**< temporal unit data */
+    size_t size;         /**< temporal unit size in bytes */
+} DecTestTemporalUnit;
+
+static const DecTestTemporalUnit dec_test_stream[] = {
+    {tu0, sizeof(tu0)},
+    {tu1, sizeof(tu1)},
+    {tu2, sizeof(tu2)},
+};
+static const size_t dec_test_stream_tu_count =
+    sizeof(dec_test_stream) / sizeof(dec_test_stream[0]);
+
+/** SvtAv1DecContext is a set of decoder contexts when creation and setup */
+typedef struct {
+    EbComponentType*
+        dec_handle; /**< decoder handle, created from decoder library */
+    EbSvtAv1DecConfiguration dec_params; /**< decoder parameter set */
+} SvtAv1DecContext;
+
+}  // namespace svt_av1_test
+
+/** @} */  // end of svt_av1_test
@@ -11,6 +11,8 @@
  * @author Cidana-Edmond, Cidana-Ryan, Cidana-Wenyao
  *
  ******************************************************************************/
+#include <stdio.h>
+#include <vector>
 #include "EbSvtAv1Enc.h"
 #include "gtest/gtest.h"
 #include "SvtAv1EncApiTest.h"
@@ -82,6 +84,11 @@ TEST(EncApiTest, check_null_pointer) {
     //          nullptr));
     // open encoder with null pointer
     EXPECT_EQ(EB_ErrorBadParameter, eb_init_encoder(nullptr));
+    // get memory footprint with null pointer
+    EXPECT_EQ(EB_ErrorBadParameter,
+              eb_svt_enc_get_memory_footprint(nullptr, nullptr));
+    // reset encoder with null pointer
+    EXPECT_EQ(EB_ErrorBadParameter, eb_svt_enc_reset(nullptr, nullptr));
     // get stream header with null pointer
     EXPECT_EQ(EB_ErrorBadParameter, eb_svt_enc_stream_header(nullptr, nullptr));
     // get end of sequence NAL with null pointer
@@ -146,6 +153,396 @@ TEST(EncApiTest, DISABLED_check_normal_setup) {
         << "eb_deinit_handle failed";
 }
 
+/** @brief check_memory_budget is a api test case
+ * EncApiTest.check_memory_budget is a api test case for checking that a memory
+ * budget shrinks the estimated pool footprint reported after set_parameter
+ *
+ * Test strategy: <br>
+ * Setup the encoder without a budget and read the footprint, then setup again
+ * with a budget of half of it and with an unreachable budget.
+ *
+ * Expected result: <br>
+ * The budgeted footprints are smaller than the unbudgeted one, and an
+ * unreachable budget still leaves a valid configuration.
+ *
+ * Test coverage:
+ * max_memory_mb and eb_svt_enc_get_memory_footprint.
+ */
+static uint64_t get_footprint(uint32_t max_memory_mb) {
+    SvtAv1Context context;
+    uint64_t footprint = 0;
+    memset(&context, 0, sizeof(context));
+
+    EXPECT_EQ(
+        EB_ErrorNone,
+        eb_init_handle(&context.enc_handle, &context, &context.enc_params))
+        << "eb_init_handle failed";
+    context.enc_params.source_width = 1920;
+    context.enc_params.source_height = 1080;
+    context.enc_params.max_memory_mb = max_memory_mb;
+    EXPECT_EQ(EB_ErrorNone,
+              eb_svt_enc_set_parameter(context.enc_handle, &context.enc_params))
+        << "eb_svt_enc_set_parameter failed";
+    EXPECT_EQ(EB_ErrorNone,
+              eb_svt_enc_get_memory_footprint(context.enc_handle, &footprint))
+        << "eb_svt_enc_get_memory_footprint failed";
+    // see EncParamTestBase::TearDown about eb_deinit_encoder
+    EXPECT_EQ(EB_ErrorNone, eb_deinit_encoder(context.enc_handle))
+        << "eb_deinit_encoder failed";
+    EXPECT_EQ(EB_ErrorNone, eb_deinit_handle(context.enc_handle))
+        << "eb_deinit_handle failed";
+    return footprint;
+}
+
+TEST(EncApiTest, check_memory_budget) {
+    const uint64_t unbudgeted = get_footprint(0);
+    ASSERT_GT(unbudgeted, 0u);
+
+    const uint64_t half = get_footprint((uint32_t)(unbudgeted >> 21));
+    EXPECT_LT(half, unbudgeted);
+
+    const uint64_t minimum = get_footprint(1);
+    EXPECT_GT(minimum, 0u);
+    EXPECT_LE(minimum, half);
+}
+
+/**
+ * @brief Verify that the memory budget does not shorten the look-ahead of
+ * rate control mode 2 below the intra period
+ *
+ * Test strategy: <br>
+ * Setup a constraint VBR encoder with an unreachable budget, then initialize
+ * it.
+ *
+ * Expected result: <br>
+ * eb_svt_enc_set_parameter keeps the configuration, the footprint stays above
+ * the budget and eb_init_encoder fails instead of running with a look-ahead
+ * shorter than the intra period.
+ *
+ * Test coverage:
+ * max_memory_mb with rate_control_mode 2.
+ */
+TEST(EncApiTest, check_memory_budget_cvbr) {
+    SvtAv1Context context;
+    uint64_t footprint = 0;
+    memset(&context, 0, sizeof(context));
+
+    ASSERT_EQ(
+        EB_ErrorNone,
+        eb_init_handle(&context.enc_handle, &context, &context.enc_params))
+        << "eb_init_handle failed";
+    context.enc_params.source_width = 1920;
+    context.enc_params.source_height = 1080;
+    context.enc_params.rate_control_mode = 2;
+    context.enc_params.intra_period_length = 31;
+    context.enc_params.look_ahead_distance = 31;
+    context.enc_params.max_memory_mb = 1;
+    EXPECT_EQ(EB_ErrorNone,
+              eb_svt_enc_set_parameter(context.enc_handle, &context.enc_params))
+        << "eb_svt_enc_set_parameter failed";
+    EXPECT_EQ(EB_ErrorNone,
+              eb_svt_enc_get_memory_footprint(context.enc_handle, &footprint))
+        << "eb_svt_enc_get_memory_footprint failed";
+    EXPECT_GT(footprint, 1u << 20);
+    EXPECT_EQ(EB_ErrorInsufficientResources, eb_init_encoder(context.enc_handle))
+        << "eb_init_encoder accepted an unreachable budget";
+    EXPECT_EQ(EB_ErrorNone, eb_deinit_encoder(context.enc_handle))
+        << "eb_deinit_encoder failed";
+    EXPECT_EQ(EB_ErrorNone, eb_deinit_handle(context.enc_handle))
+        << "eb_deinit_handle failed";
+}
+
+/** Fill an 8-bit 4:2:0 frame with a texture moving with the frame index */
+static void fill_frame(std::vector<uint8_t> &frame, int width, int height,
+                       int index) {
+    frame.resize(width * height * 3 / 2);
+    for (int y = 0; y < height; ++y)
+        for (int x = 0; x < width; ++x)
+            frame[y * width + x] =
+                (uint8_t)(((x + 3 * index) * 2) ^ ((y + index) * 3));
+    for (int i = width * height; i < (int)frame.size(); ++i)
+        frame[i] = (uint8_t)(128 + ((i + index) & 15));
+}
+
+/** Encode frame_count frames of fill_frame(), send the EOS and drain the
+ * packets until the EOS one. The payloads are appended to stream, returns
+ * false on an encoder error. */
+static bool encode_frames(EbComponentType *handle, int width, int height,
+                          int frame_count, std::vector<uint8_t> *stream) {
+    std::vector<uint8_t> frame;
+    EbSvtIOFormat in_pic;
+    EbBufferHeaderType in_buf;
+
+    for (int i = 0; i < frame_count; ++i) {
+        fill_frame(frame, width, height, i);
+        memset(&in_pic, 0, sizeof(in_pic));
+        in_pic.luma = frame.data();
+        in_pic.cb = in_pic.luma + width * height;
+        in_pic.cr = in_pic.cb + width * height / 4;
+        in_pic.y_stride = width;
+        in_pic.cb_stride = in_pic.cr_stride = width / 2;
+        memset(&in_buf, 0, sizeof(in_buf));
+        in_buf.size = sizeof(in_buf);
+        in_buf.p_buffer = (uint8_t *)&in_pic;
+        in_buf.n_filled_len = (uint32_t)frame.size();
+        in_buf.pts = i;
+        in_buf.pic_type = EB_AV1_INVALID_PICTURE;
+        if (eb_svt_enc_send_picture(handle, &in_buf) != EB_ErrorNone)
+            return false;
+    }
+    memset(&in_buf, 0, sizeof(in_buf));
+    in_buf.flags = EB_BUFFERFLAG_EOS;
+    in_buf.pic_type = EB_AV1_INVALID_PICTURE;
+    if (eb_svt_enc_send_picture(handle, &in_buf) != EB_ErrorNone)
+        return false;
+
+    for (;;) {
+        EbBufferHeaderType *out_buf = nullptr;
+        EbErrorType err = eb_svt_get_packet(handle, &out_buf, 1);
+        if (err == EB_ErrorMax) {
+            eb_svt_release_out_buffer(&out_buf);
+            return false;
+        }
+        if (err != EB_ErrorNone)
+            continue;
+        const bool eos = (out_buf->flags & EB_BUFFERFLAG_EOS) != 0;
+        stream->insert(stream->end(),
+                       out_buf->p_buffer,
+                       out_buf->p_buffer + out_buf->n_filled_len);
+        eb_svt_release_out_buffer(&out_buf);
+        if (eos)
+            return true;
+    }
+}
+
+/** @brief check_fast_first_pass is a api test case
+ * EncApiTest.check_fast_first_pass is a api test case for the two-pass VBR
+ * flow with the fast first pass statistics file
+ *
+ * Test strategy: <br>
+ * Encode a first pass with fast_first_pass into a temporary statistics file,
+ * then a VBR second pass reading it back.
+ *
+ * Expected result: <br>
+ * The statistics file starts with its header and holds one record per
+ * frame, and both passes output a stream.
+ *
+ * Test coverage:
+ * fast_first_pass, output_stat_file and input_stat_file.
+ */
+TEST(EncApiTest, check_fast_first_pass) {
+    const int width = 320;
+    const int height = 240;
+    const int frame_count = 16;
+    // sizes of the header and of the per frame record of the file format
+    const long header_size = 16;
+    const long record_size = 32;
+    FILE *stat_file = tmpfile();
+    ASSERT_NE(stat_file, nullptr) << "tmpfile failed";
+
+    for (int pass = 0; pass < 2; ++pass) {
+        SvtAv1Context context;
+        std::vector<uint8_t> stream;
+        memset(&context, 0, sizeof(context));
+
+        ASSERT_EQ(EB_ErrorNone,
+                  eb_init_handle(
+                      &context.enc_handle, &context, &context.enc_params))
+            << "eb_init_handle failed";
+        context.enc_params.source_width = width;
+        context.enc_params.source_height = height;
+        if (pass == 0) {
+            context.enc_params.fast_first_pass = 1;
+            context.enc_params.output_stat_file = stat_file;
+        } else {
+            rewind(stat_file);
+            context.enc_params.rate_control_mode = 1;
+            context.enc_params.target_bit_rate = 200000;
+            context.enc_params.input_stat_file = stat_file;
+        }
+        ASSERT_EQ(
+            EB_ErrorNone,
+            eb_svt_enc_set_parameter(context.enc_handle, &context.enc_params))
+            << "eb_svt_enc_set_parameter failed at pass " << pass;
+        ASSERT_EQ(EB_ErrorNone, eb_init_encoder(context.enc_handle))
+            << "eb_init_encoder failed at pass " << pass;
+        EXPECT_TRUE(encode_frames(
+            context.enc_handle, width, height, frame_count, &stream))
+            << "encoding failed at pass " << pass;
+        EXPECT_FALSE(stream.empty()) << "no output at pass " << pass;
+        EXPECT_EQ(EB_ErrorNone, eb_deinit_encoder(context.enc_handle))
+            << "eb_deinit_encoder failed";
+        EXPECT_EQ(EB_ErrorNone, eb_deinit_handle(context.enc_handle))
+            << "eb_deinit_handle failed";
+
+        if (pass == 0) {
+            char magic[4] = {0};
+            fflush(stat_file);
+            rewind(stat_file);
+            ASSERT_EQ(fread(magic, 1, 4, stat_file), 4u);
+            EXPECT_EQ(memcmp(magic, "FPS1", 4), 0);
+            fseek(stat_file, 0, SEEK_END);
+            EXPECT_EQ(ftell(stat_file),
+                      header_size + frame_count * record_size);
+        }
+    }
+    fclose(stat_file);
+}
+
+/** Encode frame_count frames at width x height with a new encoder */
+static bool encode_with_new_encoder(int width, int height, int frame_count,
+                                    std::vector<uint8_t> *stream) {
+    SvtAv1Context context;
+    bool ok;
+    memset(&context, 0, sizeof(context));
+
+    if (eb_init_handle(&context.enc_handle, &context, &context.enc_params) !=
+        EB_ErrorNone)
+        return false;
+    context.enc_params.source_width = width;
+    context.enc_params.source_height = height;
+    ok = eb_svt_enc_set_parameter(context.enc_handle, &context.enc_params) ==
+             EB_ErrorNone &&
+         eb_init_encoder(context.enc_handle) == EB_ErrorNone &&
+         encode_frames(context.enc_handle, width, height, frame_count, stream);
+    eb_deinit_encoder(context.enc_handle);
+    eb_deinit_handle(context.enc_handle);
+    return ok;
+}
+
+/** @brief check_reset_between_sequences is a api test case
+ * EncApiTest.check_reset_between_sequences is a api test case to restart an
+ * encoder on new sequences with eb_svt_enc_reset
+ *
+ * Test strategy: <br>
+ * Encode a sequence up to its EOS packet, reset the encoder to another
+ * resolution and encode again, then reset back to the first resolution and
+ * encode again. Encode the same sequences with new encoders.
+ *
+ * Expected result: <br>
+ * Every reset succeeds, and each sequence encoded after a reset is identical
+ * to the one encoded by a new encoder.
+ *
+ * Test coverage:
+ * eb_svt_enc_reset after a flushed sequence.
+ */
+TEST(EncApiTest, check_reset_between_sequences) {
+    const int sizes[][2] = {{320, 240}, {256, 192}, {320, 240}};
+    const int frame_count = 8;
+    SvtAv1Context context;
+    memset(&context, 0, sizeof(context));
+
+    ASSERT_EQ(
+        EB_ErrorNone,
+        eb_init_handle(&context.enc_handle, &context, &context.enc_params))
+        << "eb_init_handle failed";
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        std::vector<uint8_t> stream;
+        std::vector<uint8_t> reference;
+
+        context.enc_params.source_width = sizes[i][0];
+        context.enc_params.source_height = sizes[i][1];
+        if (i == 0) {
+            ASSERT_EQ(EB_ErrorNone,
+                      eb_svt_enc_set_parameter(context.enc_handle,
+                                               &context.enc_params))
+                << "eb_svt_enc_set_parameter failed";
+            ASSERT_EQ(EB_ErrorNone, eb_init_encoder(context.enc_handle))
+                << "eb_init_encoder failed";
+        } else {
+            ASSERT_EQ(EB_ErrorNone,
+                      eb_svt_enc_reset(context.enc_handle, &context.enc_params))
+                << "eb_svt_enc_reset failed at sequence " << i;
+        }
+        ASSERT_TRUE(encode_frames(context.enc_handle,
+                                  sizes[i][0],
+                                  sizes[i][1],
+                                  frame_count,
+                                  &stream))
+            << "encoding failed at sequence " << i;
+        ASSERT_TRUE(encode_with_new_encoder(
+            sizes[i][0], sizes[i][1], frame_count, &reference))
+            << "reference encoding failed at sequence " << i;
+        EXPECT_FALSE(stream.empty()) << "no output at sequence " << i;
+        EXPECT_TRUE(stream == reference)
+            << "sequence " << i << " differs from a new encoder's";
+    }
+    EXPECT_EQ(EB_ErrorNone, eb_deinit_encoder(context.enc_handle))
+        << "eb_deinit_encoder failed";
+    EXPECT_EQ(EB_ErrorNone, eb_deinit_handle(context.enc_handle))
+        << "eb_deinit_handle failed";
+}
+
+/** @brief check_reset_active_stream is a api test case
+ * EncApiTest.check_reset_active_stream is a api test case to check that a
+ * sequence still being encoded cannot be reset
+ *
+ * Test strategy: <br>
+ * Send pictures without the EOS, call eb_svt_enc_reset, then finish the
+ * sequence and reset again.
+ *
+ * Expected result: <br>
+ * The first reset is rejected and leaves the sequence to finish normally,
+ * the reset after the EOS packet succeeds.
+ *
+ * Test coverage:
+ * eb_svt_enc_reset during a sequence.
+ */
+TEST(EncApiTest, check_reset_active_stream) {
+    const int width = 320;
+    const int height = 240;
+    std::vector<uint8_t> frame;
+    std::vector<uint8_t> stream;
+    EbSvtIOFormat in_pic;
+    EbBufferHeaderType in_buf;
+    SvtAv1Context context;
+    memset(&context, 0, sizeof(context));
+
+    ASSERT_EQ(
+        EB_ErrorNone,
+        eb_init_handle(&context.enc_handle, &context, &context.enc_params))
+        << "eb_init_handle failed";
+    context.enc_params.source_width = width;
+    context.enc_params.source_height = height;
+    ASSERT_EQ(EB_ErrorNone,
+              eb_svt_enc_set_parameter(context.enc_handle, &context.enc_params))
+        << "eb_svt_enc_set_parameter failed";
+    ASSERT_EQ(EB_ErrorNone, eb_init_encoder(context.enc_handle))
+        << "eb_init_encoder failed";
+
+    fill_frame(frame, width, height, 0);
+    memset(&in_pic, 0, sizeof(in_pic));
+    in_pic.luma = frame.data();
+    in_pic.cb = in_pic.luma + width * height;
+    in_pic.cr = in_pic.cb + width * height / 4;
+    in_pic.y_stride = width;
+    in_pic.cb_stride = in_pic.cr_stride = width / 2;
+    memset(&in_buf, 0, sizeof(in_buf));
+    in_buf.size = sizeof(in_buf);
+    in_buf.p_buffer = (uint8_t *)&in_pic;
+    in_buf.n_filled_len = (uint32_t)frame.size();
+    in_buf.pic_type = EB_AV1_INVALID_PICTURE;
+    ASSERT_EQ(EB_ErrorNone, eb_svt_enc_send_picture(context.enc_handle, &in_buf))
+        << "eb_svt_enc_send_picture failed";
+
+    EXPECT_NE(EB_ErrorNone,
+              eb_svt_enc_reset(context.enc_handle, &context.enc_params))
+        << "eb_svt_enc_reset accepted a sequence without its EOS";
+
+    // The sequence is left intact, it still encodes to its end
+    EXPECT_TRUE(encode_frames(context.enc_handle, width, height, 4, &stream))
+        << "encoding failed after the rejected reset";
+    EXPECT_FALSE(stream.empty()) << "no output after the rejected reset";
+    EXPECT_EQ(EB_ErrorNone,
+              eb_svt_enc_reset(context.enc_handle, &context.enc_params))
+        << "eb_svt_enc_reset failed after the EOS";
+
+    EXPECT_EQ(EB_ErrorNone, eb_deinit_encoder(context.enc_handle))
+        << "eb_deinit_encoder failed";
+    EXPECT_EQ(EB_ErrorNone, eb_deinit_handle(context.enc_handle))
+        << "eb_deinit_handle failed";
+}
+
 /** @brief repeat_normal_setup is a api test case
  * EncApiTest.repeat_normal_setup is a api test case of repeating test with a
  * default normal setup to check for a resource or memory leak
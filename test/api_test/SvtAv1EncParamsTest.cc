@@ -123,6 +123,8 @@ class EncParamTestBase : public ::testing::Test {
             }
         } else if (!param_name_str_.compare("target_bit_rate")) {
             ctxt_.enc_params.rate_control_mode = 1;
+        } else if (!param_name_str_.compare("max_bit_rate")) {
+            ctxt_.enc_params.rate_control_mode = 3;
         } else if (!param_name_str_.compare("injector_frame_rate")) {
             ctxt_.enc_params.speed_control_flag = 1;
         } else if (!param_name_str_.compare("altref_strength") ||
@@ -341,6 +343,10 @@ PARAM_TEST(EncParamLookAheadDistanceTest);
 DEFINE_PARAM_TEST_CLASS(EncParamTargetBitRateTest, target_bit_rate);
 PARAM_TEST(EncParamTargetBitRateTest);
 
+/** Test case for max_bit_rate*/
+DEFINE_PARAM_TEST_CLASS(EncParamMaxBitRateTest, max_bit_rate);
+PARAM_TEST(EncParamMaxBitRateTest);
+
 /** Test case for max_qp_allowed*/
 DEFINE_PARAM_TEST_CLASS(EncParamMaxQPAllowTest, max_qp_allowed);
 PARAM_TEST(EncParamMaxQPAllowTest);
@@ -390,6 +396,10 @@ PARAM_TEST(EncParamInjectorFrameRateTest);
 DEFINE_PARAM_TEST_CLASS(EncParamLogicalProcessorsTest, logical_processors);
 PARAM_TEST(EncParamLogicalProcessorsTest);
 
+/** Test case for max_memory_mb*/
+DEFINE_PARAM_TEST_CLASS(EncParamMaxMemoryTest, max_memory_mb);
+PARAM_TEST(EncParamMaxMemoryTest);
+
 /** Test case for target_socket*/
 DEFINE_PARAM_TEST_CLASS(EncParamTargetSocketTest, target_socket);
 PARAM_TEST(EncParamTargetSocketTest);
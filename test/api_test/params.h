@@ -705,6 +705,24 @@ static const vector<uint32_t> invalid_target_bit_rate = {
     // none
 };
 
+/* Maximum bitrate in bits/second, only applicable when rate control mode is
+ * set to 3.
+ *
+ * Default is 0. */
+static const vector<uint32_t> default_max_bit_rate = {
+    0,
+};
+static const vector<uint32_t> valid_max_bit_rate = {
+    0,
+    1000,
+    1000000,
+    7000000,
+    0xFFFFFFFF,
+};
+static const vector<uint32_t> invalid_max_bit_rate = {
+    // none
+};
+
 /* Maxium QP value allowed for rate control use, only applicable when rate
  * control mode is set to 1. It has to be greater or equal to minQpAllowed.
  *
@@ -960,6 +978,21 @@ static const vector<uint32_t> invalid_logical_processors = {
     // ...
 };
 
+/* Memory budget in MB for the picture buffer pools. 0 = no budget. */
+static const vector<uint32_t> default_max_memory_mb = {
+    0,
+};
+static const vector<uint32_t> valid_max_memory_mb = {
+    0,
+    1,
+    64,
+    1024,
+    0xFFFFFFFF,
+};
+static const vector<uint32_t> invalid_max_memory_mb = {
+    // ...
+};
+
 /* Target socket to run on. For dual socket systems, this can specify which
  * socket the encoder runs on.
  *
@@ -0,0 +1,37 @@
+#
+# Copyright(c) 2019 Netflix, Inc
+# SPDX - License - Identifier: BSD - 2 - Clause - Patent
+#
+
+# Writes an 8-bit 4:2:0 clip for the application tests. The samples are
+# printable characters, each row is a window of the alphabet moving with the
+# row and the frame.
+function(write_app_test_clip path width height frames)
+    set(alphabet "")
+    foreach(code RANGE 33 126)
+        string(ASCII ${code} char)
+        string(APPEND alphabet "${char}")
+    endforeach()
+    string(REPEAT "${alphabet}" 4 alphabet)
+    math(EXPR chroma_width "${width} / 2")
+    math(EXPR chroma_rows "${height} / 2 * 2")
+    math(EXPR last_frame "${frames} - 1")
+    math(EXPR last_row "${height} - 1")
+    math(EXPR last_chroma_row "${chroma_rows} - 1")
+
+    file(WRITE "${path}" "")
+    foreach(frame RANGE ${last_frame})
+        set(picture "")
+        foreach(row RANGE ${last_row})
+            math(EXPR offset "(${row} * 7 + ${frame} * 3) % 94")
+            string(SUBSTRING "${alphabet}" ${offset} ${width} line)
+            string(APPEND picture "${line}")
+        endforeach()
+        foreach(row RANGE ${last_chroma_row})
+            math(EXPR offset "(${row} + ${frame}) % 94")
+            string(SUBSTRING "${alphabet}" ${offset} ${chroma_width} line)
+            string(APPEND picture "${line}")
+        endforeach()
+        file(APPEND "${path}" "${picture}")
+    endforeach()
+endfunction()
@@ -0,0 +1,67 @@
+#
+# Copyright(c) 2019 Netflix, Inc
+# SPDX - License - Identifier: BSD - 2 - Clause - Patent
+#
+
+# Encodes a generated clip, then checks that SvtAv1DecApp run with
+# SVT_AV1_DEC_ARGS outputs the same pictures as a default decode.
+
+# cmake-format: off
+if(NOT SVT_AV1_ENC_APP
+    OR NOT SVT_AV1_DEC_APP
+    OR NOT SVT_AV1_TEST_DIR
+    OR NOT SVT_AV1_DEC_ARGS)
+    message(FATAL_ERROR
+        "SVT_AV1_ENC_APP, SVT_AV1_DEC_APP, SVT_AV1_TEST_DIR and SVT_AV1_DEC_ARGS must be defined.")
+endif()
+# cmake-format: on
+
+# The height is not a multiple of 8 so the last SB row is partial
+set(width 200)
+set(height 134)
+set(frames 20)
+set(intra_period 9)
+separate_arguments(dec_args UNIX_COMMAND "${SVT_AV1_DEC_ARGS}")
+
+file(MAKE_DIRECTORY "${SVT_AV1_TEST_DIR}")
+set(input "${SVT_AV1_TEST_DIR}/md5_input.yuv")
+set(stream "${SVT_AV1_TEST_DIR}/md5_stream.ivf")
+set(reference "${SVT_AV1_TEST_DIR}/md5_reference.yuv")
+set(output "${SVT_AV1_TEST_DIR}/md5_output.yuv")
+
+include("${CMAKE_CURRENT_LIST_DIR}/app_test_clip.cmake")
+write_app_test_clip("${input}" ${width} ${height} ${frames})
+
+execute_process(COMMAND "${SVT_AV1_ENC_APP}"
+    -i "${input}" -w ${width} -h ${height} -n ${frames}
+    -intra-period ${intra_period} -b "${stream}"
+    RESULT_VARIABLE enc_result
+    OUTPUT_QUIET
+    ERROR_QUIET)
+if(NOT enc_result EQUAL 0)
+    message(FATAL_ERROR "Encoding the test stream failed.")
+endif()
+
+execute_process(COMMAND "${SVT_AV1_DEC_APP}" -i "${stream}" -o "${reference}"
+    RESULT_VARIABLE dec_result
+    OUTPUT_QUIET
+    ERROR_QUIET)
+if(NOT dec_result EQUAL 0)
+    message(FATAL_ERROR "The default decode failed.")
+endif()
+
+execute_process(COMMAND "${SVT_AV1_DEC_APP}" -i "${stream}" -o "${output}" ${dec_args}
+    RESULT_VARIABLE dec_result
+    OUTPUT_QUIET
+    ERROR_QUIET)
+if(NOT dec_result EQUAL 0)
+    message(FATAL_ERROR "The decode with ${SVT_AV1_DEC_ARGS} failed (${dec_result}).")
+endif()
+
+file(MD5 "${reference}" reference_md5)
+file(MD5 "${output}" output_md5)
+if(NOT reference_md5 STREQUAL output_md5)
+    message(FATAL_ERROR
+        "The decode with ${SVT_AV1_DEC_ARGS} outputs ${output_md5}, ${reference_md5} expected.")
+endif()
+message(STATUS "The decode with ${SVT_AV1_DEC_ARGS} matches the default decode (${output_md5})")
@@ -0,0 +1,73 @@
+#
+# Copyright(c) 2019 Netflix, Inc
+# SPDX - License - Identifier: BSD - 2 - Clause - Patent
+#
+
+# Encodes a test vector with SvtAv1EncApp, then benchmarks the decoding of the
+# stream with SvtAv1DecApp -bench. The results are written to
+# $SVT_AV1_BENCH_DIR/<test vector name>.json
+
+# cmake-format: off
+if(NOT SVT_AV1_E2E_ROOT
+    OR NOT SVT_AV1_TEST_FILE
+    OR NOT SVT_AV1_ENC_APP
+    OR NOT SVT_AV1_DEC_APP
+    OR NOT SVT_AV1_BENCH_DIR)
+    message(FATAL_ERROR
+        "SVT_AV1_E2E_ROOT, SVT_AV1_TEST_FILE, SVT_AV1_ENC_APP, SVT_AV1_DEC_APP and
+        SVT_AV1_BENCH_DIR must be defined.")
+endif()
+# cmake-format: on
+
+if(NOT SVT_AV1_BENCH_THREADS)
+    set(SVT_AV1_BENCH_THREADS 1)
+endif()
+
+# The vectors are where test_data_download_worker.cmake stores them
+if(NOT SVT_AV1_STORE_PATH)
+    set(SVT_AV1_STORE_PATH "$ENV{SVT_AV1_TEST_VECTOR_PATH}")
+endif()
+if("${SVT_AV1_STORE_PATH}" STREQUAL "")
+    set(SVT_AV1_STORE_PATH "${SVT_AV1_E2E_ROOT}/../vectors/")
+endif()
+
+set(input "${SVT_AV1_STORE_PATH}/${SVT_AV1_TEST_FILE}")
+if(NOT EXISTS "${input}")
+    message(FATAL_ERROR "${input} is missing, build the TestVectors target first.")
+endif()
+
+get_filename_component(name "${SVT_AV1_TEST_FILE}" NAME_WE)
+file(MAKE_DIRECTORY "${SVT_AV1_BENCH_DIR}")
+set(stream "${SVT_AV1_BENCH_DIR}/${name}.ivf")
+set(result_file "${SVT_AV1_BENCH_DIR}/${name}.json")
+
+set(enc_args -i "${input}" -b "${stream}" -enc-mode 8)
+set(dec_args -i "${stream}" -bench ${SVT_AV1_BENCH_THREADS} -bench-json "${result_file}")
+
+# The raw vectors carry their size in their name, the y4m ones in their header
+if("${SVT_AV1_TEST_FILE}" MATCHES "_([0-9]+)_([0-9]+)_[^/]*\\.yuv$")
+    list(APPEND enc_args -w ${CMAKE_MATCH_1} -h ${CMAKE_MATCH_2})
+elseif("${SVT_AV1_TEST_FILE}" MATCHES "\\.y4m$")
+    file(READ "${input}" y4m_header LIMIT 128)
+    if("${y4m_header}" MATCHES " C[0-9]+p10")
+        list(APPEND dec_args -bit-depth 10)
+    endif()
+endif()
+
+# The stream is kept between runs so that only the decoding is redone
+if(NOT EXISTS "${stream}" OR "${input}" IS_NEWER_THAN "${stream}")
+    execute_process(COMMAND "${SVT_AV1_ENC_APP}" ${enc_args}
+        RESULT_VARIABLE enc_result
+        OUTPUT_QUIET
+        ERROR_QUIET)
+    if(NOT enc_result EQUAL 0)
+        file(REMOVE "${stream}")
+        message(FATAL_ERROR "Encoding ${SVT_AV1_TEST_FILE} failed.")
+    endif()
+endif()
+
+execute_process(COMMAND "${SVT_AV1_DEC_APP}" ${dec_args} RESULT_VARIABLE dec_result)
+if(NOT dec_result EQUAL 0)
+    message(FATAL_ERROR "Decoder benchmark of ${SVT_AV1_TEST_FILE} failed.")
+endif()
+message(STATUS "Decoder benchmark of ${SVT_AV1_TEST_FILE} written to ${result_file}")
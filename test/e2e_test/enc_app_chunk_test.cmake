@@ -0,0 +1,82 @@
+#
+# Copyright(c) 2019 Netflix, Inc
+# SPDX - License - Identifier: BSD - 2 - Clause - Patent
+#
+
+# Encodes a generated clip with SvtAv1EncApp -chunks, then checks that
+# SvtAv1DecApp decodes every frame of the stitched stream.
+
+# cmake-format: off
+if(NOT SVT_AV1_ENC_APP
+    OR NOT SVT_AV1_DEC_APP
+    OR NOT SVT_AV1_TEST_DIR)
+    message(FATAL_ERROR
+        "SVT_AV1_ENC_APP, SVT_AV1_DEC_APP and SVT_AV1_TEST_DIR must be defined.")
+endif()
+# cmake-format: on
+
+set(width 192)
+set(height 128)
+set(frames 24)
+set(intra_period 7)
+set(chunks 3)
+
+file(MAKE_DIRECTORY "${SVT_AV1_TEST_DIR}")
+set(input "${SVT_AV1_TEST_DIR}/chunk_input.yuv")
+set(stream "${SVT_AV1_TEST_DIR}/chunk_stream.ivf")
+set(output "${SVT_AV1_TEST_DIR}/chunk_output.yuv")
+
+include("${CMAKE_CURRENT_LIST_DIR}/app_test_clip.cmake")
+write_app_test_clip("${input}" ${width} ${height} ${frames})
+
+execute_process(COMMAND "${SVT_AV1_ENC_APP}"
+    -i "${input}" -w ${width} -h ${height} -n ${frames}
+    -intra-period ${intra_period} -chunks ${chunks} -b "${stream}"
+    RESULT_VARIABLE enc_result
+    OUTPUT_QUIET
+    ERROR_QUIET)
+if(NOT enc_result EQUAL 0)
+    message(FATAL_ERROR "Chunk encoding failed.")
+endif()
+
+execute_process(COMMAND "${SVT_AV1_DEC_APP}" -i "${stream}" -o "${output}"
+    RESULT_VARIABLE dec_result
+    OUTPUT_QUIET
+    ERROR_QUIET)
+if(NOT dec_result EQUAL 0)
+    message(FATAL_ERROR "Decoding the stitched stream failed.")
+endif()
+
+file(SIZE "${input}" input_size)
+file(SIZE "${output}" output_size)
+if(NOT input_size EQUAL output_size)
+    message(FATAL_ERROR
+        "The stitched stream decodes to ${output_size} bytes, ${input_size} expected.")
+endif()
+message(STATUS "The ${chunks} chunk streams decode as one stream")
+
+# Every chunk is a separate encode, scene change key frames within a chunk are allowed
+execute_process(COMMAND "${SVT_AV1_ENC_APP}"
+    -i "${input}" -w ${width} -h ${height} -n ${frames}
+    -intra-period ${intra_period} -chunks ${chunks} -scd 1 -b "${stream}"
+    RESULT_VARIABLE enc_result
+    OUTPUT_QUIET
+    ERROR_QUIET)
+if(NOT enc_result EQUAL 0)
+    message(FATAL_ERROR "Chunk encoding with scene change detection failed.")
+endif()
+
+execute_process(COMMAND "${SVT_AV1_DEC_APP}" -i "${stream}" -o "${output}"
+    RESULT_VARIABLE dec_result
+    OUTPUT_QUIET
+    ERROR_QUIET)
+if(NOT dec_result EQUAL 0)
+    message(FATAL_ERROR "Decoding the stitched stream with scene changes failed.")
+endif()
+
+file(SIZE "${output}" output_size)
+if(NOT input_size EQUAL output_size)
+    message(FATAL_ERROR
+        "The stitched stream with scene changes decodes to ${output_size} bytes, ${input_size} expected.")
+endif()
+message(STATUS "The ${chunks} chunk streams with scene change detection decode as one stream")
@@ -0,0 +1,68 @@
+#
+# Copyright(c) 2019 Netflix, Inc
+# SPDX - License - Identifier: BSD - 2 - Clause - Patent
+#
+
+# Encodes a generated clip with deblocking, CDEF and loop restoration enabled,
+# then checks that the stream matches the one of the encoder before the CDEF
+# search was overlapped with the deblocking. The SB rows of the clip let the
+# CDEF search of the top rows run while the bottom rows are deblocked.
+# SVT_AV1_FILTER_STREAM_MD5 has to be updated by the changes meant to alter
+# the bitstream.
+
+# cmake-format: off
+if(NOT SVT_AV1_ENC_APP
+    OR NOT SVT_AV1_DEC_APP
+    OR NOT SVT_AV1_TEST_DIR)
+    message(FATAL_ERROR
+        "SVT_AV1_ENC_APP, SVT_AV1_DEC_APP and SVT_AV1_TEST_DIR must be defined.")
+endif()
+# cmake-format: on
+
+set(SVT_AV1_FILTER_STREAM_MD5 3356f7bb6f320ba286628d7d8e01c621)
+set(width 256)
+set(height 192)
+set(frames 10)
+set(intra_period 9)
+
+file(MAKE_DIRECTORY "${SVT_AV1_TEST_DIR}")
+set(input "${SVT_AV1_TEST_DIR}/filter_input.yuv")
+set(stream "${SVT_AV1_TEST_DIR}/filter_stream.ivf")
+set(output "${SVT_AV1_TEST_DIR}/filter_output.yuv")
+
+include("${CMAKE_CURRENT_LIST_DIR}/app_test_clip.cmake")
+write_app_test_clip("${input}" ${width} ${height} ${frames})
+
+# Deblocking and CDEF are enabled by default in this preset, the restoration is not
+execute_process(COMMAND "${SVT_AV1_ENC_APP}"
+    -i "${input}" -w ${width} -h ${height} -n ${frames}
+    -intra-period ${intra_period} -enc-mode 8 -dlf 0 -restoration-filtering 1
+    -b "${stream}"
+    RESULT_VARIABLE enc_result
+    OUTPUT_QUIET
+    ERROR_QUIET)
+if(NOT enc_result EQUAL 0)
+    message(FATAL_ERROR "Encoding the test stream failed.")
+endif()
+
+file(MD5 "${stream}" stream_md5)
+if(NOT stream_md5 STREQUAL SVT_AV1_FILTER_STREAM_MD5)
+    message(FATAL_ERROR
+        "The filtered stream is ${stream_md5}, ${SVT_AV1_FILTER_STREAM_MD5} expected.")
+endif()
+
+execute_process(COMMAND "${SVT_AV1_DEC_APP}" -i "${stream}" -o "${output}"
+    RESULT_VARIABLE dec_result
+    OUTPUT_QUIET
+    ERROR_QUIET)
+if(NOT dec_result EQUAL 0)
+    message(FATAL_ERROR "Decoding the filtered stream failed.")
+endif()
+
+file(SIZE "${input}" input_size)
+file(SIZE "${output}" output_size)
+if(NOT input_size EQUAL output_size)
+    message(FATAL_ERROR
+        "The filtered stream decodes to ${output_size} bytes, ${input_size} expected.")
+endif()
+message(STATUS "The filtered stream matches the previous encoder (${stream_md5})")
@@ -0,0 +1,76 @@
+#
+# Copyright(c) 2019 Netflix, Inc
+# SPDX - License - Identifier: BSD - 2 - Clause - Patent
+#
+
+# Encodes a generated clip with an SvtAv1EncApp -ladder rendition, checks that
+# SvtAv1DecApp decodes every frame of both streams at their resolution, and
+# that the ladder is rejected along with scene change detection.
+
+# cmake-format: off
+if(NOT SVT_AV1_ENC_APP
+    OR NOT SVT_AV1_DEC_APP
+    OR NOT SVT_AV1_TEST_DIR)
+    message(FATAL_ERROR
+        "SVT_AV1_ENC_APP, SVT_AV1_DEC_APP and SVT_AV1_TEST_DIR must be defined.")
+endif()
+# cmake-format: on
+
+set(width 192)
+set(height 128)
+set(ladder_width 96)
+set(ladder_height 64)
+set(frames 12)
+
+file(MAKE_DIRECTORY "${SVT_AV1_TEST_DIR}")
+set(input "${SVT_AV1_TEST_DIR}/ladder_input.yuv")
+set(stream "${SVT_AV1_TEST_DIR}/ladder_stream.ivf")
+set(ladder_stream "${SVT_AV1_TEST_DIR}/ladder_rendition.ivf")
+
+include("${CMAKE_CURRENT_LIST_DIR}/app_test_clip.cmake")
+write_app_test_clip("${input}" ${width} ${height} ${frames})
+
+set(ladder "${ladder_width}x${ladder_height}:100:${ladder_stream}")
+execute_process(COMMAND "${SVT_AV1_ENC_APP}"
+    -i "${input}" -w ${width} -h ${height} -n ${frames} -scd 1
+    -ladder "${ladder}" -b "${stream}"
+    RESULT_VARIABLE enc_result
+    OUTPUT_QUIET
+    ERROR_QUIET)
+if(enc_result EQUAL 0)
+    message(FATAL_ERROR "The ladder was accepted with scene change detection.")
+endif()
+
+execute_process(COMMAND "${SVT_AV1_ENC_APP}"
+    -i "${input}" -w ${width} -h ${height} -n ${frames}
+    -ladder "${ladder}" -b "${stream}"
+    RESULT_VARIABLE enc_result
+    OUTPUT_QUIET
+    ERROR_QUIET)
+if(NOT enc_result EQUAL 0)
+    message(FATAL_ERROR "Ladder encoding failed.")
+endif()
+
+foreach(rendition top ladder)
+    if(rendition STREQUAL "top")
+        set(rendition_stream "${stream}")
+        math(EXPR expected_size "${width} * ${height} * 3 / 2 * ${frames}")
+    else()
+        set(rendition_stream "${ladder_stream}")
+        math(EXPR expected_size "${ladder_width} * ${ladder_height} * 3 / 2 * ${frames}")
+    endif()
+    set(output "${SVT_AV1_TEST_DIR}/ladder_${rendition}.yuv")
+    execute_process(COMMAND "${SVT_AV1_DEC_APP}" -i "${rendition_stream}" -o "${output}"
+        RESULT_VARIABLE dec_result
+        OUTPUT_QUIET
+        ERROR_QUIET)
+    if(NOT dec_result EQUAL 0)
+        message(FATAL_ERROR "Decoding the ${rendition} rendition failed.")
+    endif()
+    file(SIZE "${output}" output_size)
+    if(NOT output_size EQUAL expected_size)
+        message(FATAL_ERROR
+            "The ${rendition} rendition decodes to ${output_size} bytes, ${expected_size} expected.")
+    endif()
+endforeach()
+message(STATUS "Both renditions of the ladder decode")